@@ -0,0 +1,3554 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IDENTIFIER = 3,                 /* IDENTIFIER  */
+  YYSYMBOL_INT_CONSTANT = 4,               /* INT_CONSTANT  */
+  YYSYMBOL_FLOAT_CONSTANT = 5,             /* FLOAT_CONSTANT  */
+  YYSYMBOL_DOUBLE_CONSTANT = 6,            /* DOUBLE_CONSTANT  */
+  YYSYMBOL_CHAR_CONSTANT = 7,              /* CHAR_CONSTANT  */
+  YYSYMBOL_STRING_LITERAL = 8,             /* STRING_LITERAL  */
+  YYSYMBOL_PTR_OP = 9,                     /* PTR_OP  */
+  YYSYMBOL_INC_OP = 10,                    /* INC_OP  */
+  YYSYMBOL_DEC_OP = 11,                    /* DEC_OP  */
+  YYSYMBOL_LEFT_OP = 12,                   /* LEFT_OP  */
+  YYSYMBOL_RIGHT_OP = 13,                  /* RIGHT_OP  */
+  YYSYMBOL_LE_OP = 14,                     /* LE_OP  */
+  YYSYMBOL_GE_OP = 15,                     /* GE_OP  */
+  YYSYMBOL_EQ_OP = 16,                     /* EQ_OP  */
+  YYSYMBOL_NE_OP = 17,                     /* NE_OP  */
+  YYSYMBOL_AND_OP = 18,                    /* AND_OP  */
+  YYSYMBOL_OR_OP = 19,                     /* OR_OP  */
+  YYSYMBOL_MUL_ASSIGN = 20,                /* MUL_ASSIGN  */
+  YYSYMBOL_DIV_ASSIGN = 21,                /* DIV_ASSIGN  */
+  YYSYMBOL_MOD_ASSIGN = 22,                /* MOD_ASSIGN  */
+  YYSYMBOL_ADD_ASSIGN = 23,                /* ADD_ASSIGN  */
+  YYSYMBOL_SUB_ASSIGN = 24,                /* SUB_ASSIGN  */
+  YYSYMBOL_LEFT_ASSIGN = 25,               /* LEFT_ASSIGN  */
+  YYSYMBOL_RIGHT_ASSIGN = 26,              /* RIGHT_ASSIGN  */
+  YYSYMBOL_AND_ASSIGN = 27,                /* AND_ASSIGN  */
+  YYSYMBOL_XOR_ASSIGN = 28,                /* XOR_ASSIGN  */
+  YYSYMBOL_OR_ASSIGN = 29,                 /* OR_ASSIGN  */
+  YYSYMBOL_TYPEDEF = 30,                   /* TYPEDEF  */
+  YYSYMBOL_EXTERN = 31,                    /* EXTERN  */
+  YYSYMBOL_STATIC = 32,                    /* STATIC  */
+  YYSYMBOL_AUTO = 33,                      /* AUTO  */
+  YYSYMBOL_REGISTER = 34,                  /* REGISTER  */
+  YYSYMBOL_INLINE = 35,                    /* INLINE  */
+  YYSYMBOL_SIZEOF = 36,                    /* SIZEOF  */
+  YYSYMBOL_CHAR = 37,                      /* CHAR  */
+  YYSYMBOL_SHORT = 38,                     /* SHORT  */
+  YYSYMBOL_INT = 39,                       /* INT  */
+  YYSYMBOL_LONG = 40,                      /* LONG  */
+  YYSYMBOL_SIGNED = 41,                    /* SIGNED  */
+  YYSYMBOL_UNSIGNED = 42,                  /* UNSIGNED  */
+  YYSYMBOL_FLOAT = 43,                     /* FLOAT  */
+  YYSYMBOL_DOUBLE = 44,                    /* DOUBLE  */
+  YYSYMBOL_CONST = 45,                     /* CONST  */
+  YYSYMBOL_VOLATILE = 46,                  /* VOLATILE  */
+  YYSYMBOL_VOID = 47,                      /* VOID  */
+  YYSYMBOL_STRUCT = 48,                    /* STRUCT  */
+  YYSYMBOL_UNION = 49,                     /* UNION  */
+  YYSYMBOL_ENUM = 50,                      /* ENUM  */
+  YYSYMBOL_ELLIPSIS = 51,                  /* ELLIPSIS  */
+  YYSYMBOL_CASE = 52,                      /* CASE  */
+  YYSYMBOL_DEFAULT = 53,                   /* DEFAULT  */
+  YYSYMBOL_IF = 54,                        /* IF  */
+  YYSYMBOL_ELSE = 55,                      /* ELSE  */
+  YYSYMBOL_SWITCH = 56,                    /* SWITCH  */
+  YYSYMBOL_WHILE = 57,                     /* WHILE  */
+  YYSYMBOL_DO = 58,                        /* DO  */
+  YYSYMBOL_FOR = 59,                       /* FOR  */
+  YYSYMBOL_GOTO = 60,                      /* GOTO  */
+  YYSYMBOL_CONTINUE = 61,                  /* CONTINUE  */
+  YYSYMBOL_BREAK = 62,                     /* BREAK  */
+  YYSYMBOL_RETURN = 63,                    /* RETURN  */
+  YYSYMBOL_UNKNOWN = 64,                   /* UNKNOWN  */
+  YYSYMBOL_TYPE_NAME = 65,                 /* TYPE_NAME  */
+  YYSYMBOL_END_OF_CODE = 66,               /* END_OF_CODE  */
+  YYSYMBOL_67_ = 67,                       /* ';'  */
+  YYSYMBOL_68_ = 68,                       /* '{'  */
+  YYSYMBOL_69_ = 69,                       /* '}'  */
+  YYSYMBOL_70_ = 70,                       /* ','  */
+  YYSYMBOL_71_ = 71,                       /* '='  */
+  YYSYMBOL_72_ = 72,                       /* '*'  */
+  YYSYMBOL_73_ = 73,                       /* '('  */
+  YYSYMBOL_74_ = 74,                       /* ')'  */
+  YYSYMBOL_75_ = 75,                       /* '['  */
+  YYSYMBOL_76_ = 76,                       /* ']'  */
+  YYSYMBOL_77_ = 77,                       /* ':'  */
+  YYSYMBOL_78_ = 78,                       /* '.'  */
+  YYSYMBOL_79_ = 79,                       /* '&'  */
+  YYSYMBOL_80_ = 80,                       /* '+'  */
+  YYSYMBOL_81_ = 81,                       /* '-'  */
+  YYSYMBOL_82_ = 82,                       /* '~'  */
+  YYSYMBOL_83_ = 83,                       /* '!'  */
+  YYSYMBOL_84_ = 84,                       /* '/'  */
+  YYSYMBOL_85_ = 85,                       /* '%'  */
+  YYSYMBOL_86_ = 86,                       /* '<'  */
+  YYSYMBOL_87_ = 87,                       /* '>'  */
+  YYSYMBOL_88_ = 88,                       /* '^'  */
+  YYSYMBOL_89_ = 89,                       /* '|'  */
+  YYSYMBOL_90_ = 90,                       /* '?'  */
+  YYSYMBOL_YYACCEPT = 91,                  /* $accept  */
+  YYSYMBOL_ROOT = 92,                      /* ROOT  */
+  YYSYMBOL_translation_unit = 93,          /* translation_unit  */
+  YYSYMBOL_external_declaration = 94,      /* external_declaration  */
+  YYSYMBOL_function_definition = 95,       /* function_definition  */
+  YYSYMBOL_declaration = 96,               /* declaration  */
+  YYSYMBOL_enum_specifier = 97,            /* enum_specifier  */
+  YYSYMBOL_enumerator_list = 98,           /* enumerator_list  */
+  YYSYMBOL_enumerator = 99,                /* enumerator  */
+  YYSYMBOL_declaration_specifiers = 100,   /* declaration_specifiers  */
+  YYSYMBOL_type_specifier = 101,           /* type_specifier  */
+  YYSYMBOL_init_declarator_list = 102,     /* init_declarator_list  */
+  YYSYMBOL_declarator = 103,               /* declarator  */
+  YYSYMBOL_direct_declarator = 104,        /* direct_declarator  */
+  YYSYMBOL_parameter_list = 105,           /* parameter_list  */
+  YYSYMBOL_parameter_declaration = 106,    /* parameter_declaration  */
+  YYSYMBOL_identifier = 107,               /* identifier  */
+  YYSYMBOL_initializer = 108,              /* initializer  */
+  YYSYMBOL_initializer_list = 109,         /* initializer_list  */
+  YYSYMBOL_statement = 110,                /* statement  */
+  YYSYMBOL_compound_statement = 111,       /* compound_statement  */
+  YYSYMBOL_statement_list = 112,           /* statement_list  */
+  YYSYMBOL_declaration_list = 113,         /* declaration_list  */
+  YYSYMBOL_expression_statement = 114,     /* expression_statement  */
+  YYSYMBOL_selection_statement = 115,      /* selection_statement  */
+  YYSYMBOL_labeled_statement = 116,        /* labeled_statement  */
+  YYSYMBOL_iteration_statement = 117,      /* iteration_statement  */
+  YYSYMBOL_jump_statement = 118,           /* jump_statement  */
+  YYSYMBOL_primary_expression = 119,       /* primary_expression  */
+  YYSYMBOL_postfix_expression = 120,       /* postfix_expression  */
+  YYSYMBOL_argument_list = 121,            /* argument_list  */
+  YYSYMBOL_unary_expression = 122,         /* unary_expression  */
+  YYSYMBOL_unary_operator = 123,           /* unary_operator  */
+  YYSYMBOL_cast_expression = 124,          /* cast_expression  */
+  YYSYMBOL_multiplicative_expression = 125, /* multiplicative_expression  */
+  YYSYMBOL_additive_expression = 126,      /* additive_expression  */
+  YYSYMBOL_shift_expression = 127,         /* shift_expression  */
+  YYSYMBOL_relational_expression = 128,    /* relational_expression  */
+  YYSYMBOL_equality_expression = 129,      /* equality_expression  */
+  YYSYMBOL_and_expression = 130,           /* and_expression  */
+  YYSYMBOL_exclusive_or_expression = 131,  /* exclusive_or_expression  */
+  YYSYMBOL_inclusive_or_expression = 132,  /* inclusive_or_expression  */
+  YYSYMBOL_logical_and_expression = 133,   /* logical_and_expression  */
+  YYSYMBOL_logical_or_expression = 134,    /* logical_or_expression  */
+  YYSYMBOL_conditional_expression = 135,   /* conditional_expression  */
+  YYSYMBOL_assignment_expression = 136,    /* assignment_expression  */
+  YYSYMBOL_assignment_operator = 137,      /* assignment_operator  */
+  YYSYMBOL_expression = 138,               /* expression  */
+  YYSYMBOL_constant_expression = 139       /* constant_expression  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 24 "src/parser.y"
+
+    // the reentrant scanner's interface, from lexer.flex
+    int yylex(YYSTYPE* yylval, yyscan_t scanner);
+    int yylex_init_extra(ParseContext* context, yyscan_t* scanner);
+    int yylex_destroy(yyscan_t scanner);
+    void yyset_in(FILE* in, yyscan_t scanner);
+    char* yyget_text(yyscan_t scanner);
+    int yyget_lineno(yyscan_t scanner);
+    typedef struct yy_buffer_state* YY_BUFFER_STATE;
+    YY_BUFFER_STATE yy_scan_buffer(char* base, size_t size, yyscan_t scanner);
+    void yy_delete_buffer(YY_BUFFER_STATE buffer, yyscan_t scanner);
+
+    void yyerror(yyscan_t scanner, ParseContext& context, const char* s);
+
+#line 258 "build/parser.tab.cpp"
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+# define YYCOPY_NEEDED 1
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  25
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   936
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  91
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  49
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  161
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  279
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   321
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    83,     2,     2,     2,    85,    79,     2,
+      73,    74,    72,    80,    70,    81,    78,    84,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    77,    67,
+      86,    71,    87,    90,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    75,     2,    76,    88,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    68,    89,    69,    82,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   104,   104,   108,   114,   122,   123,   127,   146,   161,
+     188,   190,   195,   206,   217,   222,   228,   233,   235,   240,
+     241,   242,   246,   247,   248,   249,   250,   251,   252,   253,
+     257,   264,   270,   287,   296,   297,   305,   307,   308,   310,
+     313,   316,   321,   327,   335,   339,   344,   349,   350,   351,
+     352,   358,   364,   373,   374,   375,   376,   377,   378,   382,
+     385,   388,   394,   412,   418,   426,   432,   440,   441,   445,
+     449,   453,   460,   464,   468,   473,   477,   481,   492,   505,
+     510,   512,   514,   516,   521,   524,   525,   526,   527,   528,
+     529,   533,   534,   537,   538,   541,   544,   547,   548,   552,
+     558,   566,   567,   570,   573,   576,   579,   583,   584,   585,
+     586,   587,   588,   592,   593,   598,   599,   602,   605,   611,
+     612,   615,   621,   622,   625,   631,   632,   635,   638,   641,
+     647,   648,   651,   657,   658,   664,   665,   671,   672,   678,
+     679,   685,   686,   692,   693,   699,   700,   703,   710,   711,
+     712,   713,   714,   715,   716,   717,   718,   719,   720,   741,
+     742,   748
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  static const char *const yy_sname[] =
+  {
+  "end of file", "error", "invalid token", "IDENTIFIER", "INT_CONSTANT",
+  "FLOAT_CONSTANT", "DOUBLE_CONSTANT", "CHAR_CONSTANT", "STRING_LITERAL",
+  "PTR_OP", "INC_OP", "DEC_OP", "LEFT_OP", "RIGHT_OP", "LE_OP", "GE_OP",
+  "EQ_OP", "NE_OP", "AND_OP", "OR_OP", "MUL_ASSIGN", "DIV_ASSIGN",
+  "MOD_ASSIGN", "ADD_ASSIGN", "SUB_ASSIGN", "LEFT_ASSIGN", "RIGHT_ASSIGN",
+  "AND_ASSIGN", "XOR_ASSIGN", "OR_ASSIGN", "TYPEDEF", "EXTERN", "STATIC",
+  "AUTO", "REGISTER", "INLINE", "SIZEOF", "CHAR", "SHORT", "INT", "LONG",
+  "SIGNED", "UNSIGNED", "FLOAT", "DOUBLE", "CONST", "VOLATILE", "VOID",
+  "STRUCT", "UNION", "ENUM", "ELLIPSIS", "CASE", "DEFAULT", "IF", "ELSE",
+  "SWITCH", "WHILE", "DO", "FOR", "GOTO", "CONTINUE", "BREAK", "RETURN",
+  "UNKNOWN", "TYPE_NAME", "END_OF_CODE", "';'", "'{'", "'}'", "','", "'='",
+  "'*'", "'('", "')'", "'['", "']'", "':'", "'.'", "'&'", "'+'", "'-'",
+  "'~'", "'!'", "'/'", "'%'", "'<'", "'>'", "'^'", "'|'", "'?'", "$accept",
+  "ROOT", "translation_unit", "external_declaration",
+  "function_definition", "declaration", "enum_specifier",
+  "enumerator_list", "enumerator", "declaration_specifiers",
+  "type_specifier", "init_declarator_list", "declarator",
+  "direct_declarator", "parameter_list", "parameter_declaration",
+  "identifier", "initializer", "initializer_list", "statement",
+  "compound_statement", "statement_list", "declaration_list",
+  "expression_statement", "selection_statement", "labeled_statement",
+  "iteration_statement", "jump_statement", "primary_expression",
+  "postfix_expression", "argument_list", "unary_expression",
+  "unary_operator", "cast_expression", "multiplicative_expression",
+  "additive_expression", "shift_expression", "relational_expression",
+  "equality_expression", "and_expression", "exclusive_or_expression",
+  "inclusive_or_expression", "logical_and_expression",
+  "logical_or_expression", "conditional_expression",
+  "assignment_expression", "assignment_operator", "expression",
+  "constant_expression", YY_NULLPTR
+  };
+  return yy_sname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-121)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-51)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     279,   354,  -121,  -121,  -121,  -121,  -121,  -121,   466,  -121,
+      29,  -121,    67,   279,  -121,  -121,  -121,    53,    34,   -10,
+       4,  -121,  -121,    80,    20,  -121,  -121,  -121,  -121,  -121,
+       4,     4,   -58,    78,    30,  -121,    17,    25,   -21,  -121,
+      76,    80,  -121,    84,  -121,     4,   214,   622,  -121,   126,
+     670,  -121,  -121,    80,   815,   107,  -121,    91,    87,  -121,
+    -121,  -121,  -121,  -121,   837,   837,   853,   815,    97,   113,
+     119,   128,   491,   132,   177,   139,   140,   704,  -121,  -121,
+    -121,   572,  -121,  -121,  -121,  -121,  -121,  -121,    34,  -121,
+    -121,  -121,   376,   295,  -121,  -121,  -121,  -121,  -121,  -121,
+      35,    33,   815,  -121,   -43,    98,   170,    13,   171,   129,
+     122,   125,   197,     0,  -121,  -121,    90,    42,   622,  -121,
+    -121,  -121,     4,   -34,  -121,  -121,  -121,  -121,   147,  -121,
+    -121,  -121,   622,   491,   815,  -121,  -121,   572,  -121,   149,
+     491,   815,   815,   815,   172,   721,   160,  -121,  -121,  -121,
+     105,   154,    -6,  -121,  -121,  -121,  -121,   410,    80,  -121,
+    -121,   755,   815,    80,  -121,  -121,  -121,  -121,  -121,  -121,
+    -121,  -121,  -121,  -121,   222,   815,  -121,   815,   815,   815,
+     815,   815,   815,   815,   815,   815,   815,   815,   815,   815,
+     815,   815,   815,   815,   815,   815,  -121,   815,  -121,   120,
+    -121,   354,  -121,  -121,  -121,  -121,   157,   491,  -121,    -5,
+      15,    44,   161,   721,  -121,  -121,   815,  -121,  -121,  -121,
+    -121,    49,  -121,    16,  -121,  -121,  -121,  -121,  -121,  -121,
+     -43,   -43,    98,    98,   170,   170,   170,   170,    13,    13,
+     171,   129,   122,   125,   197,     5,  -121,  -121,   588,  -121,
+    -121,  -121,   491,   491,   491,   815,   803,  -121,   815,  -121,
+    -121,   815,  -121,  -121,   178,  -121,  -121,    51,   491,    52,
+    -121,  -121,   491,   168,  -121,   491,  -121,  -121,  -121
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,     0,    23,    24,    28,    29,    25,    26,     0,    22,
+       0,    27,     0,     2,     3,     5,     6,     0,     0,    19,
+       0,    20,    46,     0,    14,     1,     4,    11,    36,    10,
+       0,     0,     0,    30,    34,    21,     0,    30,     0,    15,
+      17,     0,    35,     0,     9,     0,     0,     0,     7,     0,
+       0,     8,    12,     0,     0,     0,    37,    31,    46,    85,
+      86,    87,    88,    89,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    67,    59,
+     108,     0,   107,   109,   110,   111,   112,    65,     0,    84,
+      63,    54,     0,     0,    55,    56,    53,    57,    58,    91,
+     101,   113,     0,   115,   119,   122,   125,   130,   133,   135,
+     137,   139,   141,   143,   145,   159,     0,    89,     0,    32,
+      47,    41,    45,     0,    42,    38,   113,   161,     0,    16,
+      18,    13,     0,     0,     0,   102,   103,     0,   105,     0,
+       0,     0,     0,     0,     0,     0,     0,    80,    81,    82,
+       0,     0,     0,    60,    64,    61,    66,     0,     0,    97,
+      98,     0,     0,     0,   149,   150,   151,   152,   153,   154,
+     155,   156,   157,   158,   148,     0,   104,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    68,     0,    51,     0,
+      44,     0,    40,    39,    33,    72,     0,     0,    74,     0,
+       0,     0,     0,     0,    79,    83,     0,    90,    62,    96,
+      93,     0,    99,     0,    95,   147,   146,   116,   117,   118,
+     120,   121,   123,   124,   128,   129,   126,   127,   131,   132,
+     134,   136,   138,   140,   142,     0,   160,    48,     0,    43,
+     106,    73,     0,     0,     0,     0,     0,   114,     0,    94,
+      92,     0,    49,    52,    69,    71,    75,     0,     0,     0,
+     100,   144,     0,     0,    77,     0,    70,    76,    78
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -121,  -121,  -121,   223,  -121,   -20,  -121,   196,   185,     1,
+      14,   219,    -7,  -121,  -121,    39,    -2,   -98,  -121,   -59,
+     208,   150,  -121,  -120,  -121,  -121,  -121,  -121,  -121,  -121,
+    -121,   -50,  -121,   -99,    18,    21,   -32,     8,    55,    56,
+      54,    59,    60,  -121,   -49,   -16,  -121,   -71,   -24
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,    12,    13,    14,    15,    16,    17,    38,    39,    18,
+      19,    32,    37,    34,   123,   124,    89,   119,   199,    90,
+      91,    92,    93,    94,    95,    96,    97,    98,    99,   100,
+     221,   101,   102,   103,   104,   105,   106,   107,   108,   109,
+     110,   111,   112,   113,   114,   115,   175,   116,   128
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+     126,   127,    20,   176,   126,   127,   150,    28,    24,    44,
+     152,    33,    45,   144,   135,   136,   138,   126,   127,   194,
+     198,    40,    21,    42,    43,   213,    87,   184,   185,   177,
+     130,   120,    22,   154,   204,    35,   201,    28,    57,    40,
+     202,   178,   179,   139,   158,   159,   160,    88,    52,    53,
+     122,    40,   126,   164,   165,   166,   167,   168,   169,   170,
+     171,   172,   173,   152,   197,   197,   152,    25,   217,   252,
+     209,   210,   211,   156,   205,   197,    30,    31,   227,   228,
+     229,   208,   261,    22,    51,   197,   197,    45,    41,   253,
+     195,   223,   260,   256,    88,   151,    47,    23,   154,   186,
+     187,    29,   120,    49,   174,    50,    30,    31,   161,   -50,
+     162,   -50,   -50,   163,   197,   200,   120,   257,   254,   258,
+      27,   197,   197,   259,   245,   273,   275,   126,   126,   126,
+     126,   126,   126,   126,   126,   126,   126,   126,   126,   126,
+     126,   126,   126,   126,   126,   222,    46,    54,   251,    47,
+     263,   206,   234,   235,   236,   237,   219,   196,    56,   226,
+     197,   224,   132,     2,   133,     3,   126,     4,     5,     6,
+       7,     8,   215,     9,   140,   197,   131,    53,   180,   181,
+     146,   246,   182,   183,   267,   269,   141,   188,   189,   247,
+     248,    11,   142,   264,   265,   266,   238,   239,   230,   231,
+     121,   143,   122,   232,   233,   145,   147,   148,   190,   274,
+     191,   126,   271,   276,   192,   193,   278,    58,    59,    60,
+      61,    62,    63,   203,    64,    65,   207,   214,   216,   212,
+     225,   250,   120,   272,   255,   277,    26,    55,   129,    36,
+     249,    48,   270,   157,     1,   240,   242,   241,     0,     0,
+      66,     2,   243,     3,   244,     4,     5,     6,     7,     8,
+       0,     9,     0,     0,    10,     0,    67,    68,    69,     0,
+      70,    71,    72,    73,    74,    75,    76,    77,     0,    11,
+       0,    78,    46,    79,     0,     0,    80,    81,     0,     0,
+       0,     0,     0,    82,    83,    84,    85,    86,    58,    59,
+      60,    61,    62,    63,     0,    64,    65,     0,     0,     1,
+       0,     0,     0,     0,     0,     0,     2,     0,     3,     0,
+       4,     5,     6,     7,     8,     1,     9,     0,     0,    10,
+       0,    66,     2,     0,     3,     0,     4,     5,     6,     7,
+       8,     0,     9,     0,    11,    10,     0,    67,    68,    69,
+       0,    70,    71,    72,    73,    74,    75,    76,    77,     0,
+      11,     0,    78,    46,   155,     0,     0,    80,    81,     0,
+       0,     0,     0,     0,    82,    83,    84,    85,    86,    58,
+      59,    60,    61,    62,    63,     0,    64,    65,     0,     0,
+       0,     2,     0,     3,     0,     4,     5,     6,     7,     8,
+       0,     9,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    66,    58,    59,    60,    61,    62,    63,    11,
+      64,    65,     0,     0,     0,     0,     0,     0,    67,    68,
+      69,     0,    70,    71,    72,    73,    74,    75,    76,    77,
+       0,     0,     0,    78,    46,   153,    66,     0,    80,    81,
+       0,     0,     0,     0,     0,    82,    83,    84,    85,    86,
+       0,     0,    67,    68,    69,     0,    70,    71,    72,    73,
+      74,    75,    76,    77,     0,     0,     0,    78,    46,   218,
+       0,     0,    80,    81,     0,     0,     0,     0,     0,    82,
+      83,    84,    85,    86,    58,    59,    60,    61,    62,    63,
+       0,    64,    65,     2,     0,     3,     0,     4,     5,     6,
+       7,     0,     0,     9,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    66,     0,     0,
+       0,    11,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    67,    68,    69,     0,    70,    71,    72,
+      73,    74,    75,    76,    77,     0,     0,     0,    78,    46,
+       0,     0,     0,    80,    81,     0,     0,     0,     0,     0,
+      82,    83,    84,    85,    86,    22,    59,    60,    61,    62,
+      63,     0,    64,    65,     0,     0,     0,     0,     0,     0,
+       0,    22,    59,    60,    61,    62,   117,     0,    64,    65,
+       0,     0,     0,     0,     0,     0,     0,     0,    66,     2,
+       0,     3,     0,     4,     5,     6,     7,     0,     0,     9,
+       0,     0,     0,     0,    66,    22,    59,    60,    61,    62,
+     117,     0,    64,    65,     0,     0,     0,    11,     0,     0,
+       0,     0,     0,     0,    80,    81,     0,     0,     0,     0,
+       0,    82,    83,    84,    85,    86,   118,   262,    66,     0,
+      80,    81,     0,     0,     0,     0,     0,    82,    83,    84,
+      85,    86,     0,    22,    59,    60,    61,    62,    63,     0,
+      64,    65,     0,     0,     0,     0,     0,     0,     0,     0,
+     118,     0,     0,     0,    80,    81,     0,     0,     0,     0,
+       0,    82,    83,    84,    85,    86,    66,    22,    59,    60,
+      61,    62,    63,     0,    64,    65,     0,     0,     0,     0,
+       0,     0,     0,     0,    22,    59,    60,    61,    62,    63,
+       0,    64,    65,     0,     0,     0,     0,     0,     0,     0,
+      66,     0,    80,    81,     0,     0,   125,     0,     0,    82,
+      83,    84,    85,    86,     0,     0,     0,    66,    22,    59,
+      60,    61,    62,    63,     0,    64,    65,     0,     0,     0,
+       0,   149,     0,     0,     0,     0,    80,    81,     0,     0,
+       0,     0,     0,    82,    83,    84,    85,    86,    78,     0,
+       0,    66,     0,    80,    81,     0,     0,     0,     0,     0,
+      82,    83,    84,    85,    86,     0,    22,    59,    60,    61,
+      62,    63,     0,    64,    65,     0,     0,     0,    22,    59,
+      60,    61,    62,    63,     0,    64,    65,    80,    81,   220,
+       0,     0,     0,     0,    82,    83,    84,    85,    86,    66,
+      22,    59,    60,    61,    62,    63,     0,    64,    65,     0,
+       0,    66,     0,     0,     0,     0,    22,    59,    60,    61,
+      62,    63,     0,    64,    65,     0,     0,     0,     0,     0,
+       0,     0,     0,    66,     0,    80,    81,   268,     0,     0,
+       0,     0,    82,    83,    84,    85,    86,    80,    81,    66,
+       0,     0,     0,     0,    82,    83,    84,    85,    86,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    80,
+     134,     0,     0,     0,     0,     0,    82,    83,    84,    85,
+      86,     0,     0,     0,     0,    80,   137,     0,     0,     0,
+       0,     0,    82,    83,    84,    85,    86
+};
+
+static const yytype_int16 yycheck[] =
+{
+      50,    50,     1,   102,    54,    54,    77,     3,    10,    67,
+      81,    18,    70,    72,    64,    65,    66,    67,    67,    19,
+     118,    23,     8,    30,    31,   145,    46,    14,    15,    72,
+      54,    47,     3,    92,   132,    45,    70,     3,    45,    41,
+      74,    84,    85,    67,     9,    10,    11,    46,    69,    70,
+      49,    53,   102,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,   134,    70,    70,   137,     0,    74,    74,
+     141,   142,   143,    93,   133,    70,    72,    73,   177,   178,
+     179,   140,    77,     3,    67,    70,    70,    70,    68,    74,
+      90,   162,    76,   213,    93,    81,    71,    68,   157,    86,
+      87,    67,   118,    73,    71,    75,    72,    73,    73,    67,
+      75,    69,    70,    78,    70,   122,   132,   216,    74,    70,
+      67,    70,    70,    74,   195,    74,    74,   177,   178,   179,
+     180,   181,   182,   183,   184,   185,   186,   187,   188,   189,
+     190,   191,   192,   193,   194,   161,    68,    71,   207,    71,
+     248,   137,   184,   185,   186,   187,   158,    67,    74,   175,
+      70,   163,    71,    37,    77,    39,   216,    41,    42,    43,
+      44,    45,    67,    47,    77,    70,    69,    70,    80,    81,
+       3,   197,    12,    13,   255,   256,    73,    16,    17,    69,
+      70,    65,    73,   252,   253,   254,   188,   189,   180,   181,
+      74,    73,   201,   182,   183,    73,    67,    67,    79,   268,
+      88,   261,   261,   272,    89,    18,   275,     3,     4,     5,
+       6,     7,     8,    76,    10,    11,    77,    67,    74,    57,
+       8,    74,   248,    55,    73,    67,    13,    41,    53,    20,
+     201,    33,   258,    93,    30,   190,   192,   191,    -1,    -1,
+      36,    37,   193,    39,   194,    41,    42,    43,    44,    45,
+      -1,    47,    -1,    -1,    50,    -1,    52,    53,    54,    -1,
+      56,    57,    58,    59,    60,    61,    62,    63,    -1,    65,
+      -1,    67,    68,    69,    -1,    -1,    72,    73,    -1,    -1,
+      -1,    -1,    -1,    79,    80,    81,    82,    83,     3,     4,
+       5,     6,     7,     8,    -1,    10,    11,    -1,    -1,    30,
+      -1,    -1,    -1,    -1,    -1,    -1,    37,    -1,    39,    -1,
+      41,    42,    43,    44,    45,    30,    47,    -1,    -1,    50,
+      -1,    36,    37,    -1,    39,    -1,    41,    42,    43,    44,
+      45,    -1,    47,    -1,    65,    50,    -1,    52,    53,    54,
+      -1,    56,    57,    58,    59,    60,    61,    62,    63,    -1,
+      65,    -1,    67,    68,    69,    -1,    -1,    72,    73,    -1,
+      -1,    -1,    -1,    -1,    79,    80,    81,    82,    83,     3,
+       4,     5,     6,     7,     8,    -1,    10,    11,    -1,    -1,
+      -1,    37,    -1,    39,    -1,    41,    42,    43,    44,    45,
+      -1,    47,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    36,     3,     4,     5,     6,     7,     8,    65,
+      10,    11,    -1,    -1,    -1,    -1,    -1,    -1,    52,    53,
+      54,    -1,    56,    57,    58,    59,    60,    61,    62,    63,
+      -1,    -1,    -1,    67,    68,    69,    36,    -1,    72,    73,
+      -1,    -1,    -1,    -1,    -1,    79,    80,    81,    82,    83,
+      -1,    -1,    52,    53,    54,    -1,    56,    57,    58,    59,
+      60,    61,    62,    63,    -1,    -1,    -1,    67,    68,    69,
+      -1,    -1,    72,    73,    -1,    -1,    -1,    -1,    -1,    79,
+      80,    81,    82,    83,     3,     4,     5,     6,     7,     8,
+      -1,    10,    11,    37,    -1,    39,    -1,    41,    42,    43,
+      44,    -1,    -1,    47,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    36,    -1,    -1,
+      -1,    65,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    52,    53,    54,    -1,    56,    57,    58,
+      59,    60,    61,    62,    63,    -1,    -1,    -1,    67,    68,
+      -1,    -1,    -1,    72,    73,    -1,    -1,    -1,    -1,    -1,
+      79,    80,    81,    82,    83,     3,     4,     5,     6,     7,
+       8,    -1,    10,    11,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,     3,     4,     5,     6,     7,     8,    -1,    10,    11,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    36,    37,
+      -1,    39,    -1,    41,    42,    43,    44,    -1,    -1,    47,
+      -1,    -1,    -1,    -1,    36,     3,     4,     5,     6,     7,
+       8,    -1,    10,    11,    -1,    -1,    -1,    65,    -1,    -1,
+      -1,    -1,    -1,    -1,    72,    73,    -1,    -1,    -1,    -1,
+      -1,    79,    80,    81,    82,    83,    68,    69,    36,    -1,
+      72,    73,    -1,    -1,    -1,    -1,    -1,    79,    80,    81,
+      82,    83,    -1,     3,     4,     5,     6,     7,     8,    -1,
+      10,    11,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      68,    -1,    -1,    -1,    72,    73,    -1,    -1,    -1,    -1,
+      -1,    79,    80,    81,    82,    83,    36,     3,     4,     5,
+       6,     7,     8,    -1,    10,    11,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,     3,     4,     5,     6,     7,     8,
+      -1,    10,    11,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      36,    -1,    72,    73,    -1,    -1,    76,    -1,    -1,    79,
+      80,    81,    82,    83,    -1,    -1,    -1,    36,     3,     4,
+       5,     6,     7,     8,    -1,    10,    11,    -1,    -1,    -1,
+      -1,    67,    -1,    -1,    -1,    -1,    72,    73,    -1,    -1,
+      -1,    -1,    -1,    79,    80,    81,    82,    83,    67,    -1,
+      -1,    36,    -1,    72,    73,    -1,    -1,    -1,    -1,    -1,
+      79,    80,    81,    82,    83,    -1,     3,     4,     5,     6,
+       7,     8,    -1,    10,    11,    -1,    -1,    -1,     3,     4,
+       5,     6,     7,     8,    -1,    10,    11,    72,    73,    74,
+      -1,    -1,    -1,    -1,    79,    80,    81,    82,    83,    36,
+       3,     4,     5,     6,     7,     8,    -1,    10,    11,    -1,
+      -1,    36,    -1,    -1,    -1,    -1,     3,     4,     5,     6,
+       7,     8,    -1,    10,    11,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    36,    -1,    72,    73,    74,    -1,    -1,
+      -1,    -1,    79,    80,    81,    82,    83,    72,    73,    36,
+      -1,    -1,    -1,    -1,    79,    80,    81,    82,    83,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    72,
+      73,    -1,    -1,    -1,    -1,    -1,    79,    80,    81,    82,
+      83,    -1,    -1,    -1,    -1,    72,    73,    -1,    -1,    -1,
+      -1,    -1,    79,    80,    81,    82,    83
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,    30,    37,    39,    41,    42,    43,    44,    45,    47,
+      50,    65,    92,    93,    94,    95,    96,    97,   100,   101,
+     100,   101,     3,    68,   107,     0,    94,    67,     3,    67,
+      72,    73,   102,   103,   104,    45,   102,   103,    98,    99,
+     107,    68,   103,   103,    67,    70,    68,    71,   111,    73,
+      75,    67,    69,    70,    71,    98,    74,   103,     3,     4,
+       5,     6,     7,     8,    10,    11,    36,    52,    53,    54,
+      56,    57,    58,    59,    60,    61,    62,    63,    67,    69,
+      72,    73,    79,    80,    81,    82,    83,    96,   100,   107,
+     110,   111,   112,   113,   114,   115,   116,   117,   118,   119,
+     120,   122,   123,   124,   125,   126,   127,   128,   129,   130,
+     131,   132,   133,   134,   135,   136,   138,     8,    68,   108,
+     136,    74,   100,   105,   106,    76,   122,   135,   139,    99,
+     139,    69,    71,    77,    73,   122,   122,    73,   122,   139,
+      77,    73,    73,    73,   110,    73,     3,    67,    67,    67,
+     138,   101,   138,    69,   110,    69,    96,   112,     9,    10,
+      11,    73,    75,    78,    20,    21,    22,    23,    24,    25,
+      26,    27,    28,    29,    71,   137,   124,    72,    84,    85,
+      80,    81,    12,    13,    14,    15,    86,    87,    16,    17,
+      79,    88,    89,    18,    19,    90,    67,    70,   108,   109,
+     103,    70,    74,    76,   108,   110,   101,    77,   110,   138,
+     138,   138,    57,   114,    67,    67,    74,    74,    69,   107,
+      74,   121,   136,   138,   107,     8,   136,   124,   124,   124,
+     125,   125,   126,   126,   127,   127,   127,   127,   128,   128,
+     129,   130,   131,   132,   133,   138,   136,    69,    70,   106,
+      74,   110,    74,    74,    74,    73,   114,   124,    70,    74,
+      76,    77,    69,   108,   110,   110,   110,   138,    74,   138,
+     136,   135,    55,    74,   110,    74,   110,    67,   110
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    91,    92,    93,    93,    94,    94,    95,    96,    96,
+      96,    96,    97,    97,    97,    98,    98,    99,    99,   100,
+     100,   100,   101,   101,   101,   101,   101,   101,   101,   101,
+     102,   102,   102,   102,   103,   103,   104,   104,   104,   104,
+     104,   104,   105,   105,   106,   106,   107,   108,   108,   108,
+     108,   109,   109,   110,   110,   110,   110,   110,   110,   111,
+     111,   111,   111,   112,   112,   113,   113,   114,   114,   115,
+     115,   115,   116,   116,   116,   117,   117,   117,   117,   118,
+     118,   118,   118,   118,   119,   119,   119,   119,   119,   119,
+     119,   120,   120,   120,   120,   120,   120,   120,   120,   121,
+     121,   122,   122,   122,   122,   122,   122,   123,   123,   123,
+     123,   123,   123,   124,   124,   125,   125,   125,   125,   126,
+     126,   126,   127,   127,   127,   128,   128,   128,   128,   128,
+     129,   129,   129,   130,   130,   131,   131,   132,   132,   133,
+     133,   134,   134,   135,   135,   136,   136,   136,   137,   137,
+     137,   137,   137,   137,   137,   137,   137,   137,   137,   138,
+     138,   139
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     2,     1,     1,     3,     4,     3,
+       2,     2,     4,     5,     2,     1,     3,     1,     3,     1,
+       2,     2,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     3,     3,     5,     1,     2,     1,     3,     3,     4,
+       4,     3,     1,     3,     2,     1,     1,     1,     3,     4,
+       1,     1,     3,     1,     1,     1,     1,     1,     1,     2,
+       3,     3,     4,     1,     2,     1,     2,     1,     2,     5,
+       7,     5,     3,     4,     3,     5,     7,     6,     7,     3,
+       2,     2,     2,     3,     1,     1,     1,     1,     1,     1,
+       3,     1,     4,     3,     4,     3,     3,     2,     2,     1,
+       3,     1,     2,     2,     2,     2,     4,     1,     1,     1,
+       1,     1,     1,     1,     4,     1,     3,     3,     3,     1,
+       3,     3,     1,     3,     3,     1,     3,     3,     3,     3,
+       1,     3,     3,     1,     3,     1,     3,     1,     3,     1,
+       3,     1,     3,     1,     5,     1,     3,     3,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       3,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        YY_LAC_DISCARD ("YYBACKUP");                              \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, context, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, scanner, context); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, ParseContext& context)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (context);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, ParseContext& context)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, context);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, yyscan_t scanner, ParseContext& context)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, context);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner, context); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Given a state stack such that *YYBOTTOM is its bottom, such that
+   *YYTOP is either its top or is YYTOP_EMPTY to indicate an empty
+   stack, and such that *YYCAPACITY is the maximum number of elements it
+   can hold without a reallocation, make sure there is enough room to
+   store YYADD more elements.  If not, allocate a new stack using
+   YYSTACK_ALLOC, copy the existing elements, and adjust *YYBOTTOM,
+   *YYTOP, and *YYCAPACITY to reflect the new capacity and memory
+   location.  If *YYBOTTOM != YYBOTTOM_NO_FREE, then free the old stack
+   using YYSTACK_FREE.  Return 0 if successful or if no reallocation is
+   required.  Return YYENOMEM if memory is exhausted.  */
+static int
+yy_lac_stack_realloc (YYPTRDIFF_T *yycapacity, YYPTRDIFF_T yyadd,
+#if YYDEBUG
+                      char const *yydebug_prefix,
+                      char const *yydebug_suffix,
+#endif
+                      yy_state_t **yybottom,
+                      yy_state_t *yybottom_no_free,
+                      yy_state_t **yytop, yy_state_t *yytop_empty)
+{
+  YYPTRDIFF_T yysize_old =
+    *yytop == yytop_empty ? 0 : *yytop - *yybottom + 1;
+  YYPTRDIFF_T yysize_new = yysize_old + yyadd;
+  if (*yycapacity < yysize_new)
+    {
+      YYPTRDIFF_T yyalloc = 2 * yysize_new;
+      yy_state_t *yybottom_new;
+      /* Use YYMAXDEPTH for maximum stack size given that the stack
+         should never need to grow larger than the main state stack
+         needs to grow without LAC.  */
+      if (YYMAXDEPTH < yysize_new)
+        {
+          YYDPRINTF ((stderr, "%smax size exceeded%s", yydebug_prefix,
+                      yydebug_suffix));
+          return YYENOMEM;
+        }
+      if (YYMAXDEPTH < yyalloc)
+        yyalloc = YYMAXDEPTH;
+      yybottom_new =
+        YY_CAST (yy_state_t *,
+                 YYSTACK_ALLOC (YY_CAST (YYSIZE_T,
+                                         yyalloc * YYSIZEOF (*yybottom_new))));
+      if (!yybottom_new)
+        {
+          YYDPRINTF ((stderr, "%srealloc failed%s", yydebug_prefix,
+                      yydebug_suffix));
+          return YYENOMEM;
+        }
+      if (*yytop != yytop_empty)
+        {
+          YYCOPY (yybottom_new, *yybottom, yysize_old);
+          *yytop = yybottom_new + (yysize_old - 1);
+        }
+      if (*yybottom != yybottom_no_free)
+        YYSTACK_FREE (*yybottom);
+      *yybottom = yybottom_new;
+      *yycapacity = yyalloc;
+    }
+  return 0;
+}
+
+/* Establish the initial context for the current lookahead if no initial
+   context is currently established.
+
+   We define a context as a snapshot of the parser stacks.  We define
+   the initial context for a lookahead as the context in which the
+   parser initially examines that lookahead in order to select a
+   syntactic action.  Thus, if the lookahead eventually proves
+   syntactically unacceptable (possibly in a later context reached via a
+   series of reductions), the initial context can be used to determine
+   the exact set of tokens that would be syntactically acceptable in the
+   lookahead's place.  Moreover, it is the context after which any
+   further semantic actions would be erroneous because they would be
+   determined by a syntactically unacceptable token.
+
+   YY_LAC_ESTABLISH should be invoked when a reduction is about to be
+   performed in an inconsistent state (which, for the purposes of LAC,
+   includes consistent states that don't know they're consistent because
+   their default reductions have been disabled).  Iff there is a
+   lookahead token, it should also be invoked before reporting a syntax
+   error.  This latter case is for the sake of the debugging output.
+
+   For parse.lac=full, the implementation of YY_LAC_ESTABLISH is as
+   follows.  If no initial context is currently established for the
+   current lookahead, then check if that lookahead can eventually be
+   shifted if syntactic actions continue from the current context.
+   Report a syntax error if it cannot.  */
+#define YY_LAC_ESTABLISH                                                \
+do {                                                                    \
+  if (!yy_lac_established)                                              \
+    {                                                                   \
+      YYDPRINTF ((stderr,                                               \
+                  "LAC: initial context established for %s\n",          \
+                  yysymbol_name (yytoken)));                            \
+      yy_lac_established = 1;                                           \
+      switch (yy_lac (yyesa, &yyes, &yyes_capacity, yyssp, yytoken))    \
+        {                                                               \
+        case YYENOMEM:                                                  \
+          YYNOMEM;                                                      \
+        case 1:                                                         \
+          goto yyerrlab;                                                \
+        }                                                               \
+    }                                                                   \
+} while (0)
+
+/* Discard any previous initial lookahead context because of Event,
+   which may be a lookahead change or an invalidation of the currently
+   established initial context for the current lookahead.
+
+   The most common example of a lookahead change is a shift.  An example
+   of both cases is syntax error recovery.  That is, a syntax error
+   occurs when the lookahead is syntactically erroneous for the
+   currently established initial context, so error recovery manipulates
+   the parser stacks to try to find a new initial context in which the
+   current lookahead is syntactically acceptable.  If it fails to find
+   such a context, it discards the lookahead.  */
+#if YYDEBUG
+# define YY_LAC_DISCARD(Event)                                           \
+do {                                                                     \
+  if (yy_lac_established)                                                \
+    {                                                                    \
+      YYDPRINTF ((stderr, "LAC: initial context discarded due to "       \
+                  Event "\n"));                                          \
+      yy_lac_established = 0;                                            \
+    }                                                                    \
+} while (0)
+#else
+# define YY_LAC_DISCARD(Event) yy_lac_established = 0
+#endif
+
+/* Given the stack whose top is *YYSSP, return 0 iff YYTOKEN can
+   eventually (after perhaps some reductions) be shifted, return 1 if
+   not, or return YYENOMEM if memory is exhausted.  As preconditions and
+   postconditions: *YYES_CAPACITY is the allocated size of the array to
+   which *YYES points, and either *YYES = YYESA or *YYES points to an
+   array allocated with YYSTACK_ALLOC.  yy_lac may overwrite the
+   contents of either array, alter *YYES and *YYES_CAPACITY, and free
+   any old *YYES other than YYESA.  */
+static int
+yy_lac (yy_state_t *yyesa, yy_state_t **yyes,
+        YYPTRDIFF_T *yyes_capacity, yy_state_t *yyssp, yysymbol_kind_t yytoken)
+{
+  yy_state_t *yyes_prev = yyssp;
+  yy_state_t *yyesp = yyes_prev;
+  /* Reduce until we encounter a shift and thereby accept the token.  */
+  YYDPRINTF ((stderr, "LAC: checking lookahead %s:", yysymbol_name (yytoken)));
+  if (yytoken == YYSYMBOL_YYUNDEF)
+    {
+      YYDPRINTF ((stderr, " Always Err\n"));
+      return 1;
+    }
+  while (1)
+    {
+      int yyrule = yypact[+*yyesp];
+      if (yypact_value_is_default (yyrule)
+          || (yyrule += yytoken) < 0 || YYLAST < yyrule
+          || yycheck[yyrule] != yytoken)
+        {
+          /* Use the default action.  */
+          yyrule = yydefact[+*yyesp];
+          if (yyrule == 0)
+            {
+              YYDPRINTF ((stderr, " Err\n"));
+              return 1;
+            }
+        }
+      else
+        {
+          /* Use the action from yytable.  */
+          yyrule = yytable[yyrule];
+          if (yytable_value_is_error (yyrule))
+            {
+              YYDPRINTF ((stderr, " Err\n"));
+              return 1;
+            }
+          if (0 < yyrule)
+            {
+              YYDPRINTF ((stderr, " S%d\n", yyrule));
+              return 0;
+            }
+          yyrule = -yyrule;
+        }
+      /* By now we know we have to simulate a reduce.  */
+      YYDPRINTF ((stderr, " R%d", yyrule - 1));
+      {
+        /* Pop the corresponding number of values from the stack.  */
+        YYPTRDIFF_T yylen = yyr2[yyrule];
+        /* First pop from the LAC stack as many tokens as possible.  */
+        if (yyesp != yyes_prev)
+          {
+            YYPTRDIFF_T yysize = yyesp - *yyes + 1;
+            if (yylen < yysize)
+              {
+                yyesp -= yylen;
+                yylen = 0;
+              }
+            else
+              {
+                yyesp = yyes_prev;
+                yylen -= yysize;
+              }
+          }
+        /* Only afterwards look at the main stack.  */
+        if (yylen)
+          yyesp = yyes_prev -= yylen;
+      }
+      /* Push the resulting state of the reduction.  */
+      {
+        yy_state_fast_t yystate;
+        {
+          const int yylhs = yyr1[yyrule] - YYNTOKENS;
+          const int yyi = yypgoto[yylhs] + *yyesp;
+          yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyesp
+                     ? yytable[yyi]
+                     : yydefgoto[yylhs]);
+        }
+        if (yyesp == yyes_prev)
+          {
+            yyesp = *yyes;
+            YY_IGNORE_USELESS_CAST_BEGIN
+            *yyesp = YY_CAST (yy_state_t, yystate);
+            YY_IGNORE_USELESS_CAST_END
+          }
+        else
+          {
+            if (yy_lac_stack_realloc (yyes_capacity, 1,
+#if YYDEBUG
+                                      " (", ")",
+#endif
+                                      yyes, yyesa, &yyesp, yyes_prev))
+              {
+                YYDPRINTF ((stderr, "\n"));
+                return YYENOMEM;
+              }
+            YY_IGNORE_USELESS_CAST_BEGIN
+            *++yyesp = YY_CAST (yy_state_t, yystate);
+            YY_IGNORE_USELESS_CAST_END
+          }
+        YYDPRINTF ((stderr, " G%d", yystate));
+      }
+    }
+}
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yy_state_t *yyesa;
+  yy_state_t **yyes;
+  YYPTRDIFF_T *yyes_capacity;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+
+  int yyx;
+  for (yyx = 0; yyx < YYNTOKENS; ++yyx)
+    {
+      yysymbol_kind_t yysym = YY_CAST (yysymbol_kind_t, yyx);
+      if (yysym != YYSYMBOL_YYerror && yysym != YYSYMBOL_YYUNDEF)
+        switch (yy_lac (yyctx->yyesa, yyctx->yyes, yyctx->yyes_capacity, yyctx->yyssp, yysym))
+          {
+          case YYENOMEM:
+            return YYENOMEM;
+          case 1:
+            continue;
+          default:
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = yysym;
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+       In the first two cases, it might appear that the current syntax
+       error should have been detected in the previous state when yy_lac
+       was invoked.  However, at that time, there might have been a
+       different syntax error that discarded a different initial context
+       during error recovery, leaving behind the current lookahead.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      YYDPRINTF ((stderr, "Constructing syntax error message\n"));
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else if (yyn == 0)
+        YYDPRINTF ((stderr, "No expected tokens.\n"));
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.  In order to see if a particular token T is a
+   valid looakhead, invoke yy_lac (YYESA, YYES, YYES_CAPACITY, YYSSP, T).
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store or if
+   yy_lac returned YYENOMEM.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yystrlen (yysymbol_name (yyarg[yyi]));
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp = yystpcpy (yyp, yysymbol_name (yyarg[yyi++]));
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, yyscan_t scanner, ParseContext& context)
+{
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (context);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (yyscan_t scanner, ParseContext& context)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    yy_state_t yyesa[20];
+    yy_state_t *yyes = yyesa;
+    YYPTRDIFF_T yyes_capacity = 20 < YYMAXDEPTH ? 20 : YYMAXDEPTH;
+
+  /* Whether LAC context is established.  A Boolean.  */
+  int yy_lac_established = 0;
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    {
+      YY_LAC_ESTABLISH;
+      goto yydefault;
+    }
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      YY_LAC_ESTABLISH;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  YY_LAC_DISCARD ("shift");
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  {
+    int yychar_backup = yychar;
+    switch (yyn)
+      {
+  case 2: /* ROOT: translation_unit  */
+#line 104 "src/parser.y"
+                       {context.root = (yyvsp[0].node_list_ptr);}
+#line 2021 "build/parser.tab.cpp"
+    break;
+
+  case 3: /* translation_unit: external_declaration  */
+#line 109 "src/parser.y"
+        {
+            auto list = ast::makeNodeList();
+            list->PushBack((yyvsp[0].node_ptr));
+            (yyval.node_list_ptr) = list;
+        }
+#line 2031 "build/parser.tab.cpp"
+    break;
+
+  case 4: /* translation_unit: translation_unit external_declaration  */
+#line 115 "src/parser.y"
+        {
+            (yyvsp[-1].node_list_ptr)->PushBack((yyvsp[0].node_ptr));
+            (yyval.node_list_ptr) = (yyvsp[-1].node_list_ptr);
+        }
+#line 2040 "build/parser.tab.cpp"
+    break;
+
+  case 5: /* external_declaration: function_definition  */
+#line 122 "src/parser.y"
+                          { (yyval.node_ptr) = (yyvsp[0].node_ptr); }
+#line 2046 "build/parser.tab.cpp"
+    break;
+
+  case 6: /* external_declaration: declaration  */
+#line 123 "src/parser.y"
+                  { (yyval.node_ptr) = (yyvsp[0].node_ptr); }
+#line 2052 "build/parser.tab.cpp"
+    break;
+
+  case 7: /* function_definition: declaration_specifiers declarator compound_statement  */
+#line 128 "src/parser.y"
+        {
+            auto fn = dynamic_cast<FunctionDeclarator*>((yyvsp[-1].declarator_ptr));
+            if (fn) {
+                auto compoundStmt = dynamic_cast<CompoundStatement*>((yyvsp[0].stmt_ptr));
+                if (compoundStmt) {
+                    (yyval.node_ptr) = makeFunctionDeclaration((yyvsp[-2].type_specifier), fn, compoundStmt);
+                } else {
+                    (yyval.node_ptr) = makeFunctionDeclaration((yyvsp[-2].type_specifier), fn, nullptr);
+                }
+            } else {
+                auto fnDecl = makeFunctionDeclarator((yyvsp[-1].declarator_ptr), nullptr);
+                auto compoundStmt = dynamic_cast<CompoundStatement*>((yyvsp[0].stmt_ptr));
+                (yyval.node_ptr) = makeFunctionDeclaration((yyvsp[-2].type_specifier), fnDecl, compoundStmt);
+            }
+        }
+#line 2072 "build/parser.tab.cpp"
+    break;
+
+  case 8: /* declaration: TYPEDEF declaration_specifiers init_declarator_list ';'  */
+#line 147 "src/parser.y"
+        {
+            for (const auto &node : (yyvsp[-1].node_list_ptr)->getNodes())
+            {
+                auto initDecl = dynamic_cast<InitDeclarator*>(node);
+                if (initDecl) {
+                    auto ident = initDecl->getDeclarator();
+                    if (ident) {
+                        context.updateTypeDefs(ident->getSymbol(), (yyvsp[-2].type_specifier));
+                    }
+                }
+            }
+            auto initDeclarator = dynamic_cast<InitDeclarator*>((yyvsp[-1].node_list_ptr)->getNodes()[0]);
+            (yyval.node_ptr) = makeTypedefDeclaration((yyvsp[-2].type_specifier), initDeclarator->getDeclarator());
+        }
+#line 2091 "build/parser.tab.cpp"
+    break;
+
+  case 9: /* declaration: declaration_specifiers init_declarator_list ';'  */
+#line 162 "src/parser.y"
+        {
+            // if there is only one declaration (case most of the time) -> return single variable decl
+            if ((yyvsp[-1].node_list_ptr)->getNodes().size() == 1) {
+                auto initDeclarator = dynamic_cast<InitDeclarator*>((yyvsp[-1].node_list_ptr)->getNodes()[0]);
+                if (initDeclarator) {
+                    (yyval.node_ptr) = makeVariableDeclaration(
+                        (yyvsp[-2].type_specifier), initDeclarator->getDeclarator(), initDeclarator->getInitializer());
+                }
+                else {
+                    (yyval.node_ptr) = makeNodeList();
+                } /*empty list if smth wrong*/
+            }
+            else {
+                // for multiple declarations
+                auto decls = makeNodeList();
+                for (auto& initDecl : (yyvsp[-1].node_list_ptr)->getNodes()) {
+                    auto initDeclarator = dynamic_cast<InitDeclarator*>(initDecl);
+                    if (initDeclarator) {
+                        auto decl = makeVariableDeclaration(
+                            (yyvsp[-2].type_specifier), initDeclarator->getDeclarator(), initDeclarator->getInitializer());
+                        decls->PushBack(decl);
+                    }
+                }
+                (yyval.node_ptr) = decls;
+            }
+        }
+#line 2122 "build/parser.tab.cpp"
+    break;
+
+  case 10: /* declaration: declaration_specifiers ';'  */
+#line 189 "src/parser.y"
+        { (yyval.node_ptr) = makeNodeList(); }
+#line 2128 "build/parser.tab.cpp"
+    break;
+
+  case 11: /* declaration: enum_specifier ';'  */
+#line 191 "src/parser.y"
+        { (yyval.node_ptr) = (yyvsp[-1].node_ptr); }
+#line 2134 "build/parser.tab.cpp"
+    break;
+
+  case 12: /* enum_specifier: ENUM '{' enumerator_list '}'  */
+#line 196 "src/parser.y"
+        {
+            auto enumDecl = makeEnumDeclaration(nullptr);
+            for (auto& node : (yyvsp[-1].node_list_ptr)->getNodes()) {
+                auto enumValue = dynamic_cast<EnumValue*>(node);
+                if (enumValue) {
+                    enumDecl->addValue(enumValue);
+                }
+            }
+            (yyval.node_ptr) = enumDecl;
+        }
+#line 2149 "build/parser.tab.cpp"
+    break;
+
+  case 13: /* enum_specifier: ENUM identifier '{' enumerator_list '}'  */
+#line 207 "src/parser.y"
+        {
+            auto enumDecl = makeEnumDeclaration((yyvsp[-3].identifier_ptr));
+            for (auto& node : (yyvsp[-1].node_list_ptr)->getNodes()) {
+                auto enumValue = dynamic_cast<EnumValue*>(node);
+                if (enumValue) {
+                    enumDecl->addValue(enumValue);
+                }
+            }
+            (yyval.node_ptr) = enumDecl;
+        }
+#line 2164 "build/parser.tab.cpp"
+    break;
+
+  case 14: /* enum_specifier: ENUM identifier  */
+#line 218 "src/parser.y"
+        {(yyval.node_ptr) = makeEnumDeclaration((yyvsp[0].identifier_ptr));}
+#line 2170 "build/parser.tab.cpp"
+    break;
+
+  case 15: /* enumerator_list: enumerator  */
+#line 223 "src/parser.y"
+        {
+            auto list = makeNodeList();
+            list->PushBack((yyvsp[0].node_ptr));
+            (yyval.node_list_ptr) = list;
+        }
+#line 2180 "build/parser.tab.cpp"
+    break;
+
+  case 16: /* enumerator_list: enumerator_list ',' enumerator  */
+#line 229 "src/parser.y"
+        {(yyvsp[-2].node_list_ptr)->PushBack((yyvsp[0].node_ptr)); (yyval.node_list_ptr) = (yyvsp[-2].node_list_ptr);}
+#line 2186 "build/parser.tab.cpp"
+    break;
+
+  case 17: /* enumerator: identifier  */
+#line 234 "src/parser.y"
+        {(yyval.node_ptr) = makeEnumValue((yyvsp[0].identifier_ptr));}
+#line 2192 "build/parser.tab.cpp"
+    break;
+
+  case 18: /* enumerator: identifier '=' constant_expression  */
+#line 236 "src/parser.y"
+        { (yyval.node_ptr) = makeEnumValue((yyvsp[-2].identifier_ptr), (yyvsp[0].expr_ptr));}
+#line 2198 "build/parser.tab.cpp"
+    break;
+
+  case 19: /* declaration_specifiers: type_specifier  */
+#line 240 "src/parser.y"
+                     { (yyval.type_specifier) = (yyvsp[0].type_specifier); }
+#line 2204 "build/parser.tab.cpp"
+    break;
+
+  case 20: /* declaration_specifiers: CONST type_specifier  */
+#line 241 "src/parser.y"
+                           { (yyval.type_specifier) = (yyvsp[0].type_specifier); /* Ignore const for simplicity */ }
+#line 2210 "build/parser.tab.cpp"
+    break;
+
+  case 21: /* declaration_specifiers: type_specifier CONST  */
+#line 242 "src/parser.y"
+                           { (yyval.type_specifier) = (yyvsp[-1].type_specifier); /* Ignore const for simplicity */ }
+#line 2216 "build/parser.tab.cpp"
+    break;
+
+  case 22: /* type_specifier: VOID  */
+#line 246 "src/parser.y"
+           { (yyval.type_specifier) = TypeSpecifier::VOID; }
+#line 2222 "build/parser.tab.cpp"
+    break;
+
+  case 23: /* type_specifier: CHAR  */
+#line 247 "src/parser.y"
+           { (yyval.type_specifier) = TypeSpecifier::CHAR; }
+#line 2228 "build/parser.tab.cpp"
+    break;
+
+  case 24: /* type_specifier: INT  */
+#line 248 "src/parser.y"
+          { (yyval.type_specifier) = TypeSpecifier::INT; }
+#line 2234 "build/parser.tab.cpp"
+    break;
+
+  case 25: /* type_specifier: FLOAT  */
+#line 249 "src/parser.y"
+            { (yyval.type_specifier) = TypeSpecifier::FLOAT; }
+#line 2240 "build/parser.tab.cpp"
+    break;
+
+  case 26: /* type_specifier: DOUBLE  */
+#line 250 "src/parser.y"
+             { (yyval.type_specifier) = TypeSpecifier::DOUBLE; }
+#line 2246 "build/parser.tab.cpp"
+    break;
+
+  case 27: /* type_specifier: TYPE_NAME  */
+#line 251 "src/parser.y"
+                { (yyval.type_specifier) = context.getTypeDefType(Symbol::FromId((yyvsp[0].symbol))); }
+#line 2252 "build/parser.tab.cpp"
+    break;
+
+  case 28: /* type_specifier: SIGNED  */
+#line 252 "src/parser.y"
+             { (yyval.type_specifier) = TypeSpecifier::SIGNED; }
+#line 2258 "build/parser.tab.cpp"
+    break;
+
+  case 29: /* type_specifier: UNSIGNED  */
+#line 253 "src/parser.y"
+               { (yyval.type_specifier) = TypeSpecifier::UNSIGNED; }
+#line 2264 "build/parser.tab.cpp"
+    break;
+
+  case 30: /* init_declarator_list: declarator  */
+#line 258 "src/parser.y"
+        {
+            auto list = makeInitDeclaratorList();
+            auto initDecl = makeInitDeclarator((yyvsp[0].declarator_ptr), nullptr);
+            list->PushBack(initDecl);
+            (yyval.node_list_ptr) = list;
+        }
+#line 2275 "build/parser.tab.cpp"
+    break;
+
+  case 31: /* init_declarator_list: init_declarator_list ',' declarator  */
+#line 265 "src/parser.y"
+        {
+            auto initDecl = makeInitDeclarator((yyvsp[0].declarator_ptr), nullptr);
+            (yyvsp[-2].node_list_ptr)->PushBack(initDecl);
+            (yyval.node_list_ptr) = (yyvsp[-2].node_list_ptr);
+        }
+#line 2285 "build/parser.tab.cpp"
+    break;
+
+  case 32: /* init_declarator_list: declarator '=' initializer  */
+#line 271 "src/parser.y"
+        {
+                auto list = makeInitDeclaratorList();
+                auto initDecl = makeInitDeclarator((yyvsp[-2].declarator_ptr), (yyvsp[0].expr_ptr));
+                list->PushBack(initDecl);
+                (yyval.node_list_ptr) = list;
+
+                if ((yyvsp[-2].declarator_ptr)->isPointer() && (yyvsp[0].expr_ptr)->getType() == TypeSpecifier::CHAR) {
+                auto stringExpr = dynamic_cast<ast::StringLiteralExpression*>((yyvsp[0].expr_ptr));
+                if (stringExpr) {
+                    auto arrayDecl = makeArrayDeclarator((yyvsp[-2].declarator_ptr), makeLiteralExpression(4)); //size should be a word no matter what (4 CHARS)
+                    list->PushBack(arrayDecl);
+                    }
+                }
+
+
+        }
+#line 2306 "build/parser.tab.cpp"
+    break;
+
+  case 33: /* init_declarator_list: init_declarator_list ',' declarator '=' initializer  */
+#line 288 "src/parser.y"
+        {
+            auto initDecl = makeInitDeclarator((yyvsp[-2].declarator_ptr), (yyvsp[0].expr_ptr));
+            (yyvsp[-4].node_list_ptr)->PushBack(initDecl);
+            (yyval.node_list_ptr) = (yyvsp[-4].node_list_ptr);
+        }
+#line 2316 "build/parser.tab.cpp"
+    break;
+
+  case 34: /* declarator: direct_declarator  */
+#line 296 "src/parser.y"
+                        { (yyval.declarator_ptr) = (yyvsp[0].declarator_ptr); }
+#line 2322 "build/parser.tab.cpp"
+    break;
+
+  case 35: /* declarator: '*' declarator  */
+#line 297 "src/parser.y"
+                     {
+            // std::string id = $2->getIdentifier();
+            // std::cerr << $2->getIdentifier() << std::endl;
+            (yyval.declarator_ptr) = makePointerDeclarator((yyvsp[0].declarator_ptr));
+        }
+#line 2332 "build/parser.tab.cpp"
+    break;
+
+  case 36: /* direct_declarator: IDENTIFIER  */
+#line 306 "src/parser.y"
+            {(yyval.declarator_ptr) = makeIdentifierDeclarator(Symbol::FromId((yyvsp[0].symbol)));}
+#line 2338 "build/parser.tab.cpp"
+    break;
+
+  case 37: /* direct_declarator: '(' declarator ')'  */
+#line 307 "src/parser.y"
+                         { (yyval.declarator_ptr) = (yyvsp[-1].declarator_ptr); }
+#line 2344 "build/parser.tab.cpp"
+    break;
+
+  case 38: /* direct_declarator: direct_declarator '[' ']'  */
+#line 309 "src/parser.y"
+            {(yyval.declarator_ptr) = makeArrayDeclarator((yyvsp[-2].declarator_ptr), nullptr);}
+#line 2350 "build/parser.tab.cpp"
+    break;
+
+  case 39: /* direct_declarator: direct_declarator '[' constant_expression ']'  */
+#line 310 "src/parser.y"
+                                                    {
+            (yyval.declarator_ptr) = makeArrayDeclarator((yyvsp[-3].declarator_ptr), (yyvsp[-1].expr_ptr));
+        }
+#line 2358 "build/parser.tab.cpp"
+    break;
+
+  case 40: /* direct_declarator: direct_declarator '(' parameter_list ')'  */
+#line 313 "src/parser.y"
+                                               {
+            (yyval.declarator_ptr) = makeFunctionDeclarator((yyvsp[-3].declarator_ptr), (yyvsp[-1].parameter_list_ptr));
+        }
+#line 2366 "build/parser.tab.cpp"
+    break;
+
+  case 41: /* direct_declarator: direct_declarator '(' ')'  */
+#line 317 "src/parser.y"
+            {(yyval.declarator_ptr) = makeFunctionDeclarator((yyvsp[-2].declarator_ptr), nullptr);}
+#line 2372 "build/parser.tab.cpp"
+    break;
+
+  case 42: /* parameter_list: parameter_declaration  */
+#line 322 "src/parser.y"
+        {
+            auto list = makeParameterList();
+            list->addParameter((yyvsp[0].node_ptr));
+            (yyval.parameter_list_ptr) = list;
+        }
+#line 2382 "build/parser.tab.cpp"
+    break;
+
+  case 43: /* parameter_list: parameter_list ',' parameter_declaration  */
+#line 328 "src/parser.y"
+        {
+            (yyvsp[-2].parameter_list_ptr)->addParameter((yyvsp[0].node_ptr));
+            (yyval.parameter_list_ptr) = (yyvsp[-2].parameter_list_ptr);
+        }
+#line 2391 "build/parser.tab.cpp"
+    break;
+
+  case 44: /* parameter_declaration: declaration_specifiers declarator  */
+#line 336 "src/parser.y"
+        {
+            (yyval.node_ptr) = makeParameterDeclaration((yyvsp[-1].type_specifier), (yyvsp[0].declarator_ptr));
+        }
+#line 2399 "build/parser.tab.cpp"
+    break;
+
+  case 45: /* parameter_declaration: declaration_specifiers  */
+#line 340 "src/parser.y"
+        {(yyval.node_ptr) = makeParameterDeclaration((yyvsp[0].type_specifier), nullptr);}
+#line 2405 "build/parser.tab.cpp"
+    break;
+
+  case 46: /* identifier: IDENTIFIER  */
+#line 345 "src/parser.y"
+            {(yyval.identifier_ptr) = makeIdentifier(Symbol::FromId((yyvsp[0].symbol)));}
+#line 2411 "build/parser.tab.cpp"
+    break;
+
+  case 47: /* initializer: assignment_expression  */
+#line 349 "src/parser.y"
+                            { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 2417 "build/parser.tab.cpp"
+    break;
+
+  case 48: /* initializer: '{' initializer_list '}'  */
+#line 350 "src/parser.y"
+                               { (yyval.expr_ptr) = (yyvsp[-1].expr_ptr); }
+#line 2423 "build/parser.tab.cpp"
+    break;
+
+  case 49: /* initializer: '{' initializer_list ',' '}'  */
+#line 351 "src/parser.y"
+                                   { (yyval.expr_ptr) = (yyvsp[-2].expr_ptr); }
+#line 2429 "build/parser.tab.cpp"
+    break;
+
+  case 50: /* initializer: STRING_LITERAL  */
+#line 352 "src/parser.y"
+                     {
+            (yyval.expr_ptr) = makeStringLiteralExpression(Symbol::FromId((yyvsp[0].symbol)));
+        }
+#line 2437 "build/parser.tab.cpp"
+    break;
+
+  case 51: /* initializer_list: initializer  */
+#line 359 "src/parser.y"
+        {
+            auto list = makeInitializerList();
+            list->addExpression((yyvsp[0].expr_ptr));
+            (yyval.expr_ptr) = list;
+        }
+#line 2447 "build/parser.tab.cpp"
+    break;
+
+  case 52: /* initializer_list: initializer_list ',' initializer  */
+#line 365 "src/parser.y"
+        {
+            auto list = dynamic_cast<InitializerList*>((yyvsp[-2].expr_ptr));
+            list->addExpression((yyvsp[0].expr_ptr));
+            (yyval.expr_ptr) = (yyvsp[-2].expr_ptr);
+        }
+#line 2457 "build/parser.tab.cpp"
+    break;
+
+  case 53: /* statement: labeled_statement  */
+#line 373 "src/parser.y"
+                        { (yyval.stmt_ptr) = (yyvsp[0].stmt_ptr); }
+#line 2463 "build/parser.tab.cpp"
+    break;
+
+  case 54: /* statement: compound_statement  */
+#line 374 "src/parser.y"
+                         { (yyval.stmt_ptr) = (yyvsp[0].stmt_ptr); }
+#line 2469 "build/parser.tab.cpp"
+    break;
+
+  case 55: /* statement: expression_statement  */
+#line 375 "src/parser.y"
+                           { (yyval.stmt_ptr) = (yyvsp[0].stmt_ptr); }
+#line 2475 "build/parser.tab.cpp"
+    break;
+
+  case 56: /* statement: selection_statement  */
+#line 376 "src/parser.y"
+                          { (yyval.stmt_ptr) = (yyvsp[0].stmt_ptr); }
+#line 2481 "build/parser.tab.cpp"
+    break;
+
+  case 57: /* statement: iteration_statement  */
+#line 377 "src/parser.y"
+                          { (yyval.stmt_ptr) = (yyvsp[0].stmt_ptr); }
+#line 2487 "build/parser.tab.cpp"
+    break;
+
+  case 58: /* statement: jump_statement  */
+#line 378 "src/parser.y"
+                     { (yyval.stmt_ptr) = (yyvsp[0].stmt_ptr); }
+#line 2493 "build/parser.tab.cpp"
+    break;
+
+  case 59: /* compound_statement: '{' '}'  */
+#line 382 "src/parser.y"
+              {
+            (yyval.stmt_ptr) = makeCompoundStatement();
+        }
+#line 2501 "build/parser.tab.cpp"
+    break;
+
+  case 60: /* compound_statement: '{' statement_list '}'  */
+#line 385 "src/parser.y"
+                             {
+            (yyval.stmt_ptr) = makeCompoundStatement((yyvsp[-1].node_list_ptr));
+        }
+#line 2509 "build/parser.tab.cpp"
+    break;
+
+  case 61: /* compound_statement: '{' declaration_list '}'  */
+#line 389 "src/parser.y"
+        {
+            auto compStmt = makeCompoundStatement();
+            compStmt->setDeclarationList((yyvsp[-1].node_list_ptr));
+            (yyval.stmt_ptr) = compStmt;
+        }
+#line 2519 "build/parser.tab.cpp"
+    break;
+
+  case 62: /* compound_statement: '{' declaration_list statement_list '}'  */
+#line 395 "src/parser.y"
+        {
+            auto compStmt = makeCompoundStatement();
+            compStmt->setDeclarationList((yyvsp[-2].node_list_ptr));
+
+            // Add the statements
+            for (auto& node : (yyvsp[-1].node_list_ptr)->getNodes()) {
+                auto stmt = dynamic_cast<Statement*>(node);
+                if (stmt) {
+                    compStmt->addStatement(stmt);
+                }
+            }
+
+            (yyval.stmt_ptr) = compStmt;
+        }
+#line 2538 "build/parser.tab.cpp"
+    break;
+
+  case 63: /* statement_list: statement  */
+#line 413 "src/parser.y"
+        {
+            auto list = makeNodeList();
+            list->PushBack((yyvsp[0].stmt_ptr));
+            (yyval.node_list_ptr) = list;
+        }
+#line 2548 "build/parser.tab.cpp"
+    break;
+
+  case 64: /* statement_list: statement_list statement  */
+#line 419 "src/parser.y"
+        {
+            (yyvsp[-1].node_list_ptr)->PushBack((yyvsp[0].stmt_ptr));
+            (yyval.node_list_ptr) = (yyvsp[-1].node_list_ptr);
+        }
+#line 2557 "build/parser.tab.cpp"
+    break;
+
+  case 65: /* declaration_list: declaration  */
+#line 427 "src/parser.y"
+        {
+            auto list = makeNodeList();
+            list->PushBack((yyvsp[0].node_ptr));
+            (yyval.node_list_ptr) = list;
+        }
+#line 2567 "build/parser.tab.cpp"
+    break;
+
+  case 66: /* declaration_list: declaration_list declaration  */
+#line 433 "src/parser.y"
+        {
+            (yyvsp[-1].node_list_ptr)->PushBack((yyvsp[0].node_ptr));
+            (yyval.node_list_ptr) = (yyvsp[-1].node_list_ptr);
+        }
+#line 2576 "build/parser.tab.cpp"
+    break;
+
+  case 67: /* expression_statement: ';'  */
+#line 440 "src/parser.y"
+          {(yyval.stmt_ptr) = makeExpressionStatement(nullptr);}
+#line 2582 "build/parser.tab.cpp"
+    break;
+
+  case 68: /* expression_statement: expression ';'  */
+#line 441 "src/parser.y"
+                     {(yyval.stmt_ptr) = makeExpressionStatement((yyvsp[-1].expr_ptr));}
+#line 2588 "build/parser.tab.cpp"
+    break;
+
+  case 69: /* selection_statement: IF '(' expression ')' statement  */
+#line 446 "src/parser.y"
+        {
+            (yyval.stmt_ptr) = makeIfStatement((yyvsp[-2].expr_ptr), (yyvsp[0].stmt_ptr), nullptr);
+        }
+#line 2596 "build/parser.tab.cpp"
+    break;
+
+  case 70: /* selection_statement: IF '(' expression ')' statement ELSE statement  */
+#line 450 "src/parser.y"
+        {
+            (yyval.stmt_ptr) = makeIfStatement((yyvsp[-4].expr_ptr), (yyvsp[-2].stmt_ptr), (yyvsp[0].stmt_ptr));
+        }
+#line 2604 "build/parser.tab.cpp"
+    break;
+
+  case 71: /* selection_statement: SWITCH '(' expression ')' statement  */
+#line 454 "src/parser.y"
+        {
+            (yyval.stmt_ptr) = makeSwitchStatement((yyvsp[-2].expr_ptr), (yyvsp[0].stmt_ptr));
+        }
+#line 2612 "build/parser.tab.cpp"
+    break;
+
+  case 72: /* labeled_statement: IDENTIFIER ':' statement  */
+#line 460 "src/parser.y"
+                               {
+            auto id = makeIdentifier(Symbol::FromId((yyvsp[-2].symbol)));
+            (yyval.stmt_ptr) = makeLabeledStatement(id, (yyvsp[0].stmt_ptr));
+        }
+#line 2621 "build/parser.tab.cpp"
+    break;
+
+  case 73: /* labeled_statement: CASE constant_expression ':' statement  */
+#line 465 "src/parser.y"
+        {
+            (yyval.stmt_ptr) = makeCaseStatement((yyvsp[-2].expr_ptr), (yyvsp[0].stmt_ptr));
+        }
+#line 2629 "build/parser.tab.cpp"
+    break;
+
+  case 74: /* labeled_statement: DEFAULT ':' statement  */
+#line 469 "src/parser.y"
+        {(yyval.stmt_ptr) = makeDefaultStatement((yyvsp[0].stmt_ptr));}
+#line 2635 "build/parser.tab.cpp"
+    break;
+
+  case 75: /* iteration_statement: WHILE '(' expression ')' statement  */
+#line 474 "src/parser.y"
+        {
+            (yyval.stmt_ptr) = makeWhileStatement((yyvsp[-2].expr_ptr), (yyvsp[0].stmt_ptr));
+        }
+#line 2643 "build/parser.tab.cpp"
+    break;
+
+  case 76: /* iteration_statement: DO statement WHILE '(' expression ')' ';'  */
+#line 478 "src/parser.y"
+        {
+            (yyval.stmt_ptr) = makeDoWhileStatement((yyvsp[-5].stmt_ptr), (yyvsp[-2].expr_ptr));
+        }
+#line 2651 "build/parser.tab.cpp"
+    break;
+
+  case 77: /* iteration_statement: FOR '(' expression_statement expression_statement ')' statement  */
+#line 482 "src/parser.y"
+    {
+        // Cast to ExpressionStatement
+        auto initStmt = dynamic_cast<ExpressionStatement*>((yyvsp[-3].stmt_ptr));
+        auto condStmt = dynamic_cast<ExpressionStatement*>((yyvsp[-2].stmt_ptr));
+
+        Expression* init = initStmt ? initStmt->getExpression() : nullptr;
+        Expression* cond = condStmt ? condStmt->getExpression() : nullptr;
+
+        (yyval.stmt_ptr) = makeForStatement(init, cond, nullptr, (yyvsp[0].stmt_ptr));
+    }
+#line 2666 "build/parser.tab.cpp"
+    break;
+
+  case 78: /* iteration_statement: FOR '(' expression_statement expression_statement expression ')' statement  */
+#line 493 "src/parser.y"
+    {
+        auto initStmt = dynamic_cast<ExpressionStatement*>((yyvsp[-4].stmt_ptr));
+        auto condStmt = dynamic_cast<ExpressionStatement*>((yyvsp[-3].stmt_ptr));
+
+        Expression* init = initStmt ? initStmt->getExpression() : nullptr;
+        Expression* cond = condStmt ? condStmt->getExpression() : nullptr;
+
+        (yyval.stmt_ptr) = makeForStatement(init, cond, (yyvsp[-2].expr_ptr), (yyvsp[0].stmt_ptr));
+    }
+#line 2680 "build/parser.tab.cpp"
+    break;
+
+  case 79: /* jump_statement: GOTO IDENTIFIER ';'  */
+#line 506 "src/parser.y"
+        {
+            auto id = makeIdentifier(Symbol::FromId((yyvsp[-1].symbol)));
+            (yyval.stmt_ptr) = makeGotoStatement(id);
+        }
+#line 2689 "build/parser.tab.cpp"
+    break;
+
+  case 80: /* jump_statement: CONTINUE ';'  */
+#line 511 "src/parser.y"
+        {(yyval.stmt_ptr) = makeContinueStatement();}
+#line 2695 "build/parser.tab.cpp"
+    break;
+
+  case 81: /* jump_statement: BREAK ';'  */
+#line 513 "src/parser.y"
+        {(yyval.stmt_ptr) = makeBreakStatement();}
+#line 2701 "build/parser.tab.cpp"
+    break;
+
+  case 82: /* jump_statement: RETURN ';'  */
+#line 515 "src/parser.y"
+        { (yyval.stmt_ptr) = makeReturnStatement(nullptr);}
+#line 2707 "build/parser.tab.cpp"
+    break;
+
+  case 83: /* jump_statement: RETURN expression ';'  */
+#line 517 "src/parser.y"
+        {(yyval.stmt_ptr) = makeReturnStatement((yyvsp[-1].expr_ptr));}
+#line 2713 "build/parser.tab.cpp"
+    break;
+
+  case 84: /* primary_expression: identifier  */
+#line 521 "src/parser.y"
+                 {
+            (yyval.expr_ptr) = makeIdentifierExpression((yyvsp[0].identifier_ptr));
+        }
+#line 2721 "build/parser.tab.cpp"
+    break;
+
+  case 85: /* primary_expression: INT_CONSTANT  */
+#line 524 "src/parser.y"
+                   {(yyval.expr_ptr) = makeLiteralExpression((yyvsp[0].number_int));}
+#line 2727 "build/parser.tab.cpp"
+    break;
+
+  case 86: /* primary_expression: FLOAT_CONSTANT  */
+#line 525 "src/parser.y"
+                     {(yyval.expr_ptr) = makeLiteralExpression((yyvsp[0].number_float));}
+#line 2733 "build/parser.tab.cpp"
+    break;
+
+  case 87: /* primary_expression: DOUBLE_CONSTANT  */
+#line 526 "src/parser.y"
+                      {(yyval.expr_ptr) = makeLiteralExpression((yyvsp[0].number_double));}
+#line 2739 "build/parser.tab.cpp"
+    break;
+
+  case 88: /* primary_expression: CHAR_CONSTANT  */
+#line 527 "src/parser.y"
+                    {(yyval.expr_ptr) = makeLiteralExpression((yyvsp[0].number_char));}
+#line 2745 "build/parser.tab.cpp"
+    break;
+
+  case 89: /* primary_expression: STRING_LITERAL  */
+#line 528 "src/parser.y"
+                     {(yyval.expr_ptr) = makeStringLiteralExpression(Symbol::FromId((yyvsp[0].symbol)));}
+#line 2751 "build/parser.tab.cpp"
+    break;
+
+  case 90: /* primary_expression: '(' expression ')'  */
+#line 529 "src/parser.y"
+                         { (yyval.expr_ptr) = (yyvsp[-1].expr_ptr); }
+#line 2757 "build/parser.tab.cpp"
+    break;
+
+  case 91: /* postfix_expression: primary_expression  */
+#line 533 "src/parser.y"
+                         { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 2763 "build/parser.tab.cpp"
+    break;
+
+  case 92: /* postfix_expression: postfix_expression '[' expression ']'  */
+#line 534 "src/parser.y"
+                                            {
+            (yyval.expr_ptr) = makeArrayAccessExpression((yyvsp[-3].expr_ptr), (yyvsp[-1].expr_ptr));
+        }
+#line 2771 "build/parser.tab.cpp"
+    break;
+
+  case 93: /* postfix_expression: postfix_expression '(' ')'  */
+#line 537 "src/parser.y"
+                                 {(yyval.expr_ptr) = makeCallExpression((yyvsp[-2].expr_ptr), nullptr);}
+#line 2777 "build/parser.tab.cpp"
+    break;
+
+  case 94: /* postfix_expression: postfix_expression '(' argument_list ')'  */
+#line 538 "src/parser.y"
+                                               {
+            (yyval.expr_ptr) = makeCallExpression((yyvsp[-3].expr_ptr), (yyvsp[-1].node_list_ptr));
+        }
+#line 2785 "build/parser.tab.cpp"
+    break;
+
+  case 95: /* postfix_expression: postfix_expression '.' identifier  */
+#line 541 "src/parser.y"
+                                        {
+            (yyval.expr_ptr) = makeMemberAccessExpression((yyvsp[-2].expr_ptr), (yyvsp[0].identifier_ptr));
+        }
+#line 2793 "build/parser.tab.cpp"
+    break;
+
+  case 96: /* postfix_expression: postfix_expression PTR_OP identifier  */
+#line 544 "src/parser.y"
+                                           {
+            (yyval.expr_ptr) = makePointerMemberAccessExpression((yyvsp[-2].expr_ptr), (yyvsp[0].identifier_ptr));
+        }
+#line 2801 "build/parser.tab.cpp"
+    break;
+
+  case 97: /* postfix_expression: postfix_expression INC_OP  */
+#line 547 "src/parser.y"
+                                {(yyval.expr_ptr) = makeUnaryExpression((yyvsp[-1].expr_ptr), UnaryOp::Type::POST_INCREMENT);}
+#line 2807 "build/parser.tab.cpp"
+    break;
+
+  case 98: /* postfix_expression: postfix_expression DEC_OP  */
+#line 548 "src/parser.y"
+                                {(yyval.expr_ptr) = makeUnaryExpression((yyvsp[-1].expr_ptr), UnaryOp::Type::POST_DECREMENT);}
+#line 2813 "build/parser.tab.cpp"
+    break;
+
+  case 99: /* argument_list: assignment_expression  */
+#line 553 "src/parser.y"
+        {
+            auto list = makeNodeList();
+            list->PushBack((yyvsp[0].expr_ptr));
+            (yyval.node_list_ptr) = list;
+        }
+#line 2823 "build/parser.tab.cpp"
+    break;
+
+  case 100: /* argument_list: argument_list ',' assignment_expression  */
+#line 559 "src/parser.y"
+        {
+            (yyvsp[-2].node_list_ptr)->PushBack((yyvsp[0].expr_ptr));
+            (yyval.node_list_ptr) = (yyvsp[-2].node_list_ptr);
+        }
+#line 2832 "build/parser.tab.cpp"
+    break;
+
+  case 101: /* unary_expression: postfix_expression  */
+#line 566 "src/parser.y"
+                         { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 2838 "build/parser.tab.cpp"
+    break;
+
+  case 102: /* unary_expression: INC_OP unary_expression  */
+#line 567 "src/parser.y"
+                              {
+            (yyval.expr_ptr) = makeUnaryExpression((yyvsp[0].expr_ptr), UnaryOp::Type::PRE_INCREMENT);
+        }
+#line 2846 "build/parser.tab.cpp"
+    break;
+
+  case 103: /* unary_expression: DEC_OP unary_expression  */
+#line 570 "src/parser.y"
+                              {
+            (yyval.expr_ptr) = makeUnaryExpression((yyvsp[0].expr_ptr), UnaryOp::Type::PRE_DECREMENT);
+        }
+#line 2854 "build/parser.tab.cpp"
+    break;
+
+  case 104: /* unary_expression: unary_operator cast_expression  */
+#line 573 "src/parser.y"
+                                     {
+            (yyval.expr_ptr) = makeUnaryExpression((yyvsp[0].expr_ptr), (yyvsp[-1].unary_op));
+        }
+#line 2862 "build/parser.tab.cpp"
+    break;
+
+  case 105: /* unary_expression: SIZEOF unary_expression  */
+#line 576 "src/parser.y"
+                              {
+            (yyval.expr_ptr) = makeSizeofExpression((yyvsp[0].expr_ptr));
+        }
+#line 2870 "build/parser.tab.cpp"
+    break;
+
+  case 106: /* unary_expression: SIZEOF '(' type_specifier ')'  */
+#line 579 "src/parser.y"
+                                    {(yyval.expr_ptr) = makeSizeofTypeExpression((yyvsp[-1].type_specifier));}
+#line 2876 "build/parser.tab.cpp"
+    break;
+
+  case 107: /* unary_operator: '&'  */
+#line 583 "src/parser.y"
+          { (yyval.unary_op) = UnaryOp::Type::ADDRESS_OF; }
+#line 2882 "build/parser.tab.cpp"
+    break;
+
+  case 108: /* unary_operator: '*'  */
+#line 584 "src/parser.y"
+          { (yyval.unary_op) = UnaryOp::Type::DEREFERENCE; }
+#line 2888 "build/parser.tab.cpp"
+    break;
+
+  case 109: /* unary_operator: '+'  */
+#line 585 "src/parser.y"
+          { (yyval.unary_op) = UnaryOp::Type::PLUS; }
+#line 2894 "build/parser.tab.cpp"
+    break;
+
+  case 110: /* unary_operator: '-'  */
+#line 586 "src/parser.y"
+          { (yyval.unary_op) = UnaryOp::Type::MINUS; }
+#line 2900 "build/parser.tab.cpp"
+    break;
+
+  case 111: /* unary_operator: '~'  */
+#line 587 "src/parser.y"
+          { (yyval.unary_op) = UnaryOp::Type::BITWISE_NOT; }
+#line 2906 "build/parser.tab.cpp"
+    break;
+
+  case 112: /* unary_operator: '!'  */
+#line 588 "src/parser.y"
+          { (yyval.unary_op) = UnaryOp::Type::LOGICAL_NOT; }
+#line 2912 "build/parser.tab.cpp"
+    break;
+
+  case 113: /* cast_expression: unary_expression  */
+#line 592 "src/parser.y"
+                       { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 2918 "build/parser.tab.cpp"
+    break;
+
+  case 114: /* cast_expression: '(' type_specifier ')' cast_expression  */
+#line 594 "src/parser.y"
+        {(yyval.expr_ptr) = makeCastExpression((yyvsp[-2].type_specifier), (yyvsp[0].expr_ptr));}
+#line 2924 "build/parser.tab.cpp"
+    break;
+
+  case 115: /* multiplicative_expression: cast_expression  */
+#line 598 "src/parser.y"
+                      { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 2930 "build/parser.tab.cpp"
+    break;
+
+  case 116: /* multiplicative_expression: multiplicative_expression '*' cast_expression  */
+#line 599 "src/parser.y"
+                                                    {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::MUL);
+        }
+#line 2938 "build/parser.tab.cpp"
+    break;
+
+  case 117: /* multiplicative_expression: multiplicative_expression '/' cast_expression  */
+#line 602 "src/parser.y"
+                                                    {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::DIV);
+        }
+#line 2946 "build/parser.tab.cpp"
+    break;
+
+  case 118: /* multiplicative_expression: multiplicative_expression '%' cast_expression  */
+#line 605 "src/parser.y"
+                                                    {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::MOD);
+        }
+#line 2954 "build/parser.tab.cpp"
+    break;
+
+  case 119: /* additive_expression: multiplicative_expression  */
+#line 611 "src/parser.y"
+                                { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 2960 "build/parser.tab.cpp"
+    break;
+
+  case 120: /* additive_expression: additive_expression '+' multiplicative_expression  */
+#line 612 "src/parser.y"
+                                                        {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::ADD);
+        }
+#line 2968 "build/parser.tab.cpp"
+    break;
+
+  case 121: /* additive_expression: additive_expression '-' multiplicative_expression  */
+#line 615 "src/parser.y"
+                                                        {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::SUB);
+        }
+#line 2976 "build/parser.tab.cpp"
+    break;
+
+  case 122: /* shift_expression: additive_expression  */
+#line 621 "src/parser.y"
+                          { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 2982 "build/parser.tab.cpp"
+    break;
+
+  case 123: /* shift_expression: shift_expression LEFT_OP additive_expression  */
+#line 622 "src/parser.y"
+                                                   {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::LEFT_SHIFT);
+        }
+#line 2990 "build/parser.tab.cpp"
+    break;
+
+  case 124: /* shift_expression: shift_expression RIGHT_OP additive_expression  */
+#line 625 "src/parser.y"
+                                                    {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::RIGHT_SHIFT);
+        }
+#line 2998 "build/parser.tab.cpp"
+    break;
+
+  case 125: /* relational_expression: shift_expression  */
+#line 631 "src/parser.y"
+                       { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3004 "build/parser.tab.cpp"
+    break;
+
+  case 126: /* relational_expression: relational_expression '<' shift_expression  */
+#line 632 "src/parser.y"
+                                                 {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::LT);
+        }
+#line 3012 "build/parser.tab.cpp"
+    break;
+
+  case 127: /* relational_expression: relational_expression '>' shift_expression  */
+#line 635 "src/parser.y"
+                                                 {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::GT);
+        }
+#line 3020 "build/parser.tab.cpp"
+    break;
+
+  case 128: /* relational_expression: relational_expression LE_OP shift_expression  */
+#line 638 "src/parser.y"
+                                                   {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::LE);
+        }
+#line 3028 "build/parser.tab.cpp"
+    break;
+
+  case 129: /* relational_expression: relational_expression GE_OP shift_expression  */
+#line 641 "src/parser.y"
+                                                   {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::GE);
+        }
+#line 3036 "build/parser.tab.cpp"
+    break;
+
+  case 130: /* equality_expression: relational_expression  */
+#line 647 "src/parser.y"
+                            { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3042 "build/parser.tab.cpp"
+    break;
+
+  case 131: /* equality_expression: equality_expression EQ_OP relational_expression  */
+#line 648 "src/parser.y"
+                                                      {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::EQ);
+        }
+#line 3050 "build/parser.tab.cpp"
+    break;
+
+  case 132: /* equality_expression: equality_expression NE_OP relational_expression  */
+#line 651 "src/parser.y"
+                                                      {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::NE);
+        }
+#line 3058 "build/parser.tab.cpp"
+    break;
+
+  case 133: /* and_expression: equality_expression  */
+#line 657 "src/parser.y"
+                          { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3064 "build/parser.tab.cpp"
+    break;
+
+  case 134: /* and_expression: and_expression '&' equality_expression  */
+#line 658 "src/parser.y"
+                                             {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::AND);
+        }
+#line 3072 "build/parser.tab.cpp"
+    break;
+
+  case 135: /* exclusive_or_expression: and_expression  */
+#line 664 "src/parser.y"
+                     { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3078 "build/parser.tab.cpp"
+    break;
+
+  case 136: /* exclusive_or_expression: exclusive_or_expression '^' and_expression  */
+#line 665 "src/parser.y"
+                                                 {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::XOR);
+        }
+#line 3086 "build/parser.tab.cpp"
+    break;
+
+  case 137: /* inclusive_or_expression: exclusive_or_expression  */
+#line 671 "src/parser.y"
+                              { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3092 "build/parser.tab.cpp"
+    break;
+
+  case 138: /* inclusive_or_expression: inclusive_or_expression '|' exclusive_or_expression  */
+#line 672 "src/parser.y"
+                                                          {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::OR);
+        }
+#line 3100 "build/parser.tab.cpp"
+    break;
+
+  case 139: /* logical_and_expression: inclusive_or_expression  */
+#line 678 "src/parser.y"
+                              { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3106 "build/parser.tab.cpp"
+    break;
+
+  case 140: /* logical_and_expression: logical_and_expression AND_OP inclusive_or_expression  */
+#line 679 "src/parser.y"
+                                                            {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::LOGICAL_AND);
+        }
+#line 3114 "build/parser.tab.cpp"
+    break;
+
+  case 141: /* logical_or_expression: logical_and_expression  */
+#line 685 "src/parser.y"
+                             { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3120 "build/parser.tab.cpp"
+    break;
+
+  case 142: /* logical_or_expression: logical_or_expression OR_OP logical_and_expression  */
+#line 686 "src/parser.y"
+                                                         {
+            (yyval.expr_ptr) = makeBinaryExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), BinaryOp::Type::LOGICAL_OR);
+        }
+#line 3128 "build/parser.tab.cpp"
+    break;
+
+  case 143: /* conditional_expression: logical_or_expression  */
+#line 692 "src/parser.y"
+                            { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3134 "build/parser.tab.cpp"
+    break;
+
+  case 144: /* conditional_expression: logical_or_expression '?' expression ':' conditional_expression  */
+#line 693 "src/parser.y"
+                                                                      {
+            (yyval.expr_ptr) = makeConditionalExpression((yyvsp[-4].expr_ptr), (yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr));
+        }
+#line 3142 "build/parser.tab.cpp"
+    break;
+
+  case 145: /* assignment_expression: conditional_expression  */
+#line 699 "src/parser.y"
+                             { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3148 "build/parser.tab.cpp"
+    break;
+
+  case 146: /* assignment_expression: unary_expression assignment_operator assignment_expression  */
+#line 700 "src/parser.y"
+                                                                 {
+            (yyval.expr_ptr) = makeAssignmentExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr), (yyvsp[-1].assign_op));
+        }
+#line 3156 "build/parser.tab.cpp"
+    break;
+
+  case 147: /* assignment_expression: unary_expression '=' STRING_LITERAL  */
+#line 703 "src/parser.y"
+                                          {
+            auto stringExpr = makeStringLiteralExpression(Symbol::FromId((yyvsp[0].symbol)));
+            (yyval.expr_ptr) = makeAssignmentExpression((yyvsp[-2].expr_ptr), stringExpr, AssignOp::ASSIGN);
+        }
+#line 3165 "build/parser.tab.cpp"
+    break;
+
+  case 148: /* assignment_operator: '='  */
+#line 710 "src/parser.y"
+          { (yyval.assign_op) = AssignOp::Type::ASSIGN; }
+#line 3171 "build/parser.tab.cpp"
+    break;
+
+  case 149: /* assignment_operator: MUL_ASSIGN  */
+#line 711 "src/parser.y"
+                 { (yyval.assign_op) = AssignOp::Type::MUL_ASSIGN; }
+#line 3177 "build/parser.tab.cpp"
+    break;
+
+  case 150: /* assignment_operator: DIV_ASSIGN  */
+#line 712 "src/parser.y"
+                 { (yyval.assign_op) = AssignOp::Type::DIV_ASSIGN; }
+#line 3183 "build/parser.tab.cpp"
+    break;
+
+  case 151: /* assignment_operator: MOD_ASSIGN  */
+#line 713 "src/parser.y"
+                 { (yyval.assign_op) = AssignOp::Type::MOD_ASSIGN; }
+#line 3189 "build/parser.tab.cpp"
+    break;
+
+  case 152: /* assignment_operator: ADD_ASSIGN  */
+#line 714 "src/parser.y"
+                 { (yyval.assign_op) = AssignOp::Type::ADD_ASSIGN; }
+#line 3195 "build/parser.tab.cpp"
+    break;
+
+  case 153: /* assignment_operator: SUB_ASSIGN  */
+#line 715 "src/parser.y"
+                 { (yyval.assign_op) = AssignOp::Type::SUB_ASSIGN; }
+#line 3201 "build/parser.tab.cpp"
+    break;
+
+  case 154: /* assignment_operator: LEFT_ASSIGN  */
+#line 716 "src/parser.y"
+                  { (yyval.assign_op) = AssignOp::Type::LEFT_ASSIGN; }
+#line 3207 "build/parser.tab.cpp"
+    break;
+
+  case 155: /* assignment_operator: RIGHT_ASSIGN  */
+#line 717 "src/parser.y"
+                   { (yyval.assign_op) = AssignOp::Type::RIGHT_ASSIGN; }
+#line 3213 "build/parser.tab.cpp"
+    break;
+
+  case 156: /* assignment_operator: AND_ASSIGN  */
+#line 718 "src/parser.y"
+                 { (yyval.assign_op) = AssignOp::Type::AND_ASSIGN; }
+#line 3219 "build/parser.tab.cpp"
+    break;
+
+  case 157: /* assignment_operator: XOR_ASSIGN  */
+#line 719 "src/parser.y"
+                 { (yyval.assign_op) = AssignOp::Type::XOR_ASSIGN; }
+#line 3225 "build/parser.tab.cpp"
+    break;
+
+  case 158: /* assignment_operator: OR_ASSIGN  */
+#line 720 "src/parser.y"
+                { (yyval.assign_op) = AssignOp::Type::OR_ASSIGN; }
+#line 3231 "build/parser.tab.cpp"
+    break;
+
+  case 159: /* expression: assignment_expression  */
+#line 741 "src/parser.y"
+                            { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3237 "build/parser.tab.cpp"
+    break;
+
+  case 160: /* expression: expression ',' assignment_expression  */
+#line 742 "src/parser.y"
+                                           {
+            (yyval.expr_ptr) = makeCommaExpression((yyvsp[-2].expr_ptr), (yyvsp[0].expr_ptr));
+        }
+#line 3245 "build/parser.tab.cpp"
+    break;
+
+  case 161: /* constant_expression: conditional_expression  */
+#line 748 "src/parser.y"
+                             { (yyval.expr_ptr) = (yyvsp[0].expr_ptr); }
+#line 3251 "build/parser.tab.cpp"
+    break;
+
+
+#line 3255 "build/parser.tab.cpp"
+
+        default: break;
+      }
+    if (yychar_backup != yychar)
+      YY_LAC_DISCARD ("yychar change");
+  }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yyesa, &yyes, &yyes_capacity, yytoken};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        if (yychar != YYEMPTY)
+          YY_LAC_ESTABLISH;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (scanner, context, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, scanner, context);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, context);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  /* If the stack popping above didn't lose the initial context for the
+     current lookahead token, the shift below will for sure.  */
+  YY_LAC_DISCARD ("error recovery");
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (scanner, context, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, scanner, context);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, context);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yyes != yyesa)
+    YYSTACK_FREE (yyes);
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 751 "src/parser.y"
+
+
+// Bison gives up after the first error; ParseAST reports it once the scanner is cleaned up.
+// A character the scanner could not lex has already been described by it.
+void yyerror (yyscan_t scanner, ParseContext& context, const char *s)
+{
+    if (context.error.empty()) {
+        context.error = std::string("Error: ") + s + " at line " + std::to_string(yyget_lineno(scanner)) +
+                        " near '" + yyget_text(scanner) + "'";
+    }
+}
+
+NodePtr ParseAST(std::string file_name, SourceBuffer& source, Arena& arena)
+{
+  ParseContext context;
+  Arena::Scope scope(arena);
+  yyscan_t scanner;
+  yylex_init_extra(&context, &scanner);
+  YY_BUFFER_STATE buffer = yy_scan_buffer(source.scanBuffer(), source.scanBufferSize(), scanner);
+  int failed = yyparse(scanner, context);
+  yy_delete_buffer(buffer, scanner);
+  yylex_destroy(scanner);
+  if(failed){
+    throw std::runtime_error(file_name + ": " + context.error);
+  }
+  return context.root;
+}
+
+// Nothing here is shared between calls: the scanner and the typedef table
+// belong to this parse, so files may be parsed on several threads at once.
+NodePtr ParseAST(std::string file_name, Arena& arena)
+{
+  // regular files are scanned in place; "-", pipes and terminals are streamed
+  std::optional<SourceBuffer> source = SourceBuffer::Load(file_name);
+  if(source){
+    return ParseAST(file_name, *source, arena);
+  }
+
+  ParseContext context;
+  Arena::Scope scope(arena);
+  yyscan_t scanner;
+  yylex_init_extra(&context, &scanner);
+
+  FILE* input = file_name == "-" ? stdin : fopen(file_name.c_str(), "r");
+  if(input == NULL){
+    yylex_destroy(scanner);
+    throw std::runtime_error("Couldn't open input file: " + file_name);
+  }
+  yyset_in(input, scanner);
+  int failed = yyparse(scanner, context);
+  if(input != stdin){
+    fclose(input);
+  }
+  yylex_destroy(scanner);
+  if(failed){
+    throw std::runtime_error(file_name + ": " + context.error);
+  }
+  return context.root;
+}
+
+NodePtr ParseAST(std::string file_name, std::string_view text, Arena& arena)
+{
+  SourceBuffer source = SourceBuffer::FromText(text);
+  return ParseAST(file_name, source, arena);
+}
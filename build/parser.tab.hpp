@@ -0,0 +1,187 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED
+# define YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 1 "src/parser.y"
+
+    #include "ast_node.hpp"
+    #include "Expression.hpp"
+    #include "Statement.hpp"
+    #include "Declaration.hpp"
+    #include "Declarator.hpp"
+    #include "ast_context.hpp"
+    #include "ast_type_specifier.hpp"
+    #include "EnumDeclaration.hpp"
+    #include "Factory.hpp"
+    #include "parse_context.hpp"
+    #include "source_buffer.hpp"
+    #include <stdexcept>
+    #include <string>
+
+    using namespace ast;
+
+    #ifndef YY_TYPEDEF_YY_SCANNER_T
+    #define YY_TYPEDEF_YY_SCANNER_T
+    typedef void* yyscan_t;
+    #endif
+
+#line 72 "build/parser.tab.hpp"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IDENTIFIER = 258,              /* IDENTIFIER  */
+    INT_CONSTANT = 259,            /* INT_CONSTANT  */
+    FLOAT_CONSTANT = 260,          /* FLOAT_CONSTANT  */
+    DOUBLE_CONSTANT = 261,         /* DOUBLE_CONSTANT  */
+    CHAR_CONSTANT = 262,           /* CHAR_CONSTANT  */
+    STRING_LITERAL = 263,          /* STRING_LITERAL  */
+    PTR_OP = 264,                  /* PTR_OP  */
+    INC_OP = 265,                  /* INC_OP  */
+    DEC_OP = 266,                  /* DEC_OP  */
+    LEFT_OP = 267,                 /* LEFT_OP  */
+    RIGHT_OP = 268,                /* RIGHT_OP  */
+    LE_OP = 269,                   /* LE_OP  */
+    GE_OP = 270,                   /* GE_OP  */
+    EQ_OP = 271,                   /* EQ_OP  */
+    NE_OP = 272,                   /* NE_OP  */
+    AND_OP = 273,                  /* AND_OP  */
+    OR_OP = 274,                   /* OR_OP  */
+    MUL_ASSIGN = 275,              /* MUL_ASSIGN  */
+    DIV_ASSIGN = 276,              /* DIV_ASSIGN  */
+    MOD_ASSIGN = 277,              /* MOD_ASSIGN  */
+    ADD_ASSIGN = 278,              /* ADD_ASSIGN  */
+    SUB_ASSIGN = 279,              /* SUB_ASSIGN  */
+    LEFT_ASSIGN = 280,             /* LEFT_ASSIGN  */
+    RIGHT_ASSIGN = 281,            /* RIGHT_ASSIGN  */
+    AND_ASSIGN = 282,              /* AND_ASSIGN  */
+    XOR_ASSIGN = 283,              /* XOR_ASSIGN  */
+    OR_ASSIGN = 284,               /* OR_ASSIGN  */
+    TYPEDEF = 285,                 /* TYPEDEF  */
+    EXTERN = 286,                  /* EXTERN  */
+    STATIC = 287,                  /* STATIC  */
+    AUTO = 288,                    /* AUTO  */
+    REGISTER = 289,                /* REGISTER  */
+    INLINE = 290,                  /* INLINE  */
+    SIZEOF = 291,                  /* SIZEOF  */
+    CHAR = 292,                    /* CHAR  */
+    SHORT = 293,                   /* SHORT  */
+    INT = 294,                     /* INT  */
+    LONG = 295,                    /* LONG  */
+    SIGNED = 296,                  /* SIGNED  */
+    UNSIGNED = 297,                /* UNSIGNED  */
+    FLOAT = 298,                   /* FLOAT  */
+    DOUBLE = 299,                  /* DOUBLE  */
+    CONST = 300,                   /* CONST  */
+    VOLATILE = 301,                /* VOLATILE  */
+    VOID = 302,                    /* VOID  */
+    STRUCT = 303,                  /* STRUCT  */
+    UNION = 304,                   /* UNION  */
+    ENUM = 305,                    /* ENUM  */
+    ELLIPSIS = 306,                /* ELLIPSIS  */
+    CASE = 307,                    /* CASE  */
+    DEFAULT = 308,                 /* DEFAULT  */
+    IF = 309,                      /* IF  */
+    ELSE = 310,                    /* ELSE  */
+    SWITCH = 311,                  /* SWITCH  */
+    WHILE = 312,                   /* WHILE  */
+    DO = 313,                      /* DO  */
+    FOR = 314,                     /* FOR  */
+    GOTO = 315,                    /* GOTO  */
+    CONTINUE = 316,                /* CONTINUE  */
+    BREAK = 317,                   /* BREAK  */
+    RETURN = 318,                  /* RETURN  */
+    UNKNOWN = 319,                 /* UNKNOWN  */
+    TYPE_NAME = 320,               /* TYPE_NAME  */
+    END_OF_CODE = 321              /* END_OF_CODE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 46 "src/parser.y"
+
+    Node*                               node_ptr;
+    NodeList*                           node_list_ptr;
+    ParameterList*                      parameter_list_ptr;
+    Declarator*                         declarator_ptr;
+    Expression*                         expr_ptr;
+    Statement*                          stmt_ptr;
+    Identifier*                         identifier_ptr;
+    int                                 number_int;
+    float                               number_float;
+    double                              number_double;
+    char                                number_char;
+    Symbol::Id                          symbol;     // interned by the lexer
+    TypeSpecifier                       type_specifier;
+    BinaryOp::Type                      binary_op;
+    UnaryOp::Type                       unary_op;
+    AssignOp::Type                      assign_op;
+
+#line 174 "build/parser.tab.hpp"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (yyscan_t scanner, ParseContext& context);
+
+
+#endif /* !YY_YY_BUILD_PARSER_TAB_HPP_INCLUDED  */
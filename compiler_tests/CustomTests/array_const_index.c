@@ -0,0 +1,12 @@
+int table[4] = {3, 5, 7, 9};
+
+int f()
+{
+    int a[4];
+    int i;
+    a[0] = table[3];
+    a[3] = table[1];
+    i = 2;
+    a[i] = table[i];
+    return a[0] + a[3] + a[2];
+}
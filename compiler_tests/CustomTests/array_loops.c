@@ -0,0 +1,11 @@
+int axpy(int *y, int *x, int a, int n)
+{
+    int i;
+    int s;
+    for (i = 0; i < n; i++)
+        y[i] = a * x[i] + y[i];
+    s = 0;
+    for (i = 0; i < n; i++)
+        s += y[i];
+    return s;
+}
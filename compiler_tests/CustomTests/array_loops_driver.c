@@ -0,0 +1,13 @@
+int axpy(int *y, int *x, int a, int n);
+
+int main()
+{
+    int x[19];
+    int y[19];
+    int i;
+    for (i = 0; i < 19; i++) {
+        x[i] = i;
+        y[i] = 1;
+    }
+    return !(axpy(y, x, 3, 19) == 532 && y[18] == 55);
+}
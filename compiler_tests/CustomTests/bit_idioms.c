@@ -0,0 +1,12 @@
+int f(int x, int y)
+{
+    int n;
+    int m;
+    n = 0;
+    m = x & ~y;
+    while (m) {
+        n++;
+        m &= m - 1;
+    }
+    return (x < y ? x : y) * 100 + n;
+}
@@ -0,0 +1,6 @@
+int f(int x, int y);
+
+int main()
+{
+    return !(f(255, 15) == 1504 && f(-1, 0) == -68);
+}
@@ -0,0 +1,76 @@
+/* FLAGS: -march=rv32imfd_zba_zbb */
+int popcount(int x)
+{
+    int n;
+    n = 0;
+    while (x) {
+        n++;
+        x &= x - 1;
+    }
+    return n;
+}
+
+int low_bits(int x)
+{
+    int n;
+    n = 0;
+    while (x != 0) {
+        n += x & 1;
+        x >>= 1;
+    }
+    return n;
+}
+
+int bit_length(int x)
+{
+    int n;
+    for (n = 0; x; x >>= 1)
+        n++;
+    return n;
+}
+
+int width_above_trailing(int x)
+{
+    int n;
+    n = 0;
+    while (x) {
+        n = n + 1;
+        x = x << 1;
+    }
+    return n;
+}
+
+int mix(int x, int y)
+{
+    return (x & ~y) + (x | ~y) + (x ^ ~y);
+}
+
+int extend(int x)
+{
+    return ((x << 24) >> 24) + ((x << 16) >> 16) + (x & 0xffff);
+}
+
+int rotate(int x)
+{
+    return (x << 8) | ((x >> 24) & 255);
+}
+
+int smaller(int x, int y)
+{
+    return x < y ? x : y;
+}
+
+int larger(int x, int y)
+{
+    return x > y ? x : y;
+}
+
+int pick(int *a, int i)
+{
+    return a[i];
+}
+
+double pick_double(double *a, int i)
+{
+    return a[i];
+}
@@ -0,0 +1,37 @@
+int popcount(int x);
+int low_bits(int x);
+int bit_length(int x);
+int width_above_trailing(int x);
+int mix(int x, int y);
+int extend(int x);
+int rotate(int x);
+int smaller(int x, int y);
+int larger(int x, int y);
+int pick(int *a, int i);
+double pick_double(double *a, int i);
+
+int main()
+{
+    int a[4] = {5, 6, 7, 8};
+    double d[3] = {1.5, 2.5, 3.5};
+
+    if (popcount(0) != 0 || popcount(255) != 8 || popcount(-1) != 32)
+        return 1;
+    if (low_bits(0) != 0 || low_bits(0x7fffffff) != 31 || low_bits(0x50505) != 6)
+        return 2;
+    if (bit_length(0) != 0 || bit_length(1) != 1 || bit_length(0x12345) != 17)
+        return 3;
+    if (width_above_trailing(1) != 32 || width_above_trailing(8) != 29 || width_above_trailing(-2) != 31)
+        return 4;
+    if (mix(12, 10) != -6)
+        return 5;
+    if (extend(0x1280ff) != 509 || extend(0x17f) != 893)
+        return 6;
+    if (rotate(0x12345678) != 0x34567812)
+        return 7;
+    if (smaller(3, -4) != -4 || larger(3, -4) != 3)
+        return 8;
+    if (pick(a, 2) != 7 || pick_double(d, 1) != 2.5)
+        return 9;
+    return 0;
+}
@@ -0,0 +1,33 @@
+/* FLAGS: -freorder-blocks-and-partition */
+int find(int key)
+{
+    int values[8];
+    int i;
+    for (i = 0; i < 8; i++) {
+        values[i] = i * 3;
+    }
+    i = 0;
+    while (i < 8) {
+        if (values[i] == key) {
+            return i;
+        }
+        i++;
+    }
+    return -1;
+}
+
+int f(int n)
+{
+    int total = 0;
+    int skipped = 0;
+    while (n > 0) {
+        n--;
+        if (n % 4 == 0) {
+            skipped++;
+            continue;
+        } else {
+            total = total + n;
+        }
+    }
+    return total * 100 + skipped + find(9) * 1000 + find(10);
+}
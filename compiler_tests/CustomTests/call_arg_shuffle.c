@@ -0,0 +1,10 @@
+/* FLAGS: -march=rv32imfdc */
+int g(int a, int b, int c)
+{
+    return a * 100 + b * 10 + c;
+}
+
+int f(int x, int y, int z)
+{
+    return g(z, x, y) + g(y, g(1, 2, 3), x);
+}
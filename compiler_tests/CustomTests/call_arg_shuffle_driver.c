@@ -0,0 +1,6 @@
+int f(int x, int y, int z);
+
+int main()
+{
+    return !(f(1, 2, 3) == 1743);
+}
@@ -0,0 +1,20 @@
+/* FLAGS: -fipa-ra -fwhole-program */
+int scale(int x)
+{
+    return x * 3 + 1;
+}
+
+int sum10(int a, int b, int c, int d, int e, int f, int g, int h, int i, int j)
+{
+    return a + b + c + d + e + f + g + h + i * 100 + j * 1000;
+}
+
+int f(int n)
+{
+    int total = sum10(1, 2, 3, 4, 5, 6, 7, 8, 9, n);
+    int i;
+    for (i = 0; i < n; i++) {
+        total = total + (i + scale(i)) * (n - scale(i));
+    }
+    return total;
+}
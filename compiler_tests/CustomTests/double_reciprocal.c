@@ -0,0 +1,8 @@
+double f(double x)
+{
+    double s = 0.0;
+    int i;
+    for (i = 0; i < 7; i++)
+        s = s + x / 4.0;
+    return s;
+}
@@ -0,0 +1,6 @@
+double f(double x);
+
+int main()
+{
+    return !(f(6.0) == 10.5);
+}
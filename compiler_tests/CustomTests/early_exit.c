@@ -0,0 +1,32 @@
+/* FLAGS: -fshrink-wrap */
+int g;
+
+int get()
+{
+    return g;
+}
+
+int add(int a, int b)
+{
+    return a + b;
+}
+
+int lookup(int *p, int n)
+{
+    if (n < 0) return -1;
+    if (n > 100) {
+        return -2;
+    }
+    return p[n] + add(n, get());
+}
+
+int f()
+{
+    int a[4];
+    a[0] = 1;
+    a[1] = 2;
+    a[2] = 3;
+    a[3] = 4;
+    g = 10;
+    return lookup(a, -3) * 1000 + lookup(a, 101) * 100 + lookup(a, 2);
+}
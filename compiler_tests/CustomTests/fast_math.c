@@ -0,0 +1,46 @@
+/* FLAGS: -ffast-math */
+double sum(double *x, int n)
+{
+    double s = 0.0;
+    int i;
+    for (i = 0; i < n; i++)
+        s = s + x[i];
+    return s;
+}
+
+double sum4(double a, double b, double c, double d)
+{
+    return a + b + c + d;
+}
+
+float product5(float a, float b, float c, float d, float e)
+{
+    return a * b * c * d * e;
+}
+
+void scale(double *x, int n, double d)
+{
+    int i;
+    for (i = 0; i < n; i++)
+        x[i] = x[i] / d;
+}
+
+int same(double x)
+{
+    return (x == x) + (x <= x) + (x < x) + (x != x);
+}
+
+int not_less(double a, double b)
+{
+    return !(a < b);
+}
+
+int not_greater(float a, float b)
+{
+    return !(a > b);
+}
+
+int not_at_least(double a, double b)
+{
+    return !(a >= b);
+}
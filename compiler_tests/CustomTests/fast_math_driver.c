@@ -0,0 +1,33 @@
+double sum(double *x, int n);
+double sum4(double a, double b, double c, double d);
+float product5(float a, float b, float c, float d, float e);
+void scale(double *x, int n, double d);
+int same(double x);
+int not_less(double a, double b);
+int not_greater(float a, float b);
+int not_at_least(double a, double b);
+
+int main()
+{
+    double x[5] = {8.0, 4.0, 2.0, 1.0, 0.5};
+    double y[11] = {0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.5, 4.0, 4.5, 5.0, 5.5};
+
+    if (sum(y, 11) != 33.0 || sum(y, 3) != 3.0 || sum(y, 0) != 0.0)
+        return 1;
+    if (sum4(1.0, 2.0, 3.0, 4.0) != 10.0)
+        return 2;
+    if (product5(1.0f, 2.0f, 3.0f, 4.0f, 0.5f) != 12.0f)
+        return 3;
+    scale(x, 5, 4.0);
+    if (x[0] != 2.0 || x[1] != 1.0 || x[2] != 0.5 || x[3] != 0.25 || x[4] != 0.125)
+        return 4;
+    if (same(3.0) != 2)
+        return 5;
+    if (not_less(1.0, 2.0) != 0 || not_less(2.0, 1.0) != 1 || not_less(2.0, 2.0) != 1)
+        return 6;
+    if (not_greater(1.0f, 2.0f) != 1 || not_greater(2.0f, 1.0f) != 0 || not_greater(2.0f, 2.0f) != 1)
+        return 7;
+    if (not_at_least(1.0, 2.0) != 1 || not_at_least(2.0, 2.0) != 0)
+        return 8;
+    return 0;
+}
@@ -0,0 +1,49 @@
+/* FLAGS: -march=rv32imfdc */
+double scale(char c, double x, int n)
+{
+    char tag;
+    double sum;
+    char buf[5];
+    int i;
+    tag = c;
+    sum = 0.0;
+    for (i = 0; i < 5; i++) {
+        buf[i] = tag + i;
+    }
+    for (i = 0; i < n; i++) {
+        sum = sum + x;
+    }
+    if (buf[4] == 104) {
+        sum = sum + 1.0;
+    }
+    return sum;
+}
+
+int f()
+{
+    char a;
+    double d;
+    char b;
+    int i;
+    int r;
+    double e[3];
+    char s[3];
+    a = 1;
+    b = 2;
+    d = 2.5;
+    s[0] = 10;
+    s[1] = 20;
+    s[2] = 30;
+    e[0] = 0.5;
+    for (i = 1; i < 3; i++) {
+        e[i] = e[i - 1] + d;
+    }
+    r = a + b + s[0] + s[1] + s[2];
+    if (e[2] == 5.5) {
+        r += 100;
+    }
+    if (scale(100, d, 4) == 11.0) {
+        r += 1000;
+    }
+    return r;
+}
@@ -0,0 +1,33 @@
+/* FLAGS: -fprofile-use=compiler_tests/CustomTests/function_layout.profile -freorder-blocks-and-partition -freorder-functions */
+int report(int code)
+{
+    return code * 1000;
+}
+
+int square(int x)
+{
+    return x * x;
+}
+
+int step(int x)
+{
+    if (x < 0) {
+        return report(x);
+    }
+    return square(x) + 1;
+}
+
+int unused_helper(int x)
+{
+    return x - 1;
+}
+
+int run(int n)
+{
+    int total = 0;
+    int i;
+    for (i = 0; i < n; i++) {
+        total = total + step(i);
+    }
+    return total;
+}
@@ -0,0 +1,9 @@
+report 0 0
+square 0 50
+step 0 50
+step 1 50
+step 2 0
+unused_helper 0 0
+run 0 1
+run 1 1
+run 2 50
@@ -0,0 +1,12 @@
+int run(int n);
+int step(int x);
+int unused_helper(int x);
+
+int main()
+{
+    if (run(10) != 295)
+        return 1;
+    if (step(-2) != -2000 || unused_helper(5) != 4)
+        return 2;
+    return 0;
+}
@@ -0,0 +1,33 @@
+/* FLAGS: -fprofile-generate=bin/profile_feedback.profile */
+int classify(int x)
+{
+    switch (x % 4) {
+    case 0:
+        return 10;
+    case 1:
+        return 20;
+    case 2:
+        return 30;
+    default:
+        return 40;
+    }
+}
+
+int work(int n)
+{
+    int total = 0;
+    int i;
+    for (i = 0; i < n; i++) {
+        if (i % 16 == 15) {
+            total = total - 1;
+        } else {
+            total = total + classify(i);
+        }
+    }
+    return total;
+}
+
+int rarely(int x)
+{
+    return x * 7;
+}
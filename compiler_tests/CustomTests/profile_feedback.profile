@@ -0,0 +1,12 @@
+classify 0 94
+classify 1 94
+classify 3 25
+classify 5 25
+classify 7 25
+classify 9 19
+work 0 2
+work 1 2
+work 2 100
+work 3 100
+work 4 6
+rarely 0 0
@@ -0,0 +1,8 @@
+int work(int n);
+
+int main()
+{
+    if (work(100) != 2254 || work(0) != 0)
+        return 1;
+    return 0;
+}
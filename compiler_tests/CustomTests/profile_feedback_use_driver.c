@@ -0,0 +1,11 @@
+int work(int n);
+int rarely(int x);
+
+int main()
+{
+    if (work(100) != 2254 || work(0) != 0)
+        return 1;
+    if (rarely(6) != 42)
+        return 2;
+    return 0;
+}
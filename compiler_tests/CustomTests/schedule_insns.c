@@ -0,0 +1,54 @@
+/* FLAGS: -fschedule-insns -mtune=sifive-7-series -mlatency=load:3,mul:4 */
+int dot3(int *a, int *b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+int store_then_load(int *p, int *q)
+{
+    *p = 5;
+    *q = 7;
+    return *p + *q;
+}
+
+int swap_ends(int *a)
+{
+    int t;
+    t = a[0];
+    a[0] = a[3];
+    a[3] = t;
+    return a[0] - a[3];
+}
+
+void bump(int *p)
+{
+    *p = *p + 10;
+}
+
+int around_call(int *p)
+{
+    int before;
+    before = *p;
+    bump(p);
+    return before * 100 + *p;
+}
+
+double weighted(double *x, double k)
+{
+    double s;
+    double t;
+    s = x[0] * k;
+    t = x[1] / k;
+    return s + t;
+}
+
+int mixed(int x, int y)
+{
+    int a;
+    int b;
+    int c;
+    a = x * y;
+    b = x + y;
+    c = a / (b + 1);
+    return c + a - b;
+}
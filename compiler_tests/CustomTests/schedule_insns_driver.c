@@ -0,0 +1,32 @@
+int dot3(int *a, int *b);
+int store_then_load(int *p, int *q);
+int swap_ends(int *a);
+int around_call(int *p);
+double weighted(double *x, double k);
+int mixed(int x, int y);
+
+int main()
+{
+    int a[4] = {1, 2, 3, 4};
+    int b[3] = {5, 6, 7};
+    int v;
+    int w;
+    double x[2] = {3.0, 8.0};
+
+    if (dot3(a, b) != 38)
+        return 1;
+    v = 0;
+    w = 0;
+    if (store_then_load(&v, &w) != 12 || store_then_load(&v, &v) != 14)
+        return 2;
+    if (swap_ends(a) != 3 || a[0] != 4 || a[3] != 1)
+        return 3;
+    v = 3;
+    if (around_call(&v) != 313)
+        return 4;
+    if (weighted(x, 2.0) != 10.0)
+        return 5;
+    if (mixed(6, 4) != 16)
+        return 6;
+    return 0;
+}
@@ -0,0 +1,10 @@
+int s10(int a, int b, int c, int d, int e, int f, int g, int h, int i, int j)
+{
+    return a + i * 10 + j * 100;
+}
+
+int f(int x)
+{
+    int r = s10(1, 2, 3, 4, 5, 6, 7, 8, s10(1, 0, 0, 0, 0, 0, 0, 0, 2, 3), x);
+    return r + s10(x, x, x, x, x, x, x, x, x, x);
+}
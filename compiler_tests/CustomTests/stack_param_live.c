@@ -0,0 +1,15 @@
+int twice(int x)
+{
+    return x * 2 + 1;
+}
+
+int pick(int a, int b, int c, int d, int e, int f, int g, int h, int i, int j)
+{
+    return a + i * 10 + j * 100;
+}
+
+int relay(int a, int b, int c, int d, int e, int f, int g, int h, int i, int j)
+{
+    int r = a + twice(i);
+    return r + j * twice(j) + pick(h, g, f, e, d, c, b, a, j, i);
+}
@@ -0,0 +1,50 @@
+int sum(int *p, int n)
+{
+    int i;
+    int total;
+    total = 0;
+    for (i = 0; i < n; i++) {
+        total += p[i];
+    }
+    return total;
+}
+
+int f()
+{
+    int result;
+    int i;
+    result = 0;
+    {
+        int a[50];
+        for (i = 0; i < 50; i++) {
+            a[i] = i;
+        }
+        result += sum(a, 50);
+    }
+    {
+        int b[70];
+        int x;
+        x = 7;
+        for (i = 0; i < 70; i++) {
+            b[i] = x;
+        }
+        result += sum(b, 70);
+        {
+            int c[30];
+            for (i = 0; i < 30; i++) {
+                c[i] = b[i] + 1;
+            }
+            result += sum(c, 30);
+        }
+        result += x;
+    }
+    for (i = 0; i < 3; i++) {
+        int d[60];
+        int j;
+        for (j = 0; j < 60; j++) {
+            d[j] = result;
+        }
+        result = d[59] + 1;
+    }
+    return result;
+}
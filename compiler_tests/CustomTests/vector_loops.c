@@ -0,0 +1,39 @@
+/* FLAGS: -march=rv32imfdv */
+void fill(int *a, int n, int v)
+{
+    int i;
+    for (i = 0; i < n; i++)
+        a[i] = v;
+}
+
+void axpy(double *y, double *x, int n, double k)
+{
+    int i;
+    for (i = 0; i < n; i++)
+        y[i] += x[i] * k;
+}
+
+double dsum(double *x, int n)
+{
+    double s = 0.0;
+    int i;
+    for (i = 0; i < n; i++)
+        s = s + x[i];
+    return s;
+}
+
+int isum(int *x, int n)
+{
+    int s = 0;
+    int i;
+    for (i = 0; i < n; i++)
+        s += x[i];
+    return s;
+}
+
+void next(int *a, int *b, int n)
+{
+    int i;
+    for (i = 0; i < n; i++)
+        a[i] = b[i] + 1;
+}
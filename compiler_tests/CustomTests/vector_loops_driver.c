@@ -0,0 +1,47 @@
+void fill(int *a, int n, int v);
+void axpy(double *y, double *x, int n, double k);
+double dsum(double *x, int n);
+int isum(int *x, int n);
+void next(int *a, int *b, int n);
+
+int main()
+{
+    int a[20];
+    int *p;
+    double x[13];
+    double y[13];
+    double v = 0.0;
+    int i;
+
+    fill(a, 19, 7);
+    a[19] = 3;
+    for (i = 0; i < 19; i++)
+        if (a[i] != 7)
+            return 1;
+    if (a[19] != 3)
+        return 2;
+    if (isum(a, 20) != 136 || isum(a, 0) != 0)
+        return 3;
+
+    for (i = 0; i < 13; i++) {
+        x[i] = v;
+        y[i] = 1.0;
+        v = v + 1.0;
+    }
+    axpy(y, x, 13, 0.5);
+    for (i = 0; i < 13; i++)
+        if (y[i] != 1.0 + x[i] * 0.5)
+            return 4;
+    if (dsum(x, 13) != 78.0 || dsum(y, 4) != 7.0)
+        return 5;
+
+    /* the destination is one element above the source, so each element
+       depends on the one stored before it */
+    a[0] = 1;
+    p = a;
+    next(p + 1, p, 19);
+    for (i = 0; i < 20; i++)
+        if (a[i] != i + 1)
+            return 6;
+    return 0;
+}
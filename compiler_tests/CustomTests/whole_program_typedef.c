@@ -0,0 +1,24 @@
+/* FLAGS: -fwhole-program */
+typedef int count_t;
+typedef count_t *cursor_t;
+
+count_t total;
+
+count_t step(cursor_t at, count_t by)
+{
+    *at = *at + by;
+    return *at;
+}
+
+count_t tally(count_t n)
+{
+    count_t i;
+    count_t sum;
+    sum = total;
+    for (i = 1; i <= n; i++)
+    {
+        step(&sum, i);
+    }
+    total = sum;
+    return total;
+}
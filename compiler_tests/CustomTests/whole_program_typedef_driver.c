@@ -0,0 +1,6 @@
+int tally(int n);
+
+int main()
+{
+    return !(tally(10) == 55 && tally(3) == 61);
+}
@@ -4,7 +4,6 @@
 #include "ast_type_specifier.hpp"
 #include "Declarator.hpp"
 #include <string>
-#include <memory>
 #include <vector>
 
 namespace ast {
@@ -18,21 +17,24 @@ public:
 class VariableDeclaration : public Declaration {
 private:
     TypeSpecifier type;
-    std::shared_ptr<Declarator> declarator;
-    std::shared_ptr<Expression> initializer; // Optional
+    Declarator* declarator = nullptr;
+    Expression* initializer = nullptr; // Optional
+    bool typedefName = false;          // typedef T: names a type, defines no object
 
 public:
-    VariableDeclaration(TypeSpecifier t, std::shared_ptr<Declarator> decl,
-                        std::shared_ptr<Expression> init = nullptr)
-        : type(t), declarator(std::move(decl)), initializer(std::move(init)) {}
+    VariableDeclaration(TypeSpecifier t, Declarator* decl,
+                        Expression* init = nullptr, bool isTypedef = false)
+        : type(t), declarator(decl), initializer(init), typedefName(isTypedef) {}
 
     TypeSpecifier getType() const override { return type; }
-    std::string getIdentifier() const { return declarator->getIdentifier(); }
-    std::shared_ptr<Declarator> getDeclarator() const {return declarator;}
+    Symbol getSymbol() const { return declarator->getSymbol(); }
+    const std::string& getIdentifier() const { return declarator->getIdentifier(); }
+    const Declarator* getDeclarator() const {return declarator;}
     bool isPointer() const { return declarator && declarator->isPointer(); }
     bool isArray() const { return declarator->isArray(); }
-    const Expression* getInitializer() const { return initializer.get(); }
+    const Expression* getInitializer() const { return initializer; }
     bool hasInitializer() const { return initializer != nullptr; }
+    bool isTypedef() const { return typedefName; }
 
     void accept(Visitor& visitor) const {
         visitor.visitVariableDeclaration(*this);
@@ -42,22 +44,22 @@ public:
 class FunctionDeclaration : public Declaration {
 private:
     TypeSpecifier returnType;
-    std::shared_ptr<FunctionDeclarator> declarator;
-    std::shared_ptr<CompoundStatement> body; // Optional (for definition)
-    std::vector<std::shared_ptr<VariableDeclaration>> parameters;
+    FunctionDeclarator* declarator = nullptr;
+    CompoundStatement* body = nullptr; // Optional (for definition)
+    ArenaVector<VariableDeclaration*> parameters{Arena::CurrentResource()};
 
 public:
-    FunctionDeclaration(TypeSpecifier retType, std::shared_ptr<FunctionDeclarator> decl,
-                   std::shared_ptr<CompoundStatement> functionBody = nullptr)
-    : returnType(retType), declarator(std::move(decl)), body(std::move(functionBody)) {
+    FunctionDeclaration(TypeSpecifier retType, FunctionDeclarator* decl,
+                   CompoundStatement* functionBody = nullptr)
+    : returnType(retType), declarator(decl), body(functionBody) {
 
     if (declarator->getParameters()) {
         const auto& params = declarator->getParameters()->getParameters();
         for (const auto& param : params) {
-            auto paramDecl = std::dynamic_pointer_cast<ParameterDeclaration>(param);
+            auto paramDecl = dynamic_cast<const ParameterDeclaration*>(param);
             if (paramDecl) {
                 // Create a VariableDeclaration from the ParameterDeclaration
-                auto varDecl = std::make_shared<VariableDeclaration>(
+                auto varDecl = New<VariableDeclaration>(
                     paramDecl->getType(),
                     paramDecl->getDeclaratorPtr()
                 );
@@ -69,9 +71,10 @@ public:
 
     TypeSpecifier getType() const override { return returnType; }
     bool getRetPtr() const { return declarator->isPointer(); }
-    std::string getIdentifier() const { return declarator->getIdentifier(); }
-    const std::vector<std::shared_ptr<VariableDeclaration>>& getParameters() const { return parameters; }
-    const CompoundStatement* getBody() const { return body.get(); }
+    Symbol getSymbol() const { return declarator->getSymbol(); }
+    const std::string& getIdentifier() const { return declarator->getIdentifier(); }
+    const ArenaVector<VariableDeclaration*>& getParameters() const { return parameters; }
+    const CompoundStatement* getBody() const { return body; }
     bool hasBody() const { return body != nullptr; }
 
     void accept(Visitor& visitor) const {
@@ -1,20 +1,19 @@
 #pragma once
 #include "Statement.hpp"
 #include "Declaration.hpp"
-#include <memory>
 
 namespace ast {
 
 //represents variable declarations in compound statements.
 class DeclarationStatement : public Statement {
 private:
-    std::shared_ptr<Declaration> declaration;
+    Declaration* declaration = nullptr;
 
 public:
-    DeclarationStatement(std::shared_ptr<Declaration> decl) : declaration(decl) {}
+    DeclarationStatement(Declaration* decl) : declaration(decl) {}
 
-    const Declaration* getDeclaration() const { return declaration.get(); }
-    std::shared_ptr<Declaration> getDeclarationPtr() const { return declaration; }
+    const Declaration* getDeclaration() const { return declaration; }
+    Declaration* getDeclarationPtr() const { return declaration; }
 
     void accept(Visitor& visitor) const override;
 
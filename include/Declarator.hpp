@@ -1,8 +1,8 @@
 #pragma once
 #include "ast_node.hpp"
 #include "ast_type_specifier.hpp"
+#include "symbol.hpp"
 #include <string>
-#include <memory>
 #include <vector>
 
 namespace ast {
@@ -13,7 +13,8 @@ class Visitor;
 class Declarator : public Node {
 public:
     virtual ~Declarator() = default;
-    virtual std::string getIdentifier() const = 0;
+    virtual Symbol getSymbol() const = 0;
+    const std::string& getIdentifier() const { return getSymbol().str(); }
     virtual bool isPointer() const { return false; }
     virtual bool isArray() const { return false; }
     virtual bool isString() const { return false; }
@@ -28,28 +29,28 @@ public:
 // same as variableDeclarator
 class IdentifierDeclarator : public Declarator {
 private:
-    std::string identifier;
+    Symbol identifier;
 
 public:
-    IdentifierDeclarator(const std::string& id) : identifier(id) {}
+    IdentifierDeclarator(Symbol id) : identifier(id) {}
 
     const IdentifierDeclarator* asIdentifierDeclarator() const override {return this;}
-    std::string getIdentifier() const override { return identifier; }
+    Symbol getSymbol() const override { return identifier; }
 
     void accept(Visitor& visitor) const override;
 };
 
 class InitDeclarator : public Node {
 private:
-    std::shared_ptr<Declarator> declarator;
-    std::shared_ptr<Expression> initializer; // Optional
+    Declarator* declarator = nullptr;
+    Expression* initializer = nullptr; // Optional
 
 public:
-    InitDeclarator(std::shared_ptr<Declarator> decl, std::shared_ptr<Expression> init = nullptr)
-        : declarator(std::move(decl)), initializer(std::move(init)) {}
+    InitDeclarator(Declarator* decl, Expression* init = nullptr)
+        : declarator(decl), initializer(init) {}
 
-    std::shared_ptr<Declarator> getDeclarator() const { return declarator; }
-    std::shared_ptr<Expression> getInitializer() const { return initializer; }
+    Declarator* getDeclarator() const { return declarator; }
+    Expression* getInitializer() const { return initializer; }
 
     void accept(Visitor& visitor) const override;
 
@@ -72,37 +73,37 @@ public:
 
 class ArrayDeclarator : public Declarator {
 private:
-    std::shared_ptr<Declarator> baseDeclarator;
-    std::shared_ptr<Expression> size; // Optional
+    Declarator* baseDeclarator = nullptr;
+    Expression* size = nullptr; // Optional
 
 public:
-    ArrayDeclarator(std::shared_ptr<Declarator> base, std::shared_ptr<Expression> arraySize = nullptr)
-        : baseDeclarator(std::move(base)), size(std::move(arraySize)) {}
+    ArrayDeclarator(Declarator* base, Expression* arraySize = nullptr)
+        : baseDeclarator(base), size(arraySize) {}
 
-    std::string getIdentifier() const override {
-        return baseDeclarator ? baseDeclarator->getIdentifier() : "";
+    Symbol getSymbol() const override {
+        return baseDeclarator ? baseDeclarator->getSymbol() : Symbol();
     }
     const ArrayDeclarator* asArrayDeclarator() const override {return this;}
     bool isArray() const override { return true; }
-    const Declarator* getBaseDeclarator() const {return baseDeclarator.get();}
-    std::shared_ptr<Declarator> getBaseDeclaratorPtr() const {return baseDeclarator;}
-    const Expression* getSize() const {return size.get();}
+    const Declarator* getBaseDeclarator() const {return baseDeclarator;}
+    Declarator* getBaseDeclaratorPtr() const {return baseDeclarator;}
+    const Expression* getSize() const {return size;}
 
     void accept(Visitor& visitor) const override;
 };
 
 class ParameterList : public Node {
 private:
-    std::vector<std::shared_ptr<Node>> parameters;
+    ArenaVector<NodePtr> parameters{Arena::CurrentResource()};
 
 public:
     ParameterList() = default;
 
-    void addParameter(std::shared_ptr<Node> param) {
-        parameters.push_back(std::move(param));
+    void addParameter(Node* param) {
+        parameters.push_back(param);
     }
 
-    const std::vector<std::shared_ptr<Node>>& getParameters() const {
+    const ArenaVector<NodePtr>& getParameters() const {
         return parameters;
     }
 
@@ -124,19 +125,15 @@ public:
 
 class FunctionDeclarator : public Declarator {
 private:
-    std::shared_ptr<Declarator> baseDeclarator;
-    std::shared_ptr<ParameterList> parameters; // Optional
+    Declarator* baseDeclarator = nullptr;
+    ParameterList* parameters = nullptr; // Optional
 
 public:
     FunctionDeclarator(Declarator* base, ParameterList* params = nullptr)
-    : baseDeclarator(std::shared_ptr<Declarator>(base)),
-    parameters(std::shared_ptr<ParameterList>(params)) {}
+        : baseDeclarator(base), parameters(params) {}
 
-    FunctionDeclarator(std::shared_ptr<Declarator> base, std::shared_ptr<ParameterList> params = nullptr)
-        : baseDeclarator(std::move(base)), parameters(std::move(params)) {}
-
-    std::string getIdentifier() const override {
-        return baseDeclarator ? baseDeclarator->getIdentifier() : "";
+    Symbol getSymbol() const override {
+        return baseDeclarator ? baseDeclarator->getSymbol() : Symbol();
     }
 
     const FunctionDeclarator* asFunctionDeclarator() const override {return this;}
@@ -144,11 +141,11 @@ public:
     bool isFunction() const override { return true; }
     bool isPointer() const override { return baseDeclarator->isPointer();}
 
-    const Declarator* getBaseDeclarator() const {return baseDeclarator.get();}
+    const Declarator* getBaseDeclarator() const {return baseDeclarator;}
 
-    std::shared_ptr<Declarator> getBaseDeclaratorPtr() const {return baseDeclarator;}
+    Declarator* getBaseDeclaratorPtr() const {return baseDeclarator;}
 
-    const ParameterList* getParameters() const {return parameters.get();}
+    const ParameterList* getParameters() const {return parameters;}
 
     void accept(Visitor& visitor) const override;
 };
@@ -156,53 +153,54 @@ public:
 class ParameterDeclaration : public Node {
 private:
     TypeSpecifier type;
-    std::shared_ptr<Declarator> declarator;
+    Declarator* declarator = nullptr;
 
 public:
-    ParameterDeclaration(TypeSpecifier t, std::shared_ptr<Declarator> decl = nullptr)
-        : type(t), declarator(std::move(decl)) {}
+    ParameterDeclaration(TypeSpecifier t, Declarator* decl = nullptr)
+        : type(t), declarator(decl) {}
 
     TypeSpecifier getType() const { return type; }
-    std::string getIdentifier() const {
-        if (!declarator) return "";
-        return declarator->getIdentifier();
+    Symbol getSymbol() const {
+        if (!declarator) return Symbol();
+        return declarator->getSymbol();
     }
+    const std::string& getIdentifier() const { return getSymbol().str(); }
 
     bool isPointer() const {
         if (!declarator) return false;
         // direct pointer declarator?
-        if (auto pointerDecl = std::dynamic_pointer_cast<PointerDeclarator>(declarator)){
+        if (declarator->asPointerDeclarator()){
             return true;
         }
         return declarator->isPointer();
     }
     bool hasDeclarator() const {return declarator != nullptr;}
 
-    const Declarator* getDeclarator() const {return declarator.get();}
-    std::shared_ptr<Declarator> getDeclaratorPtr() const {return declarator;}
+    const Declarator* getDeclarator() const {return declarator;}
+    Declarator* getDeclaratorPtr() const {return declarator;}
 
     void accept(Visitor& visitor) const override;
 };
 
 class PointerDeclarator : public Declarator {
 private:
-    std::shared_ptr<Declarator> baseDeclarator;
+    Declarator* baseDeclarator = nullptr;
 
 public:
-    PointerDeclarator(std::shared_ptr<Declarator> base)
-        : baseDeclarator(std::move(base)) {}
+    PointerDeclarator(Declarator* base)
+        : baseDeclarator(base) {}
 
-    std::string getIdentifier() const override {
-        return baseDeclarator ? baseDeclarator->getIdentifier() : "";
+    Symbol getSymbol() const override {
+        return baseDeclarator ? baseDeclarator->getSymbol() : Symbol();
     }
 
     const PointerDeclarator* asPointerDeclarator() const override {return this;}
 
     bool isPointer() const override { return true; }
 
-    const Declarator* getBaseDeclarator() const {return baseDeclarator.get();}
+    const Declarator* getBaseDeclarator() const {return baseDeclarator;}
 
-    std::shared_ptr<Declarator> getBaseDeclaratorPtr() const {
+    Declarator* getBaseDeclaratorPtr() const {
         return baseDeclarator;
     }
 
@@ -3,23 +3,23 @@
 #include "ast_type_specifier.hpp"
 #include "Identifier.hpp"
 #include <string>
-#include <memory>
 #include <vector>
 
 namespace ast {
 
 class EnumValue : public Node {
 private:
-    std::shared_ptr<Identifier> name;
-    std::shared_ptr<Expression> value;
+    Identifier* name = nullptr;
+    Expression* value = nullptr;
 
 public:
-    EnumValue(std::shared_ptr<Identifier> name, std::shared_ptr<Expression> value = nullptr)
-        : name(std::move(name)), value(std::move(value)) {}
+    EnumValue(Identifier* name, Expression* value = nullptr)
+        : name(name), value(value) {}
 
-    std::string getName() const { return name->getName(); }
+    const std::string& getName() const { return name->getName(); }
+    Symbol getSymbol() const { return name->getSymbol(); }
     bool hasValue() const { return value != nullptr; }
-    const Expression* getValue() const { return value.get(); }
+    const Expression* getValue() const { return value; }
 
     void accept(Visitor& visitor) const override {
         visitor.visitEnumValue(*this);
@@ -28,20 +28,20 @@ public:
 
 class EnumDeclaration : public Declaration {
 private:
-    std::shared_ptr<Identifier> name;
-    std::vector<std::shared_ptr<EnumValue>> values;
+    Identifier* name = nullptr;
+    ArenaVector<EnumValue*> values{Arena::CurrentResource()};
 
 public:
-    EnumDeclaration(std::shared_ptr<Identifier> name = nullptr)
-        : name(std::move(name)) {}
+    EnumDeclaration(Identifier* name = nullptr)
+        : name(name) {}
 
-    void addValue(std::shared_ptr<EnumValue> value) {
-        values.push_back(std::move(value));
+    void addValue(EnumValue* value) {
+        values.push_back(value);
     }
 
     bool hasName() const { return name != nullptr; }
-    std::string getName() const { return hasName() ? name->getName() : ""; }
-    const std::vector<std::shared_ptr<EnumValue>>& getValues() const { return values; }
+    const std::string& getName() const { return hasName() ? name->getName() : Symbol().str(); }
+    const ArenaVector<EnumValue*>& getValues() const { return values; }
 
     TypeSpecifier getType() const override { return TypeSpecifier::ENUM; }
 
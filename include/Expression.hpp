@@ -6,7 +6,6 @@
 #include "Visitor.hpp"
 #include <string>
 #include <vector>
-#include <memory>
 #include <iostream>
 #include <stdexcept>
 #include <ostream>
@@ -44,7 +43,7 @@ public:
     virtual const InitializerList* asInitializerList() const { return nullptr;}
 };
 
-using ExprPtr = std::shared_ptr<Expression>;
+using ExprPtr = Expression*;
 
 namespace BinaryOp {
     enum Type {
@@ -88,28 +87,21 @@ namespace AssignOp {
 class BinaryExpression : public Expression {
 private:
     BinaryOp::Type op;
-    ExprPtr left;
-    ExprPtr right;
+    ExprPtr left = nullptr;
+    ExprPtr right = nullptr;
     TypeSpecifier resultType;
 
 public:
-    BinaryExpression(Expression* lhs, Expression* rhs, BinaryOp::Type operation)
-        : op(operation),
-          left(ExprPtr(lhs)),
-          right(ExprPtr(rhs)) {
-        resultType = left->getType();
-    }
-
     BinaryExpression(ExprPtr lhs, ExprPtr rhs, BinaryOp::Type operation)
-        : op(operation), left(std::move(lhs)), right(std::move(rhs)) {
+        : op(operation), left(lhs), right(rhs) {
         resultType = left->getType();
     }
 
     const BinaryExpression* asBinaryExpression() const override { return this; }
 
     BinaryOp::Type getOperator() const { return op; }
-    const Expression* getLeft() const { return left.get(); }
-    const Expression* getRight() const { return right.get(); }
+    const Expression* getLeft() const { return left; }
+    const Expression* getRight() const { return right; }
 
     TypeSpecifier getType() const override { return resultType; }
 
@@ -135,24 +127,19 @@ namespace UnaryOp {
 class UnaryExpression : public Expression {
 private:
     UnaryOp::Type op;
-    ExprPtr operand;
+    ExprPtr operand = nullptr;
     TypeSpecifier resultType;
 
 public:
-    UnaryExpression(Expression* expr, UnaryOp::Type operation)
-        : op(operation), operand(ExprPtr(expr)) {
-        resultType = operand->getType();
-    }
-
     UnaryExpression(ExprPtr expr, UnaryOp::Type operation)
-        : op(operation), operand(std::move(expr)) {
+        : op(operation), operand(expr) {
         resultType = operand->getType();
     }
 
     const UnaryExpression* asUnaryExpression() const override { return this; }
 
     UnaryOp::Type getOperator() const { return op; }
-    const Expression* getOperand() const { return operand.get(); }
+    const Expression* getOperand() const { return operand; }
 
     TypeSpecifier getType() const override { return resultType; }
 
@@ -215,14 +202,15 @@ public:
 
 class StringLiteralExpression : public Expression {
 private:
-    std::string value;
+    Symbol value;
     int size;
 
 public:
-    StringLiteralExpression(const std::string& str) : value(str) {}
+    StringLiteralExpression(Symbol str) : value(str) {}
 
-    const std::string& getValue() const { return value; }
-    const int& getSize() { size = value.size() - 1;  return size; } //Excludes "" and includes null element
+    const std::string& getValue() const { return value.str(); }
+    Symbol getSymbol() const { return value; }
+    const int& getSize() { size = value.str().size() - 1;  return size; } //Excludes "" and includes null element
     TypeSpecifier getType() const override { return TypeSpecifier::CHAR; } // Char pointer technically
 
     void accept(Visitor& visitor) const override;
@@ -230,20 +218,18 @@ public:
 
 class IdentifierExpression : public Expression {
 private:
-    std::shared_ptr<Identifier> identifier;
+    Identifier* identifier = nullptr;
     TypeSpecifier type;
 
 public:
-    IdentifierExpression(std::shared_ptr<Identifier> id)
-        : identifier(std::move(id)), type() {}
-
     IdentifierExpression(Identifier* id)
-        : identifier(std::shared_ptr<Identifier>(id)), type() {}
+        : identifier(id), type() {}
 
     const IdentifierExpression* asIdentifierExpression() const override { return this;}
 
-    const Identifier* getIdentifier() const { return identifier.get(); }
+    const Identifier* getIdentifier() const { return identifier; }
     const std::string& getName() const { return identifier->getName(); }
+    Symbol getSymbol() const { return identifier->getSymbol(); }
     TypeSpecifier getType() const override { return type; }
     void setType(TypeSpecifier t) { type = t; }
 
@@ -252,20 +238,17 @@ public:
 
 class CallExpression : public Expression {
 private:
-    ExprPtr function;
-    std::shared_ptr<NodeList> arguments;
+    ExprPtr function = nullptr;
+    NodeList* arguments = nullptr;
 
 public:
-    CallExpression(Expression* func, NodeList* args = nullptr)
-        : function(ExprPtr(func)), arguments(std::shared_ptr<NodeList>(args)) {}
-
-    CallExpression(ExprPtr func, std::shared_ptr<NodeList> args = nullptr)
-        : function(std::move(func)), arguments(std::move(args)) {}
+    CallExpression(ExprPtr func, NodeList* args = nullptr)
+        : function(func), arguments(args) {}
 
     const CallExpression* asCallExpression() const override { return this;}
 
-    const Expression* getFunction() const { return function.get(); }
-    const NodeList* getArguments() const { return arguments.get(); }
+    const Expression* getFunction() const { return function; }
+    const NodeList* getArguments() const { return arguments; }
     bool hasArguments() const { return arguments != nullptr; }
 
     TypeSpecifier getType() const override { return TypeSpecifier::INT; }
@@ -273,8 +256,8 @@ public:
     // Have to more thoroughly check if function return types properly implemented
     TypeSpecifier getType(const Context* context) const override {
         if(!context) return TypeSpecifier::INT;
-        if (const IdentifierExpression* idExpr = dynamic_cast<const IdentifierExpression*>(function.get())) {
-            const std::string& funcName = idExpr->getName();
+        if (const IdentifierExpression* idExpr = dynamic_cast<const IdentifierExpression*>(function)) {
+            Symbol funcName = idExpr->getSymbol();
             if (context->functionExists(funcName)) {
                 return context->getFunctionReturnType(funcName);
             }
@@ -288,24 +271,19 @@ public:
 // Assignment expression (x = expr)
 class AssignmentExpression : public Expression {
 private:
-    ExprPtr lhs;
-    ExprPtr rhs;
+    ExprPtr lhs = nullptr;
+    ExprPtr rhs = nullptr;
     AssignOp::Type op;
     TypeSpecifier resultType;
 
 public:
-    AssignmentExpression(Expression* left, Expression* right, AssignOp::Type operation)
-        : lhs(ExprPtr(left)), rhs(ExprPtr(right)), op(operation) {
-        resultType = rhs->getType();
-    }
-
     AssignmentExpression(ExprPtr left, ExprPtr right, AssignOp::Type operation)
-        : lhs(std::move(left)), rhs(std::move(right)), op(operation) {
+        : lhs(left), rhs(right), op(operation) {
         resultType = rhs->getType();
     }
 
-    const Expression* getLHS() const { return lhs.get(); }
-    const Expression* getRHS() const { return rhs.get(); }
+    const Expression* getLHS() const { return lhs; }
+    const Expression* getRHS() const { return rhs; }
     std::string getVariableName() const;
     AssignOp::Type getOperator() const { return op; }
     TypeSpecifier getType() const override { return resultType; }
@@ -315,14 +293,14 @@ public:
 
 class InitializerList : public Expression {
 private:
-    std::vector<std::shared_ptr<Expression>> expressions;
+    ArenaVector<Expression*> expressions{Arena::CurrentResource()};
 
 public:
     InitializerList() = default;
 
     const InitializerList* asInitializerList() const override { return this;}
-    void addExpression(std::shared_ptr<Expression> expr) {expressions.push_back(std::move(expr));}
-    const std::vector<std::shared_ptr<Expression>>& getExpressions() const {return expressions;}
+    void addExpression(Expression* expr) {expressions.push_back(expr);}
+    const ArenaVector<Expression*>& getExpressions() const {return expressions;}
     TypeSpecifier getType() const override {return TypeSpecifier::INT;}  // TODO implement support for other types
 
     void accept(Visitor& visitor) const override {visitor.visitInitializerList(*this);}
@@ -330,26 +308,20 @@ public:
 
 class ArrayAccessExpression : public Expression {
 private:
-    ExprPtr array;
-    ExprPtr index;
+    ExprPtr array = nullptr;
+    ExprPtr index = nullptr;
     TypeSpecifier resultType;
 
 public:
-    ArrayAccessExpression(Expression* arr, Expression* idx)
-        : array(ExprPtr(arr)), index(ExprPtr(idx)) {
-        // result type should be set to type of array element
-        resultType = array->getType();
-    }
-
     ArrayAccessExpression(ExprPtr arr, ExprPtr idx)
-        : array(std::move(arr)), index(std::move(idx)) {
+        : array(arr), index(idx) {
         resultType = array->getType();
     }
 
     const ArrayAccessExpression* asArrayAccessExpression() const override { return this;}
 
-    const Expression* getArray() const { return array.get(); }
-    const Expression* getIndex() const { return index.get(); }
+    const Expression* getArray() const { return array; }
+    const Expression* getIndex() const { return index; }
     TypeSpecifier getType() const override {return resultType; }
 
     void accept(Visitor& visitor) const override;
@@ -358,16 +330,16 @@ public:
 // struct member access
 class MemberAccessExpression : public Expression {
 private:
-    std::shared_ptr<Expression> object;
-    std::shared_ptr<Identifier> member;
+    Expression* object = nullptr;
+    Identifier* member = nullptr;
     TypeSpecifier resultType;
 
 public:
-    MemberAccessExpression(std::shared_ptr<Expression> obj, std::shared_ptr<Identifier> id)
-    : object(std::move(obj)), member(std::move(id)), resultType(TypeSpecifier::INT) {}
+    MemberAccessExpression(Expression* obj, Identifier* id)
+    : object(obj), member(id), resultType(TypeSpecifier::INT) {}
 
-    const Expression* getObject() const { return object.get(); }
-    const Identifier* getMember() const { return member.get(); }
+    const Expression* getObject() const { return object; }
+    const Identifier* getMember() const { return member; }
     TypeSpecifier getType() const override { return resultType; }
     void setType(TypeSpecifier type) { resultType = type; }
 
@@ -377,19 +349,16 @@ public:
 // Pointer member access expression (ptr->member)
 class PointerMemberAccessExpression : public Expression {
 private:
-    std::shared_ptr<Expression> object;
-    std::shared_ptr<Identifier> member;
+    Expression* object = nullptr;
+    Identifier* member = nullptr;
     TypeSpecifier resultType;
 
 public:
-    PointerMemberAccessExpression(std::shared_ptr<Expression> obj, std::shared_ptr<Identifier> id)
-        : object(std::move(obj)), member(std::move(id)), resultType(TypeSpecifier::INT) {}
-
     PointerMemberAccessExpression(Expression* obj, Identifier* id)
-        : object(ExprPtr(obj)), member(std::shared_ptr<Identifier>(id)), resultType(TypeSpecifier::INT) {} //CHECK INT
+        : object(obj), member(id), resultType(TypeSpecifier::INT) {}
 
-    const Expression* getObject() const { return object.get(); }
-    const Identifier* getMemberName() const { return member.get(); }
+    const Expression* getObject() const { return object; }
+    const Identifier* getMemberName() const { return member; }
     TypeSpecifier getType() const override { return resultType; }
     void setType(TypeSpecifier type) { resultType = type; }
 
@@ -400,42 +369,34 @@ public:
 class CastExpression : public Expression {
 private:
     TypeSpecifier targetType;
-    ExprPtr expr;
+    ExprPtr expr = nullptr;
 
 public:
-    CastExpression(TypeSpecifier type, Expression* expression)
-        : targetType(type), expr(ExprPtr(expression)) {}
-
     CastExpression(TypeSpecifier type, ExprPtr expression)
-        : targetType(type), expr(std::move(expression)) {}
+        : targetType(type), expr(expression) {}
 
     TypeSpecifier getType() const override { return targetType; }
-    const Expression* getExpression() const { return expr.get(); }
+    const Expression* getExpression() const { return expr; }
 
     void accept(Visitor& visitor) const override;
 };
 
 class ConditionalExpression : public Expression {
 private:
-    ExprPtr condition;
-    ExprPtr thenExpr;
-    ExprPtr elseExpr;
+    ExprPtr condition = nullptr;
+    ExprPtr thenExpr = nullptr;
+    ExprPtr elseExpr = nullptr;
     TypeSpecifier resultType;
 
 public:
-    ConditionalExpression(Expression* cond, Expression* thenE, Expression* elseE)
-        : condition(ExprPtr(cond)), thenExpr(ExprPtr(thenE)), elseExpr(ExprPtr(elseE)) {
-       // resultType = thenExpr->getType();
-    }
-
     ConditionalExpression(ExprPtr cond, ExprPtr thenE, ExprPtr elseE)
-        : condition(std::move(cond)), thenExpr(std::move(thenE)), elseExpr(std::move(elseE)) {
+        : condition(cond), thenExpr(thenE), elseExpr(elseE) {
         // resultType = thenExpr->getType();
     }
 
-    const Expression* getCondition() const { return condition.get(); }
-    const Expression* getThenExpression() const { return thenExpr.get(); }
-    const Expression* getElseExpression() const { return elseExpr.get(); }
+    const Expression* getCondition() const { return condition; }
+    const Expression* getThenExpression() const { return thenExpr; }
+    const Expression* getElseExpression() const { return elseExpr; }
     TypeSpecifier getType() const override {const TypeSpecifier resultType = thenExpr->getType(); return resultType; }
 
     void accept(Visitor& visitor) const override;
@@ -443,18 +404,15 @@ public:
 
 class CommaExpression : public Expression {
 private:
-    ExprPtr left;
-    ExprPtr right;
+    ExprPtr left = nullptr;
+    ExprPtr right = nullptr;
 
 public:
-    CommaExpression(Expression* lhs, Expression* rhs)
-        : left(ExprPtr(lhs)), right(ExprPtr(rhs)) {}
-
     CommaExpression(ExprPtr lhs, ExprPtr rhs)
-        : left(std::move(lhs)), right(std::move(rhs)) {}
+        : left(lhs), right(rhs) {}
 
-    const Expression* getLeft() const { return left.get(); }
-    const Expression* getRight() const { return right.get(); }
+    const Expression* getLeft() const { return left; }
+    const Expression* getRight() const { return right; }
 
     TypeSpecifier getType() const override { return right->getType(); }
 
@@ -463,13 +421,12 @@ public:
 
 class SizeofExpression : public Expression {
 private:
-    ExprPtr expr;
+    ExprPtr expr = nullptr;
 
 public:
-    SizeofExpression(Expression* e) : expr(ExprPtr(e)) {}
-    SizeofExpression(ExprPtr e) : expr(std::move(e)) {}
+    SizeofExpression(ExprPtr e) : expr(e) {}
 
-    const Expression* getExpression() const { return expr.get(); }
+    const Expression* getExpression() const { return expr; }
 
     TypeSpecifier getType() const override { return expr->getType(); }
 
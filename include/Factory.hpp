@@ -6,254 +6,257 @@
 #include "Declarator.hpp"
 #include "Identifier.hpp"
 #include "EnumDeclaration.hpp"
-#include <memory>
 #include <string>
 
 namespace ast {
 
 /*
-   Factory functions that consistenly return shared_ptr
-   better memory management and avoids static_cast and dynamic_casting in the parser
-   No more direct calls to new object and wayyy faster compile time
+   Factory functions that consistenly allocate in the current Arena (see
+   Arena::Scope) and return the typed node, which avoids static_cast and
+   dynamic_casting in the parser. The arena frees the whole tree at once.
 */
 
-inline std::shared_ptr<NodeList> makeNodeList() {
-    return std::make_shared<NodeList>();
+inline NodeList* makeNodeList() {
+    return New<NodeList>();
 }
 
-inline std::shared_ptr<Identifier> makeIdentifier(const std::string& name) {
-    return std::make_shared<Identifier>(name);
+inline Identifier* makeIdentifier(Symbol name) {
+    return New<Identifier>(name);
 }
 
 // Declarators
-inline std::shared_ptr<IdentifierDeclarator> makeIdentifierDeclarator(const std::string& id) {
-    return std::make_shared<IdentifierDeclarator>(id);
+inline IdentifierDeclarator* makeIdentifierDeclarator(Symbol id) {
+    return New<IdentifierDeclarator>(id);
 }
 
-inline std::shared_ptr<PointerDeclarator> makePointerDeclarator(std::shared_ptr<Declarator> base) {
-    return std::make_shared<PointerDeclarator>(std::move(base));
+inline PointerDeclarator* makePointerDeclarator(Declarator* base) {
+    return New<PointerDeclarator>(base);
 }
 
-inline std::shared_ptr<ArrayDeclarator> makeArrayDeclarator(std::shared_ptr<Declarator> base,
-                                                           std::shared_ptr<Expression> size = nullptr) {
-    return std::make_shared<ArrayDeclarator>(std::move(base), std::move(size));
+inline ArrayDeclarator* makeArrayDeclarator(Declarator* base,
+                                            Expression* size = nullptr) {
+    return New<ArrayDeclarator>(base, size);
 }
 
-inline std::shared_ptr<FunctionDeclarator> makeFunctionDeclarator(std::shared_ptr<Declarator> base,
-                                                                 std::shared_ptr<ParameterList> params = nullptr) {
-    return std::make_shared<FunctionDeclarator>(std::move(base), std::move(params));
+inline FunctionDeclarator* makeFunctionDeclarator(Declarator* base,
+                                                  ParameterList* params = nullptr) {
+    return New<FunctionDeclarator>(base, params);
 }
 
 // Parameter handling
-inline std::shared_ptr<ParameterList> makeParameterList() {
-    return std::make_shared<ParameterList>();
+inline ParameterList* makeParameterList() {
+    return New<ParameterList>();
 }
 
-inline std::shared_ptr<ParameterDeclaration> makeParameterDeclaration(
-    TypeSpecifier type, std::shared_ptr<Declarator> decl = nullptr) {
-    return std::make_shared<ParameterDeclaration>(type, std::move(decl));
+inline ParameterDeclaration* makeParameterDeclaration(
+    TypeSpecifier type, Declarator* decl = nullptr) {
+    return New<ParameterDeclaration>(type, decl);
 }
 
 // Initializers
-inline std::shared_ptr<InitDeclarator> makeInitDeclarator(
-    std::shared_ptr<Declarator> decl, std::shared_ptr<Expression> init = nullptr) {
-    return std::make_shared<InitDeclarator>(std::move(decl), std::move(init));
+inline InitDeclarator* makeInitDeclarator(
+    Declarator* decl, Expression* init = nullptr) {
+    return New<InitDeclarator>(decl, init);
 }
 
-inline std::shared_ptr<InitDeclaratorList> makeInitDeclaratorList() {
-    return std::make_shared<InitDeclaratorList>();
+inline InitDeclaratorList* makeInitDeclaratorList() {
+    return New<InitDeclaratorList>();
 }
 
 // Declarations
-inline std::shared_ptr<VariableDeclaration> makeVariableDeclaration(
-    TypeSpecifier type, std::shared_ptr<Declarator> decl, std::shared_ptr<Expression> init = nullptr) {
-    return std::make_shared<VariableDeclaration>(type, std::move(decl), std::move(init));
+inline VariableDeclaration* makeVariableDeclaration(
+    TypeSpecifier type, Declarator* decl, Expression* init = nullptr) {
+    return New<VariableDeclaration>(type, decl, init);
 }
 
-inline std::shared_ptr<FunctionDeclaration> makeFunctionDeclaration(
-    TypeSpecifier returnType, std::shared_ptr<FunctionDeclarator> decl,
-    std::shared_ptr<CompoundStatement> body = nullptr) {
-    return std::make_shared<FunctionDeclaration>(returnType, std::move(decl), std::move(body));
+inline VariableDeclaration* makeTypedefDeclaration(TypeSpecifier type, Declarator* decl) {
+    return New<VariableDeclaration>(type, decl, nullptr, true);
+}
+
+inline FunctionDeclaration* makeFunctionDeclaration(
+    TypeSpecifier returnType, FunctionDeclarator* decl,
+    CompoundStatement* body = nullptr) {
+    return New<FunctionDeclaration>(returnType, decl, body);
 }
 
 // Enum-related
-inline std::shared_ptr<EnumDeclaration> makeEnumDeclaration(
-    std::shared_ptr<Identifier> id = nullptr) {
-    return std::make_shared<EnumDeclaration>(std::move(id));
+inline EnumDeclaration* makeEnumDeclaration(
+    Identifier* id = nullptr) {
+    return New<EnumDeclaration>(id);
 }
 
-inline std::shared_ptr<EnumValue> makeEnumValue(
-    std::shared_ptr<Identifier> id, std::shared_ptr<Expression> value = nullptr) {
-    return std::make_shared<EnumValue>(std::move(id), std::move(value));
+inline EnumValue* makeEnumValue(
+    Identifier* id, Expression* value = nullptr) {
+    return New<EnumValue>(id, value);
 }
 
 // Expressions
-inline std::shared_ptr<IdentifierExpression> makeIdentifierExpression(std::shared_ptr<Identifier> id) {
-    return std::make_shared<IdentifierExpression>(id);
+inline IdentifierExpression* makeIdentifierExpression(Identifier* id) {
+    return New<IdentifierExpression>(id);
 }
 
-inline std::shared_ptr<LiteralExpression> makeLiteralExpression(int value) {
-    return std::make_shared<LiteralExpression>(value);
+inline LiteralExpression* makeLiteralExpression(int value) {
+    return New<LiteralExpression>(value);
 }
 
-inline std::shared_ptr<LiteralExpression> makeLiteralExpression(float value) {
-    return std::make_shared<LiteralExpression>(value);
+inline LiteralExpression* makeLiteralExpression(float value) {
+    return New<LiteralExpression>(value);
 }
 
-inline std::shared_ptr<LiteralExpression> makeLiteralExpression(double value) {
-    return std::make_shared<LiteralExpression>(value);
+inline LiteralExpression* makeLiteralExpression(double value) {
+    return New<LiteralExpression>(value);
 }
 
-inline std::shared_ptr<LiteralExpression> makeLiteralExpression(char value) {
-    return std::make_shared<LiteralExpression>(value);
+inline LiteralExpression* makeLiteralExpression(char value) {
+    return New<LiteralExpression>(value);
 }
 
-inline std::shared_ptr<StringLiteralExpression> makeStringLiteralExpression(const std::string& value) {
-    return std::make_shared<StringLiteralExpression>(value);
+inline StringLiteralExpression* makeStringLiteralExpression(Symbol value) {
+    return New<StringLiteralExpression>(value);
 }
 
-inline std::shared_ptr<BinaryExpression> makeBinaryExpression(
-    std::shared_ptr<Expression> left, std::shared_ptr<Expression> right, BinaryOp::Type op) {
-    return std::make_shared<BinaryExpression>(std::move(left), std::move(right), op);
+inline BinaryExpression* makeBinaryExpression(
+    Expression* left, Expression* right, BinaryOp::Type op) {
+    return New<BinaryExpression>(left, right, op);
 }
 
-inline std::shared_ptr<UnaryExpression> makeUnaryExpression(
-    std::shared_ptr<Expression> expr, UnaryOp::Type op) {
-    return std::make_shared<UnaryExpression>(std::move(expr), op);
+inline UnaryExpression* makeUnaryExpression(
+    Expression* expr, UnaryOp::Type op) {
+    return New<UnaryExpression>(expr, op);
 }
 
-inline std::shared_ptr<AssignmentExpression> makeAssignmentExpression(
-    std::shared_ptr<Expression> left, std::shared_ptr<Expression> right, AssignOp::Type op) {
-    return std::make_shared<AssignmentExpression>(std::move(left), std::move(right), op);
+inline AssignmentExpression* makeAssignmentExpression(
+    Expression* left, Expression* right, AssignOp::Type op) {
+    return New<AssignmentExpression>(left, right, op);
 }
 
-inline std::shared_ptr<CallExpression> makeCallExpression(
-    std::shared_ptr<Expression> func, std::shared_ptr<NodeList> args = nullptr) {
-    return std::make_shared<CallExpression>(std::move(func), std::move(args));
+inline CallExpression* makeCallExpression(
+    Expression* func, NodeList* args = nullptr) {
+    return New<CallExpression>(func, args);
 }
 
-inline std::shared_ptr<ArrayAccessExpression> makeArrayAccessExpression(
-    std::shared_ptr<Expression> array, std::shared_ptr<Expression> index) {
-    return std::make_shared<ArrayAccessExpression>(std::move(array), std::move(index));
+inline ArrayAccessExpression* makeArrayAccessExpression(
+    Expression* array, Expression* index) {
+    return New<ArrayAccessExpression>(array, index);
 }
 
-inline std::shared_ptr<MemberAccessExpression> makeMemberAccessExpression(
-    std::shared_ptr<Expression> object, std::shared_ptr<Identifier> member) {
-    return std::make_shared<MemberAccessExpression>(std::move(object), std::move(member));
+inline MemberAccessExpression* makeMemberAccessExpression(
+    Expression* object, Identifier* member) {
+    return New<MemberAccessExpression>(object, member);
 }
 
-inline std::shared_ptr<PointerMemberAccessExpression> makePointerMemberAccessExpression(
-    std::shared_ptr<Expression> object, std::shared_ptr<Identifier> member) {
-    return std::make_shared<PointerMemberAccessExpression>(std::move(object), std::move(member));
+inline PointerMemberAccessExpression* makePointerMemberAccessExpression(
+    Expression* object, Identifier* member) {
+    return New<PointerMemberAccessExpression>(object, member);
 }
 
-inline std::shared_ptr<CastExpression> makeCastExpression(
-    TypeSpecifier type, std::shared_ptr<Expression> expr) {
-    return std::make_shared<CastExpression>(type, std::move(expr));
+inline CastExpression* makeCastExpression(
+    TypeSpecifier type, Expression* expr) {
+    return New<CastExpression>(type, expr);
 }
 
-// inline std::shared_ptr<ConditionalExpression> makeConditionalExpression(
-//     std::shared_ptr<Expression> cond, std::shared_ptr<Expression> thenExpr,
-//     std::shared_ptr<Expression> elseExpr, TypeSpecifier type) {
-//     return std::make_shared<ConditionalExpression>(
-//         std::move(cond), std::move(thenExpr), std::move(elseExpr), type);
+// inline ConditionalExpression* makeConditionalExpression(
+//     Expression* cond, Expression* thenExpr,
+//     Expression* elseExpr, TypeSpecifier type) {
+//     return New<ConditionalExpression>(
+//         cond, thenExpr, elseExpr, type);
 // }
 
-inline std::shared_ptr<ConditionalExpression> makeConditionalExpression(
-    std::shared_ptr<Expression> cond, std::shared_ptr<Expression> thenExpr,
-    std::shared_ptr<Expression> elseExpr) {
-    return std::make_shared<ConditionalExpression>(
-        std::move(cond), std::move(thenExpr), std::move(elseExpr));
+inline ConditionalExpression* makeConditionalExpression(
+    Expression* cond, Expression* thenExpr,
+    Expression* elseExpr) {
+    return New<ConditionalExpression>(
+        cond, thenExpr, elseExpr);
 }
 
-inline std::shared_ptr<CommaExpression> makeCommaExpression(
-    std::shared_ptr<Expression> left, std::shared_ptr<Expression> right) {
-    return std::make_shared<CommaExpression>(std::move(left), std::move(right));
+inline CommaExpression* makeCommaExpression(
+    Expression* left, Expression* right) {
+    return New<CommaExpression>(left, right);
 }
 
-inline std::shared_ptr<SizeofExpression> makeSizeofExpression(std::shared_ptr<Expression> expr) {
-    return std::make_shared<SizeofExpression>(std::move(expr));
+inline SizeofExpression* makeSizeofExpression(Expression* expr) {
+    return New<SizeofExpression>(expr);
 }
 
-inline std::shared_ptr<SizeofTypeExpression> makeSizeofTypeExpression(TypeSpecifier type) {
-    return std::make_shared<SizeofTypeExpression>(type);
+inline SizeofTypeExpression* makeSizeofTypeExpression(TypeSpecifier type) {
+    return New<SizeofTypeExpression>(type);
 }
 
 // Statements
-inline std::shared_ptr<ExpressionStatement> makeExpressionStatement(
-    std::shared_ptr<Expression> expr = nullptr) {
-    return std::make_shared<ExpressionStatement>(std::move(expr));
+inline ExpressionStatement* makeExpressionStatement(
+    Expression* expr = nullptr) {
+    return New<ExpressionStatement>(expr);
 }
 
-inline std::shared_ptr<CompoundStatement> makeCompoundStatement() {
-    return std::make_shared<CompoundStatement>();
+inline CompoundStatement* makeCompoundStatement() {
+    return New<CompoundStatement>();
 }
 
-inline std::shared_ptr<CompoundStatement> makeCompoundStatement(std::shared_ptr<NodeList> stmts) {
-    return std::make_shared<CompoundStatement>(stmts.get());
+inline CompoundStatement* makeCompoundStatement(NodeList* stmts) {
+    return New<CompoundStatement>(stmts);
 }
 
-inline std::shared_ptr<IfStatement> makeIfStatement(
-    std::shared_ptr<Expression> cond, std::shared_ptr<Statement> thenStmt,
-    std::shared_ptr<Statement> elseStmt = nullptr) {
-    return std::make_shared<IfStatement>(std::move(cond), std::move(thenStmt), std::move(elseStmt));
+inline IfStatement* makeIfStatement(
+    Expression* cond, Statement* thenStmt,
+    Statement* elseStmt = nullptr) {
+    return New<IfStatement>(cond, thenStmt, elseStmt);
 }
 
-inline std::shared_ptr<WhileStatement> makeWhileStatement(
-    std::shared_ptr<Expression> cond, std::shared_ptr<Statement> body) {
-    return std::make_shared<WhileStatement>(std::move(cond), std::move(body));
+inline WhileStatement* makeWhileStatement(
+    Expression* cond, Statement* body) {
+    return New<WhileStatement>(cond, body);
 }
 
-inline std::shared_ptr<DoWhileStatement> makeDoWhileStatement(
-    std::shared_ptr<Statement> body, std::shared_ptr<Expression> cond) {
-    return std::make_shared<DoWhileStatement>(std::move(body), std::move(cond));
+inline DoWhileStatement* makeDoWhileStatement(
+    Statement* body, Expression* cond) {
+    return New<DoWhileStatement>(body, cond);
 }
 
-inline std::shared_ptr<ForStatement> makeForStatement(
-    std::shared_ptr<Expression> init, std::shared_ptr<Expression> cond,
-    std::shared_ptr<Expression> inc, std::shared_ptr<Statement> body) {
-    return std::make_shared<ForStatement>(
-        std::move(init), std::move(cond), std::move(inc), std::move(body));
+inline ForStatement* makeForStatement(
+    Expression* init, Expression* cond,
+    Expression* inc, Statement* body) {
+    return New<ForStatement>(
+        init, cond, inc, body);
 }
 
-inline std::shared_ptr<ReturnStatement> makeReturnStatement(
-    std::shared_ptr<Expression> expr = nullptr) {
-    return std::make_shared<ReturnStatement>(std::move(expr));
+inline ReturnStatement* makeReturnStatement(
+    Expression* expr = nullptr) {
+    return New<ReturnStatement>(expr);
 }
 
-inline std::shared_ptr<BreakStatement> makeBreakStatement() {
-    return std::make_shared<BreakStatement>();
+inline BreakStatement* makeBreakStatement() {
+    return New<BreakStatement>();
 }
 
-inline std::shared_ptr<ContinueStatement> makeContinueStatement() {
-    return std::make_shared<ContinueStatement>();
+inline ContinueStatement* makeContinueStatement() {
+    return New<ContinueStatement>();
 }
 
-inline std::shared_ptr<SwitchStatement> makeSwitchStatement(
-    std::shared_ptr<Expression> cond, std::shared_ptr<Statement> body) {
-    return std::make_shared<SwitchStatement>(std::move(cond), std::move(body));
+inline SwitchStatement* makeSwitchStatement(
+    Expression* cond, Statement* body) {
+    return New<SwitchStatement>(cond, body);
 }
 
-inline std::shared_ptr<CaseStatement> makeCaseStatement(
-    std::shared_ptr<Expression> value, std::shared_ptr<Statement> stmt) {
-    return std::make_shared<CaseStatement>(std::move(value), std::move(stmt));
+inline CaseStatement* makeCaseStatement(
+    Expression* value, Statement* stmt) {
+    return New<CaseStatement>(value, stmt);
 }
 
-inline std::shared_ptr<DefaultStatement> makeDefaultStatement(std::shared_ptr<Statement> stmt) {
-    return std::make_shared<DefaultStatement>(std::move(stmt));
+inline DefaultStatement* makeDefaultStatement(Statement* stmt) {
+    return New<DefaultStatement>(stmt);
 }
 
-inline std::shared_ptr<GotoStatement> makeGotoStatement(std::shared_ptr<Identifier> label) {
-    return std::make_shared<GotoStatement>(std::move(label));
+inline GotoStatement* makeGotoStatement(Identifier* label) {
+    return New<GotoStatement>(label);
 }
 
-inline std::shared_ptr<LabeledStatement> makeLabeledStatement(
-    std::shared_ptr<Identifier> label, std::shared_ptr<Statement> stmt) {
-    return std::make_shared<LabeledStatement>(std::move(label), std::move(stmt));
+inline LabeledStatement* makeLabeledStatement(
+    Identifier* label, Statement* stmt) {
+    return New<LabeledStatement>(label, stmt);
 }
 
-inline std::shared_ptr<InitializerList> makeInitializerList() {
-    return std::make_shared<InitializerList>();
+inline InitializerList* makeInitializerList() {
+    return New<InitializerList>();
 }
 
 } // namespace ast
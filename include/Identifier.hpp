@@ -1,18 +1,20 @@
 #pragma once
 #include "ast_node.hpp"
 #include "Visitor.hpp"
+#include "symbol.hpp"
 #include <string>
 
 namespace ast {
 
 class Identifier : public Node {
 private:
-    std::string name;
+    Symbol name;
 
 public:
-    Identifier(const std::string& n) : name(n) {}
+    Identifier(Symbol n) : name(n) {}
 
-    const std::string& getName() const { return name; }
+    const std::string& getName() const { return name.str(); }
+    Symbol getSymbol() const { return name; }
 
     void accept(Visitor& visitor) const override {
         (void)visitor; // should not be calling this
@@ -4,7 +4,6 @@
 #include "Identifier.hpp"
 #include "Visitor.hpp"
 #include <vector>
-#include <memory>
 #include <string>
 
 namespace ast {
@@ -16,27 +15,28 @@ public:
     virtual ~Statement() = default;
 };
 
-using StmtPtr = std::shared_ptr<Statement>;
+using StmtPtr = Statement*;
 
 // function call or assignment
 class ExpressionStatement : public Statement {
 private:
-    std::shared_ptr<Expression> expression;
+    Expression* expression = nullptr;
 
 public:
-    ExpressionStatement(std::shared_ptr<Expression> expr = nullptr)
+    ExpressionStatement(Expression* expr = nullptr)
         : expression(expr) {}
 
-    std::shared_ptr<Expression> getExpression() const {return expression;}
-    void setExpression(std::shared_ptr<Expression> expr) {expression = expr;}
+    const Expression* getExpression() const {return expression;}
+    Expression* getExpression() {return expression;}
+    void setExpression(Expression* expr) {expression = expr;}
 
     void accept(Visitor& visitor) const override;
 };
 
 class CompoundStatement : public Statement {
 private:
-    std::vector<StmtPtr> statements;
-    std::shared_ptr<NodeList> declarationList;
+    ArenaVector<StmtPtr> statements{Arena::CurrentResource()};
+    NodeList* declarationList = nullptr;
 
 public:
     CompoundStatement() = default;
@@ -44,7 +44,7 @@ public:
     CompoundStatement(NodeList* stmtList) {
         if (stmtList) {
             for (auto& node : stmtList->getNodes()) {
-                auto stmtPtr = std::dynamic_pointer_cast<Statement>(node);
+                auto stmtPtr = dynamic_cast<Statement*>(node);
                 if (stmtPtr) {
                     statements.push_back(stmtPtr);
                 }
@@ -52,38 +52,38 @@ public:
         }
     }
 
-    void setDeclarationList(std::shared_ptr<NodeList> list) {
-        declarationList = std::move(list);
+    void setDeclarationList(NodeList* list) {
+        declarationList = list;
     }
 
     const NodeList* getDeclarationList() const {
-        return declarationList.get();
+        return declarationList;
     }
 
     void addStatement(StmtPtr stmt) {
-        statements.push_back(std::move(stmt));
+        statements.push_back(stmt);
     }
 
-    const std::vector<StmtPtr>& getStatements() const {return statements;}
+    const ArenaVector<StmtPtr>& getStatements() const {return statements;}
 
     void accept(Visitor& visitor) const override;
 };
 
 class IfStatement : public Statement {
 private:
-    std::shared_ptr<Expression> condition;
-    StmtPtr thenStatement;
-    StmtPtr elseStatement;
+    Expression* condition = nullptr;
+    StmtPtr thenStatement = nullptr;
+    StmtPtr elseStatement = nullptr;
 
 public:
-    IfStatement(std::shared_ptr<Expression> cond, StmtPtr thenStmt, StmtPtr elseStmt = nullptr)
-        : condition(std::move(cond)),
-          thenStatement(std::move(thenStmt)),
-          elseStatement(std::move(elseStmt)) {}
-
-    std::shared_ptr<Expression> getCondition() const { return condition; }
-    const Statement* getThenStatement() const { return thenStatement.get(); }
-    const Statement* getElseStatement() const { return elseStatement.get(); }
+    IfStatement(Expression* cond, StmtPtr thenStmt, StmtPtr elseStmt = nullptr)
+        : condition(cond),
+          thenStatement(thenStmt),
+          elseStatement(elseStmt) {}
+
+    const Expression* getCondition() const { return condition; }
+    const Statement* getThenStatement() const { return thenStatement; }
+    const Statement* getElseStatement() const { return elseStatement; }
     bool hasElseStatement() const { return elseStatement != nullptr; }
 
     void accept(Visitor& visitor) const override;
@@ -91,15 +91,15 @@ public:
 
 class SwitchStatement : public Statement {
 private:
-    std::shared_ptr<Expression> condition;
-    StmtPtr body;
+    Expression* condition = nullptr;
+    StmtPtr body = nullptr;
 
 public:
-    SwitchStatement(std::shared_ptr<Expression> cond, StmtPtr bodyStmt)
-        : condition(std::move(cond)), body(std::move(bodyStmt)) {}
+    SwitchStatement(Expression* cond, StmtPtr bodyStmt)
+        : condition(cond), body(bodyStmt) {}
 
-    std::shared_ptr<Expression> getCondition() const { return condition; }
-    const Statement* getBody() const { return body.get(); }
+    const Expression* getCondition() const { return condition; }
+    const Statement* getBody() const { return body; }
 
     void accept(Visitor& visitor) const override;
 };
@@ -107,19 +107,19 @@ public:
 // Case statement (part of switch)
 class CaseStatement : public Statement {
 private:
-    std::shared_ptr<Expression> caseValue;
-    StmtPtr statement;
+    Expression* caseValue = nullptr;
+    StmtPtr statement = nullptr;
 
 public:
-    CaseStatement(std::shared_ptr<Expression> value, StmtPtr stmt)
-        : caseValue(std::move(value)), statement(std::move(stmt)) {}
+    CaseStatement(Expression* value, StmtPtr stmt)
+        : caseValue(value), statement(stmt) {}
 
     CaseStatement(StmtPtr stmt)
-        : caseValue(nullptr), statement(std::move(stmt)) {}
+        : caseValue(nullptr), statement(stmt) {}
 
-    std::shared_ptr<Expression> getCaseValue() const { return caseValue; }
+    const Expression* getCaseValue() const { return caseValue; }
     bool isDefault() const { return caseValue == nullptr; }
-    const Statement* getStatement() const { return statement.get(); }
+    const Statement* getStatement() const { return statement; }
 
     void accept(Visitor& visitor) const override;
 };
@@ -132,30 +132,30 @@ public:
 
 class WhileStatement : public Statement {
 private:
-    std::shared_ptr<Expression> condition;
-    StmtPtr body;
+    Expression* condition = nullptr;
+    StmtPtr body = nullptr;
 
 public:
-    WhileStatement(std::shared_ptr<Expression> cond, StmtPtr bodyStmt)
-        : condition(std::move(cond)), body(std::move(bodyStmt)) {}
+    WhileStatement(Expression* cond, StmtPtr bodyStmt)
+        : condition(cond), body(bodyStmt) {}
 
-    std::shared_ptr<Expression> getCondition() const { return condition; }
-    const Statement* getBody() const { return body.get(); }
+    const Expression* getCondition() const { return condition; }
+    const Statement* getBody() const { return body; }
 
     void accept(Visitor& visitor) const override;
 };
 
 class DoWhileStatement : public Statement {
 private:
-    StmtPtr body;
-    std::shared_ptr<Expression> condition;
+    StmtPtr body = nullptr;
+    Expression* condition = nullptr;
 
 public:
-    DoWhileStatement(StmtPtr bodyStmt, std::shared_ptr<Expression> cond)
-        : body(std::move(bodyStmt)), condition(std::move(cond)) {}
+    DoWhileStatement(StmtPtr bodyStmt, Expression* cond)
+        : body(bodyStmt), condition(cond) {}
 
-    const Statement* getBody() const { return body.get(); }
-    std::shared_ptr<Expression> getCondition() const { return condition; }
+    const Statement* getBody() const { return body; }
+    const Expression* getCondition() const { return condition; }
 
     void accept(Visitor& visitor) const override;
 };
@@ -163,23 +163,23 @@ public:
 class ForStatement : public Statement {
 private:
     // all optional except body
-    std::shared_ptr<Expression> initialization;
-    std::shared_ptr<Expression> condition;
-    std::shared_ptr<Expression> increment;
-    StmtPtr body;
+    Expression* initialization = nullptr;
+    Expression* condition = nullptr;
+    Expression* increment = nullptr;
+    StmtPtr body = nullptr;
 
 public:
-    ForStatement(std::shared_ptr<Expression> init, std::shared_ptr<Expression> cond,
-                 std::shared_ptr<Expression> inc, StmtPtr bodyStmt)
-        : initialization(std::move(init)),
-          condition(std::move(cond)),
-          increment(std::move(inc)),
-          body(std::move(bodyStmt)) {}
-
-    std::shared_ptr<Expression> getInitialization() const { return initialization; }
-    std::shared_ptr<Expression> getCondition() const { return condition; }
-    std::shared_ptr<Expression> getIncrement() const { return increment; }
-    const Statement* getBody() const { return body.get(); }
+    ForStatement(Expression* init, Expression* cond,
+                 Expression* inc, StmtPtr bodyStmt)
+        : initialization(init),
+          condition(cond),
+          increment(inc),
+          body(bodyStmt) {}
+
+    const Expression* getInitialization() const { return initialization; }
+    const Expression* getCondition() const { return condition; }
+    const Expression* getIncrement() const { return increment; }
+    const Statement* getBody() const { return body; }
 
     bool hasInitialization() const { return initialization != nullptr; }
     bool hasCondition() const { return condition != nullptr; }
@@ -190,12 +190,12 @@ public:
 
 class ReturnStatement : public Statement {
 private:
-    std::shared_ptr<Expression> expression;  // Optional (void functions don't have a return value)
+    Expression* expression = nullptr;  // Optional (void functions don't have a return value)
 
 public:
-    ReturnStatement(std::shared_ptr<Expression> expr = nullptr) : expression(std::move(expr)) {}
+    ReturnStatement(Expression* expr = nullptr) : expression(expr) {}
 
-    std::shared_ptr<Expression> getExpression() const { return expression; }
+    const Expression* getExpression() const { return expression; }
     bool hasExpression() const { return expression != nullptr; }
 
     void accept(Visitor& visitor) const override;
@@ -217,34 +217,28 @@ public:
 
 class GotoStatement : public Statement {
 private:
-    std::shared_ptr<Identifier> label;
+    Identifier* label = nullptr;
 
 public:
     GotoStatement(Identifier* l)
-        : label(std::shared_ptr<Identifier>(l)) {}
+        : label(l) {}
 
-    GotoStatement(std::shared_ptr<Identifier> l)
-        : label(std::move(l)) {}
-
-    const Identifier* getLabel() const { return label.get(); }
+    const Identifier* getLabel() const { return label; }
 
     void accept(Visitor& visitor) const override;
 };
 
 class LabeledStatement : public Statement {
 private:
-    std::shared_ptr<Identifier> label;
-    StmtPtr statement;
+    Identifier* label = nullptr;
+    StmtPtr statement = nullptr;
 
 public:
-    LabeledStatement(Identifier* l, Statement* stmt)
-        : label(std::shared_ptr<Identifier>(l)), statement(StmtPtr(stmt)) {}
-
-    LabeledStatement(std::shared_ptr<Identifier> l, StmtPtr stmt)
-        : label(std::move(l)), statement(std::move(stmt)) {}
+    LabeledStatement(Identifier* l, StmtPtr stmt)
+        : label(l), statement(stmt) {}
 
-    const Identifier* getLabel() const { return label.get(); }
-    const Statement* getStatement() const { return statement.get(); }
+    const Identifier* getLabel() const { return label; }
+    const Statement* getStatement() const { return statement; }
 
     void accept(Visitor& visitor) const override;
 };
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Visitor.hpp"
+#include "DeclarationStatement.hpp"
+#include "Declarator.hpp"
+#include "Declaration.hpp"
+#include "EnumDeclaration.hpp"
+#include "Expression.hpp"
+#include "Statement.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace ast;
+namespace codegen {
+
+/* Read-only walk over a subtree that records which names it reads, writes,
+   declares and calls. Codegen runs it on loop bodies and whole functions
+   before deciding whether a rewrite is safe; it never emits anything. */
+class AnalysisVisitor : public Visitor {
+private:
+    std::unordered_set<Symbol> assigned;
+    std::unordered_set<Symbol> read;
+    std::unordered_set<Symbol> declared;
+    std::unordered_set<Symbol> addressTaken;
+    std::unordered_set<Symbol> storedArrays;
+    std::unordered_set<Symbol> fpDivisors;
+    std::unordered_set<Symbol> calledFunctions;
+    std::unordered_map<Symbol, int> useCounts;
+    std::vector<const Node*> branchStatements;  // if/loop/switch/case/default in source order
+    std::unordered_set<Symbol> unevaluated;     // names that only appear as operands of sizeof
+
+    int callCount = 0;
+    int nodeCount = 0;
+    bool indirectCall = false;
+    bool indirectStore = false;
+    bool controlFlow = false;   // return, break, continue, goto or labels
+
+    void noteRead(Symbol name);
+    void noteStore(const Expression* lhs);
+
+public:
+    const std::unordered_set<Symbol>& getAssigned() const { return assigned; }
+    const std::unordered_set<Symbol>& getRead() const { return read; }
+    const std::unordered_set<Symbol>& getDeclared() const { return declared; }
+    const std::unordered_set<Symbol>& getAddressTaken() const { return addressTaken; }
+    const std::unordered_set<Symbol>& getStoredArrays() const { return storedArrays; }
+    const std::unordered_set<Symbol>& getFloatingDivisors() const { return fpDivisors; }
+    const std::unordered_set<Symbol>& getCalledFunctions() const { return calledFunctions; }
+    int getUseCount(Symbol name) const;
+    const std::vector<const Node*>& getBranchStatements() const { return branchStatements; }
+    const std::unordered_set<Symbol>& getUnevaluated() const { return unevaluated; }
+
+    int getCallCount() const { return callCount; }
+    int getNodeCount() const { return nodeCount; }
+    bool hasIndirectCall() const { return indirectCall; }
+    bool hasIndirectStore() const { return indirectStore; }
+    bool hasControlFlow() const { return controlFlow; }
+
+    // true if evaluating the subtree can change any state visible outside it
+    bool hasSideEffects() const {
+        return !assigned.empty() || !storedArrays.empty() || indirectStore || callCount > 0;
+    }
+
+    bool isModified(Symbol name) const {
+        return assigned.count(name) || storedArrays.count(name);
+    }
+
+    void visitVariableDeclaration(const VariableDeclaration& decl) override;
+    void visitFunctionDeclaration(const FunctionDeclaration& decl) override;
+
+    // expressions
+    void visitBinaryExpression(const BinaryExpression& expr) override;
+    void visitUnaryExpression(const UnaryExpression& expr) override;
+    void visitLiteralExpression(const LiteralExpression& expr) override;
+    void visitIdentifierExpression(const IdentifierExpression& expr) override;
+    void visitCallExpression(const CallExpression& expr) override;
+    void visitAssignmentExpression(const AssignmentExpression& expr) override;
+    void visitStringLiteralExpression(const StringLiteralExpression& expr) override;
+    void visitArrayAccessExpression(const ArrayAccessExpression& expr) override;
+    void visitMemberAccessExpression(const MemberAccessExpression& expr) override;
+    void visitPointerMemberAccessExpression(const PointerMemberAccessExpression& expr) override;
+    void visitCastExpression(const CastExpression& expr) override;
+    void visitConditionalExpression(const ConditionalExpression& expr) override;
+    void visitCommaExpression(const CommaExpression& expr) override;
+    void visitSizeofExpression(const SizeofExpression& expr) override;
+    void visitSizeofTypeExpression(const SizeofTypeExpression& expr) override;
+
+    // statements
+    void visitExpressionStatement(const ExpressionStatement& stmt) override;
+    void visitCompoundStatement(const CompoundStatement& stmt) override;
+    void visitIfStatement(const IfStatement& stmt) override;
+    void visitWhileStatement(const WhileStatement& stmt) override;
+    void visitForStatement(const ForStatement& stmt) override;
+    void visitReturnStatement(const ReturnStatement& stmt) override;
+    void visitBreakStatement(const BreakStatement& stmt) override;
+    void visitContinueStatement(const ContinueStatement& stmt) override;
+    void visitSwitchStatement(const SwitchStatement& stmt) override;
+    void visitCaseStatement(const CaseStatement& stmt) override;
+    void visitDoWhileStatement(const DoWhileStatement& stmt) override;
+    void visitGotoStatement(const GotoStatement& stmt) override;
+    void visitLabeledStatement(const LabeledStatement& stmt) override;
+    void visitDefaultStatement(const DefaultStatement& stmt) override;
+
+    // declarators
+    void visitIdentifierDeclarator(const IdentifierDeclarator& decl) override;
+    void visitArrayDeclarator(const ArrayDeclarator& decl) override;
+    void visitFunctionDeclarator(const FunctionDeclarator& decl) override;
+    void visitPointerDeclarator(const PointerDeclarator& decl) override;
+    void visitParameterDeclaration(const ParameterDeclaration& decl) override;
+    void visitParameterList(const ParameterList& list) override;
+    void visitInitDeclarator(const InitDeclarator& decl) override;
+    void visitInitializerList(const ast::InitializerList& list) override;
+
+    void visitEnumValue(const ast::EnumValue& value) override;
+    void visitEnumDeclaration(const ast::EnumDeclaration& decl) override;
+};
+
+} // namespace codegen
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ast {
+
+// Bump allocator owning every node of one translation unit. Nodes are carved
+// out of large chunks and never freed one by one: the arena runs their
+// destructors, newest first, and releases the chunks when it goes away, so
+// links between nodes are plain pointers with no reference counts.
+// It is also the memory resource behind the nodes' child lists (ArenaVector),
+// so building a list while parsing never touches the heap either.
+class Arena : public std::pmr::memory_resource
+{
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena() override;
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args)
+    {
+        void* place = carve(sizeof(T), alignof(T), std::is_trivially_destructible_v<T> ? nullptr : &destroy<T>);
+        T* object = new (place) T(std::forward<Args>(args)...);
+        objects++;
+        return object;
+    }
+
+    // Destroys every object but keeps the chunks, so a long-lived arena (one
+    // per compile server worker) serves later translation units from memory
+    // it has already touched.
+    void reset();
+
+    // the arena make() allocates from on this thread; see Scope
+    static Arena& Current();
+
+    // the current arena, or the heap when none is in scope (nodes built on
+    // the stack by the code generator)
+    static std::pmr::memory_resource* CurrentResource();
+
+    // Makes an arena current on this thread while in scope, restoring the
+    // previous one after, so nested parses each fill their own.
+    class Scope
+    {
+    public:
+        explicit Scope(Arena& arena);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        Arena* previous;
+    };
+
+    size_t objectCount() const { return objects; }
+    size_t bytesUsed() const { return used; }           // objects, headers and alignment
+    size_t bytesReserved() const { return reserved; }   // chunks taken from the heap
+
+private:
+    struct Chunk;
+    struct Header;
+    using Destructor = void (*)(void*);
+
+    template <typename T>
+    static void destroy(void* object)
+    {
+        static_cast<T*>(object)->~T();
+    }
+
+    void* carve(size_t size, size_t align, Destructor destructor);
+
+    // storage for ArenaVector; outgrown buffers stay until the arena goes
+    void* do_allocate(size_t bytes, size_t align) override { return carve(bytes, align, nullptr); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    Chunk* chunks = nullptr;
+    Chunk* spare = nullptr;     // chunks kept by reset(), largest first
+    char* next = nullptr;
+    char* end = nullptr;
+    Header* last = nullptr;     // newest object with a destructor
+    size_t objects = 0;
+    size_t used = 0;
+    size_t reserved = 0;
+};
+
+// a node's list of children, stored in the arena the node was made in
+template <typename T>
+using ArenaVector = std::pmr::vector<T>;
+
+// allocates a node in the current arena
+template <typename T, typename... Args>
+T* New(Args&&... args)
+{
+    return Arena::Current().make<T>(std::forward<Args>(args)...);
+}
+
+} // namespace ast
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Output stream for generated assembly. Lines collect in a large buffer that
+// reaches the sink in one write when it fills or at close(); nothing is
+// flushed per line, so the code generator ends lines with '\n', never
+// std::endl. A file sink that outgrows the buffer starts a writer thread and
+// keeps generating into a second buffer while the first is written.
+class AssemblyStream : public std::ostream
+{
+public:
+    static constexpr size_t BUFFER_SIZE = 256 * 1024;
+
+    // appends to text
+    explicit AssemblyStream(std::string& text);
+
+    // truncates or creates the file; throws if it cannot be opened
+    explicit AssemblyStream(const std::string& path);
+
+    AssemblyStream(const AssemblyStream&) = delete;
+    AssemblyStream& operator=(const AssemblyStream&) = delete;
+    ~AssemblyStream() override;
+
+    // writes out what is buffered and waits for the writer thread; throws if
+    // a write failed
+    void close();
+
+private:
+    class Buffer : public std::streambuf
+    {
+    public:
+        Buffer(std::string* text, int fd);
+        ~Buffer() override;
+        void close();
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* data, std::streamsize count) override;
+        int sync() override { return 0; }   // std::flush must not cost a write
+
+    private:
+        void handOver();
+        void writeOut(const std::vector<char>& data, size_t size);
+        void writerLoop();
+
+        std::string* text;                  // string sink, or
+        int fd;                             // file sink
+        std::vector<char> filling;
+        std::vector<char> writing;          // the writer thread's
+        size_t pending = 0;                 // bytes of writing not yet written
+        bool failed = false;
+        bool stopping = false;
+        std::thread writer;
+        std::mutex mutex;
+        std::condition_variable changed;
+    };
+
+    Buffer buffer;
+    bool closed = false;
+};
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "ast_node.hpp"
@@ -18,5 +19,14 @@
 #include "Visitor.hpp"
 #include "Factory.hpp"
 
+class SourceBuffer;
 
-ast::NodePtr ParseAST(std::string file_name);
+// Parses a file into nodes allocated from arena, which must outlive the tree.
+// Throws std::runtime_error on a syntax error or a file that cannot be read.
+ast::NodePtr ParseAST(std::string file_name, ast::Arena& arena);
+
+// The same for source text already in memory; file_name is only used in errors.
+ast::NodePtr ParseAST(std::string file_name, std::string_view text, ast::Arena& arena);
+
+// Scans source in place, without copying it; flex writes into the buffer while it runs.
+ast::NodePtr ParseAST(std::string file_name, SourceBuffer& source, ast::Arena& arena);
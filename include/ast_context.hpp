@@ -1,5 +1,9 @@
 #pragma once
 #include "ast_type_specifier.hpp"
+#include "compile_options.hpp"
+#include "machine_ir.hpp"
+#include "profile_data.hpp"
+#include "symbol.hpp"
 
 #include <unordered_map>
 #include <string>
@@ -8,8 +12,7 @@
 #include <stack>
 #include <optional>
 #include <stdexcept>
-#include <ostream>
-#include <iostream>
+#include <algorithm>
 #include <stdint.h>
 
 namespace ast {
@@ -17,6 +20,14 @@ namespace ast {
 constexpr int TOTAL_STACK_SIZE = 1024;
 constexpr int POINTER_MEM = 4;
 
+// -fomit-frame-pointer keeps sp fixed in the body, so what used to be pushed
+// gets a place in the frame: outgoing stack arguments at the bottom, and a
+// slot for every caller-saved register at the top. Both come on top of the
+// TOTAL_STACK_SIZE locals get, so omitting the frame pointer never costs room.
+constexpr int OUTGOING_ARGS_SIZE = 32;
+constexpr int CALL_SAVE_AREA_SIZE = 15 * 4 + 4 + 16 * 8;
+constexpr int OMIT_FP_FRAME_SIZE = (TOTAL_STACK_SIZE + OUTGOING_ARGS_SIZE + CALL_SAVE_AREA_SIZE + 8 + 15) / 16 * 16;
+
 extern const std::unordered_map<TypeSpecifier, unsigned int> TYPE_SIZE;
 
 struct Variable {
@@ -60,25 +71,38 @@ private:
     };
 
     //scope management
-    using Scope = std::unordered_map<std::string, Variable>;
+    using Scope = std::unordered_map<Symbol, Variable>;
     std::vector<Scope> scopes;
     std::vector<bool> function_scopes;
-    std::vector<std::string> current_function_stack;
-    std::unordered_map<std::string, bool> global_variables; // true if var is global
+    std::vector<Symbol> current_function_stack;
+    std::unordered_map<Symbol, bool> global_variables; // true if var is global
 
     //stack management
     int stack_offset;
     int used_stack_memory;
     std::vector<int> remaining_mem_stack;
 
-    std::unordered_map<std::string, TypeSpecifier> function_return_types;
+    // -fstack-reuse: bytes of locals requested and frame bytes they ended up needing,
+    // summed over functions; a function's need is its high-water mark above frame_start
+    int requested_stack_memory = 0;
+    int needed_stack_memory = 0;
+    int frame_start = 0;
+    int frame_high_water = 0;
+
+    // frame layout: gaps left by alignment, per open block, and offsets planned for the next declarations
+    std::vector<std::pair<int, int>> frame_holes;   // offset, length
+    std::vector<std::vector<std::pair<int, int>>> frame_holes_stack;
+    std::unordered_map<Symbol, int> planned_offsets;
+    int padding_bytes = 0;
+
+    std::unordered_map<Symbol, TypeSpecifier> function_return_types;
     std::unordered_map<std::string, EnumType> enumTypes;
-    std::unordered_map<std::string, std::pair<std::string, int>> enumValues;
+    std::unordered_map<Symbol, std::pair<std::string, int>> enumValues;
 
-    std::unordered_map<std::string, std::string> function_end_labels;
+    std::unordered_map<Symbol, std::string> function_end_labels;
     std::unordered_map<float, std::string> float_labels; // map float values to data section
     std::unordered_map<double, std::string> double_labels; // map double values to data section
-    std::unordered_map<std::string, std::string> string_labels; // map double values to data section
+    std::unordered_map<Symbol, std::string> string_labels; // map double values to data section
     std::vector<std::string> break_targets;
     std::string current_switch_reg;
     std::vector<std::string> continue_targets;
@@ -87,31 +111,118 @@ private:
 
     std::set<std::string> used_registers;
     std::set<std::string> used_float_registers;
-    std::unordered_map<std::string, int> saved_registers;
-    std::unordered_map<std::string, int> saved_float_registers;
+
+    // registers saved around the call being generated; calls in its arguments nest
+    struct SavedRegisters {
+        std::unordered_map<std::string, int> integer;
+        std::unordered_map<std::string, int> floating;
+        int stack_adjust = 0;
+    };
+    std::vector<SavedRegisters> saved_register_stack;
 
     std::vector<float> floatValues;
     std::vector<double> doubleValues;
     std::vector<std::string> stringValues;
 
-    std::unordered_map<std::string, int> arraySize;
+    std::unordered_map<Symbol, int> arraySize;
 
-    int last_stack_adjust;
+    int skipped_saves = 0;      // live registers left unsaved because the callee keeps them
+    bool prefer_high_registers = false;
+    std::unordered_map<Symbol, std::string> incoming_registers;
 
     int label_counter;
 
     TypeSpecifier current_declaration_type;
 
-    int getMemory(int mem_size) {
-        if (mem_size % 4 != 0) {
-            mem_size = ((mem_size + 3) / 4) * 4;  // Align to 4 bytes
+    CompileOptions options;
+
+    // -fprofile-use counts, and the "<function> <block>" name of each -fprofile-generate counter
+    const ProfileData* profile = nullptr;
+    std::vector<std::string> profile_counters;
+
+    // bytes the prologue takes off sp
+    int frameSize() const { return options.omit_frame_pointer ? OMIT_FP_FRAME_SIZE : TOTAL_STACK_SIZE; }
+    int returnAddressSlot() const { return options.compressed ? frameBottom() + 4 : frameSize() - 4; }
+    int framePointerSlot() const { return options.compressed ? frameBottom() : frameSize() - 8; }
+    int frameBottom() const { return options.omit_frame_pointer ? OUTGOING_ARGS_SIZE : 0; }
+
+    // end of the space locals may take
+    int frameLimit() const {
+        if (!options.omit_frame_pointer) {
+            return TOTAL_STACK_SIZE;
         }
+        return frameSize() - CALL_SAVE_AREA_SIZE - (options.compressed ? 0 : 8);
+    }
 
-        if (used_stack_memory + mem_size > TOTAL_STACK_SIZE) {
+    // slot of a caller-saved register in the -fomit-frame-pointer save area; 8 bytes for floats
+    int callSaveSlot(const std::string& reg) const {
+        static const std::vector<std::string> integer_registers = {
+            "t0", "t1", "t2", "t3", "t4", "t5", "t6", "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7"
+        };
+        static const std::vector<std::string> float_registers = {
+            "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7", "fa0", "fa1", "fa2", "fa3", "fa4", "fa5", "fa6", "fa7"
+        };
+        auto it = std::find(integer_registers.begin(), integer_registers.end(), reg);
+        if (it != integer_registers.end()) {
+            return frameLimit() + 4 * static_cast<int>(it - integer_registers.begin());
+        }
+        it = std::find(float_registers.begin(), float_registers.end(), reg);
+        if (it == float_registers.end()) {
+            throw std::runtime_error("No save slot for register: " + reg);
+        }
+        return frameLimit() + 64 + 8 * static_cast<int>(it - float_registers.begin());
+    }
+
+    // First fit into padding an earlier slot left behind, else on top of the
+    // frame at the next multiple of align. Globals take no frame space.
+    int getMemory(int mem_size, int align) {
+        if (current_function_stack.empty()) {
+            return 0;
+        }
+        requested_stack_memory += mem_size;
+
+        for (size_t i = 0; i < frame_holes.size(); i++) {
+            auto [hole, length] = frame_holes[i];
+            int offset = alignUp(hole, align);
+            if (offset + mem_size > hole + length) {
+                continue;
+            }
+            frame_holes.erase(frame_holes.begin() + i);
+            if (offset > hole) {
+                frame_holes.push_back({hole, offset - hole});
+            }
+            if (offset + mem_size < hole + length) {
+                frame_holes.push_back({offset + mem_size, hole + length - offset - mem_size});
+            }
+            padding_bytes -= mem_size;
+            return offset;
+        }
+
+        int offset = alignUp(used_stack_memory, align);
+        if (offset + mem_size > frameLimit()) {
             throw std::runtime_error("Stack overflow");
         }
-        used_stack_memory += mem_size;
-        int offset = used_stack_memory - mem_size;
+        if (offset > used_stack_memory) {
+            frame_holes.push_back({used_stack_memory, offset - used_stack_memory});
+            padding_bytes += offset - used_stack_memory;
+        }
+        used_stack_memory = offset + mem_size;
+        frame_high_water = std::max(frame_high_water, used_stack_memory);
+        return offset;
+    }
+
+    static int alignUp(int offset, int align) {
+        return (offset + align - 1) / align * align;
+    }
+
+    // a planned slot from planLocals, or a new one
+    int slotFor(Symbol id, int mem_size, int align) {
+        auto it = planned_offsets.find(id);
+        if (it == planned_offsets.end()) {
+            return getMemory(mem_size, align);
+        }
+        int offset = it->second;
+        planned_offsets.erase(it);
         return offset;
     }
 
@@ -126,15 +237,79 @@ public:
         function_scopes.push_back(false);
     }
 
+    void setOptions(const CompileOptions& opts) { options = opts; }
+    const CompileOptions& getOptions() const { return options; }
+
+    void setProfile(const ProfileData* data) { profile = data; }
+    const ProfileData* getProfile() const { return profile; }
+
+    // returns the index of a new counter in the instrumented build's table
+    int addProfileCounter(const std::string& name) {
+        profile_counters.push_back(name);
+        return static_cast<int>(profile_counters.size()) - 1;
+    }
+    const std::vector<std::string>& getProfileCounters() const { return profile_counters; }
+
+    int getSkippedSaves() const { return skipped_saves; }
+
+    // stack bytes every local asked for, against the frame space they took
+    int getRequestedStackMemory() const { return requested_stack_memory; }
+    int getNeededStackMemory() const { return needed_stack_memory; }
+
+    // frame bytes lost to alignment, over every function
+    int getPaddingBytes() const { return padding_bytes; }
+
+    // A local about to be declared, with its number of uses in the block.
+    struct FrameSlot {
+        Symbol id;
+        int size;
+        int align;
+        int uses;
+        bool array;
+    };
+
+    // Lays out the locals a block declares before their declarations are
+    // generated: scalars before arrays, each most used first, so hot values sit
+    // nearest sp (and within reach of c.lwsp). Small slots fill the padding that
+    // aligning the larger ones leaves.
+    void planLocals(std::vector<FrameSlot> slots) {
+        planned_offsets.clear();
+        std::stable_sort(slots.begin(), slots.end(), [](const FrameSlot& a, const FrameSlot& b) {
+            if (a.array != b.array) {
+                return !a.array;
+            }
+            if (a.uses != b.uses) {
+                return a.uses > b.uses;
+            }
+            return a.align > b.align;
+        });
+        for (const auto& slot : slots) {
+            planned_offsets[slot.id] = getMemory(slot.size, slot.align);
+        }
+    }
+
+    int getAlignment(TypeSpecifier type, bool isPointer = false) const {
+        if (isPointer) {
+            return POINTER_MEM;
+        }
+        return std::max(1, getTypeSize(type));
+    }
+
+    // -fipa-ra leaf functions take temporaries from a7 down, out of the way of
+    // their callers' t0 upwards, so the callers find those still intact
+    void setPreferHighRegisters(bool prefer) { prefer_high_registers = prefer; }
+
     void enterScope(bool isFunction) {
         scopes.push_back(Scope());
         parameters_stack.push_back(std::vector<Variable>());
         remaining_mem_stack.push_back(TOTAL_STACK_SIZE - used_stack_memory);
+        frame_holes_stack.push_back(frame_holes);
 
         if (isFunction) {
             function_scopes.push_back(true);
             stack_offset = 0;
             used_stack_memory = 0;
+            frame_holes.clear();
         } else {
             function_scopes.push_back(false);
         }
@@ -148,13 +323,19 @@ public:
         std::vector<Variable> params = parameters_stack.back();
         parameters_stack.pop_back();
 
-        //int remaining_mem = remaining_mem_stack.back();
+        int remaining_mem = remaining_mem_stack.back();
         remaining_mem_stack.pop_back();
+        std::vector<std::pair<int, int>> holes = frame_holes_stack.back();
+        frame_holes_stack.pop_back();
 
         if (!function_scopes.empty() && function_scopes.back()) {
             if (!current_function_stack.empty()) {
                 current_function_stack.pop_back();
             }
+        } else if (options.stack_reuse && !current_function_stack.empty()) {
+            // a block's slots are dead once it closes, so its siblings reuse them
+            used_stack_memory = TOTAL_STACK_SIZE - remaining_mem;
+            frame_holes = holes;
         }
         function_scopes.pop_back();
         scopes.pop_back();
@@ -164,24 +345,24 @@ public:
         return scopes.size() - 1;
     }
 
-    void setFunctionReturnType(const std::string& function_name, TypeSpecifier return_type, bool isPointer) {
+    void setFunctionReturnType(Symbol function_name, TypeSpecifier return_type, bool isPointer) {
         (void)isPointer;
         function_return_types[function_name] = return_type;
     }
 
-    TypeSpecifier getFunctionReturnType(const std::string& function_name) const {
+    TypeSpecifier getFunctionReturnType(Symbol function_name) const {
         auto it = function_return_types.find(function_name);
         if (it != function_return_types.end()) {
             return it->second;
         }
-        throw std::runtime_error("Unknown function: " + function_name);
+        throw std::runtime_error("Unknown function: " + function_name.str());
     }
 
-    bool functionExists(const std::string& function_name) const {
+    bool functionExists(Symbol function_name) const {
         return function_return_types.find(function_name) != function_return_types.end();
     }
 
-    void beginFunction(std::ostream& stream, const std::string& name, TypeSpecifier return_type, bool isPointer) {
+    void beginFunction(mir::Function& code, Symbol name, TypeSpecifier return_type, bool isPointer) {
         setFunctionReturnType(name, return_type, isPointer);
 
         std::string end_label = generateUniqueLabel("func_end");
@@ -190,55 +371,115 @@ public:
         current_function_stack.push_back(name);
 
         enterScope(true);
-        stream << "    addi sp, sp, -" << TOTAL_STACK_SIZE << std::endl;
-        stream << "    sw ra, " << (TOTAL_STACK_SIZE - 4) << "(sp)" << std::endl;
-        stream << "    sw s0, " << (TOTAL_STACK_SIZE - 8) << "(sp)" << std::endl;
-        stream << "    mv s0, sp" << std::endl;
+        used_stack_memory = frameBottom();
+        if (options.compressed) {
+            // ra/s0 live at the bottom of the frame so c.swsp/c.lwsp can reach them
+            used_stack_memory += 8;
+        }
+        frame_start = used_stack_memory;
+        frame_high_water = used_stack_memory;
+        if (!prologueDeferred()) {
+            emitPrologue(code, true);
+        }
     }
 
-    void endFunction(std::ostream& stream, const std::string& name) {
+    void endFunction(mir::Function& code, Symbol name) {
         if (!functionExists(name)) {
-            throw std::runtime_error("Not in a function: " + name);
+            throw std::runtime_error("Not in a function: " + name.str());
         }
 
-        stream << function_end_labels[name] << ":" << std::endl;
+        code.addLabel(function_end_labels[name]);
 
-        stream << "    mv sp, s0" << std::endl;
-        stream << "    lw s0, " << (TOTAL_STACK_SIZE - 8) << "(sp)" << std::endl;
-        stream << "    lw ra, " << (TOTAL_STACK_SIZE - 4) << "(sp)" << std::endl;
-        stream << "    addi sp, sp, " << TOTAL_STACK_SIZE << std::endl;
-        stream << "    jr ra" << std::endl;
+        if (!prologueDeferred()) {
+            emitEpilogue(code, true);
+            code.add(mir::Opcode::Jr, {mir::Reg("ra")});
+        }
+        needed_stack_memory += frame_high_water - frame_start;
         exitScope();
     }
 
+    // -fshrink-wrap and -fomit-frame-pointer: the code generator places the
+    // prologue and epilogue once it knows what the body uses
+    bool prologueDeferred() const {
+        return options.shrink_wrap || options.omit_frame_pointer;
+    }
+
+    // ra only needs a slot when the function makes calls, and without a frame
+    // pointer s0 only when the body allocated it
+    void emitPrologue(mir::Function& code, bool saveReturnAddress, bool saveS0 = true) const {
+        code.add(mir::Opcode::Addi, {mir::Reg("sp"), mir::Reg("sp"), mir::Imm(-frameSize())});
+        if (saveReturnAddress) {
+            code.add(mir::Opcode::Sw, {mir::Reg("ra"), mir::Mem(returnAddressSlot(), "sp")});
+        }
+        if (saveS0) {
+            code.add(mir::Opcode::Sw, {mir::Reg("s0"), mir::Mem(framePointerSlot(), "sp")});
+        }
+        if (!options.omit_frame_pointer) {
+            code.add(mir::Opcode::Mv, {mir::Reg("s0"), mir::Reg("sp")});
+        }
+    }
+
+    // everything but the final jr ra, where frameless exits can join
+    void emitEpilogue(mir::Function& code, bool saveReturnAddress, bool saveS0 = true) const {
+        if (!options.omit_frame_pointer) {
+            code.add(mir::Opcode::Mv, {mir::Reg("sp"), mir::Reg("s0")});
+        }
+        if (saveS0) {
+            code.add(mir::Opcode::Lw, {mir::Reg("s0"), mir::Mem(framePointerSlot(), "sp")});
+        }
+        if (saveReturnAddress) {
+            code.add(mir::Opcode::Lw, {mir::Reg("ra"), mir::Mem(returnAddressSlot(), "sp")});
+        }
+        code.add(mir::Opcode::Addi, {mir::Reg("sp"), mir::Reg("sp"), mir::Imm(frameSize())});
+    }
+
+    // register locals are addressed from: s0, or sp when it stays put
+    std::string frameBase() const {
+        return options.omit_frame_pointer ? "sp" : "s0";
+    }
+
     const std::set<std::string>& getUsedRegisters() const {
         return used_registers;
     }
 
-    std::string getCurrentFunction() const {
+    Symbol getCurrentFunction() const {
         if (current_function_stack.empty()) {
             throw std::runtime_error("Not in a function");
         }
         return current_function_stack.back();
     }
 
-    std::string getFunctionEndLabel(const std::string& function_name) const {
+    // where return statements in the current function jump to
+    void setFunctionEndLabel(Symbol function_name, const std::string& label) {
+        function_end_labels[function_name] = label;
+    }
+
+    // -fshrink-wrap: parameters read straight from the register they arrived in
+    void setIncomingRegister(Symbol id, const std::string& reg) {
+        incoming_registers[id] = reg;
+    }
+
+    void clearIncomingRegisters() {
+        incoming_registers.clear();
+    }
+
+    std::string getFunctionEndLabel(Symbol function_name) const {
         auto it = function_end_labels.find(function_name);
         if (it != function_end_labels.end()) {
             return it->second;
         }
-        throw std::runtime_error("Unknown function end label: " + function_name);
+        throw std::runtime_error("Unknown function end label: " + function_name.str());
     }
 
     void storeFloatValue(float value){
         floatValues.push_back(value);
     }
 
-    void printFloatData(std::ostream& stream){
+    void printFloatData(mir::Function& data){
         for(const auto& [floatValue, label] : float_labels){
-            stream << label << ":" << std::endl;
+            data.addLabel(label);
             uint32_t bits = *(uint32_t*)&floatValue;
-            stream << "    .word " << bits << std::endl;
+            data.addLine("    .word", bits);
         }
     }
 
@@ -246,17 +487,17 @@ public:
         doubleValues.push_back(value);
     }
 
-    void printDoubleData(std::ostream& stream){
-        stream << "    .section    .rodata" << std::endl;
+    void printDoubleData(mir::Function& data){
+        data.addLine("    .section    .rodata");
         for(const auto& [doubleValue, label] : double_labels){
-            stream << label << ":" << std::endl;
+            data.addLabel(label);
             union {
                 double d;
                 uint32_t parts[2];
             } doubleUnion;
             doubleUnion.d = doubleValue;
-            stream << "    .word " << doubleUnion.parts[0] << std::endl;
-            stream << "    .word " << doubleUnion.parts[1] << std::endl;
+            data.addLine("    .word", doubleUnion.parts[0]);
+            data.addLine("    .word", doubleUnion.parts[1]);
         }
     }
 
@@ -264,17 +505,17 @@ public:
         stringValues.push_back(value);
     }
 
-    void printStringData(std::ostream& stream){
+    void printStringData(mir::Function& data){
         for(const auto& [stringValue, label] : string_labels){
-            stream << label << ":" << std::endl;
-            stream << "    .string " << stringValue << std::endl;
+            data.addLabel(label);
+            data.addLine("    .string " + stringValue.str());
         }
     }
 
-    Variable declareVariable(const std::string& id, TypeSpecifier type, bool isPointer = false,
+    Variable declareVariable(Symbol id, TypeSpecifier type, bool isPointer = false,
          TypeSpecifier pointeeType = TypeSpecifier::VOID) {
         if (scopes.back().find(id) != scopes.back().end()) {
-            throw std::runtime_error("Variable '" + id + "' already declared in current scope");
+            throw std::runtime_error("Variable '" + id.str() + "' already declared in current scope");
         }
 
         unsigned int mem_size = getTypeSize(type);
@@ -282,26 +523,20 @@ public:
             mem_size = POINTER_MEM;
         }
 
-        int offset = getMemory(mem_size);
-        std::cerr << "DEBUG: New variable" << std::endl;
+        int offset = slotFor(id, mem_size, getAlignment(type, isPointer));
         Variable newVar(offset, type, false, isPointer, pointeeType);
         scopes.back()[id] = newVar;
         return newVar;
     }
 
-    Variable declareArray(const std::string& id, TypeSpecifier type, int arraySize) {
+    Variable declareArray(Symbol id, TypeSpecifier type, int arraySize) {
         if (scopes.back().find(id) != scopes.back().end()) {
-            throw std::runtime_error("Variable '" + id + "' already declared in current scope");
+            throw std::runtime_error("Variable '" + id.str() + "' already declared in current scope");
         }
         unsigned int elementSize = getTypeSize(type);
         unsigned int totalMem = elementSize*arraySize;
 
-        // align to 4 bytes (int) -> maybe could put a .align assembler directive here too
-        if(totalMem % 4 != 0) {
-            totalMem = ((totalMem + 3) / 4) * 4;
-        }
-
-        int offset = getMemory(totalMem);
+        int offset = slotFor(id, totalMem, getAlignment(type));
 
         Variable newVar(offset, type, false, false);
         newVar.is_array = true;
@@ -312,19 +547,16 @@ public:
         return newVar;
     }
 
-    int declareParameter(const std::string& id, TypeSpecifier type, int param_idx, bool isPointer=false) {
+    int declareParameter(Symbol id, TypeSpecifier type, int param_idx, bool isPointer=false) {
         unsigned int t_size = (isPointer) ? POINTER_MEM : getTypeSize(type);
-        if (t_size % 4 != 0) {
-            t_size = ((t_size + 3) / 4) * 4;
-        }
 
         int offset;
 
         if (param_idx < 8) {
-            offset = getMemory(t_size);
+            offset = getMemory(t_size, getAlignment(type, isPointer));
         } else {
             // if no regs left, params are on stack
-            offset = TOTAL_STACK_SIZE + (param_idx - 8) * 4;
+            offset = frameSize() + (param_idx - 8) * 4;
         }
 
         Variable param(offset, type, true, isPointer);
@@ -340,14 +572,10 @@ public:
     }
 
     void declareUnnamedParameter(TypeSpecifier type) {
-        unsigned int t_size = getTypeSize(type);
-        if (t_size % 4 != 0) {
-            t_size = ((t_size + 3) / 4) *4;
-        }
-        getMemory(t_size);
+        getMemory(getTypeSize(type), getAlignment(type));
     }
 
-    std::optional<Variable> findVariable(const std::string& id) const {
+    std::optional<Variable> findVariable(Symbol id) const {
         if (isGlobal(id)) {
             // find variable in  global scope first
             auto var_it = scopes.front().find(id);
@@ -366,14 +594,14 @@ public:
         return std::nullopt;
     }
 
-    bool variableExists(const std::string& id) const {
+    bool variableExists(Symbol id) const {
         return findVariable(id).has_value();
     }
 
-    TypeSpecifier getType(const std::string& id) const {
+    TypeSpecifier getType(Symbol id) const {
         auto var_opt = findVariable(id);
         if (!var_opt) {
-            throw std::runtime_error("GetType Undefined variable: " + id);
+            throw std::runtime_error("GetType Undefined variable: " + id.str());
         }
         return var_opt->type;
     }
@@ -382,49 +610,85 @@ public:
         return TYPE_SIZE.at(type);
     }
 
-    std::string allocateRegister(const std::set<std::string>& exclude = {}, std::ostream* stream = nullptr) {
+    std::string allocateRegister(const std::set<std::string>& exclude = {}) {
         static const std::vector<std::string> all_registers = {
             "t0", "t1", "t2", "t3", "t4", "t5", "t6",
             "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7"
         };
+        // x10-x15 first: most RVC register forms only encode x8-x15
+        static const std::vector<std::string> compressed_registers = {
+            "a0", "a1", "a2", "a3", "a4", "a5",
+            "t0", "t1", "t2", "t3", "t4", "t5", "t6", "a6", "a7"
+        };
 
-        for (const auto &reg : all_registers) {
+        const auto& order = options.compressed ? compressed_registers : all_registers;
+        std::vector<std::string> candidates = order;
+        if (prefer_high_registers) {
+            std::reverse(candidates.begin(), candidates.end());
+        }
+        if (options.omit_frame_pointer) {
+            // callee-saved: costs a save in the prologue, so it comes last
+            candidates.push_back("s0");
+        }
+        for (const auto &reg : candidates) {
             if ((used_registers.find(reg) == used_registers.end()) &&
                 (exclude.find(reg) == exclude.end())) {
                 used_registers.insert(reg);
-                if (stream != nullptr) {
-                    *stream << "    mv " << reg << ", zero" << std::endl;
-                }
                 return reg;
             }
         }
         throw std::runtime_error("No free registers available");
     }
 
-    std::string allocateFloatingRegister(const std::set<std::string>& exclude = {}, std::ostream* stream = nullptr) {
+    bool hasFreeRegister(const std::set<std::string>& exclude = {}) const {
+        for (const auto& reg : {"t0", "t1", "t2", "t3", "t4", "t5", "t6", "a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7"}) {
+            if (!used_registers.count(reg) && !exclude.count(reg)) {
+                return true;
+            }
+        }
+        return options.omit_frame_pointer && !used_registers.count("s0") && !exclude.count("s0");
+    }
+
+    std::string allocateFloatingRegister(const std::set<std::string>& exclude = {}) {
         static const std::vector<std::string> float_registers = {
             "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7",
             "fa0", "fa1", "fa2", "fa3", "fa4", "fa5", "fa6", "fa7"
         };
+        // f10-f15 first so c.flw/c.fsw/c.fld/c.fsd apply
+        static const std::vector<std::string> compressed_float_registers = {
+            "fa0", "fa1", "fa2", "fa3", "fa4", "fa5",
+            "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7", "fa6", "fa7"
+        };
 
-        for (const auto &reg : float_registers) {
+        for (const auto &reg : options.compressed ? compressed_float_registers : float_registers) {
             if ((used_float_registers.find(reg) == used_float_registers.end()) &&
                 (exclude.find(reg) == exclude.end())) {
                 used_float_registers.insert(reg);
-                if (stream != nullptr) {
-                    // Need a temporary integer register to load 0
-                    std::string temp_reg = allocateRegister(exclude);
-                    *stream << "    mv " << temp_reg << ", zero" << std::endl;
-                    *stream << "    fcvt.s.w " << reg << ", " << temp_reg << std::endl;
-                    freeRegister(temp_reg);
-                }
                 return reg;
             }
         }
         throw std::runtime_error("No free floating-point registers available");
     }
 
+    bool isFloatingRegisterUsed(const std::string& reg) const {
+        return used_float_registers.find(reg) != used_float_registers.end();
+    }
+
+    // mark a specific register (e.g. an outgoing argument) as taken
+    void reserveRegister(const std::string& reg) {
+        used_registers.insert(reg);
+    }
+
+    void reserveFloatingRegister(const std::string& reg) {
+        used_float_registers.insert(reg);
+    }
+
     void freeRegister(const std::string &reg) {
+        // expression results are released without knowing their type
+        if (!reg.empty() && reg[0] == 'f') {
+            used_float_registers.erase(reg);
+            return;
+        }
         used_registers.erase(reg);
     }
 
@@ -432,16 +696,34 @@ public:
         used_float_registers.erase(reg);
     }
 
-    void saveRegisters(std::ostream& stream) {
+    // clobbered, when known, limits the saves to registers the callee may change
+    void saveRegisters(mir::Function& code, const std::set<std::string>* clobbered = nullptr) {
+        auto survives = [&](const std::string& reg) {
+            if (clobbered && !clobbered->count(reg)) {
+                skipped_saves++;
+                return true;
+            }
+            return false;
+        };
+
+        SavedRegisters& saved = saved_register_stack.emplace_back();
+
         // calculate total mem needed then adjust stack pointer
+        std::vector<std::string> integerSaves;
+        std::vector<std::string> floatSaves;
         int totalMem = 0;
         for (const auto& reg : used_registers) {
-            if (reg[0] == 't' || reg[0] == 'a') {
+            if ((reg[0] == 't' || reg[0] == 'a') && !survives(reg)) {
+                integerSaves.push_back(reg);
                 totalMem += 4;
             }
         }
 
         for (const auto& reg : used_float_registers) {
+            if (survives(reg)) {
+                continue;
+            }
+            floatSaves.push_back(reg);
             if (reg.length() > 2 && reg[1] == 'a') {
                 auto funcName = getCurrentFunction();
                 auto returnType = getFunctionReturnType(funcName);
@@ -456,6 +738,19 @@ public:
             }
         }
 
+        if (options.omit_frame_pointer) {
+            // sp stays put: every register has its own slot in the frame
+            for (const auto& reg : integerSaves) {
+                saved.integer[reg] = callSaveSlot(reg);
+                code.add(mir::Opcode::Sw, {mir::Reg(reg), mir::Mem(saved.integer[reg], "sp")});
+            }
+            for (const auto& reg : floatSaves) {
+                saved.floating[reg] = callSaveSlot(reg);
+                code.add(mir::Opcode::Fsd, {mir::Reg(reg), mir::Mem(saved.floating[reg], "sp")});
+            }
+            return;
+        }
+
         // 16 byte align
         if (totalMem % 16 != 0) {
             totalMem = ((totalMem + 15) / 16) * 16;
@@ -463,20 +758,18 @@ public:
 
         // only adjust sp if need register saving
         if (totalMem > 0) {
-            stream << "    addi sp, sp, -" << totalMem << std::endl;
-            last_stack_adjust = totalMem;
+            code.add(mir::Opcode::Addi, {mir::Reg("sp"), mir::Reg("sp"), mir::Imm(-totalMem)});
+            saved.stack_adjust = totalMem;
 
             // Now save registers at known offsets
             int offset = 0;
-            for (const auto& reg : used_registers) {
-                if (reg[0] == 't' || reg[0] == 'a') {
-                    stream << "    sw " << reg << ", " << offset << "(sp)" << std::endl;
-                    saved_registers[reg] = offset;
-                    offset += 4;
-                }
+            for (const auto& reg : integerSaves) {
+                code.add(mir::Opcode::Sw, {mir::Reg(reg), mir::Mem(offset, "sp")});
+                saved.integer[reg] = offset;
+                offset += 4;
             }
             // save floating point regs too
-            for (const auto& reg : used_float_registers) {
+            for (const auto& reg : floatSaves) {
                 bool isDouble = false;
 
                 // check if double precision
@@ -487,27 +780,27 @@ public:
                 }
 
                 if (isDouble) {
-                    stream << "    fsd " << reg << ", " << offset << "(sp)" << std::endl;
-                    saved_float_registers[reg] = offset;
+                    code.add(mir::Opcode::Fsd, {mir::Reg(reg), mir::Mem(offset, "sp")});
+                    saved.floating[reg] = offset;
                     offset += 8;
                 } else {
-                    stream << "    fsw " << reg << ", " << offset << "(sp)" << std::endl;
-                    saved_float_registers[reg] = offset;
+                    code.add(mir::Opcode::Fsw, {mir::Reg(reg), mir::Mem(offset, "sp")});
+                    saved.floating[reg] = offset;
                     offset += 4;
                 }
             }
-        } else {
-            last_stack_adjust = 0;
         }
     }
 
-    void restoreRegisters(std::ostream& stream) {
+    void restoreRegisters(mir::Function& code) {
         // Restore caller-saved registers after function call
-        for (const auto& [reg, offset] : saved_registers) {
-            stream << "    lw " << reg << ", " << offset << "(sp)" << std::endl;
+        SavedRegisters saved = saved_register_stack.back();
+        saved_register_stack.pop_back();
+        for (const auto& [reg, offset] : saved.integer) {
+            code.add(mir::Opcode::Lw, {mir::Reg(reg), mir::Mem(offset, "sp")});
         }
 
-        for (const auto& [reg, offset] : saved_float_registers) {
+        for (const auto& [reg, offset] : saved.floating) {
             bool isDouble = false;
 
             if (reg.length() > 2) {
@@ -516,93 +809,106 @@ public:
                 isDouble = (returnType == TypeSpecifier::DOUBLE);
             }
 
-            if (isDouble) {
-                stream << "    fld " << reg << ", " << offset << "(sp)" << std::endl;
+            if (isDouble || options.omit_frame_pointer) {
+                code.add(mir::Opcode::Fld, {mir::Reg(reg), mir::Mem(offset, "sp")});
             } else {
-                stream << "    flw " << reg << ", " << offset << "(sp)" << std::endl;
+                code.add(mir::Opcode::Flw, {mir::Reg(reg), mir::Mem(offset, "sp")});
             }
         }
 
-        if (last_stack_adjust > 0) {
-            stream << "    addi sp, sp, " << last_stack_adjust << std::endl;
+        if (saved.stack_adjust > 0) {
+            code.add(mir::Opcode::Addi, {mir::Reg("sp"), mir::Reg("sp"), mir::Imm(saved.stack_adjust)});
         }
-        saved_registers.clear();
-        saved_float_registers.clear();
     }
 
 
-    void loadVariable(std::ostream& stream, const std::string& reg, const std::string& id) {
+    void loadVariable(mir::Function& code, const std::string& reg, Symbol id) {
         auto var_opt = findVariable(id);
         if (!var_opt) {
-            throw std::runtime_error("Load Undefined variable: " + id);
+            throw std::runtime_error("Load Undefined variable: " + id.str());
         }
 
         const Variable& var = *var_opt;
 
+        auto incoming = incoming_registers.find(id);
+        if (var.is_parameter && incoming != incoming_registers.end()) {
+            if (var.type == TypeSpecifier::CHAR && !var.is_pointer) {
+                code.add(mir::Opcode::Andi, {mir::Reg(reg), mir::Reg(incoming->second), mir::Imm(255)});
+            } else if (var.type == TypeSpecifier::FLOAT && !var.is_pointer) {
+                code.add(mir::Opcode::FmvS, {mir::Reg(reg), mir::Reg(incoming->second)});
+            } else if (var.type == TypeSpecifier::DOUBLE && !var.is_pointer) {
+                code.add(mir::Opcode::FmvD, {mir::Reg(reg), mir::Reg(incoming->second)});
+            } else {
+                code.add(mir::Opcode::Mv, {mir::Reg(reg), mir::Reg(incoming->second)});
+            }
+            return;
+        }
+
         // different handling for parameters
         if (var.is_parameter && var.is_stack_param) {
-            // load from positive offset relative to s0
+            // above the frame, in the caller's outgoing area: addressed like the
+            // locals, as sp moves while a call's saves are pushed
             if (var.type == TypeSpecifier::CHAR && !var.is_pointer) {
-                stream << "    lbu " << reg << ", " << var.stack_offset << "(sp)" << std::endl;
-            } else if (var.type == TypeSpecifier::FLOAT) {
-                stream << "    flw " << reg << ", " << var.stack_offset << "(sp)" << std::endl;
-            } else if (var.type == TypeSpecifier::DOUBLE) {
-                stream << "    fld " << reg << ", " << var.stack_offset << "(sp)" << std::endl;
+                code.add(mir::Opcode::Lbu, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
+            } else if (var.type == TypeSpecifier::FLOAT && !var.is_pointer) {
+                code.add(mir::Opcode::Flw, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
+            } else if (var.type == TypeSpecifier::DOUBLE && !var.is_pointer) {
+                code.add(mir::Opcode::Fld, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             } else {
-                stream << "    lw " << reg << ", " << var.stack_offset << "(sp)" << std::endl;
+                code.add(mir::Opcode::Lw, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             }
             return;
         }
 
-        if (var.type == TypeSpecifier::FLOAT || var.type == TypeSpecifier::DOUBLE) {
+        if ((var.type == TypeSpecifier::FLOAT || var.type == TypeSpecifier::DOUBLE) && !var.is_pointer) {
             if (var.type == TypeSpecifier::FLOAT) {
-                stream << "    flw " << reg << ", " << var.stack_offset << "(s0)" << std::endl;
+                code.add(mir::Opcode::Flw, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             } else {
-                stream << "    fld " << reg << ", " << var.stack_offset << "(s0)" << std::endl;
+                code.add(mir::Opcode::Fld, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             }
         } else {
             // For integer variables, use lw/lb
             if (var.type == TypeSpecifier::CHAR && !var.is_pointer) {
-                stream << "    lbu " << reg << ", " << var.stack_offset << "(s0)" << std::endl;
+                code.add(mir::Opcode::Lbu, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             } else {
-                stream << "    lw " << reg << ", " << var.stack_offset << "(s0)" << std::endl;
+                code.add(mir::Opcode::Lw, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             }
         }
     }
 
-    void storeVariable(std::ostream& stream, const std::string& reg, const std::string& id) {
+    void storeVariable(mir::Function& code, const std::string& reg, Symbol id) {
         auto var_opt = findVariable(id);
         if (!var_opt) {
-            throw std::runtime_error("Store: Undefined variable: " + id);
+            throw std::runtime_error("Store: Undefined variable: " + id.str());
         }
 
         const Variable& var = *var_opt;
 
         if (var.is_parameter && var.is_stack_param) {
             if (var.type == TypeSpecifier::CHAR && !var.is_pointer) {
-                stream << "    sb " << reg << ", " << var.stack_offset << "(sp)" << std::endl;
-            } else if (var.type == TypeSpecifier::FLOAT || var.type == TypeSpecifier::DOUBLE) {
-                stream << "    fsw " << reg << ", " << var.stack_offset << "(sp)" << std::endl;
+                code.add(mir::Opcode::Sb, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
+            } else if ((var.type == TypeSpecifier::FLOAT || var.type == TypeSpecifier::DOUBLE) && !var.is_pointer) {
+                code.add(mir::Opcode::Fsw, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             } else {
-                stream << "    sw " << reg << ", " << var.stack_offset << "(sp)" << std::endl;
+                code.add(mir::Opcode::Sw, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             }
             return;
         }
 
         // Handle different types
-        if (var.type == TypeSpecifier::FLOAT || var.type == TypeSpecifier::DOUBLE) {
+        if ((var.type == TypeSpecifier::FLOAT || var.type == TypeSpecifier::DOUBLE) && !var.is_pointer) {
             // For floating-point variables, use fsw/fsd
             if (var.type == TypeSpecifier::FLOAT) {
-                stream << "    fsw " << reg << ", " << var.stack_offset << "(s0)" << std::endl;
+                code.add(mir::Opcode::Fsw, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             } else {
-                stream << "    fsd " << reg << ", " << var.stack_offset << "(s0)" << std::endl;
+                code.add(mir::Opcode::Fsd, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             }
         } else {
             // For integer variables, use sw/sb
             if (var.type == TypeSpecifier::CHAR && !var.is_pointer) {
-                stream << "    sb " << reg << ", " << var.stack_offset << "(s0)" << std::endl;
+                code.add(mir::Opcode::Sb, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             } else {
-                stream << "    sw " << reg << ", " << var.stack_offset << "(s0)" << std::endl;
+                code.add(mir::Opcode::Sw, {mir::Reg(reg), mir::Mem(var.stack_offset, frameBase())});
             }
         }
     }
@@ -633,14 +939,14 @@ public:
         return label;
     }
 
-    std::string getStringLabel(std::string value) {
+    std::string getStringLabel(Symbol value) {
         auto it = string_labels.find(value);
         if (it != string_labels.end()) {
             return it->second;
         }
         std::string label = ".SLC_" + std::to_string(string_labels.size() + 1);
         string_labels[value] = label;
-        stringValues.push_back(value);
+        stringValues.push_back(value.str());
         return label;
     }
 
@@ -671,6 +977,8 @@ public:
             continue_targets.pop_back();
         }
     }
+    int getLoopDepth() const { return static_cast<int>(continue_targets.size()); }
+
     std::string getContinueTarget() const {
         if (continue_targets.empty()) {
             return "";
@@ -689,11 +997,11 @@ public:
         }
     }
 
-    bool isEnumValue(const std::string& name) const {
+    bool isEnumValue(Symbol name) const {
         return enumValues.find(name) != enumValues.end();
     }
 
-    int getEnumValue(const std::string& name) const {
+    int getEnumValue(Symbol name) const {
         auto it = enumValues.find(name);
         if (it != enumValues.end()) {
             return it->second.second;
@@ -702,29 +1010,29 @@ public:
         return 0;
     }
 
-    std::string getEnumTypeName(const std::string& valueName) const {
+    std::string getEnumTypeName(Symbol valueName) const {
         auto it = enumValues.find(valueName);
         if (it != enumValues.end()) {
             return it->second.first;
         }
     }
 
-    void setGlobal(const std::string& id) {
+    void setGlobal(Symbol id) {
         if (!functionExists(id)) {
             global_variables[id] = true;
         }
     }
 
-    bool isGlobal(const std::string& id) const {
+    bool isGlobal(Symbol id) const {
         auto it = global_variables.find(id);
         return it != global_variables.end() && it->second;
     }
 
-    void storeArraySize(std::string name, int size){
+    void storeArraySize(Symbol name, int size){
         arraySize[name] = size;
     }
 
-    int findArraySize(const std::string& name) {
+    int findArraySize(Symbol name) {
         auto it = arraySize.find(name);
         if (it != arraySize.end()) {
             return it->second;
@@ -1,7 +1,7 @@
 #pragma once
 #include <iostream>
-#include <memory>
 #include <vector>
+#include "arena.hpp"
 #include "ast_context.hpp"
 
 
@@ -21,20 +21,19 @@ public:
     }
 };
 
-// shared_ptr is just easier for now to copy around
-// probably should change to unique_ptr later
-using NodePtr = std::shared_ptr<Node>;
+// nodes live in the translation unit's Arena, so links are non-owning
+using NodePtr = Node*;
 
 class NodeList : public Node {
 private:
-    std::vector<NodePtr> nodes;
+    ArenaVector<NodePtr> nodes{Arena::CurrentResource()};
 
 public:
     NodeList() = default;
     virtual ~NodeList() = default;
 
     void PushBack(NodePtr node) {
-        nodes.push_back(std::move(node));
+        nodes.push_back(node);
     }
 
     void addAllNodes(const NodeList* otherList) {
@@ -44,7 +43,7 @@ public:
         }
     }
 
-    const std::vector<NodePtr>& getNodes() const {
+    const ArenaVector<NodePtr>& getNodes() const {
         return nodes;
     }
 
@@ -58,7 +57,7 @@ public:
 
     // Access nodes by index
     const Node* at(size_t index) const {
-        return index < nodes.size() ? nodes[index].get() : nullptr;
+        return index < nodes.size() ? nodes[index] : nullptr;
     }
 
     void accept(Visitor& visitor) const override {
@@ -5,6 +5,8 @@
 #include <unordered_map>
 #include <map>
 
+#include "symbol.hpp"
+
 namespace ast {
 
 
@@ -94,15 +96,15 @@ class TypePointer {
 class EnumType {
 private:
     std::string name;
-    std::unordered_map<std::string, int> values;
+    std::unordered_map<Symbol, int> values;
 
 public:
     EnumType(const std::string& name = "") : name(name) {}
 
-    void addValue(const std::string& valueName, int value) {values[valueName] = value;}
-    bool hasValue(const std::string& valueName) const {return values.find(valueName) != values.end();}
+    void addValue(Symbol valueName, int value) {values[valueName] = value;}
+    bool hasValue(Symbol valueName) const {return values.find(valueName) != values.end();}
 
-    int getValue(const std::string& valueName) const {
+    int getValue(Symbol valueName) const {
         auto it = values.find(valueName);
         if (it != values.end()) {
             return it->second;
@@ -110,7 +112,7 @@ public:
     }
 
     const std::string& getName() const { return name; }
-    const std::unordered_map<std::string, int>& getValues() const { return values; }
+    const std::unordered_map<Symbol, int>& getValues() const { return values; }
 };
 
 }
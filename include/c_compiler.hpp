@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+#include "arena.hpp"
+#include "ast_node.hpp"
+#include "compile_options.hpp"
+#include "symbol.hpp"
+
+class SourceBuffer;
+
+// libc_compiler: the compiler without its command line. Everything here works
+// on text in memory; only -fprofile-use reads a file (its profile).
+
+struct CompileStats
+{
+    size_t ast_nodes = 0;
+    size_t arena_bytes = 0;         // nodes, their lists and headers
+    size_t assembly_bytes = 0;
+    double milliseconds = 0;        // parsing and code generation
+};
+
+struct CompileResult
+{
+    bool ok = false;
+    std::string assembly;
+    std::string diagnostics;        // why it failed; empty when ok
+    std::string log;                // the progress report c_compiler prints
+    std::string printed_ast;        // only when the Compiler prints ASTs
+    CompileStats stats;
+};
+
+// Compiles translation units one after another, reusing the memory of the
+// last one for the next: a harness compiling many snippets should keep one
+// Compiler per thread. Never throws for bad input; a failure is reported in
+// the result.
+class Compiler
+{
+public:
+    // source_name only labels diagnostics
+    CompileResult compile(std::string_view source, const CompileOptions& options,
+                          const std::string& source_name = "<source>");
+
+    // the same, scanning a loaded file in place rather than copying its text
+    CompileResult compile(SourceBuffer& source, const CompileOptions& options,
+                          const std::string& source_name = "<source>");
+
+    // also fill CompileResult::printed_ast, as c_compiler writes to <output>.printed
+    void setPrintAst(bool print) { printAst = print; }
+
+private:
+    ast::Arena arena;
+    ast::SymbolTable names;     // the unit's identifiers and strings, forgotten after it
+    bool printAst = false;
+};
+
+// One translation unit with a Compiler of its own.
+CompileResult CompileSource(std::string_view source, const CompileOptions& options,
+                            const std::string& source_name = "<source>");
+
+// The assembly for a parsed tree, written to output, with progress on log.
+// Nodes it makes (-fipa-ra) go to the arena in scope. Throws on errors.
+void GenerateAssembly(const ast::NodePtr& root, std::ostream& output, const CompileOptions& options,
+                      std::ostream& log);
+
+// How much of the assembly the assembler can encode in 16 bits (-march=...c).
+void ReportCompression(std::istream& assembly, std::ostream& log);
@@ -1,12 +1,29 @@
 #pragma once
 
 #include <iostream>
+#include <string>
+#include <vector>
 #include <unistd.h>
 
+#include "compile_options.hpp"
+
 struct CommandLineArguments
 {
-    std::string compile_source_path;
-    std::string compile_output_path;
+    std::vector<std::string> compile_source_paths;  // several with -fwhole-program or in driver mode
+    std::string compile_output_path;                // the output directory in driver mode
+    CompileOptions options;
+
+    // Driver mode: several sources (or a -S @manifest) without -fwhole-program,
+    // each compiled on its own to the matching entry of compile_output_paths.
+    bool driver = false;
+    std::vector<std::string> compile_output_paths;
+    unsigned jobs = 1;                              // -j: translation units compiled at once
+
+    std::string server_socket;                      // --server: serve compile requests here instead
 };
 
 CommandLineArguments ParseCommandLineArgs(int argc, char **argv);
+
+// Applies one -f or -m switch, as written on the command line, returning false
+// if it is not recognised. Used by the compile server for its clients' flags.
+bool ParseOptionFlag(const std::string& flag, CompileOptions& options);
@@ -7,17 +7,27 @@
 #include "Declaration.hpp"
 #include "Expression.hpp"
 #include "Statement.hpp"
+#include "instruction_scheduler.hpp"
+#include "machine_ir.hpp"
 #include <iostream>
 #include <string>
 #include <stack>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <cstdint>
 
 using namespace ast;
 namespace codegen {
 
+class AnalysisVisitor;
+
 class CodeGenVisitor : public Visitor {
 private:
     Context& context;
-    std::ostream& stream;
+    std::ostream& output;
+    mir::Function* code = nullptr;      // where emit() appends: the function, or the part of it being generated
     std::string currentExprResult;
     std::string pendingNextCaseLabel;
 
@@ -43,12 +53,109 @@ private:
 
     std::stack<LoopLabels> loop_label_stack;
 
+    // base register plus the constant part of an address, used as disp(base)
+    struct MemoryOperand {
+        std::string base;
+        mir::Operand displacement = mir::Imm(0);    // a number or %lo(symbol)
+        std::vector<std::string> temps; // registers to free after the access
+
+        mir::Operand address() const { return mir::Mem(displacement, base); }
+    };
+
+    // one register-to-register copy, e.g. an argument into a0
+    struct RegisterMove {
+        std::string dest;
+        std::string source;
+        mir::Opcode opcode; // mv, fmv.s or fmv.d
+    };
+
+    // -march=...v: a counted loop matched for strip-mined RVV code
+    struct VectorLoop {
+        Symbol index;
+        const Expression* bound = nullptr;
+        bool inclusive = false;                 // i <= n rather than i < n
+        TypeSpecifier type = TypeSpecifier::INT;
+        const Expression* value = nullptr;      // evaluated once per element
+        Symbol dest;                            // stored array, empty for reductions
+        Symbol reduction;                       // summed scalar, empty for stores
+        bool compound = false;                  // a[i] op= value
+        BinaryOp::Type compoundOp = BinaryOp::Type::ADD;
+        std::vector<Symbol> arrays;             // every array referenced
+        std::unordered_map<Symbol, std::string> pointers;           // array -> address of element i
+        std::unordered_map<Symbol, std::string> loaded;             // array -> vector register
+        std::unordered_map<const Expression*, std::string> scalars; // invariant leaf -> register
+        int vectorRegs = 0;
+        int nextVector = 2;
+    };
+    enum class VectorOperand { None, Scalar, Vector };
+
+    // -march=..._zbb: a loop that does nothing but count the bits of one variable
+    struct BitCountLoop {
+        Symbol value;               // x, zero once the loop has run
+        Symbol counter;             // n, increased by the iteration count
+        mir::Opcode opcode = mir::Opcode::Cpop;    // cpop, clz or ctz
+        bool fromWidth = false;     // iterations are 32 - clz/ctz rather than the count itself
+        bool shiftsRight = false;   // x >>= 1 never reaches zero for a negative x
+    };
+
+    // -ffast-math: divisor name -> hidden stack slot holding its reciprocal
+    std::unordered_map<Symbol, Symbol> hoistedReciprocals;
+    std::unordered_set<Symbol> functionAddressTaken;
+
+    // -fprofile-generate/-fprofile-use: block 0 is the function entry; the n-th branch
+    // statement of a function owns blocks 2n+1 (entered) and 2n+2 (loop body or then arm)
+    std::unordered_map<const Node*, int> profileBlocks;
+    std::unordered_map<const Node*, std::string> profiledCaseLabels;    // case -> label jumped to by the dispatch
+
+    // where an if statement's arms are placed relative to its condition
+    enum class BranchLayout { Source, ElseFirst, ThenOutOfLine, ElseOutOfLine };
+    std::vector<mir::Function> coldBlocks;  // out-of-line code, placed after the function epilogue
+    int coldDepth = 0;                      // > 0 while generating out-of-line code
+
+    // -freorder-functions: each function's code, emitted in call-graph order at the end
+    std::vector<mir::Function> emittedFunctions;
+    std::unordered_map<std::string, std::unordered_map<std::string, uint64_t>> callWeights;    // caller -> callee -> weight
+
+    // -fipa-ra: caller-saved registers each compiled function may clobber, and the
+    // functions whose integer arguments past the eighth travel in t3-t6
+    std::unordered_map<std::string, std::set<std::string>> clobberedRegisters;
+    std::set<std::string> registerArgumentFunctions;
+    static const int EXTRA_ARGUMENT_REGISTERS = 4;
+
+    // -fschedule-insns: totals over every function scheduled so far
+    ScheduleReport scheduled;
+
+    // -fshrink-wrap: leading guard clauses of a function body run before its frame exists,
+    // reading the parameters from the registers they arrived in
+    struct EntryRegion {
+        const CompoundStatement* body = nullptr;    // set while the entry code is being emitted
+        mir::Function* frameCode = nullptr;         // where code goes once the frame is up
+        std::string returnLabel;                    // restored over the early-exit label
+        bool keepIncoming = false;                  // leaf functions read parameters from registers throughout
+    };
+    EntryRegion entryRegion;
+    std::vector<std::string> incomingRegisters;
+
+    bool isGuardClause(const Statement* stmt) const;
+    void planBlockLocals(const CompoundStatement& stmt);
+    void openFrame();
+    void releaseIncomingRegisters();
+
+    static const char* const COLD_TEXT_SECTION;
+
 public:
-    CodeGenVisitor(Context& ctx, std::ostream& output)
-        : context(ctx), stream(output) {}
+    CodeGenVisitor(Context& ctx, std::ostream& out)
+        : context(ctx), output(out) {}
 
     std::string getExpressionResult() const;
 
+    // writes functions held back by -freorder-functions; call once the whole unit is visited
+    void finishTranslationUnit();
+
+    void setRegisterArgumentFunctions(const std::set<std::string>& functions) { registerArgumentFunctions = functions; }
+    size_t summarisedFunctionCount() const { return clobberedRegisters.size(); }
+    const ScheduleReport& scheduleReport() const { return scheduled; }
+
     void visitVariableDeclaration(const VariableDeclaration& decl) override;
     void visitFunctionDeclaration(const FunctionDeclaration& decl) override;
 
@@ -100,6 +207,66 @@ public:
 
     // helper
     void initArray(const ast::VariableDeclaration& decl);
+    void emit(mir::Opcode opcode, std::initializer_list<mir::Operand> operands);
+    void emit(const std::string& mnemonic, std::initializer_list<mir::Operand> operands);   // e.g. vector instructions
+
+    // address generation with constant offsets folded into the load/store immediate
+    MemoryOperand emitElementAddress(const ast::ArrayAccessExpression& expr, const std::set<std::string>& exclude);
+    MemoryOperand emitPointerAddress(const Expression* addrExpr, const std::set<std::string>& exclude);
+    void emitScaledAdd(const std::string& dest, const std::string& base, const std::string& index, int elementSize, const std::set<std::string>& exclude);
+    TypeSpecifier getPointeeType(const Expression* addrExpr) const;
+    static mir::Opcode loadOpcode(TypeSpecifier type);
+    static mir::Opcode storeOpcode(TypeSpecifier type);
+    void releaseOperand(const MemoryOperand& operand);
+
+    // performs all moves as if simultaneously, breaking cycles with a scratch register
+    void emitRegisterMoves(std::vector<RegisterMove> moves);
+
+    // type of an expression using the variables currently in scope
+    TypeSpecifier inferType(const Expression* expr) const;
+
+    // floating point rewrites, each returns false if it does not apply
+    bool emitReciprocalDivision(const ast::BinaryExpression& expr);
+    bool emitReassociatedChain(const ast::BinaryExpression& expr);
+    bool emitSelfComparison(const ast::BinaryExpression& expr);
+    bool emitInvertedComparison(const ast::UnaryExpression& expr);
+    bool emitReductionLoop(const ast::ForStatement& stmt);
+    void emitAccumulate(const Expression* expr, const std::string& accReg, TypeSpecifier type);
+    std::vector<Symbol> hoistInvariantDivisors(const Node& loop);
+
+    // auto-vectorisation, falls back to emitForLoop when a loop does not match
+    void emitForLoop(const ast::ForStatement& stmt, bool withInit);
+    bool emitVectorLoop(const ast::ForStatement& stmt);
+    bool matchVectorLoop(const ast::ForStatement& stmt, VectorLoop& loop);
+    VectorOperand classifyVectorOperand(const Expression* expr, VectorLoop& loop, const AnalysisVisitor& bodyInfo);
+    std::string emitVectorOperand(const Expression* expr, VectorLoop& loop);
+    std::string emitVectorBinary(BinaryOp::Type op, const std::string& lhs, const std::string& rhs, VectorLoop& loop);
+    void emitArrayBase(Symbol name, const std::string& reg);
+    void dropInvariantDivisors(const std::vector<Symbol>& names);
+
+    // Zbb instruction selection, each returns false if it does not apply
+    bool isSimpleIntOperand(const Expression* expr) const;
+    bool isLocalIntVariable(const Expression* expr) const;
+    bool emitBitManipulation(const ast::BinaryExpression& expr);
+    bool emitMinMax(const ast::ConditionalExpression& expr);
+    bool matchBitCountLoop(const Expression* condition, const Node* body, const Expression* increment, BitCountLoop& loop);
+    bool emitBitCountLoop(const Node* init, const Expression* condition, const Node* body, const Expression* increment);
+
+    // profile instrumentation and feedback
+    int profileBlock(const Node& stmt) const;
+    void emitProfileCounter(int block);
+    std::optional<uint64_t> profileCount(int block) const;
+    bool emitProfiledSwitch(const ast::SwitchStatement& stmt, const std::string& valueReg, const std::string& endLabel);
+
+    // block placement from profile counts or static guesses
+    bool isColdPath(const Node* arm) const;
+    BranchLayout chooseIfLayout(const ast::IfStatement& stmt, int block) const;
+    void emitOutOfLine(const Node* arm, const std::string& label, const std::string& resumeLabel, int block);
+    void emitRotatedWhileLoop(const ast::WhileStatement& stmt, int block);
+
+    // function placement
+    bool isColdFunction(const std::string& name) const;
+    void noteCall(const std::string& callee);
 };
 
 } //namespace codegen
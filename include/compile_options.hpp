@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+
+// Cycle counts the instruction scheduler plans around (-mtune=<core>, -mlatency=...).
+// The defaults describe a generic single-issue in-order core.
+struct MachineModel
+{
+    int issueWidth = 1;
+    int loadLatency = 2;    // load to first use
+    int mulLatency = 3;
+    int divLatency = 20;    // div/rem
+    int fpAddLatency = 4;   // fadd/fsub/fmin/fmax
+    int fpMulLatency = 4;   // fmul and fused multiply-add
+    int fpDivLatency = 20;  // fdiv/fsqrt
+    int fpMoveLatency = 2;  // conversions, compares and moves between register files
+};
+
+// Code generation switches set from the command line (-f<flag> / -m<flag>).
+// Everything defaults to the plain, strictly conforming behaviour.
+struct CompileOptions
+{
+    // -ffast-math: allow FP reassociation, reciprocal division and assume no NaNs/infinities
+    bool fast_math = false;
+
+    // -march=rv32...c: RVC is available, so prefer x8-x15 and short immediates
+    bool compressed = false;
+
+    // -march=rv32...v: vectorise simple counted loops with RVV
+    bool vector = false;
+
+    // -march=rv32..._zba_zbb: shift-and-add addressing and the basic bit-manipulation ops
+    bool zba = false;
+    bool zbb = false;
+
+    // -freorder-blocks: rotate while loops and move cold if arms out of line
+    bool reorder_blocks = false;
+
+    // -freorder-blocks-and-partition: also put cold arms, and functions the profile never saw run, in .text.unlikely
+    bool partition_cold = false;
+
+    // -freorder-functions: emit functions in call-graph order (Pettis-Hansen) rather than source order
+    bool reorder_functions = false;
+
+    // -fschedule-insns: reorder each basic block for the machine model below
+    bool schedule = false;
+    MachineModel machine;
+
+    // -fwhole-program: compile every -S source as one program into a single output
+    bool whole_program = false;
+
+    // -fipa-ra: compile callees first and save around a call only what the callee clobbers
+    bool ipa_ra = false;
+
+    // -fshrink-wrap: no frame for leaf functions that need none, leading early exits run before the prologue
+    bool shrink_wrap = false;
+
+    // -fomit-frame-pointer: address the frame from a fixed sp and allocate s0 like any other register
+    bool omit_frame_pointer = false;
+
+    // -fstack-reuse=all: locals of blocks that are never open together share frame slots
+    bool stack_reuse = false;
+
+    // -fprofile-generate[=<file>]: count block executions and append them to the file at exit
+    std::string profile_generate;
+
+    // -fprofile-use[=<file>]: lay out branches and switches using counts from an instrumented run
+    std::string profile_use;
+};
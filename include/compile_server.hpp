@@ -0,0 +1,21 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "server_protocol.hpp"
+
+// Compiles one request. Called on the worker thread serving it; worker threads
+// live as long as the server, so thread-local state stays warm between requests.
+using CompileHandler = std::function<CompileResponse(const CompileRequest& request)>;
+
+// A connection idle this long, waiting on either a request or the client
+// reading its response, is closed so its worker can take another.
+constexpr int CONNECTION_IDLE_SECONDS = 30;
+
+// c_compiler --server: listens on a Unix socket at socket_path (replacing a
+// stale socket, never any other file) and answers compile requests on that
+// many worker threads until the process is killed. Each worker accepts
+// connections itself and serves every request on one before taking the next.
+// Throws if the socket cannot be set up.
+void RunCompileServer(const std::string& socket_path, unsigned workers, const CompileHandler& handler);
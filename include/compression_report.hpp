@@ -0,0 +1,17 @@
+#pragma once
+
+#include <istream>
+
+// Static estimate of how much of an assembly listing the assembler can encode
+// with 16-bit RVC instructions. Pseudo-instructions that expand to two
+// instructions (call, la, large li, symbolic loads) count as two 32-bit ones.
+struct CompressionReport
+{
+    int instructions = 0;
+    int compressed = 0;
+
+    int bytes() const { return 2 * compressed + 4 * (instructions - compressed); }
+    int uncompressedBytes() const { return 4 * instructions; }
+};
+
+CompressionReport MeasureCompression(std::istream& assembly);
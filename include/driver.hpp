@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// How one job of RunJobs went.
+struct JobResult
+{
+    bool ok = false;
+    std::string error;          // what the job threw, when it failed
+    double milliseconds = 0;    // wall time the job ran for
+};
+
+// Runs job(i) for every i < count on up to threads worker threads, each
+// worker taking the next job nobody has started. A job fails by throwing.
+// finished(i, result) is called as each job ends, never two at a time, so it
+// may print without interleaving. Results are returned in job order.
+std::vector<JobResult> RunJobs(size_t count, unsigned threads, const std::function<void(size_t)>& job,
+                               const std::function<void(size_t, const JobResult&)>& finished);
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A function of the translation unit as seen by the function orderer.
+struct FunctionNode
+{
+    std::string name;
+    size_t size = 0;                                    // lines of assembly
+    uint64_t heat = 0;                                  // entry count or static estimate
+    std::unordered_map<std::string, uint64_t> calls;    // callee -> weight of the call sites
+};
+
+// Pettis–Hansen ordering: call graph edges are merged heaviest first into
+// chains, each merge picking the orientation that puts caller and callee
+// closest together. Chains come out hottest first, ties in source order.
+// Returns indices into functions.
+std::vector<size_t> OrderFunctions(const std::vector<FunctionNode>& functions);
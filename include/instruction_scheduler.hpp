@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "compile_options.hpp"
+#include "machine_ir.hpp"
+
+// Totals over every basic block scheduled, with cycle counts estimated
+// from the machine model for the original and the scheduled order.
+struct ScheduleReport
+{
+    int blocks = 0;
+    int instructions = 0;
+    int cyclesBefore = 0;
+    int cyclesAfter = 0;
+};
+
+// List-schedules each basic block of a function so that independent
+// instructions fill load-use, multiply/divide and FP latency gaps, adding to
+// report. Branches, calls, CSR access and opcodes the machine IR does not
+// know (vector, atomics) stay where they are and split the block.
+void ScheduleFunction(mir::Function& function, const MachineModel& model, ScheduleReport& report);
+
+// Fills in the latencies of a named core, returning false if it is not known.
+bool LookupMachineModel(const std::string& name, MachineModel& model);
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Machine instructions between the code generator and the assembly text.
+// Each function the code generator finishes is held as typed instructions in
+// basic blocks; the passes that read or move code (register usage,
+// scheduling, function ordering) work on these, and Print() writes the
+// assembly as the last step.
+namespace mir {
+
+// Every instruction and pseudo-instruction the code generator emits.
+// Anything else is kept by name as Other and never moved.
+enum class Opcode {
+    // RV32I
+    Lui, Auipc, Addi, Slti, Sltiu, Xori, Ori, Andi, Slli, Srli, Srai,
+    Add, Sub, Sll, Slt, Sltu, Xor, Srl, Sra, Or, And,
+    Lb, Lh, Lw, Lbu, Lhu, Sb, Sh, Sw,
+    Beq, Bne, Blt, Bge, Bltu, Bgeu,
+    Jal, Jalr, Ecall, Ebreak, Fence,
+    // M
+    Mul, Mulh, Mulhsu, Mulhu, Div, Divu, Rem, Remu,
+    // F and D
+    Flw, Fsw, Fld, Fsd,
+    FaddS, FsubS, FmulS, FdivS, FsqrtS, FminS, FmaxS,
+    FmaddS, FmsubS, FnmaddS, FnmsubS,
+    FaddD, FsubD, FmulD, FdivD, FsqrtD, FminD, FmaxD,
+    FmaddD, FmsubD, FnmaddD, FnmsubD,
+    FsgnjS, FsgnjnS, FsgnjxS, FsgnjD, FsgnjnD, FsgnjxD,
+    FeqS, FltS, FleS, FeqD, FltD, FleD,
+    FcvtWS, FcvtWuS, FcvtSW, FcvtSWu, FcvtWD, FcvtWuD, FcvtDW, FcvtDWu, FcvtSD, FcvtDS,
+    FmvXW, FmvWX, FclassS, FclassD,
+    // Zicsr
+    Csrr, Csrw, Csrrw, Csrrs, Csrrc, Frcsr, Fscsr, Frrm, Fsrm, Frflags, Fsflags,
+    // Zba and Zbb
+    Sh1add, Sh2add, Sh3add,
+    Andn, Orn, Xnor, Clz, Ctz, Cpop, Min, Max, Minu, Maxu, SextB, SextH, ZextH, Rol, Ror, Rori, Rev8, OrcB,
+    // pseudo-instructions
+    Nop, Li, La, Lla, Mv, Not, Neg, Seqz, Snez, Sltz, Sgtz, Sgt, Sgtu,
+    Beqz, Bnez, Blez, Bgez, Bltz, Bgtz, Bgt, Ble, Bgtu, Bleu,
+    J, Jr, Ret, Call, Tail,
+    FmvS, FnegS, FabsS, FgtS, FgeS, FmvD, FnegD, FabsD, FgtD, FgeD,
+    Other
+};
+
+// What an opcode does, as far as the passes care.
+enum class Unit {
+    Integer,
+    Multiply,
+    Divide,         // div and rem
+    Load,
+    Store,
+    FloatMove,      // conversions, compares, sign injection and moves between register files
+    FloatAdd,       // fadd, fsub, fmin, fmax
+    FloatMultiply,  // fmul and fused multiply-add
+    FloatDivide,    // fdiv, fsqrt
+    Control,        // branches, jumps, calls and returns
+    System          // CSR access, fences, environment calls, and Other
+};
+
+struct OpcodeInfo
+{
+    Opcode opcode;
+    const char* mnemonic;
+    Unit unit;
+    int accessSize;     // bytes a load or store moves, else 0
+
+    // the first operand is written; false for stores, control flow and system instructions
+    bool definesFirst() const { return unit != Unit::Store && unit != Unit::Control && unit != Unit::System; }
+};
+
+const OpcodeInfo& Info(Opcode opcode);
+
+enum class Relocation { None, Hi, Lo };
+
+struct Operand
+{
+    enum class Kind { Register, Immediate, Symbol, Relocation, Memory };
+
+    Kind kind = Kind::Symbol;
+    std::string reg;            // Register, or the base of Memory
+    std::string symbol;         // Symbol (a label, or anything not otherwise understood) and Relocation,
+                                // or a Memory offset that is not a number, e.g. %lo(symbol)
+    Relocation relocation = Relocation::None;   // of Relocation, or of a Memory offset
+    int64_t value = 0;          // Immediate, or a numeric Memory offset
+    bool hasOffset = true;      // Memory: false for (base) with no offset written
+
+    bool isRegister() const { return kind == Kind::Register; }
+    bool empty() const { return kind == Kind::Symbol && symbol.empty(); }
+};
+
+Operand Reg(std::string name);
+Operand Imm(int64_t value);
+Operand Sym(std::string name);
+Operand Hi(std::string symbol);                         // %hi(symbol)
+Operand Lo(std::string symbol);                         // %lo(symbol)
+Operand Mem(int64_t offset, std::string base);          // offset(base)
+Operand Mem(const Operand& offset, std::string base);   // %lo(symbol)(base)
+Operand Mem(std::string base);                          // (base), as vector loads and stores take it
+
+struct Instruction
+{
+    Opcode opcode = Opcode::Other;
+    std::string name;           // the mnemonic of Other
+    std::vector<Operand> operands;
+
+    Instruction() = default;
+    Instruction(Opcode opcode, std::initializer_list<Operand> operands);
+    // Other, e.g. a vector instruction
+    Instruction(std::string name, std::initializer_list<Operand> operands);
+
+    const OpcodeInfo& info() const { return Info(opcode); }
+    std::string_view mnemonic() const { return opcode == Opcode::Other ? std::string_view(name) : info().mnemonic; }
+
+    // registers read and written, fp spelled s0 and zero left out
+    std::vector<std::string> defs() const;
+    std::vector<std::string> uses() const;
+};
+
+// Straight-line code: the labels and directives that open it, kept as
+// written, then instructions up to the first branch, jump, call or return.
+struct BasicBlock
+{
+    std::vector<std::string> header;
+    std::vector<Instruction> instructions;
+};
+
+// Code is added in program order: an instruction after a branch, jump, call
+// or return starts a new block, and so does a label or directive after code.
+struct Function
+{
+    std::string name;
+    std::vector<BasicBlock> blocks;
+
+    void add(Instruction insn);
+    void add(Opcode opcode, std::initializer_list<Operand> operands) { add(Instruction(opcode, operands)); }
+    void addLine(std::string line);         // a directive, kept as written
+    void addLine(std::string_view directive, int64_t value);   // e.g. "    .word" and 5
+    void addLabel(std::string_view label);
+    void append(const Function& code);      // code generated apart, in the same way
+
+    size_t lineCount() const;
+};
+
+void Print(const Function& function, std::ostream& output);
+
+// Compact text appended in place: registers and labels as written, numbers
+// through std::to_chars, an instruction as its line without the newline.
+void Append(std::string& text, int64_t value);
+void Append(std::string& text, const Operand& operand);
+void Append(std::string& text, const Instruction& insn);
+
+// an instruction line without its newline, e.g. "    lw a0, 8(sp)"
+std::ostream& operator<<(std::ostream& output, const Instruction& insn);
+std::ostream& operator<<(std::ostream& output, const Operand& operand);
+
+} // namespace mir
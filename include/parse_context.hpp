@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "ast_node.hpp"
+#include "ast_type_specifier.hpp"
+#include "symbol.hpp"
+
+// Everything one parse owns, so several files can be parsed on different
+// threads at once: the reentrant scanner holds it as its extra data and the
+// pure parser takes it as a parameter. Nodes still come from the Arena the
+// parse has in scope.
+struct ParseContext
+{
+    ast::NodePtr root = nullptr;
+    std::string error;      // the lexing or syntax error that stopped the parse
+
+    // names declared by typedef so far; the scanner returns them as TYPE_NAME
+    std::unordered_map<ast::Symbol, ast::TypeSpecifier> typeDefs;
+
+    void updateTypeDefs(ast::Symbol id, ast::TypeSpecifier type) {
+        typeDefs[id] = type;
+    }
+
+    ast::TypeSpecifier getTypeDefType(ast::Symbol id) {
+        return typeDefs[id];
+    }
+};
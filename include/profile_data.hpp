@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "machine_ir.hpp"
+
+// Profile written by -fprofile-generate when none is named on the command line.
+constexpr const char* DEFAULT_PROFILE_PATH = "default.profile";
+
+// Block execution counts from an instrumented run. Each line of a profile is
+// "<function> <block> <count>"; an entry that appears more than once (several
+// runs appending to the same file) is summed.
+class ProfileData
+{
+public:
+    // throws std::runtime_error if the file cannot be read or is malformed
+    static ProfileData Load(const std::string& path);
+
+    std::optional<uint64_t> count(const std::string& function, int block) const;
+    bool hasFunction(const std::string& function) const { return counts.count(function) > 0; }
+    size_t functionCount() const { return counts.size(); }
+
+private:
+    std::unordered_map<std::string, std::unordered_map<int, uint64_t>> counts;
+};
+
+// Adds the counter table for an instrumented translation unit to code, together with a
+// constructor that registers an atexit handler appending every counter to path.
+// counters[i] names 64-bit counter i as "<function> <block>".
+void EmitProfileRuntime(mir::Function& code, const std::vector<std::string>& counters, const std::string& path);
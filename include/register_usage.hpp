@@ -0,0 +1,17 @@
+#pragma once
+
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "machine_ir.hpp"
+
+// Caller-saved registers (t*, a*, ft*, fa*) clobbered by function: every one
+// it names, ra for each call and t1 for each tail call (the registers the
+// assembler expands them through), plus those clobbered by each function it
+// calls. known maps the functions already summarised to their sets. A call to
+// anything else, or an indirect call, returns nullopt: the callee may then
+// clobber every caller-saved register, as the ABI assumes.
+std::optional<std::set<std::string>> ClobberedRegisters(const mir::Function& function,
+    const std::unordered_map<std::string, std::set<std::string>>& known);
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// What the compile server and its client say to each other over a Unix
+// socket. Header-only so the client binary needs nothing else from the
+// compiler. A message is a count followed by that many length-prefixed
+// strings, in host byte order since both ends are on the same machine.
+
+constexpr const char* DEFAULT_SERVER_SOCKET = "/tmp/c_compiler.sock";
+
+struct CompileRequest
+{
+    std::string source_name;            // for diagnostics only
+    std::string source_text;
+    std::vector<std::string> flags;     // -f and -m switches, as on the command line
+};
+
+struct CompileResponse
+{
+    bool ok = false;
+    std::string assembly;
+    std::string log;                    // what c_compiler would have printed, then the error if any
+};
+
+namespace protocol {
+
+// A message past either limit is treated as a broken connection, so a bad
+// length prefix cannot make the receiver allocate gigabytes.
+constexpr uint32_t MAX_MESSAGE_FIELDS = 1024;
+constexpr uint64_t MAX_MESSAGE_BYTES = 256u << 20;
+
+inline bool SendAll(int fd, const void* data, size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0)
+    {
+        ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (sent <= 0)
+        {
+            return false;
+        }
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+inline bool ReceiveAll(int fd, void* data, size_t size)
+{
+    char* bytes = static_cast<char*>(data);
+    while (size > 0)
+    {
+        ssize_t got = recv(fd, bytes, size, 0);
+        if (got <= 0)
+        {
+            return false;
+        }
+        bytes += got;
+        size -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+inline bool SendMessage(int fd, const std::vector<std::string>& fields)
+{
+    std::string message;
+    auto put = [&message](uint32_t value) { message.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+    put(static_cast<uint32_t>(fields.size()));
+    for (const auto& field : fields)
+    {
+        put(static_cast<uint32_t>(field.size()));
+        message += field;
+    }
+    return SendAll(fd, message.data(), message.size());
+}
+
+// false on end of stream, a broken message, or one over the limits above
+inline bool ReceiveMessage(int fd, std::vector<std::string>& fields)
+{
+    uint32_t count;
+    if (!ReceiveAll(fd, &count, sizeof(count)) || count > MAX_MESSAGE_FIELDS)
+    {
+        return false;
+    }
+    fields.assign(count, std::string());
+    uint64_t total = 0;
+    for (auto& field : fields)
+    {
+        uint32_t size;
+        if (!ReceiveAll(fd, &size, sizeof(size)))
+        {
+            return false;
+        }
+        total += size;
+        if (total > MAX_MESSAGE_BYTES)
+        {
+            return false;
+        }
+        field.resize(size);
+        if (size > 0 && !ReceiveAll(fd, field.data(), size))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool SendRequest(int fd, const CompileRequest& request)
+{
+    std::vector<std::string> fields = {request.source_name, request.source_text};
+    fields.insert(fields.end(), request.flags.begin(), request.flags.end());
+    return SendMessage(fd, fields);
+}
+
+inline bool ReceiveRequest(int fd, CompileRequest& request)
+{
+    std::vector<std::string> fields;
+    if (!ReceiveMessage(fd, fields) || fields.size() < 2)
+    {
+        return false;
+    }
+    request.source_name = std::move(fields[0]);
+    request.source_text = std::move(fields[1]);
+    request.flags.assign(std::make_move_iterator(fields.begin() + 2), std::make_move_iterator(fields.end()));
+    return true;
+}
+
+inline bool SendResponse(int fd, const CompileResponse& response)
+{
+    return SendMessage(fd, {response.ok ? "ok" : "error", response.assembly, response.log});
+}
+
+inline bool ReceiveResponse(int fd, CompileResponse& response)
+{
+    std::vector<std::string> fields;
+    if (!ReceiveMessage(fd, fields) || fields.size() != 3)
+    {
+        return false;
+    }
+    response.ok = fields[0] == "ok";
+    response.assembly = std::move(fields[1]);
+    response.log = std::move(fields[2]);
+    return true;
+}
+
+} // namespace protocol
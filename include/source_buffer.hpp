@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// The whole text of a regular source file, memory-mapped (or, where mapping
+// fails, read in one go) and followed by the two NUL bytes flex's
+// yy_scan_buffer needs to scan it in place. Token text then points straight
+// into the buffer. Private copy-on-write mapping: flex briefly writes a NUL
+// after each token, and that must never reach the file.
+class SourceBuffer
+{
+public:
+    // nullopt when path is "-" or names a pipe, terminal or anything else
+    // that is not a regular file, or cannot be opened; those are streamed.
+    static std::optional<SourceBuffer> Load(const std::string& path);
+
+    // a copy of text that arrived some other way, e.g. from a compile server client
+    static SourceBuffer FromText(std::string_view text);
+
+    SourceBuffer(SourceBuffer&& other) noexcept;
+    SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+    ~SourceBuffer();
+
+    std::string_view text() const { return {bytes, length}; }
+
+    // the text and its two terminating NULs, as handed to yy_scan_buffer
+    char* scanBuffer() { return bytes; }
+    size_t scanBufferSize() const { return length + 2; }
+
+    bool isMapped() const { return mapping_size > 0; }
+
+private:
+    SourceBuffer() = default;
+
+    char* bytes = nullptr;
+    size_t length = 0;
+    size_t mapping_size = 0;    // 0 when the text was read into copy
+    std::vector<char> copy;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace ast {
+
+class SymbolTable;
+
+// A name interned in the current SymbolTable: identifiers and string literals
+// are interned once by the lexer, so equal names share an id and maps keyed by
+// Symbol hash an integer rather than the text. Id 0 is the empty name.
+// Interning may run on several threads; the text of a symbol never moves.
+class Symbol
+{
+public:
+    using Id = uint32_t;
+
+    Symbol() = default;
+    explicit Symbol(const std::string& text) : id_(Intern(text).id_) {}
+    explicit Symbol(const char* text) : id_(Intern(text).id_) {}
+
+    static Symbol Intern(std::string_view text);
+    static Symbol FromId(Id id);
+
+    // distinct names interned so far, the empty one included
+    static size_t Count();
+
+    Id id() const { return id_; }
+    const std::string& str() const;
+    bool empty() const { return id_ == 0; }
+
+    bool operator==(const Symbol& other) const { return id_ == other.id_; }
+    bool operator!=(const Symbol& other) const { return id_ != other.id_; }
+
+    // Makes a table the one names are interned in and read from on this
+    // thread while in scope, restoring the previous one after. Outside any
+    // scope that is the process-wide table, which is never emptied.
+    class Scope
+    {
+    public:
+        explicit Scope(SymbolTable& table);
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        SymbolTable* previous;
+    };
+
+private:
+    static SymbolTable& CurrentTable();
+
+    Id id_ = 0;
+};
+
+// Names of one compile's own. A Compiler keeps one, so a resident compile
+// server does not hold every name any request ever used. A Symbol only means
+// something in the table it was interned in.
+class SymbolTable
+{
+public:
+    SymbolTable();
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+    ~SymbolTable();
+
+    // Forgets every name but keeps the memory, so the next compile interns
+    // into strings it has already allocated. No Symbol from before may be
+    // used after.
+    void reset();
+
+private:
+    friend class Symbol;
+    struct Names;
+    std::unique_ptr<Names> names;
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const Symbol& symbol)
+{
+    return stream << symbol.str();
+}
+
+} // namespace ast
+
+template <>
+struct std::hash<ast::Symbol>
+{
+    size_t operator()(const ast::Symbol& symbol) const noexcept { return symbol.id(); }
+};
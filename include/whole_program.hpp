@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ast_node.hpp"
+
+// One parsed source file of a -fwhole-program build.
+struct SourceUnit
+{
+    std::string path;
+    std::unique_ptr<ast::Arena> arena;  // owns the nodes under root
+    ast::NodePtr root;
+};
+
+struct LinkReport
+{
+    int removedFunctions = 0;
+    int removedGlobals = 0;
+};
+
+// Joins the top-level declarations of every unit into a single tree, so one
+// Context sees (and pools constants and strings for) the whole program.
+// A function or global defined in more than one unit is an error. When the
+// program defines main, functions and globals that nothing reachable from
+// main refers to are dropped.
+ast::NodePtr LinkProgram(const std::vector<SourceUnit>& units, LinkReport& report);
+
+// -fipa-ra: the same declarations with function definitions moved after
+// everything else and ordered callees first (depth-first from each function
+// in source order), so a call is usually compiled after its target. Functions
+// only ever called directly, by name, and taking no floating-point parameters
+// are added to registerArguments: every caller is in the tree, so they may
+// take integer arguments past the eighth in t3-t6 instead of on the stack.
+// Only meaningful for -fwhole-program trees; main is never included.
+ast::NodePtr OrderCalleesFirst(const ast::NodePtr& root, std::set<std::string>& registerArguments);
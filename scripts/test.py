@@ -177,6 +177,17 @@ class ProgressBar:
             self.failed += 1
         self.update()
 
+def test_flags(to_assemble: Path) -> List[str]:
+    """
+    Compiler flags a testcase asks for with a "/* FLAGS: ... */" line.
+    """
+    with open(to_assemble, "r") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("/* FLAGS:") and line.endswith("*/"):
+                return line[len("/* FLAGS:"):-len("*/")].split()
+    return []
+
 def run_test(driver: Path) -> Result:
     """
     Run an instance of a test case.
@@ -211,9 +222,16 @@ def run_test(driver: Path) -> Result:
         return f"{log_path}.{component}.stderr.log \n\t {log_path}.{component}.stdout.log"
     compiler_log_file_str=f"{relevant_files('compiler')} \n\t {log_path}.s \n\t {log_path}.s.printed"
 
+    # An -march among the flags also sets the ISA to assemble and simulate for
+    flags = test_flags(to_assemble)
+    march = "rv32imfd"
+    for flag in flags:
+        if flag.startswith("-march="):
+            march = flag[len("-march="):]
+
     # Compile
     return_code, _, timed_out = run_subprocess(
-        cmd=[COMPILER_FILE, "-S", to_assemble, "-o", f"{log_path}.s"],
+        cmd=[COMPILER_FILE, *flags, "-S", to_assemble, "-o", f"{log_path}.s"],
         timeout=RUN_TIMEOUT_SECONDS,
         env=custom_env,
         log_path=f"{log_path}.compiler",
@@ -238,7 +256,7 @@ def run_test(driver: Path) -> Result:
     # Assemble
     return_code, _, timed_out = run_subprocess(
         cmd=[
-                "riscv64-unknown-elf-gcc", "-march=rv32imfd", "-mabi=ilp32d",
+                "riscv64-unknown-elf-gcc", f"-march={march}", "-mabi=ilp32d",
                 "-o", f"{log_path}.o", "-c", f"{log_path}.s"
             ],
         timeout=RUN_TIMEOUT_SECONDS,
@@ -251,7 +269,7 @@ def run_test(driver: Path) -> Result:
     # Link
     return_code, _, timed_out = run_subprocess(
         cmd=[
-                "riscv64-unknown-elf-gcc", "-march=rv32imfd", "-mabi=ilp32d", "-static",
+                "riscv64-unknown-elf-gcc", f"-march={march}", "-mabi=ilp32d", "-static",
                 "-o", f"{log_path}", f"{log_path}.o", str(driver)
             ],
         timeout=RUN_TIMEOUT_SECONDS,
@@ -263,7 +281,7 @@ def run_test(driver: Path) -> Result:
 
     # Simulate
     return_code, _, timed_out = run_subprocess(
-        cmd=["spike", "pk", log_path],
+        cmd=["spike", f"--isa={march}", "pk", log_path],
         timeout=RUN_TIMEOUT_SECONDS,
         log_path=f"{log_path}.simulation",
     )
@@ -338,6 +356,29 @@ def make(silent: bool) -> bool:
 
     return True
 
+def unit_tests(silent: bool) -> bool:
+    """
+    Wrapper for make bin/unit_tests and running it.
+
+    Return True if every unit test passed, False otherwise
+    """
+    print(GREEN + "Running unit tests..." + RESET)
+    return_code, error_msg, _ = run_subprocess(
+        cmd=["make", "-C", PROJECT_LOCATION, "-j8", "bin/unit_tests"], timeout=BUILD_TIMEOUT_SECONDS, silent=silent
+    )
+    if return_code != 0:
+        print(RED + "Error when making unit tests:", error_msg + RESET)
+        return False
+
+    return_code, error_msg, _ = run_subprocess(
+        cmd=[PROJECT_LOCATION.joinpath("bin/unit_tests")], timeout=BUILD_TIMEOUT_SECONDS, silent=silent
+    )
+    if return_code != 0:
+        print(RED + "Unit tests failed:", error_msg + RESET)
+        return False
+
+    return True
+
 def coverage() -> bool:
     """
     Wrapper for make coverage.
@@ -490,6 +531,9 @@ def main():
     if not make(silent=args.short):
         exit(3)
 
+    if not unit_tests(silent=args.short):
+        exit(5)
+
     with JUnitXMLFile(J_UNIT_OUTPUT_FILE) as xml_file:
         run_tests(args, xml_file)
 
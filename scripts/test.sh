@@ -11,7 +11,8 @@ if [ "${DONT_CLEAN:-}" != "1" ]; then
 fi
 
 set -e
-make bin/c_compiler
+make bin/c_compiler bin/unit_tests
+./bin/unit_tests
 set +e
 
 mkdir -p bin
@@ -48,26 +49,34 @@ for DRIVER in compiler_tests/${SPECIFIC_FOLDER}/*_driver.c; do
     echo "${TO_ASSEMBLE}"
     printf '%s\n' "<testcase name=\"${TO_ASSEMBLE}\">" >> "${J_UNIT_OUTPUT_FILE}"
 
+    # A testcase can ask for compiler flags with a "/* FLAGS: ... */" line; an
+    # -march among them also sets the ISA it is assembled and simulated for
+    FLAGS="$(sed -n 's|^/\* FLAGS: *\(.*[^ ]\) *\*/$|\1|p' "${TO_ASSEMBLE}" | head -n 1)"
+    MARCH="rv32imfd"
+    if [[ "${FLAGS}" =~ -march=([^[:space:]]+) ]]; then
+        MARCH="${BASH_REMATCH[1]}"
+    fi
+
     OUT="${LOG_FILE_BASE}"
-    ASAN_OPTIONS=exitcode=0 timeout --foreground 15s ./bin/c_compiler -S "${TO_ASSEMBLE}" -o "${OUT}.s" 2> "${LOG_FILE_BASE}.compiler.stderr.log" > "${LOG_FILE_BASE}.compiler.stdout.log"
+    ASAN_OPTIONS=exitcode=0 timeout --foreground 15s ./bin/c_compiler ${FLAGS} -S "${TO_ASSEMBLE}" -o "${OUT}.s" 2> "${LOG_FILE_BASE}.compiler.stderr.log" > "${LOG_FILE_BASE}.compiler.stdout.log"
     if [ $? -ne 0 ]; then
         fail_testcase "Failed to compile testcase: \n\t ${LOG_FILE_BASE}.compiler.stderr.log \n\t ${LOG_FILE_BASE}.compiler.stdout.log \n\t ${OUT}.s \n\t ${OUT}.s.printed"
         continue
     fi
 
-    timeout --foreground 15s riscv64-unknown-elf-gcc -march=rv32imfd -mabi=ilp32d -o "${OUT}.o" -c "${OUT}.s" 2> "${LOG_FILE_BASE}.assembler.stderr.log" > "${LOG_FILE_BASE}.assembler.stdout.log"
+    timeout --foreground 15s riscv64-unknown-elf-gcc -march="${MARCH}" -mabi=ilp32d -o "${OUT}.o" -c "${OUT}.s" 2> "${LOG_FILE_BASE}.assembler.stderr.log" > "${LOG_FILE_BASE}.assembler.stdout.log"
     if [ $? -ne 0 ]; then
         fail_testcase "Failed to assemble: \n\t ${LOG_FILE_BASE}.compiler.stderr.log \n\t ${LOG_FILE_BASE}.compiler.stdout.log \n\t ${LOG_FILE_BASE}.assembler.stderr.log \n\t ${LOG_FILE_BASE}.assembler.stdout.log \n\t ${OUT}.s \n\t ${OUT}.s.printed"
         continue
     fi
 
-    timeout --foreground 15s riscv64-unknown-elf-gcc -march=rv32imfd -mabi=ilp32d -static -o "${OUT}" "${OUT}.o" "${DRIVER}" 2> "${LOG_FILE_BASE}.linker.stderr.log" > "${LOG_FILE_BASE}.linker.stdout.log"
+    timeout --foreground 15s riscv64-unknown-elf-gcc -march="${MARCH}" -mabi=ilp32d -static -o "${OUT}" "${OUT}.o" "${DRIVER}" 2> "${LOG_FILE_BASE}.linker.stderr.log" > "${LOG_FILE_BASE}.linker.stdout.log"
     if [ $? -ne 0 ]; then
         fail_testcase "Failed to link driver: \n\t ${LOG_FILE_BASE}.compiler.stderr.log \n\t ${LOG_FILE_BASE}.compiler.stdout.log \n\t ${LOG_FILE_BASE}.linker.stderr.log \n\t ${LOG_FILE_BASE}.linker.stdout.log \n\t ${OUT}.s \n\t ${OUT}.s.printed"
         continue
     fi
 
-    timeout --foreground 15s spike pk "${OUT}" > "${LOG_FILE_BASE}.simulation.log"
+    timeout --foreground 15s spike --isa="${MARCH}" pk "${OUT}" > "${LOG_FILE_BASE}.simulation.log"
     if [ $? -eq 0 ]; then
         echo -e "\t> Pass"
         (( PASSING++ ))
@@ -0,0 +1,369 @@
+#include "analysis_visitor.hpp"
+
+namespace codegen {
+
+int AnalysisVisitor::getUseCount(Symbol name) const {
+    auto it = useCounts.find(name);
+    if (it != useCounts.end()) {
+        return it->second;
+    }
+    return 0;
+}
+
+void AnalysisVisitor::noteRead(Symbol name) {
+    read.insert(name);
+    useCounts[name]++;
+}
+
+void AnalysisVisitor::noteStore(const Expression* lhs) {
+    if (auto* idExpr = lhs->asIdentifierExpression()) {
+        assigned.insert(idExpr->getSymbol());
+        useCounts[idExpr->getSymbol()]++;
+        return;
+    }
+    if (auto* arrayExpr = lhs->asArrayAccessExpression()) {
+        // a[i] = x writes the array (or whatever the pointer refers to)
+        if (auto* arrayId = arrayExpr->getArray()->asIdentifierExpression()) {
+            storedArrays.insert(arrayId->getSymbol());
+            noteRead(arrayId->getSymbol());
+        } else {
+            indirectStore = true;
+            arrayExpr->getArray()->accept(*this);
+        }
+        arrayExpr->getIndex()->accept(*this);
+        return;
+    }
+    if (auto* unaryExpr = lhs->asUnaryExpression()) {
+        if (unaryExpr->getOperator() == ast::UnaryOp::Type::DEREFERENCE) {
+            indirectStore = true;
+            unaryExpr->getOperand()->accept(*this);
+            return;
+        }
+    }
+    // anything else we cannot name precisely
+    indirectStore = true;
+    lhs->accept(*this);
+}
+
+void AnalysisVisitor::visitVariableDeclaration(const ast::VariableDeclaration& decl) {
+    nodeCount++;
+    if (decl.isTypedef() || (decl.getDeclarator() && decl.getDeclarator()->isFunction())) {
+        return;
+    }
+    declared.insert(decl.getSymbol());
+    if (decl.hasInitializer()) {
+        decl.getInitializer()->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitFunctionDeclaration(const ast::FunctionDeclaration& decl) {
+    nodeCount++;
+    for (const auto& param : decl.getParameters()) {
+        declared.insert(param->getSymbol());
+    }
+    if (decl.hasBody()) {
+        decl.getBody()->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitBinaryExpression(const ast::BinaryExpression& expr) {
+    nodeCount++;
+    if (expr.getOperator() == ast::BinaryOp::Type::DIV) {
+        if (auto* idExpr = expr.getRight()->asIdentifierExpression()) {
+            fpDivisors.insert(idExpr->getSymbol());
+        }
+    }
+    expr.getLeft()->accept(*this);
+    expr.getRight()->accept(*this);
+}
+
+void AnalysisVisitor::visitUnaryExpression(const ast::UnaryExpression& expr) {
+    nodeCount++;
+    switch (expr.getOperator()) {
+        case ast::UnaryOp::Type::PRE_INCREMENT:
+        case ast::UnaryOp::Type::POST_INCREMENT:
+        case ast::UnaryOp::Type::PRE_DECREMENT:
+        case ast::UnaryOp::Type::POST_DECREMENT:
+            noteStore(expr.getOperand());
+            break;
+        case ast::UnaryOp::Type::ADDRESS_OF:
+            if (auto* idExpr = expr.getOperand()->asIdentifierExpression()) {
+                addressTaken.insert(idExpr->getSymbol());
+            }
+            expr.getOperand()->accept(*this);
+            break;
+        default:
+            expr.getOperand()->accept(*this);
+            break;
+    }
+}
+
+void AnalysisVisitor::visitLiteralExpression(const ast::LiteralExpression& expr) {
+    (void)expr;
+    nodeCount++;
+}
+
+void AnalysisVisitor::visitStringLiteralExpression(const ast::StringLiteralExpression& expr) {
+    (void)expr;
+    nodeCount++;
+}
+
+void AnalysisVisitor::visitIdentifierExpression(const ast::IdentifierExpression& expr) {
+    nodeCount++;
+    noteRead(expr.getSymbol());
+}
+
+void AnalysisVisitor::visitCallExpression(const ast::CallExpression& expr) {
+    nodeCount++;
+    callCount++;
+    if (auto* idExpr = expr.getFunction()->asIdentifierExpression()) {
+        calledFunctions.insert(idExpr->getSymbol());
+    } else {
+        indirectCall = true;
+        expr.getFunction()->accept(*this);
+    }
+    if (expr.hasArguments()) {
+        for (const auto& node : expr.getArguments()->getNodes()) {
+            if (node) {
+                node->accept(*this);
+            }
+        }
+    }
+}
+
+void AnalysisVisitor::visitAssignmentExpression(const ast::AssignmentExpression& expr) {
+    nodeCount++;
+    expr.getRHS()->accept(*this);
+    if (expr.getOperator() != ast::AssignOp::Type::ASSIGN) {
+        // compound assignment also reads the target
+        if (auto* idExpr = expr.getLHS()->asIdentifierExpression()) {
+            noteRead(idExpr->getSymbol());
+        }
+    }
+    noteStore(expr.getLHS());
+}
+
+void AnalysisVisitor::visitArrayAccessExpression(const ast::ArrayAccessExpression& expr) {
+    nodeCount++;
+    expr.getArray()->accept(*this);
+    expr.getIndex()->accept(*this);
+}
+
+void AnalysisVisitor::visitMemberAccessExpression(const ast::MemberAccessExpression& expr) {
+    nodeCount++;
+    expr.getObject()->accept(*this);
+}
+
+void AnalysisVisitor::visitPointerMemberAccessExpression(const ast::PointerMemberAccessExpression& expr) {
+    nodeCount++;
+    expr.getObject()->accept(*this);
+}
+
+void AnalysisVisitor::visitCastExpression(const ast::CastExpression& expr) {
+    nodeCount++;
+    expr.getExpression()->accept(*this);
+}
+
+void AnalysisVisitor::visitConditionalExpression(const ast::ConditionalExpression& expr) {
+    nodeCount++;
+    expr.getCondition()->accept(*this);
+    expr.getThenExpression()->accept(*this);
+    expr.getElseExpression()->accept(*this);
+}
+
+void AnalysisVisitor::visitCommaExpression(const ast::CommaExpression& expr) {
+    nodeCount++;
+    expr.getLeft()->accept(*this);
+    expr.getRight()->accept(*this);
+}
+
+void AnalysisVisitor::visitSizeofExpression(const ast::SizeofExpression& expr) {
+    // operand of sizeof is never evaluated, but its names still have to be declared
+    nodeCount++;
+    AnalysisVisitor operandInfo;
+    expr.getExpression()->accept(operandInfo);
+    unevaluated.insert(operandInfo.read.begin(), operandInfo.read.end());
+    unevaluated.insert(operandInfo.unevaluated.begin(), operandInfo.unevaluated.end());
+}
+
+void AnalysisVisitor::visitSizeofTypeExpression(const ast::SizeofTypeExpression& expr) {
+    (void)expr;
+    nodeCount++;
+}
+
+void AnalysisVisitor::visitExpressionStatement(const ast::ExpressionStatement& stmt) {
+    nodeCount++;
+    if (stmt.getExpression()) {
+        stmt.getExpression()->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitCompoundStatement(const ast::CompoundStatement& stmt) {
+    nodeCount++;
+    const NodeList* declList = stmt.getDeclarationList();
+    if (declList) {
+        for (const auto& nodePtr : declList->getNodes()) {
+            if (nodePtr) {
+                nodePtr->accept(*this);
+            }
+        }
+    }
+    for (const auto& s : stmt.getStatements()) {
+        if (s) {
+            s->accept(*this);
+        }
+    }
+}
+
+void AnalysisVisitor::visitIfStatement(const ast::IfStatement& stmt) {
+    nodeCount++;
+    branchStatements.push_back(&stmt);
+    stmt.getCondition()->accept(*this);
+    stmt.getThenStatement()->accept(*this);
+    if (stmt.hasElseStatement()) {
+        stmt.getElseStatement()->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitWhileStatement(const ast::WhileStatement& stmt) {
+    nodeCount++;
+    branchStatements.push_back(&stmt);
+    stmt.getCondition()->accept(*this);
+    stmt.getBody()->accept(*this);
+}
+
+void AnalysisVisitor::visitDoWhileStatement(const ast::DoWhileStatement& stmt) {
+    nodeCount++;
+    branchStatements.push_back(&stmt);
+    stmt.getBody()->accept(*this);
+    stmt.getCondition()->accept(*this);
+}
+
+void AnalysisVisitor::visitForStatement(const ast::ForStatement& stmt) {
+    nodeCount++;
+    branchStatements.push_back(&stmt);
+    if (stmt.hasInitialization()) {
+        stmt.getInitialization()->accept(*this);
+    }
+    if (stmt.hasCondition()) {
+        stmt.getCondition()->accept(*this);
+    }
+    if (stmt.hasIncrement()) {
+        stmt.getIncrement()->accept(*this);
+    }
+    stmt.getBody()->accept(*this);
+}
+
+void AnalysisVisitor::visitReturnStatement(const ast::ReturnStatement& stmt) {
+    nodeCount++;
+    controlFlow = true;
+    if (stmt.hasExpression()) {
+        stmt.getExpression()->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitBreakStatement(const ast::BreakStatement& stmt) {
+    (void)stmt;
+    nodeCount++;
+    controlFlow = true;
+}
+
+void AnalysisVisitor::visitContinueStatement(const ast::ContinueStatement& stmt) {
+    (void)stmt;
+    nodeCount++;
+    controlFlow = true;
+}
+
+void AnalysisVisitor::visitSwitchStatement(const ast::SwitchStatement& stmt) {
+    nodeCount++;
+    branchStatements.push_back(&stmt);
+    stmt.getCondition()->accept(*this);
+    stmt.getBody()->accept(*this);
+}
+
+void AnalysisVisitor::visitCaseStatement(const ast::CaseStatement& stmt) {
+    nodeCount++;
+    branchStatements.push_back(&stmt);
+    if (!stmt.isDefault()) {
+        stmt.getCaseValue()->accept(*this);
+    }
+    if (stmt.getStatement()) {
+        stmt.getStatement()->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitDefaultStatement(const ast::DefaultStatement& stmt) {
+    nodeCount++;
+    branchStatements.push_back(&stmt);
+    if (stmt.getStatement()) {
+        stmt.getStatement()->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitGotoStatement(const ast::GotoStatement& stmt) {
+    (void)stmt;
+    nodeCount++;
+    controlFlow = true;
+}
+
+void AnalysisVisitor::visitLabeledStatement(const ast::LabeledStatement& stmt) {
+    nodeCount++;
+    controlFlow = true;
+    stmt.getStatement()->accept(*this);
+}
+
+/*******************  DECLARATOR FUNCTIONS **********************/
+
+void AnalysisVisitor::visitIdentifierDeclarator(const ast::IdentifierDeclarator& decl) {
+    declared.insert(decl.getSymbol());
+}
+
+void AnalysisVisitor::visitArrayDeclarator(const ast::ArrayDeclarator& decl) {
+    decl.getBaseDeclarator()->accept(*this);
+}
+
+void AnalysisVisitor::visitFunctionDeclarator(const ast::FunctionDeclarator& decl) {
+    (void)decl;
+}
+
+void AnalysisVisitor::visitPointerDeclarator(const ast::PointerDeclarator& decl) {
+    decl.getBaseDeclarator()->accept(*this);
+}
+
+void AnalysisVisitor::visitParameterDeclaration(const ast::ParameterDeclaration& decl) {
+    if (decl.hasDeclarator()) {
+        declared.insert(decl.getSymbol());
+    }
+}
+
+void AnalysisVisitor::visitParameterList(const ast::ParameterList& list) {
+    for (const auto& param : list.getParameters()) {
+        param->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitInitDeclarator(const ast::InitDeclarator& decl) {
+    if (decl.getDeclarator()) {
+        decl.getDeclarator()->accept(*this);
+    }
+    if (decl.getInitializer()) {
+        decl.getInitializer()->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitInitializerList(const ast::InitializerList& list) {
+    nodeCount++;
+    for (const auto& expr : list.getExpressions()) {
+        expr->accept(*this);
+    }
+}
+
+void AnalysisVisitor::visitEnumValue(const ast::EnumValue& value) {
+    (void)value;
+}
+
+void AnalysisVisitor::visitEnumDeclaration(const ast::EnumDeclaration& decl) {
+    (void)decl;
+}
+
+} // namespace codegen
@@ -0,0 +1,136 @@
+#include "arena.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace ast {
+
+namespace {
+
+constexpr size_t kChunkSize = 64 * 1024;
+
+thread_local Arena* current = nullptr;
+
+char* alignUp(char* pointer, size_t align) {
+    auto address = reinterpret_cast<uintptr_t>(pointer);
+    return reinterpret_cast<char*>((address + align - 1) & ~(uintptr_t)(align - 1));
+}
+
+} // namespace
+
+struct Arena::Chunk {
+    Chunk* previous;
+    size_t size;
+};
+
+// sits in front of each object that needs destroying
+struct Arena::Header {
+    Header* previous;
+    Destructor destructor;
+};
+
+Arena::~Arena()
+{
+    reset();
+    while (spare) {
+        Chunk* previous = spare->previous;
+        std::free(spare);
+        spare = previous;
+    }
+}
+
+void Arena::reset()
+{
+    for (Header* header = last; header; header = header->previous) {
+        header->destructor(reinterpret_cast<char*>(header) + sizeof(Header));
+    }
+    last = nullptr;
+
+    // sorted so the largest spare is always at the front
+    while (chunks) {
+        Chunk* chunk = chunks;
+        chunks = chunk->previous;
+        Chunk** slot = &spare;
+        while (*slot && (*slot)->size > chunk->size) {
+            slot = &(*slot)->previous;
+        }
+        chunk->previous = *slot;
+        *slot = chunk;
+    }
+    next = nullptr;
+    end = nullptr;
+    objects = 0;
+    used = 0;
+}
+
+void* Arena::carve(size_t size, size_t align, Destructor destructor)
+{
+    // the object follows its header directly, so both share one alignment
+    if (destructor && align < alignof(Header)) {
+        align = alignof(Header);
+    }
+    const size_t header = destructor ? (sizeof(Header) + align - 1) / align * align : 0;
+
+    char* place = alignUp(next, align);
+    if (!next || place + header + size > end) {
+        // oversized objects get a chunk of their own
+        size_t bytes = sizeof(Chunk) + align + header + size;
+        if (bytes < kChunkSize) {
+            bytes = kChunkSize;
+        }
+        Chunk* chunk = nullptr;
+        if (spare && spare->size >= bytes) {
+            chunk = spare;
+            spare = chunk->previous;
+        } else {
+            chunk = static_cast<Chunk*>(std::malloc(bytes));
+            if (!chunk) {
+                throw std::bad_alloc();
+            }
+            chunk->size = bytes;
+            reserved += bytes;
+        }
+        chunk->previous = chunks;
+        chunks = chunk;
+        next = reinterpret_cast<char*>(chunk) + sizeof(Chunk);
+        end = reinterpret_cast<char*>(chunk) + chunk->size;
+        place = alignUp(next, align);
+    }
+
+    char* object = place + header;
+    if (destructor) {
+        auto* record = reinterpret_cast<Header*>(object - sizeof(Header));
+        record->previous = last;
+        record->destructor = destructor;
+        last = record;
+    }
+    used += static_cast<size_t>(object + size - next);
+    next = object + size;
+    return object;
+}
+
+Arena& Arena::Current()
+{
+    if (!current) {
+        throw std::runtime_error("AST node created with no arena in scope");
+    }
+    return *current;
+}
+
+std::pmr::memory_resource* Arena::CurrentResource()
+{
+    return current ? current : std::pmr::get_default_resource();
+}
+
+Arena::Scope::Scope(Arena& arena) : previous(current)
+{
+    current = &arena;
+}
+
+Arena::Scope::~Scope()
+{
+    current = previous;
+}
+
+} // namespace ast
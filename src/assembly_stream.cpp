@@ -0,0 +1,171 @@
+#include "assembly_stream.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+
+int openOutput(const std::string& path)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Couldn't open output file: " + path);
+    }
+    return fd;
+}
+
+} // namespace
+
+AssemblyStream::AssemblyStream(std::string& text) : std::ostream(nullptr), buffer(&text, -1)
+{
+    rdbuf(&buffer);
+}
+
+AssemblyStream::AssemblyStream(const std::string& path) : std::ostream(nullptr), buffer(nullptr, openOutput(path))
+{
+    rdbuf(&buffer);
+}
+
+AssemblyStream::~AssemblyStream()
+{
+    if (!closed) {
+        try {
+            close();
+        } catch (...) {
+            // destructors do not throw; close() explicitly to hear about it
+        }
+    }
+}
+
+void AssemblyStream::close()
+{
+    closed = true;
+    buffer.close();
+}
+
+AssemblyStream::Buffer::Buffer(std::string* text, int fd) : text(text), fd(fd), filling(BUFFER_SIZE)
+{
+    setp(filling.data(), filling.data() + filling.size());
+}
+
+AssemblyStream::Buffer::~Buffer()
+{
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        writer.join();
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void AssemblyStream::Buffer::close()
+{
+    const size_t size = static_cast<size_t>(pptr() - pbase());
+    if (writer.joinable()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return pending == 0; });
+        stopping = true;
+        lock.unlock();
+        changed.notify_all();
+        writer.join();
+    }
+    writeOut(filling, size);
+    setp(filling.data(), filling.data() + filling.size());
+    if (fd >= 0) {
+        if (::close(fd) != 0) {
+            failed = true;
+        }
+        fd = -1;
+    }
+    if (failed) {
+        throw std::runtime_error("Couldn't write the assembly output");
+    }
+}
+
+AssemblyStream::Buffer::int_type AssemblyStream::Buffer::overflow(int_type ch)
+{
+    handOver();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize AssemblyStream::Buffer::xsputn(const char* data, std::streamsize count)
+{
+    std::streamsize done = 0;
+    while (done < count) {
+        if (pptr() == epptr()) {
+            handOver();
+        }
+        const std::streamsize room = epptr() - pptr();
+        const std::streamsize part = count - done < room ? count - done : room;
+        std::memcpy(pptr(), data + done, static_cast<size_t>(part));
+        pbump(static_cast<int>(part));
+        done += part;
+    }
+    return count;
+}
+
+// the buffer is full: strings take it at once, files give it to the writer thread
+void AssemblyStream::Buffer::handOver()
+{
+    const size_t size = static_cast<size_t>(pptr() - pbase());
+    if (text) {
+        writeOut(filling, size);
+    } else {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!writer.joinable()) {
+            writing.resize(BUFFER_SIZE);
+            writer = std::thread(&Buffer::writerLoop, this);
+        }
+        changed.wait(lock, [this] { return pending == 0; });
+        filling.swap(writing);
+        pending = size;
+        lock.unlock();
+        changed.notify_all();
+    }
+    setp(filling.data(), filling.data() + filling.size());
+}
+
+void AssemblyStream::Buffer::writeOut(const std::vector<char>& data, size_t size)
+{
+    if (text) {
+        text->append(data.data(), size);
+        return;
+    }
+    size_t done = 0;
+    while (done < size) {
+        ssize_t written = ::write(fd, data.data() + done, size - done);
+        if (written <= 0) {
+            failed = true;
+            return;
+        }
+        done += static_cast<size_t>(written);
+    }
+}
+
+void AssemblyStream::Buffer::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        changed.wait(lock, [this] { return pending > 0 || stopping; });
+        if (pending == 0) {
+            return;
+        }
+        const size_t size = pending;
+        lock.unlock();
+        writeOut(writing, size);
+        lock.lock();
+        pending = 0;
+        changed.notify_all();
+    }
+}
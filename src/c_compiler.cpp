@@ -0,0 +1,184 @@
+#include "c_compiler.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include "assembly_stream.hpp"
+#include "ast.hpp"
+#include "compression_report.hpp"
+#include "instruction_scheduler.hpp"
+#include "profile_data.hpp"
+#include "source_buffer.hpp"
+#include "whole_program.hpp"
+
+using ast::NodePtr;
+
+CompileResult Compiler::compile(std::string_view source, const CompileOptions& options, const std::string& source_name)
+{
+    // flex needs two NULs after the text, so text from elsewhere is copied once
+    SourceBuffer buffer = SourceBuffer::FromText(source);
+    return compile(buffer, options, source_name);
+}
+
+CompileResult Compiler::compile(SourceBuffer& source, const CompileOptions& options, const std::string& source_name)
+{
+    CompileResult result;
+    std::ostringstream log;
+    const auto start = std::chrono::steady_clock::now();
+    ast::Symbol::Scope names_scope(names);
+    try
+    {
+        log << "Parsing ..." << source_name << std::endl;
+        NodePtr root = ParseAST(source_name, source, arena);
+        if (root == nullptr)
+        {
+            throw std::runtime_error("The root of the AST is a null pointer");
+        }
+        log << "AST parsing complete" << std::endl;
+        log << "AST has " << arena.objectCount() << " nodes in " << arena.bytesUsed() << " arena bytes ("
+            << arena.bytesReserved() << " reserved)" << std::endl;
+        result.stats.ast_nodes = arena.objectCount();
+        result.stats.arena_bytes = arena.bytesUsed();
+
+        ast::Arena::Scope arena_scope(arena);
+        if (printAst)
+        {
+            std::ostringstream printed;
+            root->Print(printed);
+            result.printed_ast = printed.str();
+        }
+
+        AssemblyStream assembly(result.assembly);
+        GenerateAssembly(root, assembly, options, log);
+        assembly.close();
+        if (options.compressed)
+        {
+            std::istringstream listing(result.assembly);
+            ReportCompression(listing, log);
+        }
+        result.ok = true;
+    }
+    catch (const std::exception& error)
+    {
+        result.diagnostics = error.what();
+    }
+    result.stats.assembly_bytes = result.assembly.size();
+    result.stats.milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.log = log.str();
+
+    // keeps the chunks for the next unit
+    arena.reset();
+    names.reset();
+    return result;
+}
+
+CompileResult CompileSource(std::string_view source, const CompileOptions& options, const std::string& source_name)
+{
+    Compiler compiler;
+    return compiler.compile(source, options, source_name);
+}
+
+void GenerateAssembly(const NodePtr& root, std::ostream& output, const CompileOptions& options,
+                      std::ostream& log)
+{
+    log << "Compiling parsed AST..." << std::endl;
+
+    ast::Context ctx;
+    ctx.setOptions(options);
+
+    ProfileData profile;
+    if (!options.profile_use.empty())
+    {
+        profile = ProfileData::Load(options.profile_use);
+        ctx.setProfile(&profile);
+        log << "Read profile for " << profile.functionCount() << " functions from: " << options.profile_use << std::endl;
+    }
+
+    mir::Function header;
+    if (options.compressed)
+    {
+        // let the assembler pick 16-bit encodings whatever -march it is run with
+        header.addLine("    .option rvc");
+    }
+    if (options.vector)
+    {
+        header.addLine("    .option arch, +v");
+    }
+    if (options.zba)
+    {
+        header.addLine("    .option arch, +zba");
+    }
+    if (options.zbb)
+    {
+        header.addLine("    .option arch, +zbb");
+    }
+    mir::Print(header, output);
+
+    codegen::CodeGenVisitor visitor(ctx, output);
+
+    // -fipa-ra: callees first, so each call site can see what its target clobbers
+    NodePtr tree = root;
+    if (options.ipa_ra)
+    {
+        std::set<std::string> register_arguments;
+        tree = OrderCalleesFirst(root, register_arguments);
+        if (options.whole_program)
+        {
+            // outside a whole program, callers in other units use the standard convention
+            visitor.setRegisterArgumentFunctions(register_arguments);
+        }
+    }
+
+    tree->accept(visitor);
+    visitor.finishTranslationUnit();
+    mir::Function data;
+    ctx.printDoubleData(data);
+    ctx.printFloatData(data);
+    ctx.printStringData(data);
+    if (!options.profile_generate.empty())
+    {
+        EmitProfileRuntime(data, ctx.getProfileCounters(), options.profile_generate);
+        log << "Instrumented " << ctx.getProfileCounters().size() << " blocks, counts are appended to "
+            << options.profile_generate << " at exit" << std::endl;
+    }
+    mir::Print(data, output);
+
+    if (options.ipa_ra)
+    {
+        log << "Register usage known for " << visitor.summarisedFunctionCount() << " functions, "
+            << ctx.getSkippedSaves() << " caller saves skipped" << std::endl;
+    }
+
+    log << "Frame layout: " << ctx.getRequestedStackMemory() << " bytes of locals, "
+        << ctx.getPaddingBytes() << " bytes of alignment padding" << std::endl;
+
+    if (options.stack_reuse)
+    {
+        log << "Locals need " << ctx.getNeededStackMemory() << " of " << ctx.getRequestedStackMemory()
+            << " stack bytes with slots shared between blocks" << std::endl;
+    }
+
+    if (options.schedule)
+    {
+        const ScheduleReport& report = visitor.scheduleReport();
+        log << "Scheduled " << report.instructions << " instructions in " << report.blocks
+            << " basic blocks, estimated cycles " << report.cyclesBefore << " -> "
+            << report.cyclesAfter << std::endl;
+    }
+}
+
+void ReportCompression(std::istream& assembly, std::ostream& log)
+{
+    const CompressionReport report = MeasureCompression(assembly);
+    double fraction = report.instructions ? 100.0 * report.compressed / report.instructions : 0.0;
+    double saving = report.instructions ? 100.0 * (report.uncompressedBytes() - report.bytes()) / report.uncompressedBytes() : 0.0;
+    log << std::fixed << std::setprecision(1)
+        << "Compressed instructions: " << report.compressed << "/" << report.instructions
+        << " (" << fraction << "%), code size " << report.bytes() << " bytes, "
+        << saving << "% smaller than uncompressed" << std::endl;
+}
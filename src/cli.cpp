@@ -1,4 +1,334 @@
 #include <cli.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <getopt.h>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include "instruction_scheduler.hpp"
+#include "profile_data.hpp"
+
+// Applies a -f<flag> code generation switch, returning false if it is not recognised.
+static bool ParseFeatureFlag(const std::string& flag, CompileOptions& options)
+{
+    if (flag == "fast-math")
+    {
+        options.fast_math = true;
+    }
+    else if (flag == "no-fast-math")
+    {
+        options.fast_math = false;
+    }
+    else if (flag == "whole-program")
+    {
+        options.whole_program = true;
+    }
+    else if (flag == "no-whole-program")
+    {
+        options.whole_program = false;
+    }
+    else if (flag == "ipa-ra")
+    {
+        options.ipa_ra = true;
+    }
+    else if (flag == "no-ipa-ra")
+    {
+        options.ipa_ra = false;
+    }
+    else if (flag == "shrink-wrap")
+    {
+        options.shrink_wrap = true;
+    }
+    else if (flag == "no-shrink-wrap")
+    {
+        options.shrink_wrap = false;
+    }
+    else if (flag == "omit-frame-pointer")
+    {
+        options.omit_frame_pointer = true;
+    }
+    else if (flag == "no-omit-frame-pointer")
+    {
+        options.omit_frame_pointer = false;
+    }
+    else if (flag == "stack-reuse=all")
+    {
+        options.stack_reuse = true;
+    }
+    else if (flag == "stack-reuse=none")
+    {
+        options.stack_reuse = false;
+    }
+    else if (flag == "reorder-blocks")
+    {
+        options.reorder_blocks = true;
+    }
+    else if (flag == "no-reorder-blocks")
+    {
+        options.reorder_blocks = false;
+    }
+    else if (flag == "reorder-blocks-and-partition")
+    {
+        options.reorder_blocks = true;
+        options.partition_cold = true;
+    }
+    else if (flag == "no-reorder-blocks-and-partition")
+    {
+        options.partition_cold = false;
+    }
+    else if (flag == "reorder-functions")
+    {
+        options.reorder_functions = true;
+    }
+    else if (flag == "no-reorder-functions")
+    {
+        options.reorder_functions = false;
+    }
+    else if (flag == "schedule-insns")
+    {
+        options.schedule = true;
+    }
+    else if (flag == "no-schedule-insns")
+    {
+        options.schedule = false;
+    }
+    else if (flag == "profile-generate")
+    {
+        options.profile_generate = DEFAULT_PROFILE_PATH;
+    }
+    else if (flag.rfind("profile-generate=", 0) == 0 && flag.size() > 17)
+    {
+        options.profile_generate = flag.substr(17);
+    }
+    else if (flag == "profile-use")
+    {
+        options.profile_use = DEFAULT_PROFILE_PATH;
+    }
+    else if (flag.rfind("profile-use=", 0) == 0 && flag.size() > 12)
+    {
+        options.profile_use = flag.substr(12);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// Applies -march=<isa> (e.g. rv32imfdc or rv32imc_zba_zbb), returning false for
+// anything that is not an RV32 base with extensions we know about.
+static bool ParseArchString(const std::string& isa, CompileOptions& options)
+{
+    if (isa.rfind("rv32", 0) != 0 || isa.size() < 5 || (isa[4] != 'i' && isa[4] != 'g'))
+    {
+        return false;
+    }
+
+    CompileOptions parsed = options;
+    parsed.compressed = false;
+    parsed.vector = false;
+    parsed.zba = false;
+    parsed.zbb = false;
+
+    // single-letter extensions run up to the first '_'
+    size_t end = isa.find('_');
+    if (end == std::string::npos)
+    {
+        end = isa.size();
+    }
+    for (size_t i = 5; i < end; i++)
+    {
+        switch (isa[i])
+        {
+        case 'm':
+        case 'a':
+        case 'f':
+        case 'd':
+            // always assumed by the code generator
+            break;
+        case 'c':
+            parsed.compressed = true;
+            break;
+        case 'v':
+            parsed.vector = true;
+            break;
+        default:
+            return false;
+        }
+    }
+
+    // then multi-letter extensions, each introduced by '_'
+    while (end < isa.size())
+    {
+        size_t start = end + 1;
+        end = isa.find('_', start);
+        if (end == std::string::npos)
+        {
+            end = isa.size();
+        }
+        const std::string extension = isa.substr(start, end - start);
+        if (extension == "zba")
+        {
+            parsed.zba = true;
+        }
+        else if (extension == "zbb")
+        {
+            parsed.zbb = true;
+        }
+        else if (extension != "zicsr" && extension != "zifencei")
+        {
+            return false;
+        }
+    }
+
+    options = parsed;
+    return true;
+}
+
+// Applies -mlatency=<class>:<cycles>[,<class>:<cycles>...] on top of the current
+// machine model, e.g. -mlatency=load:3,mul:4 or -mlatency=issue:2.
+static bool ParseLatencyList(const std::string& list, MachineModel& model)
+{
+    MachineModel parsed = model;
+    size_t start = 0;
+    while (start <= list.size())
+    {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos)
+        {
+            end = list.size();
+        }
+        const std::string entry = list.substr(start, end - start);
+        size_t colon = entry.find(':');
+        if (colon == std::string::npos || colon + 1 == entry.size() ||
+            entry.find_first_not_of("0123456789", colon + 1) != std::string::npos)
+        {
+            return false;
+        }
+        const std::string name = entry.substr(0, colon);
+        // only digits are left, so the one failure is a count too large for an int
+        int cycles = 0;
+        try
+        {
+            cycles = std::stoi(entry.substr(colon + 1));
+        }
+        catch (const std::out_of_range&)
+        {
+            return false;
+        }
+        if (name == "issue")
+        {
+            if (cycles < 1)
+            {
+                return false;
+            }
+            parsed.issueWidth = cycles;
+        }
+        else if (name == "load")
+        {
+            parsed.loadLatency = cycles;
+        }
+        else if (name == "mul")
+        {
+            parsed.mulLatency = cycles;
+        }
+        else if (name == "div")
+        {
+            parsed.divLatency = cycles;
+        }
+        else if (name == "fadd")
+        {
+            parsed.fpAddLatency = cycles;
+        }
+        else if (name == "fmul")
+        {
+            parsed.fpMulLatency = cycles;
+        }
+        else if (name == "fdiv")
+        {
+            parsed.fpDivLatency = cycles;
+        }
+        else if (name == "fmove")
+        {
+            parsed.fpMoveLatency = cycles;
+        }
+        else
+        {
+            return false;
+        }
+        start = end + 1;
+    }
+
+    model = parsed;
+    return true;
+}
+
+// Applies a -m<flag> target switch, returning false if it is not recognised.
+static bool ParseTargetFlag(const std::string& flag, CompileOptions& options)
+{
+    if (flag.rfind("arch=", 0) == 0)
+    {
+        return ParseArchString(flag.substr(5), options);
+    }
+    if (flag.rfind("tune=", 0) == 0)
+    {
+        return LookupMachineModel(flag.substr(5), options.machine);
+    }
+    if (flag.rfind("latency=", 0) == 0)
+    {
+        return ParseLatencyList(flag.substr(8), options.machine);
+    }
+    return false;
+}
+
+bool ParseOptionFlag(const std::string& flag, CompileOptions& options)
+{
+    if (flag.rfind("-f", 0) == 0)
+    {
+        return ParseFeatureFlag(flag.substr(2), options);
+    }
+    if (flag.rfind("-m", 0) == 0)
+    {
+        return ParseTargetFlag(flag.substr(2), options);
+    }
+    return false;
+}
+
+// Reads a -S @manifest: one translation unit per line, as a source path
+// optionally followed by the path to write its assembly to. Blank lines and
+// lines starting with '#' are skipped.
+static void ReadManifest(const std::string& manifest_path, std::vector<std::string>& sources,
+                         std::vector<std::string>& outputs)
+{
+    std::ifstream manifest(manifest_path);
+    if (!manifest)
+    {
+        std::cerr << "Could not open manifest " << manifest_path << std::endl;
+        exit(2);
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(manifest, line))
+    {
+        line_number++;
+        std::istringstream fields(line);
+        std::string source, output, extra;
+        if (!(fields >> source) || source[0] == '#')
+        {
+            continue;
+        }
+        fields >> output;
+        if (fields >> extra)
+        {
+            std::cerr << manifest_path << ":" << line_number << ": expected a source and at most one output" << std::endl;
+            exit(2);
+        }
+        sources.push_back(source);
+        outputs.push_back(output);
+    }
+}
 
 CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
 {
@@ -17,21 +347,71 @@ CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
     // Prevent opterr messages from being outputted.
     opterr = 0;
 
-    // ./bin/c_compiler -S [source-file.c] -o [dest-file.s]
+    // ./bin/c_compiler -fwhole-program [-f<flag>...] -S [a.c] -S [b.c] ... -o [dest-file.s]
+    // ./bin/c_compiler [-f<flag>...] [-march=<isa>] [-mtune=<core>] [-mlatency=<class>:<n>,...] -S [source-file.c] -o [dest-file.s]
+    // ./bin/c_compiler [-j N] [-f<flag>...] -S [a.c] -S [b.c] ... [-S @manifest] -o [dest-dir]
+    // ./bin/c_compiler [-j N] [-f<flag>...] --server [socket-path]
     CommandLineArguments cli_args;
+    std::vector<std::string> manifest_outputs;  // per source; empty when derived from -o
+    bool manifest = false;
+    static const option long_options[] = {
+        {"server", required_argument, nullptr, 'L'},
+        {nullptr, 0, nullptr, 0},
+    };
     int opt;
-    while ((opt = getopt(argc, argv, "S:o:")) != -1)
+    while ((opt = getopt_long(argc, argv, "S:o:f:m:j:", long_options, nullptr)) != -1)
     {
         switch (opt)
         {
+        case 'L':
+            cli_args.server_socket = std::string(optarg);
+            break;
         case 'S':
-            cli_args.compile_source_path = std::string(optarg);
+            if (optarg[0] == '@')
+            {
+                ReadManifest(optarg + 1, cli_args.compile_source_paths, manifest_outputs);
+                manifest = true;
+            }
+            else
+            {
+                cli_args.compile_source_paths.push_back(std::string(optarg));
+                manifest_outputs.push_back("");
+            }
             break;
         case 'o':
             cli_args.compile_output_path = std::string(optarg);
             break;
+        case 'f':
+            if (!ParseFeatureFlag(optarg, cli_args.options))
+            {
+                fprintf(stderr, "Unknown option `-f%s'.\n", optarg);
+                fprintf(stderr, "Exiting due to failure to parse CLI args\n");
+                exit(2);
+            }
+            break;
+        case 'm':
+            if (!ParseTargetFlag(optarg, cli_args.options))
+            {
+                fprintf(stderr, "Unknown option `-m%s'.\n", optarg);
+                fprintf(stderr, "Exiting due to failure to parse CLI args\n");
+                exit(2);
+            }
+            break;
+        case 'j':
+            if (std::string(optarg).find_first_not_of("0123456789") != std::string::npos || std::atoi(optarg) < 1)
+            {
+                fprintf(stderr, "Option -j needs a positive number of jobs, not `%s'.\n", optarg);
+                fprintf(stderr, "Exiting due to failure to parse CLI args\n");
+                exit(2);
+            }
+            cli_args.jobs = std::atoi(optarg);
+            break;
         case '?':
-            if (optopt == 'S' || optopt == 'o')
+            if (optopt == 'L')
+            {
+                fprintf(stderr, "Option --server requires a socket path.\n");
+            }
+            else if (optopt == 'S' || optopt == 'o' || optopt == 'f' || optopt == 'm' || optopt == 'j')
             {
                 fprintf(stderr, "Option -%c requires an argument.\n", optopt);
             }
@@ -48,16 +428,69 @@ CommandLineArguments ParseCommandLineArgs(int argc, char **argv)
         }
     }
 
-    if (cli_args.compile_source_path.length() == 0)
+    if (!cli_args.server_socket.empty())
+    {
+        if (!cli_args.compile_source_paths.empty() || !cli_args.compile_output_path.empty())
+        {
+            std::cerr << "--server takes its sources from clients, not -S and -o." << std::endl;
+            exit(2);
+        }
+        return cli_args;
+    }
+
+    if (cli_args.compile_source_paths.empty())
     {
         std::cerr << "The source path -S argument was not set." << std::endl;
         exit(2);
     }
 
-    if (cli_args.compile_output_path.length() == 0)
+    if (cli_args.options.whole_program)
     {
-        std::cerr << "The output path -o argument was not set." << std::endl;
-        exit(2);
+        for (const auto& output : manifest_outputs)
+        {
+            if (!output.empty())
+            {
+                std::cerr << "A -fwhole-program build has one output; give it with -o, not in the manifest." << std::endl;
+                exit(2);
+            }
+        }
+    }
+    else
+    {
+        cli_args.driver = manifest || cli_args.compile_source_paths.size() > 1;
+    }
+
+    if (!cli_args.driver)
+    {
+        if (cli_args.compile_output_path.length() == 0)
+        {
+            std::cerr << "The output path -o argument was not set." << std::endl;
+            exit(2);
+        }
+        return cli_args;
+    }
+
+    // each unit goes to the output its manifest line names, or to <dir>/<stem>.s under -o
+    std::set<std::string> seen;
+    for (size_t i = 0; i < cli_args.compile_source_paths.size(); i++)
+    {
+        std::string output = manifest_outputs[i];
+        if (output.empty())
+        {
+            if (cli_args.compile_output_path.length() == 0)
+            {
+                std::cerr << "The output directory -o argument was not set for " << cli_args.compile_source_paths[i] << "." << std::endl;
+                exit(2);
+            }
+            const std::filesystem::path stem = std::filesystem::path(cli_args.compile_source_paths[i]).stem();
+            output = (std::filesystem::path(cli_args.compile_output_path) / stem).string() + ".s";
+        }
+        if (!seen.insert(output).second)
+        {
+            std::cerr << "Two translation units would both be compiled to " << output << "." << std::endl;
+            exit(2);
+        }
+        cli_args.compile_output_paths.push_back(output);
     }
 
     return cli_args;
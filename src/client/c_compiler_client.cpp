@@ -0,0 +1,113 @@
+// Thin front end for a resident `c_compiler --server`: takes the same
+// -S/-o/-f/-m arguments as c_compiler, sends the source to the server and
+// writes the assembly it returns, so a build pays for a socket round trip
+// rather than for starting the compiler.
+//
+// ./bin/c_compiler_client [--socket path] [-f<flag>...] [-m<flag>...] -S [source-file.c] -o [dest-file.s]
+//
+// The socket defaults to $C_COMPILER_SOCKET, then /tmp/c_compiler.sock.
+// Paths inside flags (-fprofile-use=...) are opened by the server.
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <getopt.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "server_protocol.hpp"
+
+int main(int argc, char **argv)
+{
+    const char* socket_env = std::getenv("C_COMPILER_SOCKET");
+    std::string socket_path = socket_env ? socket_env : DEFAULT_SERVER_SOCKET;
+    std::string source_path;
+    std::string output_path;
+    CompileRequest request;
+
+    opterr = 0;
+    static const option long_options[] = {
+        {"socket", required_argument, nullptr, 'L'},
+        {nullptr, 0, nullptr, 0},
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "S:o:f:m:", long_options, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+        case 'L':
+            socket_path = optarg;
+            break;
+        case 'S':
+            source_path = optarg;
+            break;
+        case 'o':
+            output_path = optarg;
+            break;
+        case 'f':
+        case 'm':
+            request.flags.push_back(std::string("-") + static_cast<char>(opt) + optarg);
+            break;
+        default:
+            std::cerr << "Exiting due to failure to parse CLI args" << std::endl;
+            return 2;
+        }
+    }
+    if (source_path.empty() || output_path.empty())
+    {
+        std::cerr << "Both the source path -S and the output path -o must be set." << std::endl;
+        return 2;
+    }
+
+    std::ifstream source(source_path, std::ios::binary);
+    if (!source)
+    {
+        std::cerr << "Couldn't open input file: " << source_path << std::endl;
+        return 1;
+    }
+    std::ostringstream text;
+    text << source.rdbuf();
+    request.source_name = source_path;
+    request.source_text = text.str();
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path is too long: " << socket_path << std::endl;
+        return 3;
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection < 0 || connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        std::cerr << "No compile server at " << socket_path << ": " << std::strerror(errno) << std::endl;
+        return 3;
+    }
+
+    CompileResponse response;
+    if (!protocol::SendRequest(connection, request) || !protocol::ReceiveResponse(connection, response))
+    {
+        std::cerr << "The compile server at " << socket_path << " hung up" << std::endl;
+        close(connection);
+        return 3;
+    }
+    close(connection);
+
+    if (!response.ok)
+    {
+        std::cerr << response.log;
+        return 1;
+    }
+    std::cout << response.log;
+
+    std::ofstream output(output_path, std::ios::trunc | std::ios::binary);
+    output << response.assembly;
+    std::cout << "Compiled to: " << output_path << std::endl;
+    return output ? 0 : 1;
+}
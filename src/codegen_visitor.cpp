@@ -3,33 +3,56 @@
 #include "Expression.hpp"
 #include "Statement.hpp"
 #include "EnumDeclaration.hpp"
+#include "analysis_visitor.hpp"
+#include "function_order.hpp"
+#include "register_usage.hpp"
 
-#include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <cmath>
+#include <algorithm>
 
 namespace codegen {
 
+using mir::Opcode;
+using mir::Reg;
+using mir::Imm;
+using mir::Sym;
+using mir::Mem;
+using mir::Hi;
+using mir::Lo;
+
 std::string CodeGenVisitor::getExpressionResult() const {
     return currentExprResult;
 }
 
+void CodeGenVisitor::emit(Opcode opcode, std::initializer_list<mir::Operand> operands) {
+    code->add(mir::Instruction(opcode, operands));
+}
+
+void CodeGenVisitor::emit(const std::string& mnemonic, std::initializer_list<mir::Operand> operands) {
+    code->add(mir::Instruction(mnemonic, operands));
+}
+
 void CodeGenVisitor::visitVariableDeclaration(const ast::VariableDeclaration& decl) {
+    if (decl.isTypedef()) {
+        return;
+    }
     if (decl.getDeclarator() && decl.getDeclarator()->isFunction()) {
         // if no function body then just register as function in context, no codegen
-        std::string funcName = decl.getIdentifier();
-        context.setFunctionReturnType(funcName, decl.getType(), decl.isPointer());
+        context.setFunctionReturnType(decl.getSymbol(), decl.getType(), decl.isPointer());
         return;
     }
     bool isGlobal = context.ScopeDepth() == 0;
-    std::string varName = decl.getIdentifier();
+    Symbol varName = decl.getSymbol();
     if(isGlobal){
         // sets variable to global if not in a function scope
         context.setGlobal(varName);
-        stream << "    .data" << std::endl;
-        stream << "    .align 2" << std::endl;
-        stream << "    .globl " << varName << std::endl;
-        stream << varName << ":" << std::endl;
+        mir::Function data;
+        data.addLine("    .data");
+        data.addLine("    .align 2");
+        data.addLine("    .globl " + varName.str());
+        data.addLabel(varName.str());
 
         // handling global arrays
         if (decl.isArray() && decl.hasInitializer()) {
@@ -51,30 +74,30 @@ void CodeGenVisitor::visitVariableDeclaration(const ast::VariableDeclaration& de
                         for (size_t i = 0; i < expressions.size(); ++i) {
                             auto* literal = expressions[i]->asLiteralExpression();
                             if (literal && literal->getType() == ast::TypeSpecifier::INT) {
-                                stream << "    .byte " << literal->getIntValue() << std::endl;
+                                data.addLine("    .byte", literal->getIntValue());
                             } else if (literal && literal->getType() == ast::TypeSpecifier::CHAR) {
-                                stream << "    .byte " << static_cast<int>(literal->getCharValue()) << std::endl;
+                                data.addLine("    .byte", static_cast<int>(literal->getCharValue()));
                             } else {
-                                stream << "    .byte 0" << std::endl;
+                                data.addLine("    .byte 0");
                             }
                         }
                         for (size_t i = expressions.size(); i < arraySize; ++i) {
-                            stream << "    .byte 0" << std::endl;
+                            data.addLine("    .byte 0");
                         }
                         if (arraySize % 4 != 0) {
-                            stream << "    .align 2" << std::endl;
+                            data.addLine("    .align 2");
                         }
                     } else {
                         // int, float and double arrays
                         for (size_t i = 0; i < expressions.size(); ++i) {
                             auto* literal = expressions[i]->asLiteralExpression();
                             if (literal && literal->getType() == ast::TypeSpecifier::INT) {
-                                stream << "    .word " << literal->getIntValue() << std::endl;
+                                data.addLine("    .word", literal->getIntValue());
 
                             } else if (literal && literal->getType() == ast::TypeSpecifier::FLOAT) {
                                 float floatVal = literal->getFloatValue();
                                 uint32_t bits = *reinterpret_cast<uint32_t*>(&floatVal);
-                                stream << "    .word " << bits << std::endl;
+                                data.addLine("    .word", bits);
 
                             } else if (literal && literal->getType() == ast::TypeSpecifier::DOUBLE) {
                                 double doubleVal = literal->getDoubleValue();
@@ -83,19 +106,19 @@ void CodeGenVisitor::visitVariableDeclaration(const ast::VariableDeclaration& de
                                     uint32_t parts[2];
                                 } doubleUnion;
                                 doubleUnion.d = doubleVal;
-                                stream << "    .word " << doubleUnion.parts[0] << std::endl;
-                                stream << "    .word " << doubleUnion.parts[1] << std::endl;
+                                data.addLine("    .word", doubleUnion.parts[0]);
+                                data.addLine("    .word", doubleUnion.parts[1]);
                             } else {
-                                stream << "    .word 0" << std::endl;
+                                data.addLine("    .word 0");
                             }
 
                         }
                         for (size_t i = expressions.size(); i < arraySize; ++i) {
                             if (decl.getType() == ast::TypeSpecifier::DOUBLE) {
-                                stream << "    .word 0" << std::endl;
-                                stream << "    .word 0" << std::endl;
+                                data.addLine("    .word 0");
+                                data.addLine("    .word 0");
                             } else {
-                                stream << "    .word 0" << std::endl;
+                                data.addLine("    .word 0");
                             }
                         }
                     }
@@ -109,11 +132,11 @@ void CodeGenVisitor::visitVariableDeclaration(const ast::VariableDeclaration& de
             if (decl.hasInitializer()) {
                 auto* literal = decl.getInitializer()->asLiteralExpression();
                 if (literal && literal->getType() == ast::TypeSpecifier::INT) {
-                    stream << "    .word " << literal->getIntValue() << std::endl;
+                    data.addLine("    .word", literal->getIntValue());
                 } else if (literal && literal->getType() == ast::TypeSpecifier::FLOAT) {
                     float floatVal = literal->getFloatValue();
                     uint32_t bits = *reinterpret_cast<uint32_t*>(&floatVal);
-                    stream << "    .word " << bits << std::endl;
+                    data.addLine("    .word", bits);
                 }
                 else if (literal && literal->getType() == ast::TypeSpecifier::DOUBLE) {
                     double doubleVal = literal->getDoubleValue();
@@ -122,18 +145,19 @@ void CodeGenVisitor::visitVariableDeclaration(const ast::VariableDeclaration& de
                         uint32_t parts[2];
                     } doubleUnion;
                     doubleUnion.d = doubleVal;
-                    stream << "    .word " << doubleUnion.parts[0] << std::endl;
-                    stream << "    .word " << doubleUnion.parts[1] << std::endl;
+                    data.addLine("    .word", doubleUnion.parts[0]);
+                    data.addLine("    .word", doubleUnion.parts[1]);
                 }
                 else if (literal && literal->getType() == ast::TypeSpecifier::CHAR) {
-                    stream << "    .byte " << static_cast<int>(literal->getCharValue()) << std::endl;
+                    data.addLine("    .byte", static_cast<int>(literal->getCharValue()));
                 }
             } else {
                 unsigned int size = context.getTypeSize(decl.getType());
-                stream << "    .zero " << size << std::endl;
+                data.addLine("    .zero", size);
             }
-            return;
         }
+        mir::Print(data, output);
+        return;
     }
     // handling local identifiers
 
@@ -151,7 +175,7 @@ void CodeGenVisitor::visitVariableDeclaration(const ast::VariableDeclaration& de
                     arraySize = literalExpr->getIntValue();
                 }
 
-                context.declareArray(decl.getIdentifier(), decl.getType(), arraySize);
+                context.declareArray(decl.getSymbol(), decl.getType(), arraySize);
 
                 if (decl.hasInitializer()) {
                     initArray(decl);
@@ -162,11 +186,11 @@ void CodeGenVisitor::visitVariableDeclaration(const ast::VariableDeclaration& de
         }
         else {
             // normal variables and pointers
-            context.declareVariable(decl.getIdentifier(), decl.getType(), decl.isPointer());
+            context.declareVariable(decl.getSymbol(), decl.getType(), decl.isPointer());
             if (decl.hasInitializer()) {
                 decl.getInitializer()->accept(*this);
                 std::string resultReg = getExpressionResult();
-                context.storeVariable(stream, resultReg, decl.getIdentifier());
+                context.storeVariable(*code, resultReg, decl.getSymbol());
                 context.freeRegister(resultReg);
                 currentExprResult.clear();
             }
@@ -174,23 +198,98 @@ void CodeGenVisitor::visitVariableDeclaration(const ast::VariableDeclaration& de
     }
 }
 
+// true if code makes a call, which needs ra saved
+static bool containsCall(std::initializer_list<const mir::Function*> fragments) {
+    for (const mir::Function* code : fragments) {
+        for (const auto& block : code->blocks) {
+            for (const auto& insn : block.instructions) {
+                if (insn.opcode == Opcode::Call || insn.opcode == Opcode::Tail || insn.opcode == Opcode::Jalr) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// true if reg is read, written or addressed through anywhere in code
+static bool readsOrWrites(std::initializer_list<const mir::Function*> fragments, const std::string& reg) {
+    for (const mir::Function* code : fragments) {
+        for (const auto& block : code->blocks) {
+            for (const auto& insn : block.instructions) {
+                for (const auto& operand : insn.operands) {
+                    bool named = operand.kind == mir::Operand::Kind::Register ||
+                                 operand.kind == mir::Operand::Kind::Memory;
+                    if (named && operand.reg == reg) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// true if code addresses the stack or needs s0 kept for its caller
+static bool needsFrame(std::initializer_list<const mir::Function*> fragments) {
+    return readsOrWrites(fragments, "sp") || readsOrWrites(fragments, "s0");
+}
+
 void CodeGenVisitor::visitFunctionDeclaration(const ast::FunctionDeclaration& decl) {
     if(!decl.hasBody()){
         // just register func in context, don't do any codegen
-        context.setFunctionReturnType(decl.getIdentifier(), decl.getType(), decl.getRetPtr());
+        context.setFunctionReturnType(decl.getSymbol(), decl.getType(), decl.getRetPtr());
         return;
     }
-    stream << "    .text" << std::endl;
-    stream << "    .align 2" << std::endl;
-    stream << "    .globl	" << decl.getIdentifier() << std::endl;
-    stream << "    .type	" << decl.getIdentifier() << ", @function" << std::endl;
-    stream << decl.getIdentifier() << ":" << std::endl;
+    // the function is built as machine instructions, run through the passes
+    // that are enabled and only then printed
+    const CompileOptions& options = context.getOptions();
+    mir::Function function;
+    function.name = decl.getIdentifier();
+    code = &function;
+
+    bool cold = isColdFunction(decl.getIdentifier());
+    function.addLine(std::string("    ") + (cold ? COLD_TEXT_SECTION : ".text"));
+    function.addLine("    .align 2");
+    function.addLine("    .globl\t" + decl.getIdentifier());
+    function.addLine("    .type\t" + decl.getIdentifier() + ", @function");
+    function.addLabel(decl.getIdentifier());
+
+    // -fshrink-wrap, -fomit-frame-pointer: parameter stores, entry code, body and
+    // cold blocks are collected apart and the frame is built around what they use
+    bool shrinkWrap = context.getOptions().shrink_wrap;
+    bool composeFrame = context.prologueDeferred();
+    mir::Function parameterStores;
+    mir::Function entryCode;
+    mir::Function bodyCode;
+    mir::Function tailCode;
+    if (composeFrame) {
+        code = &parameterStores;
+    }
+
+    context.beginFunction(*code, decl.getSymbol(), decl.getType(), decl.getRetPtr());
 
-    context.beginFunction(stream, decl.getIdentifier(), decl.getType(), decl.getRetPtr());
+    AnalysisVisitor functionInfo;
+    decl.getBody()->accept(functionInfo);
+    functionAddressTaken = functionInfo.getAddressTaken();
+    context.setPreferHighRegisters(context.getOptions().ipa_ra && functionInfo.getCallCount() == 0);
+
+    profileBlocks.clear();
+    const auto& branches = functionInfo.getBranchStatements();
+    for (size_t i = 0; i < branches.size(); i++) {
+        profileBlocks[branches[i]] = 1 + 2 * static_cast<int>(i);
+    }
 
     const auto& params = decl.getParameters();
     int intParamIdx = 0;
     int floatParamIdx = 0;
+    bool registerArguments = registerArgumentFunctions.count(decl.getIdentifier()) > 0;
+    if (registerArguments) {
+        // nothing may be allocated over t3-t6 before they are stored
+        for (int i = 0; i < EXTRA_ARGUMENT_REGISTERS; i++) {
+            context.reserveRegister("t" + std::to_string(3 + i));
+        }
+    }
 
     for (size_t i = 0; i < params.size(); i++) {
         const auto& param = params[i];
@@ -198,8 +297,9 @@ void CodeGenVisitor::visitFunctionDeclaration(const ast::FunctionDeclaration& de
         bool isStackParam = false;
         int paramIdx = i;
 
-        if (param->getType() == ast::TypeSpecifier::FLOAT ||
-            param->getType() == ast::TypeSpecifier::DOUBLE) {
+        // a pointer to float is still an address passed in an integer register
+        if (!param->isPointer() && (param->getType() == ast::TypeSpecifier::FLOAT ||
+            param->getType() == ast::TypeSpecifier::DOUBLE)) {
             if (floatParamIdx < 8) {
                 paramReg = "fa" + std::to_string(floatParamIdx);
                 floatParamIdx++;
@@ -210,27 +310,184 @@ void CodeGenVisitor::visitFunctionDeclaration(const ast::FunctionDeclaration& de
             if (intParamIdx < 8) {
                 paramReg = "a" + std::to_string(intParamIdx);
                 intParamIdx++;
+            } else if (registerArguments && intParamIdx < 8 + EXTRA_ARGUMENT_REGISTERS) {
+                paramReg = "t" + std::to_string(intParamIdx - 5);
+                intParamIdx++;
+                paramIdx = 0;   // any register parameter index: gets a frame slot
             } else {
                 isStackParam = true;
+                if (registerArguments) {
+                    paramIdx -= EXTRA_ARGUMENT_REGISTERS;
+                }
             }
         }
-        std::cerr << "DEBUG: Declaring param" << std::endl;
-
-        context.declareParameter(param->getIdentifier(), param->getType(), paramIdx, param->isPointer());
+        context.declareParameter(param->getSymbol(), param->getType(), paramIdx, param->isPointer());
 
         // storing parameters to stack
         if (!isStackParam && !paramReg.empty()) {
-            context.storeVariable(stream, paramReg, param->getIdentifier());
+            context.storeVariable(*code, paramReg, param->getSymbol());
+        }
+    }
+    if (registerArguments) {
+        for (int i = 0; i < EXTRA_ARGUMENT_REGISTERS; i++) {
+            context.freeRegister("t" + std::to_string(3 + i));
+        }
+    }
+
+    std::string earlyExitLabel;
+    if (composeFrame) {
+        // parameters that are never written or addressed can be read from their argument registers
+        bool incoming = shrinkWrap;
+        for (const auto& param : params) {
+            Symbol name = param->getSymbol();
+            if (functionInfo.isModified(name) || functionAddressTaken.count(name)) {
+                incoming = false;
+            }
+        }
+        if (intParamIdx > 8 || floatParamIdx > 8 || params.size() > static_cast<size_t>(intParamIdx + floatParamIdx)) {
+            incoming = false;   // some arrived on the stack
+        }
+        if (incoming) {
+            int intIdx = 0;
+            int floatIdx = 0;
+            for (const auto& param : params) {
+                bool floating = !param->isPointer() && (param->getType() == ast::TypeSpecifier::FLOAT ||
+                                                        param->getType() == ast::TypeSpecifier::DOUBLE);
+                std::string reg = floating ? "fa" + std::to_string(floatIdx++) : "a" + std::to_string(intIdx++);
+                context.setIncomingRegister(param->getSymbol(), reg);
+                if (floating) {
+                    context.reserveFloatingRegister(reg);
+                } else {
+                    context.reserveRegister(reg);
+                }
+                incomingRegisters.push_back(reg);
+            }
+            earlyExitLabel = context.generateUniqueLabel("func_early_exit");
+            entryRegion.body = decl.getBody();
+            entryRegion.frameCode = &bodyCode;
+            entryRegion.returnLabel = context.getFunctionEndLabel(decl.getSymbol());
+            entryRegion.keepIncoming = functionInfo.getCallCount() == 0;
+            context.setFunctionEndLabel(decl.getSymbol(), earlyExitLabel);
+            code = &entryCode;
+        } else {
+            code = &bodyCode;
         }
     }
 
+    emitProfileCounter(0);
+
     if (decl.hasBody()) {
         decl.getBody()->accept(*this);
     }
-    context.endFunction(stream, decl.getIdentifier());
+    if (composeFrame) {
+        openFrame();
+        releaseIncomingRegisters();
+    }
+    context.endFunction(*code, decl.getSymbol());
+    if (composeFrame) {
+        code = &tailCode;
+    }
+
+    // out-of-line blocks go after the epilogue, away from the hot path
+    if (!coldBlocks.empty()) {
+        bool split = context.getOptions().partition_cold && !cold;
+        if (split) {
+            code->addLine(std::string("    ") + COLD_TEXT_SECTION);
+            code->addLabel(decl.getIdentifier() + ".cold");
+        }
+        for (const auto& block : coldBlocks) {
+            code->append(block);
+        }
+        if (split) {
+            code->addLine("    .text");
+        }
+        coldBlocks.clear();
+    }
+
+    if (composeFrame) {
+        code = &function;
+        bool leaf = shrinkWrap && !containsCall({&entryCode, &parameterStores, &bodyCode, &tailCode});
+        bool frame = !shrinkWrap || !leaf || needsFrame({&entryCode, &bodyCode, &tailCode});
+        // with a frame pointer s0 is always set up; without, only an allocated s0 is kept
+        bool saveS0 = !options.omit_frame_pointer ||
+                      readsOrWrites({&entryCode, &parameterStores, &bodyCode, &tailCode}, "s0");
+        if (!frame) {
+            // nothing touches the stack: no prologue, no epilogue
+            function.append(entryCode);
+            function.append(bodyCode);
+        } else if (!needsFrame({&entryCode})) {
+            // the early exits leave before the frame is built
+            function.append(entryCode);
+            context.emitPrologue(function, !leaf, saveS0);
+            function.append(parameterStores);
+            function.append(bodyCode);
+            context.emitEpilogue(function, !leaf, saveS0);
+        } else {
+            context.emitPrologue(function, !leaf, saveS0);
+            function.append(parameterStores);
+            function.append(entryCode);
+            function.append(bodyCode);
+            function.addLabel(earlyExitLabel);
+            context.emitEpilogue(function, !leaf, saveS0);
+            earlyExitLabel.clear();
+        }
+        if (!earlyExitLabel.empty()) {
+            function.addLabel(earlyExitLabel);
+        }
+        emit(Opcode::Jr, {Reg("ra")});
+        function.append(tailCode);
+    }
+    code = nullptr;
+
+    if (options.ipa_ra) {
+        // recursive functions reach their own call unsummarised and stay that way
+        auto clobbered = ClobberedRegisters(function, clobberedRegisters);
+        if (clobbered) {
+            clobberedRegisters[decl.getIdentifier()] = *clobbered;
+        }
+    }
+    if (options.schedule) {
+        ScheduleFunction(function, options.machine, scheduled);
+    }
+    // -freorder-functions: hold the code back until the whole call graph is known
+    if (options.reorder_functions) {
+        emittedFunctions.push_back(std::move(function));
+    } else {
+        mir::Print(function, output);
+    }
+}
+
+// what a binary operator computes in: float wins over double, either over char,
+// and char (compared unsigned) over int
+enum class BinaryOperands { Int, Char, Single, Double };
+
+static BinaryOperands binaryOperands(ast::TypeSpecifier left, ast::TypeSpecifier right) {
+    if (left == ast::TypeSpecifier::INT && right == ast::TypeSpecifier::INT) {
+        return BinaryOperands::Int;
+    }
+    if (left == ast::TypeSpecifier::FLOAT || right == ast::TypeSpecifier::FLOAT) {
+        return BinaryOperands::Single;
+    }
+    if (left == ast::TypeSpecifier::DOUBLE || right == ast::TypeSpecifier::DOUBLE) {
+        return BinaryOperands::Double;
+    }
+    if (left == ast::TypeSpecifier::CHAR || right == ast::TypeSpecifier::CHAR) {
+        return BinaryOperands::Char;
+    }
+    throw std::runtime_error("Invalid binary expression type");
 }
 
 void CodeGenVisitor::visitBinaryExpression(const ast::BinaryExpression& expr) {
+    if (expr.getOperator() == ast::BinaryOp::Type::DIV && emitReciprocalDivision(expr)) {
+        return;
+    }
+    if (context.getOptions().fast_math && (emitSelfComparison(expr) || emitReassociatedChain(expr))) {
+        return;
+    }
+    if (context.getOptions().zbb && emitBitManipulation(expr)) {
+        return;
+    }
+
     expr.getLeft()->accept(*this);
     std::string leftReg = getExpressionResult();
 
@@ -245,14 +502,14 @@ void CodeGenVisitor::visitBinaryExpression(const ast::BinaryExpression& expr) {
     const ast::IdentifierExpression* leftId = expr.getLeft()->asIdentifierExpression();
     const ast::IdentifierExpression* rightId = expr.getRight()->asIdentifierExpression();
     if (leftId) {
-        auto var = context.findVariable(leftId->getName());
+        auto var = context.findVariable(leftId->getSymbol());
         if (var && var->is_pointer) {
             isLeftPtr = true;
             pointeeSize = context.getTypeSize(var->type);
         }
     }
     if (rightId) {
-        auto var = context.findVariable(rightId->getName());
+        auto var = context.findVariable(rightId->getSymbol());
         if (var && var->is_pointer) {
             isRightPtr = true;
             pointeeSize = context.getTypeSize(var->type);
@@ -268,164 +525,127 @@ void CodeGenVisitor::visitBinaryExpression(const ast::BinaryExpression& expr) {
                                 expr.getOperator() != ast::BinaryOp::Type::GT &&
                                 expr.getOperator() != ast::BinaryOp::Type::LE &&
                                 expr.getOperator() != ast::BinaryOp::Type::GE));
+    bool floatOperands = (expr.getLeft()->getType() == ast::TypeSpecifier::FLOAT ||
+                          expr.getLeft()->getType() == ast::TypeSpecifier::DOUBLE ||
+                          expr.getRight()->getType() == ast::TypeSpecifier::FLOAT ||
+                          expr.getRight()->getType() == ast::TypeSpecifier::DOUBLE);
     std::string resultReg;
     if (useFloatingReg) {
         resultReg = context.allocateFloatingRegister({leftReg, rightReg});
+    } else if (context.getOptions().compressed && !floatOperands && !isLeftPtr && !isRightPtr && leftReg[0] != 'f') {
+        // overwrite the left operand: rd == rs1 is what c.add/c.sub/c.and/c.or/c.xor encode
+        resultReg = leftReg;
     } else {
         resultReg = context.allocateRegister({leftReg, rightReg});
     }
 
-    std::string opPrefix;
-    std::string opSuffix;
-    std::string intPrefix;
-    std::string charPrefix;
-    std::string charSuffix;
-    if(expr.getLeft()->getType() == ast::TypeSpecifier::INT && expr.getRight()->getType() == ast::TypeSpecifier::INT){
-        opPrefix = "";
-        opSuffix = "";
-        intPrefix = "s";
-        charPrefix = "";
-        charSuffix = "";
-    }
-    else if(expr.getLeft()->getType() == ast::TypeSpecifier::FLOAT || expr.getRight()->getType() == ast::TypeSpecifier::FLOAT){
-        opPrefix = "f";
-        opSuffix = ".s";
-        intPrefix = "";
-        charPrefix = "";
-        charSuffix = "";
-    }
-    else if(expr.getLeft()->getType() == ast::TypeSpecifier::DOUBLE || expr.getRight()->getType() == ast::TypeSpecifier::DOUBLE){
-        opPrefix = "f";
-        opSuffix = ".d";
-        intPrefix = "";
-        charPrefix = "";
-        charSuffix = "";
-    }
-    else if(expr.getLeft()->getType() == ast::TypeSpecifier::CHAR || expr.getRight()->getType() == ast::TypeSpecifier::CHAR){
-        opPrefix = "";
-        opSuffix = "";
-        intPrefix = "";
-        charPrefix = "s";
-        charSuffix = "u";
-    }
-    else{
-        throw std::runtime_error("Invalid binary expression type");
-    }
+    BinaryOperands operands = binaryOperands(expr.getLeft()->getType(), expr.getRight()->getType());
+    bool floating = operands == BinaryOperands::Single || operands == BinaryOperands::Double;
+    auto pick = [operands](Opcode integer, Opcode character, Opcode single, Opcode dbl) {
+        switch (operands) {
+            case BinaryOperands::Int:       return integer;
+            case BinaryOperands::Char:      return character;
+            case BinaryOperands::Single:    return single;
+            default:                        return dbl;
+        }
+    };
 
     if (!isLeftPtr && !isRightPtr) {
         switch (expr.getOperator()) {
             case ast::BinaryOp::Type::ADD:
-                stream << "    " << opPrefix << "add" << opSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(pick(Opcode::Add, Opcode::Add, Opcode::FaddS, Opcode::FaddD), {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::SUB:
-                stream << "    " << opPrefix << "sub" << opSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(pick(Opcode::Sub, Opcode::Sub, Opcode::FsubS, Opcode::FsubD), {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::MUL:
-                stream << "    " << opPrefix << "mul" << opSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(pick(Opcode::Mul, Opcode::Mul, Opcode::FmulS, Opcode::FmulD), {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::DIV:
-                stream << "    " << opPrefix << "div" << opSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(pick(Opcode::Div, Opcode::Div, Opcode::FdivS, Opcode::FdivD), {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::MOD:
-                stream << "    rem " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(Opcode::Rem, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::LT:
-                stream << "    " << intPrefix << opPrefix << charPrefix << "lt" << opSuffix << charSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(pick(Opcode::Slt, Opcode::Sltu, Opcode::FltS, Opcode::FltD), {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::GT:
-                stream << "    " << intPrefix << opPrefix << charPrefix << "gt" << opSuffix << charSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(pick(Opcode::Sgt, Opcode::Sgtu, Opcode::FgtS, Opcode::FgtD), {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::LE:
-                if(expr.getLeft()->getType() == ast::TypeSpecifier::DOUBLE || expr.getRight()->getType() == ast::TypeSpecifier::DOUBLE
-                    || expr.getLeft()->getType() == ast::TypeSpecifier::FLOAT || expr.getRight()->getType() == ast::TypeSpecifier::FLOAT){
-                        stream << "    fle" << opSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                    }
-                else{
-                    stream << "    sgt" << charSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                    stream << "    xori " << resultReg << ", " << resultReg << ", 1" << std::endl;
+                // integers: !(a > b)
+                emit(pick(Opcode::Sgt, Opcode::Sgtu, Opcode::FleS, Opcode::FleD), {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
+                if (!floating) {
+                    emit(Opcode::Xori, {Reg(resultReg), Reg(resultReg), Imm(1)});
                 }
                 break;
             case ast::BinaryOp::Type::GE:
-                if(expr.getLeft()->getType() == ast::TypeSpecifier::DOUBLE || expr.getRight()->getType() == ast::TypeSpecifier::DOUBLE
-                    || expr.getLeft()->getType() == ast::TypeSpecifier::FLOAT || expr.getRight()->getType() == ast::TypeSpecifier::FLOAT){
-                        stream << "    fge" << opSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                    }
-                else{
-                    stream << "    slt" << charSuffix << " " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                    stream << "    xori " << resultReg << ", " << resultReg << ", 1" << std::endl;
+                // integers: !(a < b)
+                emit(pick(Opcode::Slt, Opcode::Sltu, Opcode::FgeS, Opcode::FgeD), {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
+                if (!floating) {
+                    emit(Opcode::Xori, {Reg(resultReg), Reg(resultReg), Imm(1)});
                 }
                 break;
             case ast::BinaryOp::Type::EQ:
-                if(expr.getLeft()->getType() == ast::TypeSpecifier::DOUBLE || expr.getRight()->getType() == ast::TypeSpecifier::DOUBLE
-                    || expr.getLeft()->getType() == ast::TypeSpecifier::FLOAT || expr.getRight()->getType() == ast::TypeSpecifier::FLOAT){
-                        std::string intResultReg = context.allocateRegister();
-                        stream << "    feq" << opSuffix << " " << intResultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                        resultReg = intResultReg; // need integer reg for result
-                        context.freeRegister(intResultReg);
-                    }
-                else{
-                    stream << "    xor " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                    stream << "    seqz " << resultReg << ", " << resultReg << std::endl;
-                }
-                break;
             case ast::BinaryOp::Type::NE:
-                if(expr.getLeft()->getType() == ast::TypeSpecifier::DOUBLE || expr.getRight()->getType() == ast::TypeSpecifier::DOUBLE
-                    || expr.getLeft()->getType() == ast::TypeSpecifier::FLOAT || expr.getRight()->getType() == ast::TypeSpecifier::FLOAT){
-                        std::string intResultReg = context.allocateRegister();
-                        stream << "    feq" << opSuffix << " " << intResultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                        stream << "    xori " << intResultReg << ", " << intResultReg << ", 1" << std::endl;
-                        resultReg = intResultReg;
-                        context.freeRegister(intResultReg);
+                if (floating) {
+                    std::string intResultReg = context.allocateRegister();
+                    emit(operands == BinaryOperands::Single ? Opcode::FeqS : Opcode::FeqD, {Reg(intResultReg), Reg(leftReg), Reg(rightReg)});
+                    if (expr.getOperator() == ast::BinaryOp::Type::NE) {
+                        emit(Opcode::Xori, {Reg(intResultReg), Reg(intResultReg), Imm(1)});
                     }
-                else{
-                    stream << "    xor " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                    stream << "    snez " << resultReg << ", " << resultReg << std::endl;
+                    context.freeFloatingRegister(resultReg);
+                    resultReg = intResultReg; // need integer reg for result
+                } else {
+                    emit(Opcode::Xor, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
+                    emit(expr.getOperator() == ast::BinaryOp::Type::EQ ? Opcode::Seqz : Opcode::Snez, {Reg(resultReg), Reg(resultReg)});
                 }
                 break;
             case ast::BinaryOp::Type::AND: //Doesn't support FLOAT/DOUBLE
-                stream << "    and " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(Opcode::And, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::OR: //Doesn't support FLOAT/DOUBLE
-                stream << "    or " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(Opcode::Or, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::XOR: //Doesn't support FLOAT/DOUBLE
-                stream << "    xor " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(Opcode::Xor, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::LOGICAL_AND: { //Complicated to do float/double
                 std::string logicalAndLabel1 = context.generateUniqueLabel("LOGICAL_AND");
                 std::string logicalAndLabel2 = context.generateUniqueLabel("LOGICAL_AND");
-                stream << "    mv " << resultReg << ", " << leftReg << std::endl;
-                stream << "    beq " << resultReg << ", " << "zero, " << logicalAndLabel1 << std::endl;
-                stream << "    mv " << resultReg << ", " << rightReg << std::endl;
-                stream << "    beq " << resultReg << ", " << "zero, " << logicalAndLabel1 << std::endl;
-                stream << "    li " << resultReg << ", " << "1" << std::endl;
-                stream << "    j " << logicalAndLabel2 << std::endl;
-                stream << logicalAndLabel1 << ":" << std::endl;
-                stream << "    li " << resultReg << ", " << "0" << std::endl;
-                stream << logicalAndLabel2 << ":" << std::endl;
+                emit(Opcode::Mv, {Reg(resultReg), Reg(leftReg)});
+                emit(Opcode::Beq, {Reg(resultReg), Reg("zero"), Sym(logicalAndLabel1)});
+                emit(Opcode::Mv, {Reg(resultReg), Reg(rightReg)});
+                emit(Opcode::Beq, {Reg(resultReg), Reg("zero"), Sym(logicalAndLabel1)});
+                emit(Opcode::Li, {Reg(resultReg), Imm(1)});
+                emit(Opcode::J, {Sym(logicalAndLabel2)});
+                code->addLabel(logicalAndLabel1);
+                emit(Opcode::Li, {Reg(resultReg), Imm(0)});
+                code->addLabel(logicalAndLabel2);
                 break;
             }
             case ast::BinaryOp::Type::LOGICAL_OR: { //Complicated to do float/double
                 std::string logicalOrLabel1 = context.generateUniqueLabel("LOGICAL_OR");
                 std::string logicalOrLabel2 = context.generateUniqueLabel("LOGICAL_OR");
                 std::string logicalOrLabel3 = context.generateUniqueLabel("LOGICAL_OR");
-                stream << "    mv " << resultReg << ", " << leftReg << std::endl;
-                stream << "    bne " << resultReg << ", " << "zero, " << logicalOrLabel1 << std::endl;
-                stream << "    mv " << resultReg << ", " << rightReg << std::endl;
-                stream << "    beq " << resultReg << ", " << "zero, " << logicalOrLabel2 << std::endl;
-                stream << logicalOrLabel1 << ":" << std::endl;
-                stream << "    li " << resultReg << ", " << "1" << std::endl;
-                stream << "    j " << logicalOrLabel3 << std::endl;
-                stream << logicalOrLabel2 << ":" << std::endl;
-                stream << "    li " << resultReg << ", " << "0" << std::endl;
-                stream << logicalOrLabel3 << ":" << std::endl;
+                emit(Opcode::Mv, {Reg(resultReg), Reg(leftReg)});
+                emit(Opcode::Bne, {Reg(resultReg), Reg("zero"), Sym(logicalOrLabel1)});
+                emit(Opcode::Mv, {Reg(resultReg), Reg(rightReg)});
+                emit(Opcode::Beq, {Reg(resultReg), Reg("zero"), Sym(logicalOrLabel2)});
+                code->addLabel(logicalOrLabel1);
+                emit(Opcode::Li, {Reg(resultReg), Imm(1)});
+                emit(Opcode::J, {Sym(logicalOrLabel3)});
+                code->addLabel(logicalOrLabel2);
+                emit(Opcode::Li, {Reg(resultReg), Imm(0)});
+                code->addLabel(logicalOrLabel3);
                 break;
             }
             case ast::BinaryOp::Type::LEFT_SHIFT: //Doesn't support FLOAT/DOUBLE
-                stream << "    sll " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(Opcode::Sll, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::RIGHT_SHIFT: //Doesn't support FLOAT/DOUBLE
-                stream << "    sra " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(Opcode::Sra, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             default:
                 throw std::runtime_error("Unsupported binary operator");
@@ -440,34 +660,26 @@ void CodeGenVisitor::visitBinaryExpression(const ast::BinaryExpression& expr) {
             case ast::BinaryOp::Type::ADD:
                 if (isLeftPtr && !isRightPtr) {
                     // have to resize integer by pointed-to size
-                    std::string scaleReg = context.allocateRegister({leftReg, rightReg});
-                    stream << "    li " << scaleReg << ", " << pointeeSize << std::endl;
-                    stream << "    mul " << rightReg << ", " << rightReg << ", " << scaleReg << std::endl;
-                    stream << "    add " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                    context.freeRegister(scaleReg);
+                    emitScaledAdd(resultReg, leftReg, rightReg, pointeeSize, {});
                 }
                 else if (!isLeftPtr && isRightPtr) {
-                    std::string scaleReg = context.allocateRegister({leftReg, rightReg});
-                    stream << "    li " << scaleReg << ", " << pointeeSize << std::endl;
-                    stream << "    mul " << leftReg << ", " << leftReg << ", " << scaleReg << std::endl;
-                    stream << "    add " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                    context.freeRegister(scaleReg);
+                    emitScaledAdd(resultReg, rightReg, leftReg, pointeeSize, {});
                 }
                 break;
 
             case ast::BinaryOp::Type::SUB:
                 if (isLeftPtr && !isRightPtr) {
                     std::string scaleReg = context.allocateRegister({leftReg, rightReg});
-                    stream << "    li " << scaleReg << ", " << pointeeSize << std::endl;
-                    stream << "    mul " << rightReg << ", " << rightReg << ", " << scaleReg << std::endl;
-                    stream << "    sub " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Li, {Reg(scaleReg), Imm(pointeeSize)});
+                    emit(Opcode::Mul, {Reg(rightReg), Reg(rightReg), Reg(scaleReg)});
+                    emit(Opcode::Sub, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     context.freeRegister(scaleReg);
                 }
                 else if (isLeftPtr && isRightPtr) {
-                    stream << "    sub " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Sub, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     std::string divReg = context.allocateRegister({resultReg});
-                    stream << "    li " << divReg << ", " << pointeeSize << std::endl;
-                    stream << "    div " << resultReg << ", " << resultReg << ", " << divReg << std::endl;
+                    emit(Opcode::Li, {Reg(divReg), Imm(pointeeSize)});
+                    emit(Opcode::Div, {Reg(resultReg), Reg(resultReg), Reg(divReg)});
                     context.freeRegister(divReg);
                 }
                 break;
@@ -480,45 +692,71 @@ void CodeGenVisitor::visitBinaryExpression(const ast::BinaryExpression& expr) {
     else if(isLeftPtr && isRightPtr) {
         switch (expr.getOperator()) {
             case ast::BinaryOp::Type::EQ:
-                stream << "    xor " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                stream << "    seqz " << resultReg << ", " << resultReg << std::endl;
+                emit(Opcode::Xor, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
+                emit(Opcode::Seqz, {Reg(resultReg), Reg(resultReg)});
                 break;
             case ast::BinaryOp::Type::NE:
-                stream << "    xor " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                stream << "    snez " << resultReg << ", " << resultReg << std::endl;
+                emit(Opcode::Xor, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
+                emit(Opcode::Snez, {Reg(resultReg), Reg(resultReg)});
                 break;
             case ast::BinaryOp::Type::LT:
-                stream << "    slt " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(Opcode::Slt, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::GT:
-                stream << "    sgt " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                emit(Opcode::Sgt, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                 break;
             case ast::BinaryOp::Type::LE:
-                stream << "    sgt " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                stream << "    xori " << resultReg << ", " << resultReg << ", 1" << std::endl;
+                emit(Opcode::Sgt, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
+                emit(Opcode::Xori, {Reg(resultReg), Reg(resultReg), Imm(1)});
                 break;
             case ast::BinaryOp::Type::GE:
-                stream << "    slt " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
-                stream << "    xori " << resultReg << ", " << resultReg << ", 1" << std::endl;
+                emit(Opcode::Slt, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
+                emit(Opcode::Xori, {Reg(resultReg), Reg(resultReg), Imm(1)});
                 break;
             default:
                 throw std::runtime_error("illegal pointer comparison");
         }
     }
 
-    if (!useFloatingReg){
-        context.freeRegister(leftReg);
-        context.freeRegister(rightReg);
-    } else {
-        context.freeFloatingRegister(leftReg);
-        context.freeFloatingRegister(rightReg);
+    // operands are released by register file, a float comparison has an int result
+    for (const auto& reg : {leftReg, rightReg}) {
+        if (reg[0] == 'f') {
+            context.freeFloatingRegister(reg);
+        } else if (reg != resultReg) {
+            context.freeRegister(reg);
+        }
     }
     currentExprResult = resultReg;
 }
 
 void CodeGenVisitor::visitUnaryExpression(const ast::UnaryExpression& expr) {
+    if (expr.getOperator() == ast::UnaryOp::Type::LOGICAL_NOT &&
+        context.getOptions().fast_math && emitInvertedComparison(expr)) {
+        return;
+    }
+
     std::string resultReg;
-    std::string varName;
+    Symbol varName;
+
+    if (expr.getOperator() == ast::UnaryOp::Type::DEREFERENCE) {
+        TypeSpecifier pointeeType = getPointeeType(expr.getOperand());
+        MemoryOperand operand = emitPointerAddress(expr.getOperand(), {});
+        if (pointeeType == TypeSpecifier::FLOAT || pointeeType == TypeSpecifier::DOUBLE) {
+            resultReg = context.allocateFloatingRegister();
+        } else {
+            // the address register is dead after the load, reuse it
+            resultReg = operand.temps.back();
+            operand.temps.pop_back();
+        }
+        if (pointeeType == TypeSpecifier::CHAR) {
+            emit(Opcode::Lb, {Reg(resultReg), operand.address()});
+        } else {
+            emit(loadOpcode(pointeeType), {Reg(resultReg), operand.address()});
+        }
+        releaseOperand(operand);
+        currentExprResult = resultReg;
+        return;
+    }
 
     // eaiser to just seperate
     if (expr.getOperator() == ast::UnaryOp::Type::PRE_INCREMENT ||
@@ -528,7 +766,7 @@ void CodeGenVisitor::visitUnaryExpression(const ast::UnaryExpression& expr) {
 
         const ast::IdentifierExpression* idExpr = expr.getOperand()->asIdentifierExpression();
         if (idExpr) {
-            varName = idExpr->getName();
+            varName = idExpr->getSymbol();
         } else {
             throw std::runtime_error("complex expressions in increment/decrement not implemented yet");
         }
@@ -545,78 +783,55 @@ void CodeGenVisitor::visitUnaryExpression(const ast::UnaryExpression& expr) {
             // don't do anything for this?
             break;
         case ast::UnaryOp::Type::MINUS:
-            stream << "    neg " << resultReg << ", " << resultReg << std::endl;
+            emit(Opcode::Neg, {Reg(resultReg), Reg(resultReg)});
             break;
         case ast::UnaryOp::Type::LOGICAL_NOT:
-            stream << "    seqz " << resultReg << ", " << resultReg << std::endl;
+            emit(Opcode::Seqz, {Reg(resultReg), Reg(resultReg)});
             break;
         case ast::UnaryOp::Type::BITWISE_NOT:
-            stream << "    not " << resultReg << ", " << resultReg << std::endl;
+            emit(Opcode::Not, {Reg(resultReg), Reg(resultReg)});
             break;
         case ast::UnaryOp::Type::ADDRESS_OF: {
             const IdentifierExpression* idExpr = expr.getOperand()->asIdentifierExpression();
-            std::string varName = idExpr->getName();
+            Symbol varName = idExpr->getSymbol();
             auto var = context.findVariable(varName);
             // getting base frame address
-            stream << "    addi " << resultReg << ", s0, " << var->stack_offset << std::endl;
-            break;
-        }
-
-        case ast::UnaryOp::Type::DEREFERENCE: {
-            std::string addrReg = resultReg;
-            auto* pointeeExpr = expr.getOperand()->asIdentifierExpression();
-            TypeSpecifier pointeeType = TypeSpecifier::INT;
-            if (pointeeExpr) {
-                //get pointee type
-                auto var = context.findVariable(pointeeExpr->getName());
-                if (var && var->is_pointer) {
-                    pointeeType = var->type;
-                }
-            }
-            if (pointeeType == TypeSpecifier::CHAR) {
-                stream << "    lb " << resultReg << ", 0(" << addrReg << ")" << std::endl;
-            } else if (pointeeType == TypeSpecifier::FLOAT) {
-                stream << "    flw " << resultReg << ", 0(" << addrReg << ")" << std::endl;
-            } else if (pointeeType == TypeSpecifier::DOUBLE) {
-                stream << "    fld " << resultReg << ", 0(" << addrReg << ")" << std::endl;
-            } else {
-                stream << "    lw " << resultReg << ", 0(" << addrReg << ")" << std::endl;
-            }
+            emit(Opcode::Addi, {Reg(resultReg), Reg(context.frameBase()), Imm(var->stack_offset)});
             break;
         }
 
         case ast::UnaryOp::Type::PRE_INCREMENT: {
             // For ++x: load-> increment-> store-> return new value
-            context.loadVariable(stream, resultReg, varName);
-            stream << "    addi " << resultReg << ", " << resultReg << ", 1" << std::endl;
-            context.storeVariable(stream, resultReg, varName);
+            context.loadVariable(*code, resultReg, varName);
+            emit(Opcode::Addi, {Reg(resultReg), Reg(resultReg), Imm(1)});
+            context.storeVariable(*code, resultReg, varName);
             break;
         }
 
         case ast::UnaryOp::Type::POST_INCREMENT: {
             // For x++: load-> save original value-> increment-> store-> return original
             std::string tempReg = context.allocateRegister();
-            context.loadVariable(stream, tempReg, varName);  // Load into temp
-            stream << "    mv " << resultReg << ", " << tempReg << std::endl;  // Save original
-            stream << "    addi " << tempReg << ", " << tempReg << ", 1" << std::endl;  // Increment temp
-            context.storeVariable(stream, tempReg, varName);  // Store back
+            context.loadVariable(*code, tempReg, varName);  // Load into temp
+            emit(Opcode::Mv, {Reg(resultReg), Reg(tempReg)});  // Save original
+            emit(Opcode::Addi, {Reg(tempReg), Reg(tempReg), Imm(1)});  // Increment temp
+            context.storeVariable(*code, tempReg, varName);  // Store back
             context.freeRegister(tempReg);
             break;
         }
 
         case ast::UnaryOp::Type::PRE_DECREMENT: {
-            context.loadVariable(stream, resultReg, varName);
-            stream << "    addi " << resultReg << ", " << resultReg << ", -1" << std::endl;
-            context.storeVariable(stream, resultReg, varName);
+            context.loadVariable(*code, resultReg, varName);
+            emit(Opcode::Addi, {Reg(resultReg), Reg(resultReg), Imm(-1)});
+            context.storeVariable(*code, resultReg, varName);
             break;
         }
 
         case ast::UnaryOp::Type::POST_DECREMENT: {
             std::string tempReg = context.allocateRegister();
-            context.loadVariable(stream, tempReg, varName);
-            stream << "    mv " << resultReg << ", " << tempReg << std::endl;
-            stream << "    addi " << tempReg << ", " << tempReg << ", -1" << std::endl;
-            context.storeVariable(stream, tempReg, varName);
+            context.loadVariable(*code, tempReg, varName);
+            emit(Opcode::Mv, {Reg(resultReg), Reg(tempReg)});
+            emit(Opcode::Addi, {Reg(tempReg), Reg(tempReg), Imm(-1)});
+            context.storeVariable(*code, tempReg, varName);
             context.freeRegister(tempReg);
             break;
         }
@@ -632,7 +847,7 @@ void CodeGenVisitor::visitLiteralExpression(const ast::LiteralExpression& expr)
     switch (expr.getType()) {
         case ast::TypeSpecifier::INT:{
             std::string reg = context.allocateRegister();
-            stream << "    li " << reg << ", " << expr.getIntValue() << std::endl;
+            emit(Opcode::Li, {Reg(reg), Imm(expr.getIntValue())});
             currentExprResult = reg;
             break;
         }
@@ -642,12 +857,11 @@ void CodeGenVisitor::visitLiteralExpression(const ast::LiteralExpression& expr)
 
             std::string intReg = context.allocateRegister();
             std::string floatReg = context.allocateFloatingRegister();
-            stream << "    lui " << intReg << ",%hi(" << memLabel << ")" << std::endl;
-            stream << "    flw " << floatReg << ",%lo(" << memLabel << ")(" << intReg << ")" << std::endl;
+            emit(Opcode::Lui, {Reg(intReg), Hi(memLabel)});
+            emit(Opcode::Flw, {Reg(floatReg), Mem(Lo(memLabel), intReg)});
             context.freeRegister(intReg);
             currentExprResult = floatReg;
             context.storeFloatValue(floatVal);
-            context.freeFloatingRegister(floatReg);
             break;
         }
         case ast::TypeSpecifier::DOUBLE:{
@@ -655,17 +869,16 @@ void CodeGenVisitor::visitLiteralExpression(const ast::LiteralExpression& expr)
             std::string memLabel = context.getDoubleLabel(doubleVal);
             std::string intReg = context.allocateRegister();
             std::string floatReg = context.allocateFloatingRegister();
-            stream << "    lui " << intReg << ",%hi(" << memLabel << ")" << std::endl;
-            stream << "    fld " << floatReg << ",%lo(" << memLabel << ")(" << intReg << ")" << std::endl;
+            emit(Opcode::Lui, {Reg(intReg), Hi(memLabel)});
+            emit(Opcode::Fld, {Reg(floatReg), Mem(Lo(memLabel), intReg)});
             context.freeRegister(intReg);
             currentExprResult = floatReg;
             context.storeDoubleValue(doubleVal);
-            context.freeFloatingRegister(floatReg);
             break;
         }
         case ast::TypeSpecifier::CHAR:{
             std::string reg = context.allocateRegister();
-            stream << "    li " << reg << ", " << static_cast<int>(expr.getCharValue()) << std::endl;
+            emit(Opcode::Li, {Reg(reg), Imm(static_cast<int>(expr.getCharValue()))});
             currentExprResult = reg;
             break;
         }
@@ -675,32 +888,41 @@ void CodeGenVisitor::visitLiteralExpression(const ast::LiteralExpression& expr)
 }
 
 void CodeGenVisitor::visitStringLiteralExpression(const ast::StringLiteralExpression& expr) {
-    std::string stringValue = expr.getValue();
-    std::string memLabel = context.getStringLabel(stringValue);
+    const std::string& stringValue = expr.getValue();
+    std::string memLabel = context.getStringLabel(expr.getSymbol());
     std::string intReg = context.allocateRegister();
-    stream << "    lui " << intReg << ",%hi(" << memLabel << ")" << std::endl;
-    stream << "    addi " << intReg << ", " << intReg << ",%lo(" << memLabel << ")" << std::endl;
+    emit(Opcode::Lui, {Reg(intReg), Hi(memLabel)});
+    emit(Opcode::Addi, {Reg(intReg), Reg(intReg), Lo(memLabel)});
     currentExprResult = intReg;
     context.storeStringValue(stringValue);
     context.freeRegister(intReg);
 }
 
 void CodeGenVisitor::visitIdentifierExpression(const ast::IdentifierExpression& expr) {
-    std::string name = expr.getName();
+    Symbol name = expr.getSymbol();
     bool exists = context.variableExists(name);
 
     //checking if identifier is an enum
     if (context.isEnumValue(name)) {
         std::string reg = context.allocateRegister();
         int value = context.getEnumValue(name);
-        stream << "    li " << reg << ", " << value << std::endl;
+        emit(Opcode::Li, {Reg(reg), Imm(value)});
         currentExprResult = reg;
         return;
     }
 
     if(exists) {
         auto& mutableExpr = const_cast<ast::IdentifierExpression&>(expr);
-        mutableExpr.setType(context.getType(expr.getName()));
+        mutableExpr.setType(context.getType(expr.getSymbol()));
+
+        // an array used as a value decays to the address of its first element
+        auto var = context.findVariable(name);
+        if (var->is_array && !var->is_pointer) {
+            std::string reg = context.allocateRegister();
+            emitArrayBase(name, reg);
+            currentExprResult = reg;
+            return;
+        }
     }
 
     // first check global, then local
@@ -708,41 +930,41 @@ void CodeGenVisitor::visitIdentifierExpression(const ast::IdentifierExpression&
         if (expr.getType() == ast::TypeSpecifier::INT) {
             std::string reg1 = context.allocateRegister();
             std::string regDest = context.allocateRegister();
-            stream << "    lui " << reg1 << ", %hi(" << name << ")" << std::endl;
-            stream << "    lw " << regDest << ", " << "%lo(" << name << ")(" << reg1 << ")" << std::endl;
+            emit(Opcode::Lui, {Reg(reg1), Hi(name.str())});
+            emit(Opcode::Lw, {Reg(regDest), Mem(Lo(name.str()), reg1)});
             context.freeRegister(reg1);
             currentExprResult = regDest;
         } else if (expr.getType() == ast::TypeSpecifier::FLOAT) {
             std::string reg1 = context.allocateRegister();
             std::string regDest = context.allocateFloatingRegister();
-            stream << "    lui " << reg1 << ", %hi(" << name << ")" << std::endl;
-            stream << "    flw " << regDest << ", " << "%lo(" << name << ")(" << reg1 << ")" << std::endl;
+            emit(Opcode::Lui, {Reg(reg1), Hi(name.str())});
+            emit(Opcode::Flw, {Reg(regDest), Mem(Lo(name.str()), reg1)});
             context.freeRegister(reg1);
             currentExprResult = regDest;
         } else if (expr.getType() == ast::TypeSpecifier::DOUBLE) {
             std::string reg1 = context.allocateRegister();
             std::string regDest = context.allocateFloatingRegister();
-            stream << "    lui " << reg1 << ", %hi(" << name << ")" << std::endl;
-            stream << "    fld " << regDest << ", " << "%lo(" << name << ")(" << reg1 << ")" << std::endl;
+            emit(Opcode::Lui, {Reg(reg1), Hi(name.str())});
+            emit(Opcode::Fld, {Reg(regDest), Mem(Lo(name.str()), reg1)});
             context.freeRegister(reg1);
             currentExprResult = regDest;
         } else if (expr.getType() == ast::TypeSpecifier::CHAR) {
             std::string reg1 = context.allocateRegister();
             std::string regDest = context.allocateRegister();
-            stream << "    lui " << reg1 << ", %hi(" << name << ")" << std::endl;
-            stream << "    lbu " << regDest << ", " << "%lo(" << name << ")(" << reg1 << ")" << std::endl;
+            emit(Opcode::Lui, {Reg(reg1), Hi(name.str())});
+            emit(Opcode::Lbu, {Reg(regDest), Mem(Lo(name.str()), reg1)});
             context.freeRegister(reg1);
             currentExprResult = regDest;
             }
     } else {
         if(expr.getType() == ast::TypeSpecifier::CHAR || expr.getType() == ast::TypeSpecifier::INT){
             std::string reg = context.allocateRegister();
-            context.loadVariable(stream, reg, expr.getName());
+            context.loadVariable(*code, reg, expr.getSymbol());
             currentExprResult = reg;
         }
         else if(expr.getType() == ast::TypeSpecifier::DOUBLE || expr.getType() == ast::TypeSpecifier::FLOAT){
             std::string reg = context.allocateFloatingRegister();
-            context.loadVariable(stream, reg, expr.getName());
+            context.loadVariable(*code, reg, expr.getSymbol());
             currentExprResult = reg;
         }
     }
@@ -751,117 +973,264 @@ void CodeGenVisitor::visitIdentifierExpression(const ast::IdentifierExpression&
 void CodeGenVisitor::visitCallExpression(const ast::CallExpression& expr) {
     std::string result;
     int stackArgsSize = 0;
+    // -fomit-frame-pointer: sp stays put, stack arguments go to the bottom of the frame
+    bool fixedFrame = context.getOptions().omit_frame_pointer;
+    struct StackArgument {
+        Opcode opcode;
+        std::string reg;
+        int offset;
+    };
+    std::vector<StackArgument> stackArguments;
+    bool nestedCall = false;
+    const IdentifierExpression* callee = expr.getFunction()->asIdentifierExpression();
+    size_t registerArgs = 8;
+    if (callee && registerArgumentFunctions.count(callee->getName())) {
+        registerArgs += EXTRA_ARGUMENT_REGISTERS;
+    }
+
+    // integer and floating arguments are numbered separately, as on the callee side
+    std::vector<std::string> destRegs;
+    if (expr.hasArguments()) {
+        const auto& nodes = expr.getArguments()->getNodes();
+        destRegs.resize(nodes.size());
+        int intArgIdx = 0;
+        int floatArgIdx = 0;
+        for (size_t i = 0; i < nodes.size() && i < 8; i++) {
+            auto* argExpr = dynamic_cast<const Expression*>(nodes[i]);
+            if(!argExpr) continue;
+            // identifiers are only typed once visited, and arrays or pointers pass an address
+            TypeSpecifier argType = argExpr->asIdentifierExpression() ? inferType(argExpr) : argExpr->getType();
+            if (argType == ast::TypeSpecifier::FLOAT || argType == ast::TypeSpecifier::DOUBLE) {
+                destRegs[i] = "fa" + std::to_string(floatArgIdx++);
+            } else {
+                destRegs[i] = "a" + std::to_string(intArgIdx++);
+            }
+        }
+        // the callee takes integer parameters only, so these are all integers
+        for (size_t i = 8; i < nodes.size() && i < registerArgs; i++) {
+            destRegs[i] = "t" + std::to_string(i - 5);
+        }
+    }
+
+    // Live values are saved before any argument is evaluated, so the stack
+    // arguments below sit right at sp when the call is made.
+    // -fipa-ra: a compiled callee only changes what it was seen to, but loading
+    // the arguments overwrites their registers whatever the callee does
+    std::optional<std::set<std::string>> clobbered;
+    if (callee && clobberedRegisters.count(callee->getName())) {
+        clobbered = clobberedRegisters[callee->getName()];
+        for (const auto& dest : destRegs) {
+            if (!dest.empty()) {
+                clobbered->insert(dest);
+            }
+        }
+    }
+    context.saveRegisters(*code, clobbered ? &*clobbered : nullptr);
 
     //calculate stack space needed for arguments more than 8
     if (expr.hasArguments()) {
         const auto& argList = expr.getArguments();
         const auto& nodes = argList->getNodes();
-        if (nodes.size() > 8) {
-            stackArgsSize = (nodes.size() - 8) * 4;
+        if (nodes.size() > registerArgs) {
+            stackArgsSize = (nodes.size() - registerArgs) * 4;
             if (stackArgsSize % 16 != 0) {
                 stackArgsSize = ((stackArgsSize + 15) / 16) * 16;
             }
-            stream << "    addi sp, sp, -" << stackArgsSize << std::endl;
+            if (!fixedFrame) {
+                emit(Opcode::Addi, {Reg("sp"), Reg("sp"), Imm(-stackArgsSize)});
+            } else if (stackArgsSize > OUTGOING_ARGS_SIZE) {
+                throw std::runtime_error("Too many stack arguments for -fomit-frame-pointer");
+            }
+        }
+        for (const auto& node : nodes) {
+            AnalysisVisitor info;
+            if (node) {
+                node->accept(info);
+            }
+            nestedCall = nestedCall || info.getCallCount() > 0;
         }
     }
 
+    // Register arguments are evaluated into temporaries first and only moved into
+    // a0-a7/fa0-fa7 once every argument is ready, so evaluating one argument can
+    // never clobber another that already sits in its argument register.
+    std::vector<RegisterMove> argMoves;
     if (expr.hasArguments()) {
         const auto& argList = expr.getArguments();
         const auto& nodes = argList->getNodes();
+
         // process args in reverse order for arguments stored on stack
         for (int i = nodes.size() - 1; i >= 0; i--) {
-            auto* argExpr = dynamic_cast<const Expression*>(nodes[i].get());
+            auto* argExpr = dynamic_cast<const Expression*>(nodes[i]);
             if(!argExpr) continue;
-            std::cerr << "DEBUG: Arg expr before accept: type=" << argExpr->getType() << std::endl;
             argExpr->accept(*this);
             std::string argReg = getExpressionResult();
-            if (i < 8) {
-                if (argExpr->getType() == ast::TypeSpecifier::FLOAT ||
-                    argExpr->getType() == ast::TypeSpecifier::DOUBLE) {
-                    std::string destReg = "fa" + std::to_string(i);
-                    if (argReg != destReg) {
-                        if (argExpr->getType() == ast::TypeSpecifier::FLOAT) {
-                            stream << "    fmv.s " << destReg << ", " << argReg << std::endl;
-                        } else {
-                            stream << "    fmv.d " << destReg << ", " << argReg << std::endl;
-                        }
-                        context.freeFloatingRegister(argReg);
-                    }
-                }
-                // default: int argument registers
-                else {
-                    std::string destReg = "a" + std::to_string(i);
-                    if (argReg != destReg) {
-                        stream << "    mv " << destReg << ", " << argReg << std::endl;
-                        context.freeRegister(argReg);
-                    }
+            if (static_cast<size_t>(i) < registerArgs) {
+                if (argReg[0] != 'f') {
+                    argMoves.push_back({destRegs[i], argReg, Opcode::Mv});
+                } else if (argExpr->getType() == ast::TypeSpecifier::FLOAT) {
+                    argMoves.push_back({destRegs[i], argReg, Opcode::FmvS});
+                } else {
+                    argMoves.push_back({destRegs[i], argReg, Opcode::FmvD});
                 }
             } else {
                 // arguments now go on stack
-                int stackOffset = (i - 8) * 4;  // 4 bytes per arg
-                if (argExpr->getType() == ast::TypeSpecifier::FLOAT) {
-                    stream << "    fsw " << argReg << ", " << stackOffset << "(sp)" << std::endl;
+                int stackOffset = (i - registerArgs) * 4;  // 4 bytes per arg
+                if (fixedFrame && nestedCall) {
+                    // stored once every argument is evaluated: the nested call uses the same area
+                    Opcode opcode = argExpr->getType() == ast::TypeSpecifier::FLOAT ? Opcode::Fsw
+                                  : argExpr->getType() == ast::TypeSpecifier::DOUBLE ? Opcode::Fsd : Opcode::Sw;
+                    stackArguments.push_back({opcode, argReg, stackOffset});
+                } else if (argExpr->getType() == ast::TypeSpecifier::FLOAT) {
+                    emit(Opcode::Fsw, {Reg(argReg), Mem(stackOffset, "sp")});
                     context.freeFloatingRegister(argReg);
                 } else if (argExpr->getType() == ast::TypeSpecifier::DOUBLE) {
-                    stream << "    fsd " << argReg << ", " << stackOffset << "(sp)" << std::endl;
+                    emit(Opcode::Fsd, {Reg(argReg), Mem(stackOffset, "sp")});
                     context.freeFloatingRegister(argReg);
                 } else {
-                    stream << "    sw " << argReg << ", " << stackOffset << "(sp)" << std::endl;
+                    emit(Opcode::Sw, {Reg(argReg), Mem(stackOffset, "sp")});
                     context.freeRegister(argReg);
                 }
             }
         }
     }
 
-    context.saveRegisters(stream);
+    // argument temporaries die here
+    for (const auto& move : argMoves) {
+        if (move.opcode == Opcode::Mv) {
+            context.freeRegister(move.source);
+        } else {
+            context.freeFloatingRegister(move.source);
+        }
+    }
+    for (const auto& argument : stackArguments) {
+        emit(argument.opcode, {Reg(argument.reg), Mem(argument.offset, "sp")});
+        context.freeRegister(argument.reg);
+    }
+
+    emitRegisterMoves(argMoves);
 
     const Expression* funcExpr = expr.getFunction();
     TypeSpecifier returnType = expr.getType(&context);
 
     if (const IdentifierExpression* idExpr = funcExpr->asIdentifierExpression()) {
         try {
-            returnType = context.getFunctionReturnType(idExpr->getName());
+            returnType = context.getFunctionReturnType(idExpr->getSymbol());
         } catch (const std::runtime_error&) {
             // leave blank - can just use default int if can't find function
         }
     }
 
     if (const IdentifierExpression* idExpr = funcExpr->asIdentifierExpression()) {
-        stream << "    call " << idExpr->getName() << std::endl;
+        emit(Opcode::Call, {Sym(idExpr->getName())});
+        noteCall(idExpr->getName());
     } else {
+        // keep the loaded arguments out of reach while computing the target
+        for (const auto& move : argMoves) {
+            if (move.opcode == Opcode::Mv) {
+                context.reserveRegister(move.dest);
+            } else {
+                context.reserveFloatingRegister(move.dest);
+            }
+        }
         funcExpr->accept(*this);
         std::string funcReg = getExpressionResult();
+        for (const auto& move : argMoves) {
+            if (move.opcode == Opcode::Mv) {
+                context.freeRegister(move.dest);
+            } else {
+                context.freeFloatingRegister(move.dest);
+            }
+        }
 
-        stream << "    jalr " << funcReg << std::endl;
+        emit(Opcode::Jalr, {Reg(funcReg)});
         context.freeRegister(funcReg);
     }
 
-    if (stackArgsSize > 0) {
-        stream << "    addi sp, sp, " << stackArgsSize << std::endl;
+    if (stackArgsSize > 0 && !fixedFrame) {
+        emit(Opcode::Addi, {Reg("sp"), Reg("sp"), Imm(stackArgsSize)});
     }
 
-    // Restore saved registers
-    context.restoreRegisters(stream);
-
+    // take the return value before restoring, a saved register may be a0/fa0
     std::string resultReg;
     if (returnType == ast::TypeSpecifier::FLOAT || returnType == ast::TypeSpecifier::DOUBLE) {
         resultReg = context.allocateFloatingRegister();
         if (resultReg != "fa0" && returnType == ast::TypeSpecifier::FLOAT) {
-            stream << "    fmv.s " << resultReg << ", fa0" << std::endl;
+            emit(Opcode::FmvS, {Reg(resultReg), Reg("fa0")});
         }
         if (resultReg != "fa0" && returnType == ast::TypeSpecifier::DOUBLE) {
-            stream << "    fmv.d " << resultReg << ", fa0" << std::endl;
+            emit(Opcode::FmvD, {Reg(resultReg), Reg("fa0")});
         }
     } else {
         resultReg = context.allocateRegister();
         if (resultReg != "a0") {
-            stream << "    mv " << resultReg << ", a0" << std::endl;
+            emit(Opcode::Mv, {Reg(resultReg), Reg("a0")});
         }
     }
 
+    // Restore saved registers
+    context.restoreRegisters(*code);
+
     currentExprResult = resultReg;
 }
 
+void CodeGenVisitor::emitRegisterMoves(std::vector<RegisterMove> moves) {
+    // every register involved holds a value still needed, including ones already in place
+    std::set<std::string> busy;
+    for (const auto& move : moves) {
+        busy.insert(move.dest);
+        busy.insert(move.source);
+    }
+    moves.erase(std::remove_if(moves.begin(), moves.end(),
+                    [](const RegisterMove& move) { return move.dest == move.source; }),
+                moves.end());
+
+    while (!moves.empty()) {
+        // any move whose destination no pending move still reads can go now
+        auto ready = std::find_if(moves.begin(), moves.end(), [&](const RegisterMove& move) {
+            return std::none_of(moves.begin(), moves.end(),
+                [&](const RegisterMove& other) { return other.source == move.dest; });
+        });
+        if (ready != moves.end()) {
+            emit(ready->opcode, {Reg(ready->dest), Reg(ready->source)});
+            moves.erase(ready);
+            continue;
+        }
+
+        // only cycles are left: park one source in a scratch register to break it
+        RegisterMove& move = moves.front();
+        bool isFloat = move.opcode != Opcode::Mv;
+        if (!isFloat && !context.hasFreeRegister(busy)) {
+            // every integer register holds an argument: swap the pair in place
+            emit(Opcode::Xor, {Reg(move.dest), Reg(move.dest), Reg(move.source)});
+            emit(Opcode::Xor, {Reg(move.source), Reg(move.dest), Reg(move.source)});
+            emit(Opcode::Xor, {Reg(move.dest), Reg(move.dest), Reg(move.source)});
+            const std::string dest = move.dest;
+            const std::string source = move.source;
+            moves.erase(moves.begin());
+            for (auto& other : moves) {
+                if (other.source == dest) {
+                    other.source = source;
+                } else if (other.source == source) {
+                    other.source = dest;
+                }
+            }
+            moves.erase(std::remove_if(moves.begin(), moves.end(),
+                            [](const RegisterMove& other) { return other.dest == other.source; }),
+                        moves.end());
+            continue;
+        }
+        std::string scratch = isFloat ? context.allocateFloatingRegister(busy) : context.allocateRegister(busy);
+        emit(move.opcode, {Reg(scratch), Reg(move.source)});
+        move.source = scratch;
+        if (isFloat) {
+            context.freeFloatingRegister(scratch);
+        } else {
+            context.freeRegister(scratch);
+        }
+    }
+}
+
 void CodeGenVisitor::visitAssignmentExpression(const ast::AssignmentExpression& expr) {
     expr.getRHS()->accept(*this);
     std::string valueReg = getExpressionResult();
@@ -872,89 +1241,48 @@ void CodeGenVisitor::visitAssignmentExpression(const ast::AssignmentExpression&
 
         // handling pointer assignments
         if(auto* unaryExpr = lhsExpr->asUnaryExpression()) {
-            unaryExpr->getOperand()->accept(*this);
-            std::string addrReg = getExpressionResult();
-            stream << "    sw " << valueReg << ", 0(" << addrReg << ")" << std::endl;
-            context.freeRegister(addrReg);
+            TypeSpecifier pointeeType = getPointeeType(unaryExpr->getOperand());
+            MemoryOperand operand = emitPointerAddress(unaryExpr->getOperand(), {valueReg});
+            emit(storeOpcode(pointeeType), {Reg(valueReg), operand.address()});
+            releaseOperand(operand);
             currentExprResult = valueReg;
             return;
         }
         // for arrays LHS is ArrayAccessExpression
         if (auto* arrayExpr = lhsExpr->asArrayAccessExpression()) {
             if (auto* arrayID = (arrayExpr->getArray())->asIdentifierExpression()) {
-                std::string arrayName = arrayID->getName();
-
-                if(context.isGlobal(arrayName)) {
-                    // global array store
-                    arrayExpr->getIndex()->accept(*this);
-                    std::string indexReg = getExpressionResult();
-                    int elementSize = context.getTypeSize(context.getType(arrayName));
-                    std::string offsetReg = context.allocateRegister({valueReg, indexReg});
-                    stream << "    li " << offsetReg << ", " << elementSize << std::endl;
-                    stream << "    mul " << offsetReg << ", " << indexReg << ", " << offsetReg << std::endl;
-
-                    std::string addrReg = context.allocateRegister({valueReg, indexReg, offsetReg});
-                    stream << "    lui " << addrReg << ", %hi(" << arrayName << ")" << std::endl;
-                    stream << "    addi " << addrReg << ", " << addrReg << ", %lo(" << arrayName << ")" << std::endl;
-                    stream << "    add " << addrReg << ", " << addrReg << ", " << offsetReg << std::endl;
-                    stream << "    sw " << valueReg << ", 0(" << addrReg << ")" << std::endl;
-
-                    context.freeRegister(indexReg);
-                    context.freeRegister(offsetReg);
-                    context.freeRegister(addrReg);
-                } else {
-                    // local array store
-                    auto arrayVar = context.findVariable(arrayName);
-                    arrayExpr->getIndex()->accept(*this);
-                    std::string indexReg = getExpressionResult();
-
-                    // calculating offset
-                    std::string offsetReg = context.allocateRegister({valueReg, indexReg});
-                    int elementSize = context.getTypeSize(arrayVar->type);
-                    stream << "    li " << offsetReg << ", " << elementSize << std::endl;
-                    stream << "    mul " << offsetReg << ", " << indexReg << ", " << offsetReg << std::endl;
-
-                    // calculating final address
-                    std::string addrReg = context.allocateRegister({valueReg, indexReg, offsetReg});
-                    stream << "    add " << addrReg << ", s0, " << offsetReg << std::endl;
-                    stream << "    add " << addrReg << ", " << addrReg << ", " << arrayVar->stack_offset << std::endl;
-                    stream << "    sw " << valueReg << ", 0(" << addrReg << ")" << std::endl;
-
-                    context.freeRegister(indexReg);
-                    context.freeRegister(offsetReg);
-                    context.freeRegister(addrReg);
-                }
-
-
+                TypeSpecifier elementType = context.getType(arrayID->getSymbol());
+                MemoryOperand operand = emitElementAddress(*arrayExpr, {valueReg});
+                emit(storeOpcode(elementType), {Reg(valueReg), operand.address()});
+                releaseOperand(operand);
             }
 
         } else {
             // normal variable assignment
             auto* idExpr = lhsExpr->asIdentifierExpression();
-            std::string varName = idExpr->getName();
+            Symbol varName = idExpr->getSymbol();
 
             if (context.isGlobal(varName)) {
                 std::string addrReg = context.allocateRegister({valueReg});
-                stream << "    lui " << addrReg << ", %hi(" << varName << ")" << std::endl;
-                stream << "    addi " << addrReg << ", " << addrReg << ", %lo(" << varName << ")" << std::endl;
+                emit(Opcode::Lui, {Reg(addrReg), Hi(varName.str())});
                 if(context.getType(varName) == TypeSpecifier::INT){
-                    stream << "    sw " << valueReg << ", 0(" << addrReg << ")" << std::endl;
+                    emit(Opcode::Sw, {Reg(valueReg), Mem(Lo(varName.str()), addrReg)});
                 }
                 else if(context.getType(varName) == TypeSpecifier::FLOAT){
-                    stream << "    fsw " << valueReg << ", 0(" << addrReg << ")" << std::endl;
+                    emit(Opcode::Fsw, {Reg(valueReg), Mem(Lo(varName.str()), addrReg)});
                 }
                 else if(context.getType(varName) == TypeSpecifier::DOUBLE){
-                    stream << "    fsd " << valueReg << ", 0(" << addrReg << ")" << std::endl;
+                    emit(Opcode::Fsd, {Reg(valueReg), Mem(Lo(varName.str()), addrReg)});
                 }
                 else if(context.getType(varName) == TypeSpecifier::CHAR){
-                    stream << "    sb " << valueReg << ", 0(" << addrReg << ")" << std::endl;
+                    emit(Opcode::Sb, {Reg(valueReg), Mem(Lo(varName.str()), addrReg)});
                 }
                 else{
                     throw std::runtime_error("Type not found");
                 }
                 context.freeRegister(addrReg);
             } else {
-                context.storeVariable(stream, valueReg, varName);
+                context.storeVariable(*code, valueReg, varName);
             }
         }
         currentExprResult = valueReg;
@@ -963,13 +1291,13 @@ void CodeGenVisitor::visitAssignmentExpression(const ast::AssignmentExpression&
     // assignments like (+=, *= etc)
     else {
         const Expression* lhsExpr = expr.getLHS();
-        std::string varName;
+        Symbol varName;
 
         if (auto* idExpr = lhsExpr->asIdentifierExpression()) {
-            varName = idExpr->getName();
+            varName = idExpr->getSymbol();
 
             std::string leftReg = context.allocateRegister();
-            context.loadVariable(stream, leftReg, varName);
+            context.loadVariable(*code, leftReg, varName);
 
             expr.getRHS()->accept(*this);
             std::string rightReg = getExpressionResult();
@@ -978,40 +1306,40 @@ void CodeGenVisitor::visitAssignmentExpression(const ast::AssignmentExpression&
 
             switch (expr.getOperator()) {
                 case ast::AssignOp::Type::ADD_ASSIGN:
-                    stream << "    add " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Add, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::SUB_ASSIGN:
-                    stream << "    sub " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Sub, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::MUL_ASSIGN:
-                    stream << "    mul " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Mul, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::DIV_ASSIGN:
-                    stream << "    div " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Div, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::MOD_ASSIGN:
-                    stream << "    rem " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Rem, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::AND_ASSIGN:
-                    stream << "    and " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::And, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::OR_ASSIGN:
-                    stream << "    or " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Or, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::XOR_ASSIGN:
-                    stream << "    xor " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Xor, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::LEFT_ASSIGN:
-                    stream << "    sll " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Sll, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
                 case ast::AssignOp::Type::RIGHT_ASSIGN:
-                    stream << "    sra " << resultReg << ", " << leftReg << ", " << rightReg << std::endl;
+                    emit(Opcode::Sra, {Reg(resultReg), Reg(leftReg), Reg(rightReg)});
                     break;
 
                 default:
                     throw std::runtime_error("Unsupported compound assignment operator");
             }
-            context.storeVariable(stream, resultReg, varName);
+            context.storeVariable(*code, resultReg, varName);
             context.freeRegister(leftReg);
             context.freeRegister(rightReg);
             currentExprResult = resultReg;
@@ -1022,72 +1350,23 @@ void CodeGenVisitor::visitAssignmentExpression(const ast::AssignmentExpression&
 void CodeGenVisitor::visitArrayAccessExpression(const ast::ArrayAccessExpression& expr) {
     const IdentifierExpression* idExpr = expr.getArray()->asIdentifierExpression();
     if(idExpr){
-        std::string arrayName = idExpr->getName();
-        auto arrayVar = context.findVariable(arrayName);
-
-        expr.getIndex()->accept(*this);
-        std::string indexReg = getExpressionResult();
-
-        int elementSize = context.getTypeSize(arrayVar->type);
-        std::string offsetReg = context.allocateRegister({indexReg});
-        stream << "    li " << offsetReg << ", " << elementSize << std::endl;
-        stream << "    mul " << offsetReg << ", " << indexReg << ", " << offsetReg << std::endl;
-
-        TypeSpecifier arrayType = context.getType(idExpr->getName());
+        TypeSpecifier arrayType = context.getType(idExpr->getSymbol());
         bool isFloatingType = (arrayType == ast::TypeSpecifier::FLOAT || arrayType == ast::TypeSpecifier::DOUBLE);
 
-        std::string resultReg;
-
-        if(isFloatingType){
-            resultReg = context.allocateFloatingRegister({indexReg, offsetReg});
-        } else {
-            resultReg = context.allocateRegister({indexReg, offsetReg});
-        }
+        MemoryOperand operand = emitElementAddress(expr, {});
 
-        if (context.isGlobal(arrayName)) {
-            // Global array access
-            std::string addrReg = context.allocateRegister({indexReg, offsetReg, resultReg});
-            stream << "    lui " << addrReg << ", %hi(" << arrayName << ")" << std::endl;
-            stream << "    addi " << addrReg << ", " << addrReg << ", %lo(" << arrayName << ")" << std::endl;
-            stream << "    add " << addrReg << ", " << addrReg << ", " << offsetReg << std::endl;
-
-            if (arrayType == ast::TypeSpecifier::CHAR) {
-                stream << "    lbu " << resultReg << ", 0(" << addrReg << ")" << std::endl;
-            } else if (arrayType == ast::TypeSpecifier::FLOAT) {
-                stream << "    flw " << resultReg << ", 0(" << addrReg << ")" << std::endl;
-            } else if (arrayType == ast::TypeSpecifier::DOUBLE) {
-                stream << "    fld " << resultReg << ", 0(" << addrReg << ")" << std::endl;
-            } else {
-                stream << "    lw " << resultReg << ", 0(" << addrReg << ")" << std::endl;
-            }
-            context.freeRegister(addrReg);
+        std::string resultReg;
+        if (isFloatingType) {
+            resultReg = context.allocateFloatingRegister();
+        } else if (!operand.temps.empty()) {
+            // the address register is dead after the load, reuse it
+            resultReg = operand.temps.back();
+            operand.temps.pop_back();
         } else {
-            // local array access
-            if (arrayVar->is_array) {
-                // calculating final addr - frame pointer + offset
-                stream << "    add " << offsetReg << ", s0, " << offsetReg << std::endl;
-                stream << "    add " << offsetReg << ", " << offsetReg << ", " << arrayVar->stack_offset << std::endl;
-            } else if (arrayVar->is_pointer) {
-                // Pointer indexing
-                std::string ptrReg = context.allocateRegister({indexReg, offsetReg, resultReg});
-                stream << "    lw " << ptrReg << ", " << arrayVar->stack_offset << "(s0)" << std::endl;
-                stream << "    add " << offsetReg << ", " << ptrReg << ", " << offsetReg << std::endl;
-                context.freeRegister(ptrReg);
-            }
-
-            if (arrayType == ast::TypeSpecifier::CHAR) {
-                stream << "    lbu " << resultReg << ", 0(" << offsetReg << ")" << std::endl;
-            } else if (arrayType == ast::TypeSpecifier::FLOAT) {
-                stream << "    flw " << resultReg << ", 0(" << offsetReg << ")" << std::endl;
-            } else if (arrayType == ast::TypeSpecifier::DOUBLE) {
-                stream << "    fld " << resultReg << ", 0(" << offsetReg << ")" << std::endl;
-            } else {
-                stream << "    lw " << resultReg << ", 0(" << offsetReg << ")" << std::endl;
-            }
+            resultReg = context.allocateRegister();
         }
-
-        context.freeRegister(indexReg);
-        context.freeRegister(offsetReg);
+        emit(loadOpcode(arrayType), {Reg(resultReg), operand.address()});
+        releaseOperand(operand);
 
         currentExprResult = resultReg;
     }
@@ -1108,83 +1387,47 @@ void CodeGenVisitor::visitCastExpression(const ast::CastExpression& expr) {
 }
 
 void CodeGenVisitor::visitConditionalExpression(const ast::ConditionalExpression& expr) {
+    if (context.getOptions().zbb && emitMinMax(expr)) {
+        return;
+    }
     std::string falseLabel = context.generateUniqueLabel("condFalse");
     std::string endLabel = context.generateUniqueLabel("condEnd");
-    expr.getThenExpression()->accept(*this); //To get type
-    ast::TypeSpecifier Type = expr.getType();
-    std::cerr << "Cond type: " << Type << std::endl;
-    if(expr.getType() == ast::TypeSpecifier::INT){
-        std::string resultReg = context.allocateRegister();
-        expr.getCondition()->accept(*this);
-        std::string condReg = getExpressionResult();
-        stream << "    beqz " << condReg << ", " << falseLabel << std::endl;
-        expr.getThenExpression()->accept(*this);
-        condReg = getExpressionResult();
-        stream << "    mv " << resultReg << ", " << condReg << std::endl;
-        stream << "    j " << endLabel << std::endl;
-        stream << falseLabel << ":" << std::endl;
-        expr.getElseExpression()->accept(*this);
-        condReg = getExpressionResult();
-        stream << "    mv " << resultReg << ", " << condReg << std::endl;
-        stream << endLabel << ":" << std::endl;
-        currentExprResult = resultReg;
-        context.freeRegister(resultReg);
-    }
-    else if(expr.getType() == ast::TypeSpecifier::FLOAT){
-        std::string resultReg = context.allocateFloatingRegister();
-        expr.getCondition()->accept(*this);
-        std::string condReg = getExpressionResult();
-        stream << "    beqz " << condReg << ", " << falseLabel << std::endl;
-        expr.getThenExpression()->accept(*this);
-        condReg = getExpressionResult();
-        stream << "    fmv.s " << resultReg << ", " << condReg << std::endl;
-        stream << "    j " << endLabel << std::endl;
-        stream << falseLabel << ":" << std::endl;
-        expr.getElseExpression()->accept(*this);
-        condReg = getExpressionResult();
-        stream << "    fmv.s " << resultReg << ", " << condReg << std::endl;
-        stream << endLabel << ":" << std::endl;
-        currentExprResult = resultReg;
-        context.freeRegister(resultReg);
 
-    }
-    else if(expr.getType() == ast::TypeSpecifier::DOUBLE){
-        std::string resultReg = context.allocateFloatingRegister();
-        expr.getCondition()->accept(*this);
-        std::string condReg = getExpressionResult();
-        stream << "    beqz " << condReg << ", " << falseLabel << std::endl;
-        expr.getThenExpression()->accept(*this);
-        condReg = getExpressionResult();
-        stream << "    fmv.d " << resultReg << ", " << condReg << std::endl;
-        stream << "    j " << endLabel << std::endl;
-        stream << falseLabel << ":" << std::endl;
-        expr.getElseExpression()->accept(*this);
-        condReg = getExpressionResult();
-        stream << "    fmv.d " << resultReg << ", " << condReg << std::endl;
-        stream << endLabel << ":" << std::endl;
-        currentExprResult = resultReg;
-        context.freeRegister(resultReg);
-    }
-    else if(expr.getType() == ast::TypeSpecifier::CHAR){
-        std::string resultReg = context.allocateRegister();
-        expr.getCondition()->accept(*this);
-        std::string condReg = getExpressionResult();
-        stream << "    beqz " << condReg << ", " << falseLabel << std::endl;
-        expr.getThenExpression()->accept(*this);
-        condReg = getExpressionResult();
-        stream << "    mv " << resultReg << ", " << condReg << std::endl;
-        stream << "    j " << endLabel << std::endl;
-        stream << falseLabel << ":" << std::endl;
-        expr.getElseExpression()->accept(*this);
-        condReg = getExpressionResult();
-        stream << "    mv " << resultReg << ", " << condReg << std::endl;
-        stream << endLabel << ":" << std::endl;
-        currentExprResult = resultReg;
-        context.freeRegister(resultReg);
-    }
-    else{
+    // typed without evaluating the branch, which may have side effects
+    TypeSpecifier type = inferType(expr.getThenExpression());
+    std::string resultReg;
+    Opcode move;
+    if (type == ast::TypeSpecifier::INT || type == ast::TypeSpecifier::CHAR) {
+        resultReg = context.allocateRegister();
+        move = Opcode::Mv;
+    } else if (type == ast::TypeSpecifier::FLOAT) {
+        resultReg = context.allocateFloatingRegister();
+        move = Opcode::FmvS;
+    } else if (type == ast::TypeSpecifier::DOUBLE) {
+        resultReg = context.allocateFloatingRegister();
+        move = Opcode::FmvD;
+    } else {
         throw std::runtime_error("Conditional op not compatible with type");
     }
+
+    expr.getCondition()->accept(*this);
+    std::string condReg = getExpressionResult();
+    emit(Opcode::Beqz, {Reg(condReg), Sym(falseLabel)});
+    context.freeRegister(condReg);
+
+    expr.getThenExpression()->accept(*this);
+    std::string branchReg = getExpressionResult();
+    emit(move, {Reg(resultReg), Reg(branchReg)});
+    context.freeRegister(branchReg);
+    emit(Opcode::J, {Sym(endLabel)});
+
+    code->addLabel(falseLabel);
+    expr.getElseExpression()->accept(*this);
+    branchReg = getExpressionResult();
+    emit(move, {Reg(resultReg), Reg(branchReg)});
+    context.freeRegister(branchReg);
+    code->addLabel(endLabel);
+    currentExprResult = resultReg;
 }
 
 void CodeGenVisitor::visitCommaExpression(const ast::CommaExpression& expr) {
@@ -1198,14 +1441,13 @@ void CodeGenVisitor::visitSizeofExpression(const ast::SizeofExpression& expr) {
     int sizeOfValue = context.getTypeSize(expr.getType());
 
     const ast::Expression* sizeofExpr = expr.getExpression();
-    std::string arrayName;
+    Symbol arrayName;
     if (const ast::IdentifierExpression* idExpr = sizeofExpr->asIdentifierExpression()) {
-        arrayName = idExpr->getName();
+        arrayName = idExpr->getSymbol();
     }
     int arraySizeMultiplier = context.findArraySize(arrayName);
-    std::cerr << arraySizeMultiplier << std::endl;
     std::string reg = context.allocateRegister();
-    stream << "    li " << reg << ", " << sizeOfValue*arraySizeMultiplier << std::endl;
+    emit(Opcode::Li, {Reg(reg), Imm(sizeOfValue*arraySizeMultiplier)});
     context.freeRegister(reg);
     currentExprResult = reg;
 }
@@ -1213,7 +1455,7 @@ void CodeGenVisitor::visitSizeofExpression(const ast::SizeofExpression& expr) {
 void CodeGenVisitor::visitSizeofTypeExpression(const ast::SizeofTypeExpression& expr) {
     int sizeOfValue = context.getTypeSize(expr.getTargetType());
     std::string reg = context.allocateRegister();
-    stream << "    li " << reg << ", " << sizeOfValue << std::endl;
+    emit(Opcode::Li, {Reg(reg), Imm(sizeOfValue)});
     context.freeRegister(reg);
     currentExprResult = reg;
 }
@@ -1233,20 +1475,25 @@ void CodeGenVisitor::visitCompoundStatement(const ast::CompoundStatement& stmt)
     context.enterScope(false);
 
     const NodeList* declList = stmt.getDeclarationList();
+    bool functionBody = &stmt == entryRegion.body;
+    if (functionBody && declList && !declList->getNodes().empty()) {
+        openFrame();
+    }
     if (declList) {
+        planBlockLocals(stmt);
         for (const auto& nodePtr : declList->getNodes()) {
             if (!nodePtr) {
                 continue;
             }
 
             // direct variable declaration is tried first, then a nestedlist of declarations (nodelist)
-            auto varDecl = dynamic_cast<const VariableDeclaration*>(nodePtr.get());
+            auto varDecl = dynamic_cast<const VariableDeclaration*>(nodePtr);
             if (varDecl) {
                 varDecl->accept(*this);
                 continue;
             }
 
-            auto nestedList = dynamic_cast<const NodeList*>(nodePtr.get());
+            auto nestedList = dynamic_cast<const NodeList*>(nodePtr);
             if (nestedList) {
                 for (const auto& declNode : nestedList->getNodes()) {
                     if (declNode) {
@@ -1261,6 +1508,9 @@ void CodeGenVisitor::visitCompoundStatement(const ast::CompoundStatement& stmt)
 
     const auto& statements = stmt.getStatements();
     for (const auto& s : statements) {
+        if (functionBody && entryRegion.body && !isGuardClause(s)) {
+            openFrame();
+        }
         if (s) {
             s->accept(*this);
         }
@@ -1268,63 +1518,208 @@ void CodeGenVisitor::visitCompoundStatement(const ast::CompoundStatement& stmt)
     context.exitScope();
 }
 
-void CodeGenVisitor::visitIfStatement(const ast::IfStatement& stmt) {
-    stmt.getCondition()->accept(*this);
-    std::string condReg = getExpressionResult();
+// gives Context the block's locals up front, so it can order and pack their slots
+void CodeGenVisitor::planBlockLocals(const ast::CompoundStatement& stmt) {
+    std::vector<const VariableDeclaration*> decls;
+    for (const auto& nodePtr : stmt.getDeclarationList()->getNodes()) {
+        if (auto varDecl = dynamic_cast<const VariableDeclaration*>(nodePtr)) {
+            decls.push_back(varDecl);
+        } else if (auto nestedList = dynamic_cast<const NodeList*>(nodePtr)) {
+            for (const auto& declNode : nestedList->getNodes()) {
+                if (auto nested = dynamic_cast<const VariableDeclaration*>(declNode)) {
+                    decls.push_back(nested);
+                }
+            }
+        }
+    }
 
-    std::string elseLabel = context.generateUniqueLabel("if_else");
-    std::string endLabel = context.generateUniqueLabel("if_end");
+    AnalysisVisitor info;
+    stmt.accept(info);
+    std::vector<Context::FrameSlot> slots;
+    for (const auto* decl : decls) {
+        if (decl->isTypedef() || (decl->getDeclarator() && decl->getDeclarator()->isFunction())) {
+            continue;
+        }
+        Context::FrameSlot slot{decl->getSymbol(), 0, context.getAlignment(decl->getType()),
+                                info.getUseCount(decl->getSymbol()), decl->isArray()};
+        if (decl->isArray()) {
+            const auto* arrayDecl = decl->getDeclarator()->asArrayDeclarator();
+            auto* literalExpr = arrayDecl && arrayDecl->getSize() ? arrayDecl->getSize()->asLiteralExpression() : nullptr;
+            if (!literalExpr || literalExpr->getType() != ast::TypeSpecifier::INT) {
+                continue;
+            }
+            slot.size = context.getTypeSize(decl->getType()) * literalExpr->getIntValue();
+        } else if (decl->isPointer()) {
+            slot.size = POINTER_MEM;
+            slot.align = POINTER_MEM;
+        } else {
+            slot.size = context.getTypeSize(decl->getType());
+        }
+        slots.push_back(slot);
+    }
+    context.planLocals(slots);
+}
 
-    stream << "    beqz " << condReg << ", " << elseLabel << std::endl;
-    context.freeRegister(condReg);
-    stmt.getThenStatement()->accept(*this);
+// if (cond) return value; with nothing in it that calls or stores
+bool CodeGenVisitor::isGuardClause(const Statement* stmt) const {
+    auto* ifStmt = dynamic_cast<const IfStatement*>(stmt);
+    if (!ifStmt || ifStmt->getElseStatement()) {
+        return false;
+    }
+    const Statement* then = ifStmt->getThenStatement();
+    if (auto* block = dynamic_cast<const CompoundStatement*>(then)) {
+        bool declarations = block->getDeclarationList() && !block->getDeclarationList()->getNodes().empty();
+        if (declarations || block->getStatements().size() != 1) {
+            return false;
+        }
+        then = block->getStatements().front();
+    }
+    if (!dynamic_cast<const ReturnStatement*>(then)) {
+        return false;
+    }
+    AnalysisVisitor info;
+    stmt->accept(info);
+    return !info.hasSideEffects();
+}
 
-    if (stmt.hasElseStatement()) {
-        stream << "    j " << endLabel << std::endl;
+// the entry code is over: later code runs with the frame set up
+void CodeGenVisitor::openFrame() {
+    if (!entryRegion.body) {
+        return;
+    }
+    context.setFunctionEndLabel(context.getCurrentFunction(), entryRegion.returnLabel);
+    if (!entryRegion.keepIncoming) {
+        releaseIncomingRegisters();
     }
-    stream << elseLabel << ":" << std::endl;
+    code = entryRegion.frameCode;
+    entryRegion = EntryRegion();
+}
 
-    if (stmt.hasElseStatement()) {
-        stmt.getElseStatement()->accept(*this);
-        stream << endLabel << ":" << std::endl;
+void CodeGenVisitor::releaseIncomingRegisters() {
+    for (const auto& reg : incomingRegisters) {
+        context.freeRegister(reg);
     }
+    incomingRegisters.clear();
+    context.clearIncomingRegisters();
 }
 
-void CodeGenVisitor::visitSwitchStatement(const ast::SwitchStatement& stmt) {
+void CodeGenVisitor::visitIfStatement(const ast::IfStatement& stmt) {
+    int block = profileBlock(stmt);
+    emitProfileCounter(block);
+
     stmt.getCondition()->accept(*this);
-    std::string switchValueReg = getExpressionResult();
-    context.setCurrentSwitchValue(switchValueReg);
-    std::string endSwitchLabel = context.generateUniqueLabel("switch_end");
-    context.pushBreakTarget(endSwitchLabel);
+    std::string condReg = getExpressionResult();
+
+    BranchLayout layout = chooseIfLayout(stmt, block);
+    if (layout == BranchLayout::ElseFirst) {
+        std::string thenLabel = context.generateUniqueLabel("if_then");
+        std::string endLabel = context.generateUniqueLabel("if_end");
+
+        emit(Opcode::Bnez, {Reg(condReg), Sym(thenLabel)});
+        context.freeRegister(condReg);
+        stmt.getElseStatement()->accept(*this);
+        emit(Opcode::J, {Sym(endLabel)});
+        code->addLabel(thenLabel);
+        emitProfileCounter(block + 1);
+        stmt.getThenStatement()->accept(*this);
+        code->addLabel(endLabel);
+        return;
+    }
+    if (layout == BranchLayout::ThenOutOfLine) {
+        std::string thenLabel = context.generateUniqueLabel("if_cold");
+        std::string endLabel = context.generateUniqueLabel("if_end");
+
+        emit(Opcode::Bnez, {Reg(condReg), Sym(thenLabel)});
+        context.freeRegister(condReg);
+        emitOutOfLine(stmt.getThenStatement(), thenLabel, endLabel, block + 1);
+        if (stmt.hasElseStatement()) {
+            stmt.getElseStatement()->accept(*this);
+        }
+        code->addLabel(endLabel);
+        return;
+    }
+    if (layout == BranchLayout::ElseOutOfLine) {
+        std::string elseLabel = context.generateUniqueLabel("if_cold");
+        std::string endLabel = context.generateUniqueLabel("if_end");
+
+        emit(Opcode::Beqz, {Reg(condReg), Sym(elseLabel)});
+        context.freeRegister(condReg);
+        emitOutOfLine(stmt.getElseStatement(), elseLabel, endLabel, -2);
+        emitProfileCounter(block + 1);
+        stmt.getThenStatement()->accept(*this);
+        code->addLabel(endLabel);
+        return;
+    }
+
+    std::string elseLabel = context.generateUniqueLabel("if_else");
+    std::string endLabel = context.generateUniqueLabel("if_end");
+
+    emit(Opcode::Beqz, {Reg(condReg), Sym(elseLabel)});
+    context.freeRegister(condReg);
+    emitProfileCounter(block + 1);
+    stmt.getThenStatement()->accept(*this);
+
+    if (stmt.hasElseStatement()) {
+        emit(Opcode::J, {Sym(endLabel)});
+    }
+    code->addLabel(elseLabel);
+
+    if (stmt.hasElseStatement()) {
+        stmt.getElseStatement()->accept(*this);
+        code->addLabel(endLabel);
+    }
+}
+
+void CodeGenVisitor::visitSwitchStatement(const ast::SwitchStatement& stmt) {
+    emitProfileCounter(profileBlock(stmt));
+    stmt.getCondition()->accept(*this);
+    std::string switchValueReg = getExpressionResult();
+    context.setCurrentSwitchValue(switchValueReg);
+    std::string endSwitchLabel = context.generateUniqueLabel("switch_end");
+    emitProfiledSwitch(stmt, switchValueReg, endSwitchLabel);
+    context.pushBreakTarget(endSwitchLabel);
     stmt.getBody()->accept(*this);
     if (!pendingNextCaseLabel.empty()) {
-        stream << pendingNextCaseLabel << ":" << std::endl;
+        code->addLabel(pendingNextCaseLabel);
         pendingNextCaseLabel.clear();
     }
-    stream << endSwitchLabel << ":" << std::endl;
+    code->addLabel(endSwitchLabel);
     context.popBreakTarget();
     context.clearCurrentSwitchValue();
     context.freeRegister(switchValueReg);
 }
 
 void CodeGenVisitor::visitCaseStatement(const ast::CaseStatement& stmt) {
+    int block = profileBlock(stmt);
+    auto profiled = profiledCaseLabels.find(&stmt);
+    if (profiled != profiledCaseLabels.end()) {
+        // the dispatch emitted by emitProfiledSwitch jumps straight here
+        code->addLabel(profiled->second);
+        emitProfileCounter(block);
+        if (stmt.getStatement()) {
+            stmt.getStatement()->accept(*this);
+        }
+        return;
+    }
+
     if (!pendingNextCaseLabel.empty()) {
-        stream << pendingNextCaseLabel << ":" << std::endl;
+        code->addLabel(pendingNextCaseLabel);
         pendingNextCaseLabel.clear();
     }
     std::string caseLabel = context.generateUniqueLabel("case");
     std::string nextCaseLabel = context.generateUniqueLabel("next_case");
     std::string switchValueReg = context.getCurrentSwitchValue();
     if (stmt.isDefault()) {
-        stream << caseLabel << ":" << std::endl;
+        code->addLabel(caseLabel);
     } else {
         stmt.getCaseValue()->accept(*this);
         std::string caseValueReg = getExpressionResult();
-        stream << "    beq " << switchValueReg << ", " << caseValueReg << ", " << caseLabel << std::endl;
-        stream << "    j " << nextCaseLabel << std::endl;
-        stream << caseLabel << ":" << std::endl;
+        emit(Opcode::Beq, {Reg(switchValueReg), Reg(caseValueReg), Sym(caseLabel)});
+        emit(Opcode::J, {Sym(nextCaseLabel)});
+        code->addLabel(caseLabel);
         context.freeRegister(caseValueReg);
     }
+    emitProfileCounter(block);
     if (stmt.getStatement()) {
         stmt.getStatement()->accept(*this);
         // if more cases
@@ -1334,50 +1729,83 @@ void CodeGenVisitor::visitCaseStatement(const ast::CaseStatement& stmt) {
 
 void CodeGenVisitor::visitDefaultStatement(const ast::DefaultStatement& stmt) {
     std::string defaultLabel = context.generateUniqueLabel("default");
-    stream << defaultLabel << ":" << std::endl;
+    code->addLabel(defaultLabel);
     stmt.getStatement()->accept(*this);
 }
 
 void CodeGenVisitor::visitWhileStatement(const ast::WhileStatement& stmt) {
+    int block = profileBlock(stmt);
+    emitProfileCounter(block);
+    if (context.getOptions().zbb && emitBitCountLoop(nullptr, stmt.getCondition(), stmt.getBody(), nullptr)) {
+        return;
+    }
+    if (context.getOptions().reorder_blocks || context.getProfile()) {
+        emitRotatedWhileLoop(stmt, block);
+        return;
+    }
     std::string startLabel = context.generateUniqueLabel("while_start");
     std::string endLabel = context.generateUniqueLabel("while_end");
     // handle potential break and continue statements
     context.pushBreakTarget(endLabel);
     context.pushContinueTarget(startLabel);
-    stream << startLabel << ":" << std::endl;
+    auto hoisted = hoistInvariantDivisors(stmt);
+    code->addLabel(startLabel);
 
     stmt.getCondition()->accept(*this);
     std::string condReg = getExpressionResult();
 
-    stream << "    beqz " << condReg << ", " << endLabel << std::endl;
+    emit(Opcode::Beqz, {Reg(condReg), Sym(endLabel)});
     context.freeRegister(condReg);
 
+    emitProfileCounter(block + 1);
     stmt.getBody()->accept(*this);
 
-    stream << "    j " << startLabel << std::endl;
-    stream << endLabel << ":" << std::endl;
+    emit(Opcode::J, {Sym(startLabel)});
+    code->addLabel(endLabel);
 
+    dropInvariantDivisors(hoisted);
     context.popBreakTarget();
     context.popContinueTarget();
 }
 
 void CodeGenVisitor::visitDoWhileStatement(const ast::DoWhileStatement& stmt) {
+    int block = profileBlock(stmt);
+    emitProfileCounter(block);
+
     std::string startLabel = context.generateUniqueLabel("do_start");
     std::string condLabel = context.generateUniqueLabel("do_cond");
 
-    stream << startLabel << ":" << std::endl;
+    auto hoisted = hoistInvariantDivisors(stmt);
+    code->addLabel(startLabel);
+    emitProfileCounter(block + 1);
 
     stmt.getBody()->accept(*this);
 
-    stream << condLabel << ":" << std::endl;
+    code->addLabel(condLabel);
     stmt.getCondition()->accept(*this);
     std::string condReg = getExpressionResult();
 
-    stream << "    bnez " << condReg << ", " << startLabel << std::endl;
+    emit(Opcode::Bnez, {Reg(condReg), Sym(startLabel)});
     context.freeRegister(condReg);
+    dropInvariantDivisors(hoisted);
 }
 
 void CodeGenVisitor::visitForStatement(const ast::ForStatement& stmt) {
+    emitProfileCounter(profileBlock(stmt));
+    if (context.getOptions().vector && emitVectorLoop(stmt)) {
+        return;
+    }
+    if (context.getOptions().fast_math && emitReductionLoop(stmt)) {
+        return;
+    }
+    if (context.getOptions().zbb && emitBitCountLoop(stmt.getInitialization(), stmt.getCondition(),
+                                                     stmt.getBody(), stmt.getIncrement())) {
+        return;
+    }
+    emitForLoop(stmt, true);
+}
+
+void CodeGenVisitor::emitForLoop(const ast::ForStatement& stmt, bool withInit) {
     std::string initLabel = context.generateUniqueLabel("for_init");
     std::string condLabel = context.generateUniqueLabel("for_cond");
     std::string incrLabel = context.generateUniqueLabel("for_incr");
@@ -1387,8 +1815,8 @@ void CodeGenVisitor::visitForStatement(const ast::ForStatement& stmt) {
     context.pushBreakTarget(endLabel);
     context.pushContinueTarget(incrLabel);
 
-    stream << initLabel << ":" << std::endl;
-    if (stmt.hasInitialization()) {
+    code->addLabel(initLabel);
+    if (withInit && stmt.hasInitialization()) {
         stmt.getInitialization()->accept(*this);
         if (!currentExprResult.empty()) {
             context.freeRegister(currentExprResult);
@@ -1396,11 +1824,13 @@ void CodeGenVisitor::visitForStatement(const ast::ForStatement& stmt) {
         }
     }
 
-    stream << "    j " << condLabel << std::endl;
-    stream << bodyLabel << ":" << std::endl;
+    auto hoisted = hoistInvariantDivisors(stmt);
+    emit(Opcode::J, {Sym(condLabel)});
+    code->addLabel(bodyLabel);
+    emitProfileCounter(profileBlock(stmt) + 1);
     stmt.getBody()->accept(*this);
 
-    stream << incrLabel << ":" << std::endl;
+    code->addLabel(incrLabel);
     if (stmt.hasIncrement()) {
         stmt.getIncrement()->accept(*this);
         if (!currentExprResult.empty()) {
@@ -1409,20 +1839,21 @@ void CodeGenVisitor::visitForStatement(const ast::ForStatement& stmt) {
         }
     }
 
-    stream << condLabel << ":" << std::endl;
+    code->addLabel(condLabel);
     if (stmt.hasCondition()) {
         stmt.getCondition()->accept(*this);
         std::string condReg = getExpressionResult();
-        stream << "    bnez " << condReg << ", " << bodyLabel << std::endl;
+        emit(Opcode::Bnez, {Reg(condReg), Sym(bodyLabel)});
         context.freeRegister(condReg);
     } else {
-        stream << "    j " << bodyLabel << std::endl;
+        emit(Opcode::J, {Sym(bodyLabel)});
     }
 
-    stream << endLabel << ":" << std::endl;
+    code->addLabel(endLabel);
+    dropInvariantDivisors(hoisted);
 
-    context.pushBreakTarget(endLabel);
-    context.pushContinueTarget(incrLabel);
+    context.popBreakTarget();
+    context.popContinueTarget();
 }
 
 
@@ -1430,46 +1861,48 @@ void CodeGenVisitor::visitReturnStatement(const ast::ReturnStatement& stmt) {
     if (stmt.hasExpression()) {
         stmt.getExpression()->accept(*this);
         std::string resultReg = getExpressionResult();
-        std::string currentFunc = context.getCurrentFunction();
+        Symbol currentFunc = context.getCurrentFunction();
         auto returnType = context.getFunctionReturnType(currentFunc);
 
         if(returnType == ast::TypeSpecifier::FLOAT) {
-            stream << "    fmv.s fa0, " << resultReg << std::endl;
+            emit(Opcode::FmvS, {Reg("fa0"), Reg(resultReg)});
             context.freeFloatingRegister(resultReg);
         }
         else if(returnType == ast::TypeSpecifier::DOUBLE) {
-            stream << "    fmv.d fa0, " << resultReg << std::endl;
+            emit(Opcode::FmvD, {Reg("fa0"), Reg(resultReg)});
             context.freeFloatingRegister(resultReg);
         }
         else {
-            stream << "    mv a0, " << resultReg << std::endl;
+            if (resultReg != "a0") {
+                emit(Opcode::Mv, {Reg("a0"), Reg(resultReg)});
+            }
             context.freeRegister(resultReg);
         }
     }
 
-    std::string currentFunc = context.getCurrentFunction();
-    stream << "    j " << context.getFunctionEndLabel(currentFunc) << std::endl;
+    Symbol currentFunc = context.getCurrentFunction();
+    emit(Opcode::J, {Sym(context.getFunctionEndLabel(currentFunc))});
 }
 
 void CodeGenVisitor::visitBreakStatement(const ast::BreakStatement& stmt) {
     (void)stmt;
     std::string breakTarget = context.getCurrentBreakTarget();
-    stream << "    j " << breakTarget << std::endl;
+    emit(Opcode::J, {Sym(breakTarget)});
 }
 
 void CodeGenVisitor::visitContinueStatement(const ast::ContinueStatement& stmt) {
     (void)stmt;
     std::string continueTarget = context.getContinueTarget();
-    stream << "    j " << continueTarget << std::endl;
+    emit(Opcode::J, {Sym(continueTarget)});
 }
 
 void CodeGenVisitor::visitGotoStatement(const ast::GotoStatement& stmt) {
     std::string labelName = stmt.getLabel()->getName();
-    stream << "    j " << labelName << std::endl;
+    emit(Opcode::J, {Sym(labelName)});
 }
 
 void CodeGenVisitor::visitLabeledStatement(const ast::LabeledStatement& stmt) {
-    stream << stmt.getLabel()->getName() << ":" << std::endl;
+    code->addLabel(stmt.getLabel()->getName());
 
     stmt.getStatement()->accept(*this);
 }
@@ -1490,7 +1923,7 @@ void CodeGenVisitor::visitIdentifierDeclarator(const ast::IdentifierDeclarator&
 void CodeGenVisitor::visitFunctionDeclarator(const ast::FunctionDeclarator& decl) {
     // don't actually do codegen
     // just passing on information to higher-level visitor Declaration functions
-    std::shared_ptr<Declarator> baseDecl = decl.getBaseDeclaratorPtr();
+    const Declarator* baseDecl = decl.getBaseDeclarator();
     if (baseDecl) {
         baseDecl->accept(*this);
     }
@@ -1503,7 +1936,7 @@ void CodeGenVisitor::visitFunctionDeclarator(const ast::FunctionDeclarator& decl
         const auto& params = decl.getParameters()->getParameters();
 
         for (size_t i = 0; i < params.size(); ++i) {
-            auto paramDecl = std::dynamic_pointer_cast<const ParameterDeclaration>(params[i]);
+            auto paramDecl = dynamic_cast<const ParameterDeclaration*>(params[i]);
             if (paramDecl) {
                 ParameterInfo info;
                 info.name = paramDecl->getIdentifier();
@@ -1517,7 +1950,7 @@ void CodeGenVisitor::visitFunctionDeclarator(const ast::FunctionDeclarator& decl
 }
 
 void CodeGenVisitor::visitArrayDeclarator(const ast::ArrayDeclarator& decl) {
-    decl.getBaseDeclaratorPtr()->accept(*this);
+    decl.getBaseDeclarator()->accept(*this);
     if (decl.getSize()) {
         decl.getSize()->accept(*this);
         std::string sizeReg = getExpressionResult();
@@ -1530,7 +1963,7 @@ void CodeGenVisitor::visitArrayDeclarator(const ast::ArrayDeclarator& decl) {
 
 
 void CodeGenVisitor::visitPointerDeclarator(const ast::PointerDeclarator& decl) {
-    decl.getBaseDeclaratorPtr()->accept(*this);
+    decl.getBaseDeclarator()->accept(*this);
 
     isPointerType = true;
 }
@@ -1538,7 +1971,7 @@ void CodeGenVisitor::visitPointerDeclarator(const ast::PointerDeclarator& decl)
 
 void CodeGenVisitor::visitParameterDeclaration(const ast::ParameterDeclaration& decl) {
     if (decl.hasDeclarator()) {
-        context.declareParameter(decl.getIdentifier(), decl.getType(), decl.isPointer());
+        context.declareParameter(decl.getSymbol(), decl.getType(), decl.isPointer());
     } else {
         // Handle unnamed parameter (like in function prototypes)
         context.declareUnnamedParameter(decl.getType());
@@ -1569,13 +2002,13 @@ void CodeGenVisitor::visitInitializerList(const ast::InitializerList& list) {
        initArray is used for array initializations */
     (void)list;
     std::string reg = context.allocateRegister();
-    stream << "    addi " << reg << ", s0, 0" << std::endl;
+    emit(Opcode::Addi, {Reg(reg), Reg(context.frameBase()), Imm(0)});
     currentExprResult = reg;
 }
 
 void CodeGenVisitor::initArray(const ast::VariableDeclaration& decl) {
     auto* initList = decl.getInitializer()->asInitializerList();
-    std::string arrayName = decl.getIdentifier();
+    Symbol arrayName = decl.getSymbol();
     auto var = context.findVariable(arrayName);
     int elementSize = context.getTypeSize(decl.getType());
     int baseAddress = var->stack_offset;
@@ -1588,19 +2021,19 @@ void CodeGenVisitor::initArray(const ast::VariableDeclaration& decl) {
         int offset = baseAddress + (i * elementSize);
 
         if (decl.getType() == ast::TypeSpecifier::FLOAT) {
-            stream << "    fsw " << valueReg << ", " << offset << "(s0)" << std::endl;
+            emit(Opcode::Fsw, {Reg(valueReg), Mem(offset, context.frameBase())});
             context.freeFloatingRegister(valueReg);
 
         } else if (decl.getType() == ast::TypeSpecifier::DOUBLE) {
-            stream << "    fsd " << valueReg << ", " << offset << "(s0)" << std::endl;
+            emit(Opcode::Fsd, {Reg(valueReg), Mem(offset, context.frameBase())});
             context.freeFloatingRegister(valueReg);
 
         } else if (decl.getType() == ast::TypeSpecifier::CHAR) {
-            stream << "    sb " << valueReg << ", " << offset << "(s0)" << std::endl;
+            emit(Opcode::Sb, {Reg(valueReg), Mem(offset, context.frameBase())});
             context.freeRegister(valueReg);
 
         } else {
-            stream << "    sw " << valueReg << ", " << offset << "(s0)" << std::endl;
+            emit(Opcode::Sw, {Reg(valueReg), Mem(offset, context.frameBase())});
             context.freeRegister(valueReg);
         }
     }
@@ -1616,27 +2049,2046 @@ void CodeGenVisitor::visitEnumDeclaration(const ast::EnumDeclaration& decl) {
 
     int nextValue = 0;
     for (const auto& valuePtr : decl.getValues()) {
+        // the value is a constant: there is no code to generate for it, and
+        // at file scope no function to put it in
         if (valuePtr->hasValue()) {
-            valuePtr->getValue()->accept(*this);
-            std::string resultReg = getExpressionResult();
-
             const auto* literalExpr = valuePtr->getValue()->asLiteralExpression();
             if (literalExpr && literalExpr->getType() == ast::TypeSpecifier::INT) {
                 nextValue = literalExpr->getIntValue();
             } else {
                 nextValue = 0;
             }
-
-            if (!currentExprResult.empty()) {
-                context.freeRegister(currentExprResult);
-                currentExprResult.clear();
-            }
         }
 
-        enumType.addValue(valuePtr->getName(), nextValue);
+        enumType.addValue(valuePtr->getSymbol(), nextValue);
         nextValue++;
     }
     context.addEnumType(enumType);
 }
 
+/*******************  ADDRESS GENERATION **********************/
+
+static bool fitsImmediate(int value) {
+    return value >= -2048 && value <= 2047;
+}
+
+static const ast::LiteralExpression* constantIndex(const Expression* expr) {
+    auto* literal = expr->asLiteralExpression();
+    if (literal && (literal->getType() == ast::TypeSpecifier::INT || literal->getType() == ast::TypeSpecifier::CHAR)) {
+        return literal;
+    }
+    return nullptr;
+}
+
+static int constantValue(const ast::LiteralExpression* literal) {
+    if (literal->getType() == ast::TypeSpecifier::CHAR) {
+        return literal->getCharValue();
+    }
+    return literal->getIntValue();
+}
+
+Opcode CodeGenVisitor::loadOpcode(TypeSpecifier type) {
+    switch (type) {
+        case ast::TypeSpecifier::CHAR:   return Opcode::Lbu;
+        case ast::TypeSpecifier::FLOAT:  return Opcode::Flw;
+        case ast::TypeSpecifier::DOUBLE: return Opcode::Fld;
+        default:                         return Opcode::Lw;
+    }
+}
+
+Opcode CodeGenVisitor::storeOpcode(TypeSpecifier type) {
+    switch (type) {
+        case ast::TypeSpecifier::CHAR:   return Opcode::Sb;
+        case ast::TypeSpecifier::FLOAT:  return Opcode::Fsw;
+        case ast::TypeSpecifier::DOUBLE: return Opcode::Fsd;
+        default:                         return Opcode::Sw;
+    }
+}
+
+void CodeGenVisitor::releaseOperand(const MemoryOperand& operand) {
+    for (const auto& reg : operand.temps) {
+        context.freeRegister(reg);
+    }
+}
+
+// dest = base + index * elementSize; with Zba the scaling folds into sh1add/sh2add/sh3add
+void CodeGenVisitor::emitScaledAdd(const std::string& dest, const std::string& base, const std::string& index, int elementSize, const std::set<std::string>& exclude) {
+    int shift = (elementSize == 2) ? 1 : (elementSize == 4) ? 2 : (elementSize == 8) ? 3 : 0;
+    if (context.getOptions().zba && shift != 0) {
+        emit(shift == 1 ? Opcode::Sh1add : shift == 2 ? Opcode::Sh2add : Opcode::Sh3add, {Reg(dest), Reg(index), Reg(base)});
+        return;
+    }
+    if (elementSize != 1) {
+        std::set<std::string> busy = exclude;
+        busy.insert({dest, base, index});
+        std::string scaleReg = context.allocateRegister(busy);
+        emit(Opcode::Li, {Reg(scaleReg), Imm(elementSize)});
+        emit(Opcode::Mul, {Reg(index), Reg(index), Reg(scaleReg)});
+        context.freeRegister(scaleReg);
+    }
+    emit(Opcode::Add, {Reg(dest), Reg(base), Reg(index)});
+}
+
+/* a[k]  local array   -> off+k*size(s0)
+   a[k]  global array  -> lui r, %hi(a+k*size); %lo(a+k*size)(r)
+   p[k]  pointer       -> lw r, p; k*size(r)
+   variable indices still need an add, but the array's frame offset or %lo
+   part stays in the immediate. */
+CodeGenVisitor::MemoryOperand CodeGenVisitor::emitElementAddress(const ast::ArrayAccessExpression& expr, const std::set<std::string>& exclude) {
+    const IdentifierExpression* idExpr = expr.getArray()->asIdentifierExpression();
+    Symbol arrayName = idExpr->getSymbol();
+    auto arrayVar = context.findVariable(arrayName);
+    if (!arrayVar) {
+        throw std::runtime_error("Undefined array: " + arrayName.str());
+    }
+
+    int elementSize = context.getTypeSize(arrayVar->type);
+    const ast::LiteralExpression* literal = constantIndex(expr.getIndex());
+    int constantOffset = literal ? constantValue(literal) * elementSize : 0;
+
+    MemoryOperand operand;
+    std::set<std::string> busy = exclude;
+
+    // globals are always laid out as arrays, locals that are not arrays hold a pointer
+    if (arrayVar->is_pointer || (!arrayVar->is_array && !context.isGlobal(arrayName))) {
+        std::string ptrReg = context.allocateRegister(busy);
+        busy.insert(ptrReg);
+        if (context.isGlobal(arrayName)) {
+            emit(Opcode::Lui, {Reg(ptrReg), Hi(arrayName.str())});
+            emit(Opcode::Lw, {Reg(ptrReg), Mem(Lo(arrayName.str()), ptrReg)});
+        } else {
+            context.loadVariable(*code, ptrReg, arrayName);
+        }
+        operand.base = ptrReg;
+        operand.temps.push_back(ptrReg);
+        if (literal && fitsImmediate(constantOffset)) {
+            operand.displacement = Imm(constantOffset);
+            return operand;
+        }
+        expr.getIndex()->accept(*this);
+        std::string indexReg = getExpressionResult();
+        emitScaledAdd(ptrReg, ptrReg, indexReg, elementSize, busy);
+        context.freeRegister(indexReg);
+        operand.displacement = Imm(0);
+        return operand;
+    }
+
+    if (context.isGlobal(arrayName)) {
+        std::string addrReg;
+        std::string symbol = arrayName.str();
+        if (literal) {
+            if (constantOffset != 0) {
+                symbol += (constantOffset > 0 ? "+" : "") + std::to_string(constantOffset);
+            }
+            addrReg = context.allocateRegister(busy);
+            emit(Opcode::Lui, {Reg(addrReg), Hi(symbol)});
+        } else {
+            // %lo still applies after adding the index to the %hi part
+            expr.getIndex()->accept(*this);
+            addrReg = getExpressionResult();
+            busy.insert(addrReg);
+            std::string hiReg = context.allocateRegister(busy);
+            emit(Opcode::Lui, {Reg(hiReg), Hi(arrayName.str())});
+            emitScaledAdd(addrReg, hiReg, addrReg, elementSize, busy);
+            context.freeRegister(hiReg);
+        }
+        operand.base = addrReg;
+        operand.displacement = Lo(symbol);
+        operand.temps.push_back(addrReg);
+        return operand;
+    }
+
+    // local array, the frame offset always fits the immediate
+    if (literal && fitsImmediate(arrayVar->stack_offset + constantOffset)) {
+        operand.base = context.frameBase();
+        operand.displacement = Imm(arrayVar->stack_offset + constantOffset);
+        return operand;
+    }
+    expr.getIndex()->accept(*this);
+    std::string addrReg = getExpressionResult();
+    emitScaledAdd(addrReg, context.frameBase(), addrReg, elementSize, busy);
+    operand.base = addrReg;
+    operand.displacement = Imm(arrayVar->stack_offset);
+    operand.temps.push_back(addrReg);
+    return operand;
+}
+
+// *p, *(p + k) and *(p - k): the scaled constant becomes the displacement
+CodeGenVisitor::MemoryOperand CodeGenVisitor::emitPointerAddress(const Expression* addrExpr, const std::set<std::string>& exclude) {
+    MemoryOperand operand;
+    operand.displacement = Imm(0);
+
+    // a local pointer is loaded straight into a register clear of exclude
+    auto evaluateBase = [&](const Expression* baseExpr) {
+        auto* pointerId = baseExpr->asIdentifierExpression();
+        auto var = pointerId ? context.findVariable(pointerId->getSymbol()) : std::nullopt;
+        if (var && var->is_pointer && !var->is_array && !context.isGlobal(pointerId->getSymbol())) {
+            std::string ptrReg = context.allocateRegister(exclude);
+            context.loadVariable(*code, ptrReg, pointerId->getSymbol());
+            return ptrReg;
+        }
+        baseExpr->accept(*this);
+        return getExpressionResult();
+    };
+
+    auto* binaryExpr = addrExpr->asBinaryExpression();
+    if (binaryExpr && (binaryExpr->getOperator() == ast::BinaryOp::Type::ADD ||
+                       binaryExpr->getOperator() == ast::BinaryOp::Type::SUB)) {
+        const Expression* pointerExpr = binaryExpr->getLeft();
+        const ast::LiteralExpression* literal = constantIndex(binaryExpr->getRight());
+        if (!literal && binaryExpr->getOperator() == ast::BinaryOp::Type::ADD) {
+            pointerExpr = binaryExpr->getRight();
+            literal = constantIndex(binaryExpr->getLeft());
+        }
+        auto* pointerId = pointerExpr->asIdentifierExpression();
+        auto var = pointerId ? context.findVariable(pointerId->getSymbol()) : std::nullopt;
+        if (literal && var && var->is_pointer) {
+            int offset = constantValue(literal) * context.getTypeSize(var->type);
+            if (binaryExpr->getOperator() == ast::BinaryOp::Type::SUB) {
+                offset = -offset;
+            }
+            if (fitsImmediate(offset)) {
+                operand.base = evaluateBase(pointerExpr);
+                operand.displacement = Imm(offset);
+                operand.temps.push_back(operand.base);
+                return operand;
+            }
+        }
+    }
+
+    operand.base = evaluateBase(addrExpr);
+    operand.temps.push_back(operand.base);
+    return operand;
+}
+
+TypeSpecifier CodeGenVisitor::getPointeeType(const Expression* addrExpr) const {
+    if (auto* binaryExpr = addrExpr->asBinaryExpression()) {
+        TypeSpecifier leftType = getPointeeType(binaryExpr->getLeft());
+        if (leftType != TypeSpecifier::INT) {
+            return leftType;
+        }
+        return getPointeeType(binaryExpr->getRight());
+    }
+    if (auto* pointerId = addrExpr->asIdentifierExpression()) {
+        auto var = context.findVariable(pointerId->getSymbol());
+        if (var && (var->is_pointer || var->is_array)) {
+            return var->type;
+        }
+    }
+    return TypeSpecifier::INT;
+}
+
+/*******************  FLOATING POINT REWRITES **********************/
+
+static bool isFloatingType(TypeSpecifier type) {
+    return type == ast::TypeSpecifier::FLOAT || type == ast::TypeSpecifier::DOUBLE;
+}
+
+// the .s or .d form of an instruction
+static Opcode floatingOpcode(TypeSpecifier type, Opcode single, Opcode dbl) {
+    return (type == ast::TypeSpecifier::FLOAT) ? single : dbl;
+}
+
+TypeSpecifier CodeGenVisitor::inferType(const Expression* expr) const {
+    if (auto* idExpr = expr->asIdentifierExpression()) {
+        if (context.isEnumValue(idExpr->getSymbol())) {
+            return ast::TypeSpecifier::INT;
+        }
+        auto var = context.findVariable(idExpr->getSymbol());
+        if (!var) {
+            return expr->getType();
+        }
+        // the name of an array or pointer is an address
+        if (var->is_pointer || var->is_array) {
+            return ast::TypeSpecifier::INT;
+        }
+        return var->type;
+    }
+    if (auto* literal = expr->asLiteralExpression()) {
+        return literal->getType();
+    }
+    if (auto* arrayExpr = expr->asArrayAccessExpression()) {
+        if (auto* arrayId = arrayExpr->getArray()->asIdentifierExpression()) {
+            auto var = context.findVariable(arrayId->getSymbol());
+            if (var) {
+                return var->type;
+            }
+        }
+        return expr->getType();
+    }
+    if (auto* callExpr = expr->asCallExpression()) {
+        return callExpr->getType(&context);
+    }
+    if (auto* binaryExpr = expr->asBinaryExpression()) {
+        switch (binaryExpr->getOperator()) {
+            case ast::BinaryOp::Type::ADD:
+            case ast::BinaryOp::Type::SUB:
+            case ast::BinaryOp::Type::MUL:
+            case ast::BinaryOp::Type::DIV: {
+                // same precedence as the opcode selection in visitBinaryExpression
+                TypeSpecifier left = inferType(binaryExpr->getLeft());
+                TypeSpecifier right = inferType(binaryExpr->getRight());
+                if (left == ast::TypeSpecifier::FLOAT || right == ast::TypeSpecifier::FLOAT) {
+                    return ast::TypeSpecifier::FLOAT;
+                }
+                if (left == ast::TypeSpecifier::DOUBLE || right == ast::TypeSpecifier::DOUBLE) {
+                    return ast::TypeSpecifier::DOUBLE;
+                }
+                return ast::TypeSpecifier::INT;
+            }
+            default:
+                return ast::TypeSpecifier::INT;
+        }
+    }
+    if (auto* unaryExpr = expr->asUnaryExpression()) {
+        switch (unaryExpr->getOperator()) {
+            case ast::UnaryOp::Type::LOGICAL_NOT:
+            case ast::UnaryOp::Type::ADDRESS_OF:
+                return ast::TypeSpecifier::INT;
+            case ast::UnaryOp::Type::DEREFERENCE:
+                if (auto* ptrId = unaryExpr->getOperand()->asIdentifierExpression()) {
+                    auto var = context.findVariable(ptrId->getSymbol());
+                    if (var && var->is_pointer) {
+                        return var->type;
+                    }
+                }
+                return ast::TypeSpecifier::INT;
+            default:
+                return inferType(unaryExpr->getOperand());
+        }
+    }
+    if (auto* assignExpr = dynamic_cast<const ast::AssignmentExpression*>(expr)) {
+        return inferType(assignExpr->getLHS());
+    }
+    if (auto* condExpr = dynamic_cast<const ast::ConditionalExpression*>(expr)) {
+        return inferType(condExpr->getThenExpression());
+    }
+    if (auto* commaExpr = dynamic_cast<const ast::CommaExpression*>(expr)) {
+        return inferType(commaExpr->getRight());
+    }
+    return expr->getType();
+}
+
+bool CodeGenVisitor::emitReciprocalDivision(const ast::BinaryExpression& expr) {
+    TypeSpecifier type = inferType(&expr);
+    if (!isFloatingType(type) || inferType(expr.getLeft()) != type) {
+        return false;
+    }
+    bool fastMath = context.getOptions().fast_math;
+    Opcode fmul = floatingOpcode(type, Opcode::FmulS, Opcode::FmulD);
+
+    // x / c -> x * (1/c). Exact when c is a power of two, otherwise only under -ffast-math
+    if (auto* literal = expr.getRight()->asLiteralExpression()) {
+        double value;
+        switch (literal->getType()) {
+            case ast::TypeSpecifier::FLOAT:  value = literal->getFloatValue(); break;
+            case ast::TypeSpecifier::DOUBLE: value = literal->getDoubleValue(); break;
+            case ast::TypeSpecifier::INT:    value = literal->getIntValue(); break;
+            default: return false;
+        }
+        if (value == 0.0 || !std::isfinite(value)) {
+            return false;
+        }
+        double reciprocal = 1.0 / value;
+        int exponent;
+        bool exact = std::fabs(std::frexp(value, &exponent)) == 0.5 &&
+            ((type == ast::TypeSpecifier::FLOAT) ? std::isnormal(static_cast<float>(reciprocal)) : std::isnormal(reciprocal));
+        if (!exact && !fastMath) {
+            return false;
+        }
+
+        expr.getLeft()->accept(*this);
+        std::string leftReg = getExpressionResult();
+        if (type == ast::TypeSpecifier::FLOAT) {
+            ast::LiteralExpression(static_cast<float>(reciprocal)).accept(*this);
+        } else {
+            ast::LiteralExpression(reciprocal).accept(*this);
+        }
+        std::string recipReg = getExpressionResult();
+        std::string resultReg = context.allocateFloatingRegister({leftReg, recipReg});
+        emit(fmul, {Reg(resultReg), Reg(leftReg), Reg(recipReg)});
+        context.freeFloatingRegister(leftReg);
+        context.freeFloatingRegister(recipReg);
+        currentExprResult = resultReg;
+        return true;
+    }
+
+    // x / d where the reciprocal of d was computed before the enclosing loop
+    if (auto* idExpr = expr.getRight()->asIdentifierExpression()) {
+        auto it = hoistedReciprocals.find(idExpr->getSymbol());
+        if (it == hoistedReciprocals.end() || inferType(idExpr) != type) {
+            return false;
+        }
+        expr.getLeft()->accept(*this);
+        std::string leftReg = getExpressionResult();
+        std::string recipReg = context.allocateFloatingRegister({leftReg});
+        context.loadVariable(*code, recipReg, it->second);
+        std::string resultReg = context.allocateFloatingRegister({leftReg, recipReg});
+        emit(fmul, {Reg(resultReg), Reg(leftReg), Reg(recipReg)});
+        context.freeFloatingRegister(leftReg);
+        context.freeFloatingRegister(recipReg);
+        currentExprResult = resultReg;
+        return true;
+    }
+    return false;
+}
+
+bool CodeGenVisitor::emitReassociatedChain(const ast::BinaryExpression& expr) {
+    ast::BinaryOp::Type op = expr.getOperator();
+    if (op != ast::BinaryOp::Type::ADD && op != ast::BinaryOp::Type::MUL) {
+        return false;
+    }
+    TypeSpecifier type = inferType(&expr);
+    if (!isFloatingType(type)) {
+        return false;
+    }
+
+    // ((a + b) + c) + d is parsed left leaning, collect a, b, c, d
+    std::vector<const Expression*> operands;
+    const Expression* node = &expr;
+    while (auto* binaryExpr = node->asBinaryExpression()) {
+        if (binaryExpr->getOperator() != op) {
+            break;
+        }
+        operands.push_back(binaryExpr->getRight());
+        node = binaryExpr->getLeft();
+    }
+    operands.push_back(node);
+    if (operands.size() < 3) {
+        return false;
+    }
+    for (const Expression* operand : operands) {
+        AnalysisVisitor operandInfo;
+        operand->accept(operandInfo);
+        // calls would have to spill the partial results we keep in registers
+        if (inferType(operand) != type || operandInfo.getCallCount() > 0) {
+            return false;
+        }
+    }
+
+    std::vector<std::string> regs;
+    for (auto it = operands.rbegin(); it != operands.rend(); ++it) {
+        (*it)->accept(*this);
+        std::string reg = getExpressionResult();
+        if (!context.isFloatingRegisterUsed(reg)) {
+            // literals hand back an already released register, keep the value alive
+            std::string kept = context.allocateFloatingRegister();
+            if (kept != reg) {
+                emit(floatingOpcode(type, Opcode::FmvS, Opcode::FmvD), {Reg(kept), Reg(reg)});
+            }
+            reg = kept;
+        }
+        regs.push_back(reg);
+    }
+
+    // combine as a balanced tree so independent halves can overlap
+    Opcode combine = (op == ast::BinaryOp::Type::ADD) ? floatingOpcode(type, Opcode::FaddS, Opcode::FaddD)
+                                                      : floatingOpcode(type, Opcode::FmulS, Opcode::FmulD);
+    while (regs.size() > 1) {
+        std::vector<std::string> next;
+        for (size_t i = 0; i + 1 < regs.size(); i += 2) {
+            emit(combine, {Reg(regs[i]), Reg(regs[i]), Reg(regs[i + 1])});
+            context.freeFloatingRegister(regs[i + 1]);
+            next.push_back(regs[i]);
+        }
+        if (regs.size() % 2 != 0) {
+            next.push_back(regs.back());
+        }
+        regs = next;
+    }
+    currentExprResult = regs.front();
+    return true;
+}
+
+bool CodeGenVisitor::emitSelfComparison(const ast::BinaryExpression& expr) {
+    auto* leftId = expr.getLeft()->asIdentifierExpression();
+    auto* rightId = expr.getRight()->asIdentifierExpression();
+    if (!leftId || !rightId || leftId->getName() != rightId->getName() || !isFloatingType(inferType(leftId))) {
+        return false;
+    }
+
+    // with no NaNs x == x always holds
+    int value;
+    switch (expr.getOperator()) {
+        case ast::BinaryOp::Type::EQ:
+        case ast::BinaryOp::Type::LE:
+        case ast::BinaryOp::Type::GE:
+            value = 1;
+            break;
+        case ast::BinaryOp::Type::NE:
+        case ast::BinaryOp::Type::LT:
+        case ast::BinaryOp::Type::GT:
+            value = 0;
+            break;
+        default:
+            return false;
+    }
+    std::string reg = context.allocateRegister();
+    emit(Opcode::Li, {Reg(reg), Imm(value)});
+    currentExprResult = reg;
+    return true;
+}
+
+bool CodeGenVisitor::emitInvertedComparison(const ast::UnaryExpression& expr) {
+    auto* compareExpr = expr.getOperand()->asBinaryExpression();
+    if (!compareExpr) {
+        return false;
+    }
+    TypeSpecifier type = inferType(compareExpr->getLeft());
+    if (!isFloatingType(type) || inferType(compareExpr->getRight()) != type) {
+        return false;
+    }
+
+    // with no NaNs !(a < b) is a >= b, so flip the compare instead of adding seqz
+    bool orEqual;
+    bool swap;
+    switch (compareExpr->getOperator()) {
+        case ast::BinaryOp::Type::LT: orEqual = true;  swap = true;  break;
+        case ast::BinaryOp::Type::LE: orEqual = false; swap = true;  break;
+        case ast::BinaryOp::Type::GT: orEqual = true;  swap = false; break;
+        case ast::BinaryOp::Type::GE: orEqual = false; swap = false; break;
+        default: return false;
+    }
+    Opcode compare = orEqual ? floatingOpcode(type, Opcode::FleS, Opcode::FleD)
+                             : floatingOpcode(type, Opcode::FltS, Opcode::FltD);
+
+    compareExpr->getLeft()->accept(*this);
+    std::string leftReg = getExpressionResult();
+    if (!context.isFloatingRegisterUsed(leftReg)) {
+        std::string kept = context.allocateFloatingRegister();
+        if (kept != leftReg) {
+            emit(floatingOpcode(type, Opcode::FmvS, Opcode::FmvD), {Reg(kept), Reg(leftReg)});
+        }
+        leftReg = kept;
+    }
+    compareExpr->getRight()->accept(*this);
+    std::string rightReg = getExpressionResult();
+
+    std::string resultReg = context.allocateRegister();
+    emit(compare, {Reg(resultReg), Reg(swap ? rightReg : leftReg), Reg(swap ? leftReg : rightReg)});
+    context.freeFloatingRegister(leftReg);
+    context.freeFloatingRegister(rightReg);
+    currentExprResult = resultReg;
+    return true;
+}
+
+std::vector<Symbol> CodeGenVisitor::hoistInvariantDivisors(const Node& loop) {
+    std::vector<Symbol> hoisted;
+    if (!context.getOptions().fast_math) {
+        return hoisted;
+    }
+
+    AnalysisVisitor loopInfo;
+    loop.accept(loopInfo);
+    // by name, so the reciprocals come out in the same order on every run
+    std::vector<Symbol> divisors(loopInfo.getFloatingDivisors().begin(), loopInfo.getFloatingDivisors().end());
+    std::sort(divisors.begin(), divisors.end(), [](Symbol a, Symbol b) { return a.str() < b.str(); });
+    for (Symbol name : divisors) {
+        if (hoistedReciprocals.count(name) || loopInfo.isModified(name) ||
+            loopInfo.getDeclared().count(name) || functionAddressTaken.count(name)) {
+            continue;
+        }
+        auto var = context.findVariable(name);
+        if (!var || var->is_pointer || var->is_array || !isFloatingType(var->type)) {
+            continue;
+        }
+        // a callee or a store through a pointer could change a global divisor
+        if (context.isGlobal(name) && (loopInfo.getCallCount() > 0 || loopInfo.hasIndirectStore())) {
+            continue;
+        }
+
+        ast::Identifier divisorName(name);
+        ast::IdentifierExpression divisor(&divisorName);
+        divisor.accept(*this);
+        std::string divReg = getExpressionResult();
+        std::string oneReg = context.allocateFloatingRegister({divReg});
+        std::string intReg = context.allocateRegister();
+        emit(Opcode::Li, {Reg(intReg), Imm(1)});
+        emit(floatingOpcode(var->type, Opcode::FcvtSW, Opcode::FcvtDW), {Reg(oneReg), Reg(intReg)});
+        emit(floatingOpcode(var->type, Opcode::FdivS, Opcode::FdivD), {Reg(oneReg), Reg(oneReg), Reg(divReg)});
+        context.freeRegister(intReg);
+
+        Symbol slot(context.generateUniqueLabel(".recip_" + name.str()));
+        context.declareVariable(slot, var->type);
+        context.storeVariable(*code, oneReg, slot);
+        context.freeFloatingRegister(oneReg);
+        context.freeFloatingRegister(divReg);
+
+        hoistedReciprocals[name] = slot;
+        hoisted.push_back(name);
+    }
+    return hoisted;
+}
+
+void CodeGenVisitor::dropInvariantDivisors(const std::vector<Symbol>& names) {
+    for (const auto& name : names) {
+        hoistedReciprocals.erase(name);
+    }
+}
+
+void CodeGenVisitor::emitAccumulate(const Expression* expr, const std::string& accReg, TypeSpecifier type) {
+    expr->accept(*this);
+    std::string valueReg = getExpressionResult();
+    if (valueReg[0] != 'f') {
+        std::string convReg = context.allocateFloatingRegister({accReg});
+        emit(floatingOpcode(type, Opcode::FcvtSW, Opcode::FcvtDW), {Reg(convReg), Reg(valueReg)});
+        context.freeRegister(valueReg);
+        valueReg = convReg;
+    }
+    emit(floatingOpcode(type, Opcode::FaddS, Opcode::FaddD), {Reg(accReg), Reg(accReg), Reg(valueReg)});
+    context.freeFloatingRegister(valueReg);
+}
+
+/* for (i = ...; i < n; i++) s = s + f(i);
+   With reassociation allowed the sum is split over four accumulators so the
+   fadd latency of one chain is hidden behind the others, then a scalar loop
+   finishes the remaining iterations and the partial sums are combined. */
+bool CodeGenVisitor::emitReductionLoop(const ast::ForStatement& stmt) {
+    if (!stmt.hasInitialization() || !stmt.hasCondition() || !stmt.hasIncrement()) {
+        return false;
+    }
+
+    // condition: i < n or i <= n
+    auto* condExpr = stmt.getCondition()->asBinaryExpression();
+    if (!condExpr || (condExpr->getOperator() != ast::BinaryOp::Type::LT &&
+                      condExpr->getOperator() != ast::BinaryOp::Type::LE)) {
+        return false;
+    }
+    auto* indexId = condExpr->getLeft()->asIdentifierExpression();
+    const Expression* bound = condExpr->getRight();
+    if (!indexId || (!bound->asIdentifierExpression() && !bound->asLiteralExpression())) {
+        return false;
+    }
+    Symbol indexName = indexId->getSymbol();
+    auto indexVar = context.findVariable(indexName);
+    if (!indexVar || indexVar->type != ast::TypeSpecifier::INT || indexVar->is_pointer ||
+        indexVar->is_array || context.isGlobal(indexName)) {
+        return false;
+    }
+
+    // increment: i++ or ++i
+    auto* incrExpr = stmt.getIncrement()->asUnaryExpression();
+    if (!incrExpr || (incrExpr->getOperator() != ast::UnaryOp::Type::POST_INCREMENT &&
+                      incrExpr->getOperator() != ast::UnaryOp::Type::PRE_INCREMENT)) {
+        return false;
+    }
+    auto* incrId = incrExpr->getOperand()->asIdentifierExpression();
+    if (!incrId || incrId->getSymbol() != indexName) {
+        return false;
+    }
+
+    // body: a single s = s + e statement
+    const Statement* body = stmt.getBody();
+    if (auto* compound = dynamic_cast<const ast::CompoundStatement*>(body)) {
+        const NodeList* declList = compound->getDeclarationList();
+        if ((declList && !declList->empty()) || compound->getStatements().size() != 1) {
+            return false;
+        }
+        body = compound->getStatements().front();
+    }
+    auto* exprStmt = dynamic_cast<const ast::ExpressionStatement*>(body);
+    if (!exprStmt || !exprStmt->getExpression()) {
+        return false;
+    }
+    auto* assignExpr = dynamic_cast<const ast::AssignmentExpression*>(exprStmt->getExpression());
+    if (!assignExpr || assignExpr->getOperator() != ast::AssignOp::Type::ASSIGN) {
+        return false;
+    }
+    auto* sumId = assignExpr->getLHS()->asIdentifierExpression();
+    auto* addExpr = assignExpr->getRHS()->asBinaryExpression();
+    if (!sumId || !addExpr || addExpr->getOperator() != ast::BinaryOp::Type::ADD) {
+        return false;
+    }
+    Symbol sumName = sumId->getSymbol();
+    const Expression* term = nullptr;
+    auto* addLeftId = addExpr->getLeft()->asIdentifierExpression();
+    auto* addRightId = addExpr->getRight()->asIdentifierExpression();
+    if (addLeftId && addLeftId->getSymbol() == sumName) {
+        term = addExpr->getRight();
+    } else if (addRightId && addRightId->getSymbol() == sumName) {
+        term = addExpr->getLeft();
+    } else {
+        return false;
+    }
+
+    auto sumVar = context.findVariable(sumName);
+    if (!sumVar || !isFloatingType(sumVar->type) || sumVar->is_pointer || sumVar->is_array ||
+        context.isGlobal(sumName) || functionAddressTaken.count(sumName)) {
+        return false;
+    }
+    TypeSpecifier type = sumVar->type;
+    TypeSpecifier termType = inferType(term);
+    if (termType != type && termType != ast::TypeSpecifier::INT) {
+        return false;
+    }
+
+    // the term is re-evaluated for each accumulator, it must be a pure function of i
+    AnalysisVisitor termInfo;
+    term->accept(termInfo);
+    if (termInfo.hasSideEffects() || termInfo.getRead().count(sumName)) {
+        return false;
+    }
+    auto* boundId = bound->asIdentifierExpression();
+    if (boundId && (boundId->getSymbol() == sumName || boundId->getSymbol() == indexName)) {
+        return false;
+    }
+
+    Opcode fadd = floatingOpcode(type, Opcode::FaddS, Opcode::FaddD);
+    std::string unrolledLabel = context.generateUniqueLabel("for_reduce_body");
+    std::string unrolledCondLabel = context.generateUniqueLabel("for_reduce_cond");
+    std::string bodyLabel = context.generateUniqueLabel("for_body");
+    std::string condLabel = context.generateUniqueLabel("for_cond");
+
+    stmt.getInitialization()->accept(*this);
+    if (!currentExprResult.empty()) {
+        context.freeRegister(currentExprResult);
+        currentExprResult.clear();
+    }
+    auto hoisted = hoistInvariantDivisors(stmt);
+
+    const int accumulators = 4;
+    std::vector<std::string> accRegs;
+    for (int k = 0; k < accumulators; k++) {
+        accRegs.push_back(context.allocateFloatingRegister());
+    }
+    context.loadVariable(*code, accRegs[0], sumName);
+    for (int k = 1; k < accumulators; k++) {
+        emit(floatingOpcode(type, Opcode::FcvtSW, Opcode::FcvtDW), {Reg(accRegs[k]), Reg("zero")});
+    }
+
+    emit(Opcode::J, {Sym(unrolledCondLabel)});
+    code->addLabel(unrolledLabel);
+    for (int k = 0; k < accumulators; k++) {
+        emitAccumulate(term, accRegs[k], type);
+        stmt.getIncrement()->accept(*this);
+        context.freeRegister(currentExprResult);
+        currentExprResult.clear();
+    }
+
+    // keep going while all four iterations are in range: i + 3 < n
+    code->addLabel(unrolledCondLabel);
+    bound->accept(*this);
+    std::string boundReg = getExpressionResult();
+    std::string lastReg = context.allocateRegister({boundReg});
+    context.loadVariable(*code, lastReg, indexName);
+    emit(Opcode::Addi, {Reg(lastReg), Reg(lastReg), Imm(accumulators - 1)});
+    if (condExpr->getOperator() == ast::BinaryOp::Type::LT) {
+        emit(Opcode::Slt, {Reg(lastReg), Reg(lastReg), Reg(boundReg)});
+        emit(Opcode::Bnez, {Reg(lastReg), Sym(unrolledLabel)});
+    } else {
+        emit(Opcode::Slt, {Reg(lastReg), Reg(boundReg), Reg(lastReg)});
+        emit(Opcode::Beqz, {Reg(lastReg), Sym(unrolledLabel)});
+    }
+    context.freeRegister(lastReg);
+    context.freeRegister(boundReg);
+
+    // remainder
+    emit(Opcode::J, {Sym(condLabel)});
+    code->addLabel(bodyLabel);
+    emitAccumulate(term, accRegs[0], type);
+    stmt.getIncrement()->accept(*this);
+    context.freeRegister(currentExprResult);
+    currentExprResult.clear();
+    code->addLabel(condLabel);
+    stmt.getCondition()->accept(*this);
+    std::string condReg = getExpressionResult();
+    emit(Opcode::Bnez, {Reg(condReg), Sym(bodyLabel)});
+    context.freeRegister(condReg);
+
+    emit(fadd, {Reg(accRegs[0]), Reg(accRegs[0]), Reg(accRegs[1])});
+    emit(fadd, {Reg(accRegs[2]), Reg(accRegs[2]), Reg(accRegs[3])});
+    emit(fadd, {Reg(accRegs[0]), Reg(accRegs[0]), Reg(accRegs[2])});
+    context.storeVariable(*code, accRegs[0], sumName);
+    for (const auto& reg : accRegs) {
+        context.freeFloatingRegister(reg);
+    }
+    dropInvariantDivisors(hoisted);
+    return true;
+}
+
+/*******************  VECTORISATION **********************/
+
+static int elementShift(TypeSpecifier type) {
+    return (type == ast::TypeSpecifier::DOUBLE) ? 3 : 2;
+}
+
+static std::string elementWidth(TypeSpecifier type) {
+    return (type == ast::TypeSpecifier::DOUBLE) ? "64" : "32";
+}
+
+// the assignment operators that have an element-wise vector form
+static bool compoundBinaryOp(ast::AssignOp::Type op, ast::BinaryOp::Type& binaryOp) {
+    switch (op) {
+        case ast::AssignOp::Type::ADD_ASSIGN: binaryOp = ast::BinaryOp::Type::ADD; return true;
+        case ast::AssignOp::Type::SUB_ASSIGN: binaryOp = ast::BinaryOp::Type::SUB; return true;
+        case ast::AssignOp::Type::MUL_ASSIGN: binaryOp = ast::BinaryOp::Type::MUL; return true;
+        case ast::AssignOp::Type::DIV_ASSIGN: binaryOp = ast::BinaryOp::Type::DIV; return true;
+        default: return false;
+    }
+}
+
+static const char* vectorMnemonic(ast::BinaryOp::Type op) {
+    switch (op) {
+        case ast::BinaryOp::Type::ADD:         return "add";
+        case ast::BinaryOp::Type::SUB:         return "sub";
+        case ast::BinaryOp::Type::MUL:         return "mul";
+        case ast::BinaryOp::Type::DIV:         return "div";
+        case ast::BinaryOp::Type::MOD:         return "rem";
+        case ast::BinaryOp::Type::AND:         return "and";
+        case ast::BinaryOp::Type::OR:          return "or";
+        case ast::BinaryOp::Type::XOR:         return "xor";
+        case ast::BinaryOp::Type::LEFT_SHIFT:  return "sll";
+        case ast::BinaryOp::Type::RIGHT_SHIFT: return "sra";
+        default:                               return nullptr;
+    }
+}
+
+static bool isFloatingVectorOp(ast::BinaryOp::Type op) {
+    return op == ast::BinaryOp::Type::ADD || op == ast::BinaryOp::Type::SUB ||
+           op == ast::BinaryOp::Type::MUL || op == ast::BinaryOp::Type::DIV;
+}
+
+/* for (i = start; i < n; i++) a[i] = <expr of b[i], c[i], invariants>;
+   for (i = start; i < n; i++) s = s + <expr>;
+   The index must be a local int stepped by one, the bound a literal or a
+   variable the body leaves alone, and the body a single assignment with no
+   calls, pointer stores or control flow. */
+bool CodeGenVisitor::matchVectorLoop(const ast::ForStatement& stmt, VectorLoop& loop) {
+    if (!stmt.hasInitialization() || !stmt.hasCondition() || !stmt.hasIncrement()) {
+        return false;
+    }
+
+    auto* initExpr = dynamic_cast<const ast::AssignmentExpression*>(stmt.getInitialization());
+    if (!initExpr || initExpr->getOperator() != ast::AssignOp::Type::ASSIGN ||
+        !initExpr->getLHS()->asIdentifierExpression()) {
+        return false;
+    }
+    loop.index = initExpr->getLHS()->asIdentifierExpression()->getSymbol();
+    auto indexVar = context.findVariable(loop.index);
+    if (!indexVar || indexVar->type != ast::TypeSpecifier::INT || indexVar->is_pointer ||
+        indexVar->is_array || context.isGlobal(loop.index) || functionAddressTaken.count(loop.index)) {
+        return false;
+    }
+
+    auto* condExpr = stmt.getCondition()->asBinaryExpression();
+    if (!condExpr || (condExpr->getOperator() != ast::BinaryOp::Type::LT &&
+                      condExpr->getOperator() != ast::BinaryOp::Type::LE)) {
+        return false;
+    }
+    auto* condId = condExpr->getLeft()->asIdentifierExpression();
+    if (!condId || condId->getSymbol() != loop.index) {
+        return false;
+    }
+    loop.bound = condExpr->getRight();
+    loop.inclusive = condExpr->getOperator() == ast::BinaryOp::Type::LE;
+    if (!constantIndex(loop.bound) && !loop.bound->asIdentifierExpression()) {
+        return false;
+    }
+    if (inferType(loop.bound) != ast::TypeSpecifier::INT) {
+        return false;
+    }
+
+    auto* incrExpr = stmt.getIncrement()->asUnaryExpression();
+    if (!incrExpr || (incrExpr->getOperator() != ast::UnaryOp::Type::POST_INCREMENT &&
+                      incrExpr->getOperator() != ast::UnaryOp::Type::PRE_INCREMENT)) {
+        return false;
+    }
+    auto* incrId = incrExpr->getOperand()->asIdentifierExpression();
+    if (!incrId || incrId->getSymbol() != loop.index) {
+        return false;
+    }
+
+    const Statement* body = stmt.getBody();
+    if (auto* compound = dynamic_cast<const ast::CompoundStatement*>(body)) {
+        const NodeList* declList = compound->getDeclarationList();
+        if ((declList && !declList->empty()) || compound->getStatements().size() != 1) {
+            return false;
+        }
+        body = compound->getStatements().front();
+    }
+    auto* exprStmt = dynamic_cast<const ast::ExpressionStatement*>(body);
+    if (!exprStmt || !exprStmt->getExpression()) {
+        return false;
+    }
+    auto* assignExpr = dynamic_cast<const ast::AssignmentExpression*>(exprStmt->getExpression());
+    if (!assignExpr) {
+        return false;
+    }
+
+    AnalysisVisitor bodyInfo;
+    body->accept(bodyInfo);
+    if (bodyInfo.getCallCount() > 0 || bodyInfo.hasIndirectStore() || bodyInfo.hasControlFlow() ||
+        bodyInfo.isModified(loop.index)) {
+        return false;
+    }
+    if (auto* boundId = loop.bound->asIdentifierExpression()) {
+        if (bodyInfo.isModified(boundId->getSymbol()) || boundId->getSymbol() == loop.index) {
+            return false;
+        }
+    }
+
+    const Expression* lhs = assignExpr->getLHS();
+    if (auto* arrayExpr = lhs->asArrayAccessExpression()) {
+        // a[i] = value or a[i] op= value
+        auto* arrayId = arrayExpr->getArray()->asIdentifierExpression();
+        auto* indexId = arrayExpr->getIndex()->asIdentifierExpression();
+        if (!arrayId || !indexId || indexId->getSymbol() != loop.index) {
+            return false;
+        }
+        auto arrayVar = context.findVariable(arrayId->getSymbol());
+        if (!arrayVar) {
+            return false;
+        }
+        loop.dest = arrayId->getSymbol();
+        loop.type = arrayVar->type;
+        loop.value = assignExpr->getRHS();
+        if (assignExpr->getOperator() != ast::AssignOp::Type::ASSIGN) {
+            if (!compoundBinaryOp(assignExpr->getOperator(), loop.compoundOp)) {
+                return false;
+            }
+            loop.compound = true;
+            loop.vectorRegs++;
+        }
+        loop.arrays.push_back(loop.dest);
+    } else if (auto* sumId = lhs->asIdentifierExpression()) {
+        // s = s + value, s = value + s or s += value
+        loop.reduction = sumId->getSymbol();
+        auto sumVar = context.findVariable(loop.reduction);
+        if (!sumVar || sumVar->is_pointer || sumVar->is_array || context.isGlobal(loop.reduction) ||
+            functionAddressTaken.count(loop.reduction) || loop.reduction == loop.index) {
+            return false;
+        }
+        loop.type = sumVar->type;
+        if (assignExpr->getOperator() == ast::AssignOp::Type::ADD_ASSIGN) {
+            loop.value = assignExpr->getRHS();
+        } else if (assignExpr->getOperator() == ast::AssignOp::Type::ASSIGN) {
+            auto* addExpr = assignExpr->getRHS()->asBinaryExpression();
+            if (!addExpr || addExpr->getOperator() != ast::BinaryOp::Type::ADD) {
+                return false;
+            }
+            auto* leftId = addExpr->getLeft()->asIdentifierExpression();
+            auto* rightId = addExpr->getRight()->asIdentifierExpression();
+            if (leftId && leftId->getSymbol() == loop.reduction) {
+                loop.value = addExpr->getRight();
+            } else if (rightId && rightId->getSymbol() == loop.reduction) {
+                loop.value = addExpr->getLeft();
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        AnalysisVisitor valueInfo;
+        loop.value->accept(valueInfo);
+        if (valueInfo.getRead().count(loop.reduction)) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    if (loop.type != ast::TypeSpecifier::INT && loop.type != ast::TypeSpecifier::FLOAT &&
+        loop.type != ast::TypeSpecifier::DOUBLE) {
+        return false;
+    }
+
+    VectorOperand root = classifyVectorOperand(loop.value, loop, bodyInfo);
+    if (root == VectorOperand::None || (root == VectorOperand::Scalar && !loop.reduction.empty())) {
+        return false;
+    }
+    if (root == VectorOperand::Scalar) {
+        loop.vectorRegs++; // fill: the value is splatted
+    }
+    // v2, v4 ... v30 with LMUL=2
+    return loop.vectorRegs <= 15;
+}
+
+CodeGenVisitor::VectorOperand CodeGenVisitor::classifyVectorOperand(const Expression* expr, VectorLoop& loop, const AnalysisVisitor& bodyInfo) {
+    if (auto* arrayExpr = expr->asArrayAccessExpression()) {
+        auto* arrayId = arrayExpr->getArray()->asIdentifierExpression();
+        auto* indexId = arrayExpr->getIndex()->asIdentifierExpression();
+        if (!arrayId || !indexId || indexId->getSymbol() != loop.index) {
+            return VectorOperand::None;
+        }
+        auto var = context.findVariable(arrayId->getSymbol());
+        if (!var || var->type != loop.type) {
+            return VectorOperand::None;
+        }
+        if (std::find(loop.arrays.begin(), loop.arrays.end(), arrayId->getSymbol()) == loop.arrays.end()) {
+            loop.arrays.push_back(arrayId->getSymbol());
+            loop.vectorRegs++;
+        } else if (arrayId->getSymbol() == loop.dest && !loop.compound && !loop.loaded.count(loop.dest)) {
+            // a[i] = a[i] * k reads the destination too
+            loop.loaded[loop.dest] = "";
+            loop.vectorRegs++;
+        }
+        return VectorOperand::Vector;
+    }
+
+    if (auto* idExpr = expr->asIdentifierExpression()) {
+        Symbol name = idExpr->getSymbol();
+        if (name == loop.index || bodyInfo.isModified(name) || context.isEnumValue(name)) {
+            return VectorOperand::None;
+        }
+        auto var = context.findVariable(name);
+        if (!var || var->is_pointer || var->is_array) {
+            return VectorOperand::None;
+        }
+        bool convertible = isFloatingType(loop.type) && var->type == ast::TypeSpecifier::INT;
+        return (var->type == loop.type || convertible) ? VectorOperand::Scalar : VectorOperand::None;
+    }
+
+    if (auto* literal = expr->asLiteralExpression()) {
+        bool convertible = isFloatingType(loop.type) && literal->getType() == ast::TypeSpecifier::INT;
+        return (literal->getType() == loop.type || convertible) ? VectorOperand::Scalar : VectorOperand::None;
+    }
+
+    if (auto* binaryExpr = expr->asBinaryExpression()) {
+        if (!vectorMnemonic(binaryExpr->getOperator()) ||
+            (isFloatingType(loop.type) && !isFloatingVectorOp(binaryExpr->getOperator()))) {
+            return VectorOperand::None;
+        }
+        VectorOperand left = classifyVectorOperand(binaryExpr->getLeft(), loop, bodyInfo);
+        VectorOperand right = classifyVectorOperand(binaryExpr->getRight(), loop, bodyInfo);
+        if (left == VectorOperand::None || right == VectorOperand::None) {
+            return VectorOperand::None;
+        }
+        loop.vectorRegs++;
+        return VectorOperand::Vector;
+    }
+
+    return VectorOperand::None;
+}
+
+// global arrays by symbol, local arrays by frame offset, everything else holds a pointer
+void CodeGenVisitor::emitArrayBase(Symbol name, const std::string& reg) {
+    auto var = context.findVariable(name);
+    if (var->is_pointer || (!var->is_array && !context.isGlobal(name))) {
+        if (context.isGlobal(name)) {
+            emit(Opcode::Lui, {Reg(reg), Hi(name.str())});
+            emit(Opcode::Lw, {Reg(reg), Mem(Lo(name.str()), reg)});
+        } else {
+            context.loadVariable(*code, reg, name);
+        }
+    } else if (context.isGlobal(name)) {
+        emit(Opcode::Lui, {Reg(reg), Hi(name.str())});
+        emit(Opcode::Addi, {Reg(reg), Reg(reg), Lo(name.str())});
+    } else {
+        emit(Opcode::Addi, {Reg(reg), Reg(context.frameBase()), Imm(var->stack_offset)});
+    }
+}
+
+std::string CodeGenVisitor::emitVectorBinary(BinaryOp::Type op, const std::string& lhs, const std::string& rhs, VectorLoop& loop) {
+    bool isFloat = isFloatingType(loop.type);
+    std::string prefix = isFloat ? "vf" : "v";
+    std::string scalarForm = isFloat ? ".vf" : ".vx";
+    std::string splat = isFloat ? "vfmv.v.f" : "vmv.v.x";
+    std::string mnemonic = vectorMnemonic(op);
+    std::string dest = "v" + std::to_string(loop.nextVector);
+    loop.nextVector += 2;
+
+    bool leftVector = lhs[0] == 'v';
+    bool rightVector = rhs[0] == 'v';
+    bool commutative = op == ast::BinaryOp::Type::ADD || op == ast::BinaryOp::Type::MUL ||
+                       op == ast::BinaryOp::Type::AND || op == ast::BinaryOp::Type::OR ||
+                       op == ast::BinaryOp::Type::XOR;
+
+    if (leftVector && rightVector) {
+        emit(prefix + mnemonic + ".vv", {Reg(dest), Reg(lhs), Reg(rhs)});
+    } else if (leftVector) {
+        emit(prefix + mnemonic + scalarForm, {Reg(dest), Reg(lhs), Reg(rhs)});
+    } else if (rightVector && commutative) {
+        emit(prefix + mnemonic + scalarForm, {Reg(dest), Reg(rhs), Reg(lhs)});
+    } else if (rightVector && op == ast::BinaryOp::Type::SUB) {
+        emit(prefix + "rsub" + scalarForm, {Reg(dest), Reg(rhs), Reg(lhs)});
+    } else if (rightVector && isFloat && op == ast::BinaryOp::Type::DIV) {
+        emit("vfrdiv.vf", {Reg(dest), Reg(rhs), Reg(lhs)});
+    } else {
+        // no reversed form: broadcast the scalar and use .vv
+        emit(splat, {Reg(dest), Reg(lhs)});
+        if (rightVector) {
+            emit(prefix + mnemonic + ".vv", {Reg(dest), Reg(dest), Reg(rhs)});
+        } else {
+            emit(prefix + mnemonic + scalarForm, {Reg(dest), Reg(dest), Reg(rhs)});
+        }
+    }
+    return dest;
+}
+
+// vector register or, for loop invariants, the scalar register loaded before the loop
+std::string CodeGenVisitor::emitVectorOperand(const Expression* expr, VectorLoop& loop) {
+    if (auto* arrayExpr = expr->asArrayAccessExpression()) {
+        return loop.loaded.at(arrayExpr->getArray()->asIdentifierExpression()->getSymbol());
+    }
+    if (auto* binaryExpr = expr->asBinaryExpression()) {
+        std::string lhs = emitVectorOperand(binaryExpr->getLeft(), loop);
+        std::string rhs = emitVectorOperand(binaryExpr->getRight(), loop);
+        return emitVectorBinary(binaryExpr->getOperator(), lhs, rhs, loop);
+    }
+    return loop.scalars.at(expr);
+}
+
+/* Strip-mined RVV loop:
+       count = n - i; if (count <= 0) skip
+       p = &a[i] for every array
+   loop:
+       vl = vsetvli(count, e32/e64, m2)
+       vle each source, compute, vse or vredsum
+       count -= vl; p += vl * size
+       bnez count, loop
+       i = n
+   When a destination reached through a pointer may overlap a source at a
+   higher address the element order matters, so a runtime check branches to
+   the ordinary scalar loop instead. */
+bool CodeGenVisitor::emitVectorLoop(const ast::ForStatement& stmt) {
+    VectorLoop loop;
+    if (!matchVectorLoop(stmt, loop)) {
+        return false;
+    }
+
+    bool isFloat = isFloatingType(loop.type);
+    int shift = elementShift(loop.type);
+    std::string sew = "e" + elementWidth(loop.type);
+    std::string loopLabel = context.generateUniqueLabel("vec_loop");
+    std::string scalarLabel = context.generateUniqueLabel("vec_scalar");
+    std::string endLabel = context.generateUniqueLabel("vec_end");
+
+    stmt.getInitialization()->accept(*this);
+    if (!currentExprResult.empty()) {
+        context.freeRegister(currentExprResult);
+        currentExprResult.clear();
+    }
+
+    // count = n - i (+1 for <=)
+    std::string indexReg = context.allocateRegister();
+    context.loadVariable(*code, indexReg, loop.index);
+    loop.bound->accept(*this);
+    std::string countReg = getExpressionResult();
+    emit(Opcode::Sub, {Reg(countReg), Reg(countReg), Reg(indexReg)});
+    if (loop.inclusive) {
+        emit(Opcode::Addi, {Reg(countReg), Reg(countReg), Imm(1)});
+    }
+    emit(Opcode::Blez, {Reg(countReg), Sym(endLabel)});
+
+    // pointers to element i
+    std::string offsetReg = context.allocateRegister();
+    emit(Opcode::Slli, {Reg(offsetReg), Reg(indexReg), Imm(shift)});
+    for (const auto& name : loop.arrays) {
+        std::string ptrReg = context.allocateRegister();
+        emitArrayBase(name, ptrReg);
+        emit(Opcode::Add, {Reg(ptrReg), Reg(ptrReg), Reg(offsetReg)});
+        loop.pointers[name] = ptrReg;
+    }
+
+    // overlap check: unsafe only if 0 < dest - src < count * size
+    bool needsCheck = false;
+    if (!loop.dest.empty()) {
+        auto destVar = context.findVariable(loop.dest);
+        bool destIsPointer = destVar->is_pointer || (!destVar->is_array && !context.isGlobal(loop.dest));
+        for (const auto& name : loop.arrays) {
+            if (name == loop.dest) {
+                continue;
+            }
+            auto srcVar = context.findVariable(name);
+            bool srcIsPointer = srcVar->is_pointer || (!srcVar->is_array && !context.isGlobal(name));
+            if (!destIsPointer && !srcIsPointer) {
+                continue;
+            }
+            if (!needsCheck) {
+                emit(Opcode::Slli, {Reg(offsetReg), Reg(countReg), Imm(shift)});
+                needsCheck = true;
+            }
+            std::string distanceReg = context.allocateRegister();
+            std::string safeLabel = context.generateUniqueLabel("vec_no_overlap");
+            emit(Opcode::Sub, {Reg(distanceReg), Reg(loop.pointers[loop.dest]), Reg(loop.pointers[name])});
+            emit(Opcode::Blez, {Reg(distanceReg), Sym(safeLabel)});
+            emit(Opcode::Blt, {Reg(distanceReg), Reg(offsetReg), Sym(scalarLabel)});
+            code->addLabel(safeLabel);
+            context.freeRegister(distanceReg);
+        }
+    }
+
+    // loop invariant operands
+    std::vector<const Expression*> pending = {loop.value};
+    while (!pending.empty()) {
+        const Expression* expr = pending.back();
+        pending.pop_back();
+        if (auto* binaryExpr = expr->asBinaryExpression()) {
+            pending.push_back(binaryExpr->getLeft());
+            pending.push_back(binaryExpr->getRight());
+            continue;
+        }
+        if (expr->asArrayAccessExpression()) {
+            continue;
+        }
+        expr->accept(*this);
+        std::string reg = getExpressionResult();
+        if (isFloat && reg[0] != 'f') {
+            std::string convReg = context.allocateFloatingRegister();
+            emit(floatingOpcode(loop.type, Opcode::FcvtSW, Opcode::FcvtDW), {Reg(convReg), Reg(reg)});
+            context.freeRegister(reg);
+            reg = convReg;
+        }
+        loop.scalars[expr] = reg;
+    }
+
+    std::string sumReg;
+    if (!loop.reduction.empty()) {
+        sumReg = isFloat ? context.allocateFloatingRegister() : context.allocateRegister();
+        context.loadVariable(*code, sumReg, loop.reduction);
+        emit("vsetivli", {Reg("zero"), Imm(1), Sym(sew), Sym("m1"), Sym("ta"), Sym("ma")});
+        emit(isFloat ? "vfmv.s.f" : "vmv.s.x", {Reg("v1"), Reg(sumReg)});
+    }
+
+    std::string vlReg = context.allocateRegister();
+    code->addLabel(loopLabel);
+    emit("vsetvli", {Reg(vlReg), Reg(countReg), Sym(sew), Sym("m2"), Sym("ta"), Sym("ma")});
+    for (const auto& name : loop.arrays) {
+        if (name == loop.dest && !loop.compound && !loop.loaded.count(name)) {
+            continue;
+        }
+        std::string vreg = "v" + std::to_string(loop.nextVector);
+        loop.nextVector += 2;
+        emit("vle" + elementWidth(loop.type) + ".v", {Reg(vreg), Mem(loop.pointers[name])});
+        loop.loaded[name] = vreg;
+    }
+
+    std::string valueReg = emitVectorOperand(loop.value, loop);
+    if (!loop.reduction.empty()) {
+        std::string reduce = isFloat ? (context.getOptions().fast_math ? "vfredusum.vs" : "vfredosum.vs") : "vredsum.vs";
+        emit(reduce, {Reg("v1"), Reg(valueReg), Reg("v1")});
+    } else {
+        if (loop.compound) {
+            valueReg = emitVectorBinary(loop.compoundOp, loop.loaded[loop.dest], valueReg, loop);
+        } else if (valueReg[0] != 'v') {
+            std::string splatReg = "v" + std::to_string(loop.nextVector);
+            loop.nextVector += 2;
+            emit(isFloat ? "vfmv.v.f" : "vmv.v.x", {Reg(splatReg), Reg(valueReg)});
+            valueReg = splatReg;
+        }
+        emit("vse" + elementWidth(loop.type) + ".v", {Reg(valueReg), Mem(loop.pointers[loop.dest])});
+    }
+
+    emit(Opcode::Sub, {Reg(countReg), Reg(countReg), Reg(vlReg)});
+    emit(Opcode::Slli, {Reg(vlReg), Reg(vlReg), Imm(shift)});
+    for (const auto& name : loop.arrays) {
+        emit(Opcode::Add, {Reg(loop.pointers[name]), Reg(loop.pointers[name]), Reg(vlReg)});
+    }
+    emit(Opcode::Bnez, {Reg(countReg), Sym(loopLabel)});
+
+    if (!loop.reduction.empty()) {
+        emit(isFloat ? "vfmv.f.s" : "vmv.x.s", {Reg(sumReg), Reg("v1")});
+        context.storeVariable(*code, sumReg, loop.reduction);
+    }
+
+    // the index leaves the loop equal to n (n + 1 for <=)
+    loop.bound->accept(*this);
+    std::string finalReg = getExpressionResult();
+    if (loop.inclusive) {
+        emit(Opcode::Addi, {Reg(finalReg), Reg(finalReg), Imm(1)});
+    }
+    context.storeVariable(*code, finalReg, loop.index);
+    context.freeRegister(finalReg);
+
+    context.freeRegister(vlReg);
+    context.freeRegister(indexReg);
+    context.freeRegister(countReg);
+    context.freeRegister(offsetReg);
+    for (const auto& [name, reg] : loop.pointers) {
+        context.freeRegister(reg);
+    }
+    for (const auto& [expr, reg] : loop.scalars) {
+        if (reg[0] == 'f') {
+            context.freeFloatingRegister(reg);
+        } else {
+            context.freeRegister(reg);
+        }
+    }
+    if (!sumReg.empty()) {
+        if (isFloat) {
+            context.freeFloatingRegister(sumReg);
+        } else {
+            context.freeRegister(sumReg);
+        }
+    }
+
+    if (needsCheck) {
+        emit(Opcode::J, {Sym(endLabel)});
+        code->addLabel(scalarLabel);
+        emitForLoop(stmt, false);
+    }
+    code->addLabel(endLabel);
+    return true;
+}
+
+/*******************  BIT MANIPULATION **********************/
+
+// value of an integer constant expression made of literals, e.g. (1 << 8) - 1
+static bool foldConstant(const Expression* expr, int& value) {
+    if (auto* literal = constantIndex(expr)) {
+        value = constantValue(literal);
+        return true;
+    }
+    if (auto* unaryExpr = expr->asUnaryExpression()) {
+        int operand;
+        if (!foldConstant(unaryExpr->getOperand(), operand)) {
+            return false;
+        }
+        switch (unaryExpr->getOperator()) {
+            case ast::UnaryOp::Type::MINUS:       value = static_cast<int>(0u - static_cast<unsigned>(operand)); return true;
+            case ast::UnaryOp::Type::BITWISE_NOT: value = ~operand; return true;
+            default:                              return false;
+        }
+    }
+    auto* binaryExpr = expr->asBinaryExpression();
+    int left;
+    int right;
+    if (!binaryExpr || !foldConstant(binaryExpr->getLeft(), left) || !foldConstant(binaryExpr->getRight(), right)) {
+        return false;
+    }
+    unsigned l = static_cast<unsigned>(left);
+    unsigned r = static_cast<unsigned>(right);
+    switch (binaryExpr->getOperator()) {
+        case ast::BinaryOp::Type::ADD: value = static_cast<int>(l + r); return true;
+        case ast::BinaryOp::Type::SUB: value = static_cast<int>(l - r); return true;
+        case ast::BinaryOp::Type::MUL: value = static_cast<int>(l * r); return true;
+        case ast::BinaryOp::Type::AND: value = static_cast<int>(l & r); return true;
+        case ast::BinaryOp::Type::OR:  value = static_cast<int>(l | r); return true;
+        case ast::BinaryOp::Type::XOR: value = static_cast<int>(l ^ r); return true;
+        case ast::BinaryOp::Type::LEFT_SHIFT:
+            if (right < 0 || right > 31) {
+                return false;
+            }
+            value = static_cast<int>(l << right);
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool isConstant(const Expression* expr, int expected) {
+    int value;
+    return foldConstant(expr, value) && value == expected;
+}
+
+static const ast::BinaryExpression* binaryWith(const Expression* expr, ast::BinaryOp::Type op) {
+    auto* binaryExpr = expr->asBinaryExpression();
+    return (binaryExpr && binaryExpr->getOperator() == op) ? binaryExpr : nullptr;
+}
+
+// the same identifier on both sides
+static bool sameVariable(const Expression* a, const Expression* b) {
+    auto* idA = a->asIdentifierExpression();
+    auto* idB = b->asIdentifierExpression();
+    return idA && idB && idA->getSymbol() == idB->getSymbol();
+}
+
+static bool sameOperand(const Expression* a, const Expression* b) {
+    int valueA;
+    int valueB;
+    if (foldConstant(a, valueA) && foldConstant(b, valueB)) {
+        return valueA == valueB;
+    }
+    return sameVariable(a, b);
+}
+
+static const Expression* bitwiseNotOperand(const Expression* expr) {
+    auto* unaryExpr = expr->asUnaryExpression();
+    if (unaryExpr && unaryExpr->getOperator() == ast::UnaryOp::Type::BITWISE_NOT) {
+        return unaryExpr->getOperand();
+    }
+    return nullptr;
+}
+
+// an int or char scalar, or a constant: reading it twice is the same as reading it once
+bool CodeGenVisitor::isSimpleIntOperand(const Expression* expr) const {
+    int value;
+    if (foldConstant(expr, value)) {
+        return true;
+    }
+    auto* idExpr = expr->asIdentifierExpression();
+    if (!idExpr) {
+        return false;
+    }
+    if (context.isEnumValue(idExpr->getSymbol())) {
+        return true;
+    }
+    auto var = context.findVariable(idExpr->getSymbol());
+    return var && !var->is_pointer && !var->is_array &&
+           (var->type == ast::TypeSpecifier::INT || var->type == ast::TypeSpecifier::CHAR);
+}
+
+// a local int the loop may keep in a register
+bool CodeGenVisitor::isLocalIntVariable(const Expression* expr) const {
+    auto* idExpr = expr->asIdentifierExpression();
+    if (!idExpr) {
+        return false;
+    }
+    auto var = context.findVariable(idExpr->getSymbol());
+    return var && var->type == ast::TypeSpecifier::INT && !var->is_pointer && !var->is_array &&
+           !context.isGlobal(idExpr->getSymbol()) && !functionAddressTaken.count(idExpr->getSymbol());
+}
+
+/* With Zbb:
+   x & ~y, x | ~y, x ^ ~y                 -> andn, orn, xnor
+   x & 0xffff                             -> zext.h
+   (x << 24) >> 24, (x << 16) >> 16       -> sext.b, sext.h
+   (x << k) | ((x >> (32 - k)) & mask)    -> rori x, 32 - k
+   Only the last needs the mask: >> is arithmetic on int, so a rotate written
+   without it is not one. */
+bool CodeGenVisitor::emitBitManipulation(const ast::BinaryExpression& expr) {
+    const Expression* left = expr.getLeft();
+    const Expression* right = expr.getRight();
+    auto isInteger = [this](const Expression* e) {
+        TypeSpecifier type = inferType(e);
+        return type == ast::TypeSpecifier::INT || type == ast::TypeSpecifier::CHAR;
+    };
+    if (!isInteger(left) || !isInteger(right)) {
+        return false;
+    }
+
+    ast::BinaryOp::Type op = expr.getOperator();
+    if (op == ast::BinaryOp::Type::AND || op == ast::BinaryOp::Type::OR || op == ast::BinaryOp::Type::XOR) {
+        const Expression* plain = left;
+        const Expression* inverted = bitwiseNotOperand(right);
+        if (!inverted) {
+            plain = right;
+            inverted = bitwiseNotOperand(left);
+        }
+        if (inverted && !bitwiseNotOperand(plain)) {
+            Opcode opcode = (op == ast::BinaryOp::Type::AND) ? Opcode::Andn :
+                            (op == ast::BinaryOp::Type::OR)  ? Opcode::Orn : Opcode::Xnor;
+            plain->accept(*this);
+            std::string plainReg = getExpressionResult();
+            inverted->accept(*this);
+            std::string invertedReg = getExpressionResult();
+            emit(opcode, {Reg(plainReg), Reg(plainReg), Reg(invertedReg)});
+            context.freeRegister(invertedReg);
+            currentExprResult = plainReg;
+            return true;
+        }
+    }
+
+    if (op == ast::BinaryOp::Type::AND) {
+        const Expression* value = isConstant(right, 0xffff) ? left : isConstant(left, 0xffff) ? right : nullptr;
+        if (value) {
+            value->accept(*this);
+            std::string reg = getExpressionResult();
+            emit(Opcode::ZextH, {Reg(reg), Reg(reg)});
+            currentExprResult = reg;
+            return true;
+        }
+    }
+
+    if (op == ast::BinaryOp::Type::RIGHT_SHIFT) {
+        auto* shiftLeft = binaryWith(left, ast::BinaryOp::Type::LEFT_SHIFT);
+        int amount;
+        if (shiftLeft && foldConstant(right, amount) && (amount == 24 || amount == 16) &&
+            isConstant(shiftLeft->getRight(), amount)) {
+            shiftLeft->getLeft()->accept(*this);
+            std::string reg = getExpressionResult();
+            emit(amount == 24 ? Opcode::SextB : Opcode::SextH, {Reg(reg), Reg(reg)});
+            currentExprResult = reg;
+            return true;
+        }
+    }
+
+    if (op == ast::BinaryOp::Type::OR || op == ast::BinaryOp::Type::XOR || op == ast::BinaryOp::Type::ADD) {
+        // the two halves share no bits, so |, ^ and + all combine them the same way
+        for (int side = 0; side < 2; side++) {
+            auto* shiftLeft = binaryWith(side == 0 ? left : right, ast::BinaryOp::Type::LEFT_SHIFT);
+            auto* masked = binaryWith(side == 0 ? right : left, ast::BinaryOp::Type::AND);
+            if (!shiftLeft || !masked) {
+                continue;
+            }
+            auto* shiftRight = binaryWith(masked->getLeft(), ast::BinaryOp::Type::RIGHT_SHIFT);
+            const Expression* mask = masked->getRight();
+            if (!shiftRight) {
+                shiftRight = binaryWith(masked->getRight(), ast::BinaryOp::Type::RIGHT_SHIFT);
+                mask = masked->getLeft();
+            }
+            int leftAmount;
+            int rightAmount;
+            int maskValue;
+            if (!shiftRight || !sameVariable(shiftLeft->getLeft(), shiftRight->getLeft()) ||
+                !isSimpleIntOperand(shiftLeft->getLeft()) ||
+                !foldConstant(shiftLeft->getRight(), leftAmount) || !foldConstant(shiftRight->getRight(), rightAmount) ||
+                !foldConstant(mask, maskValue) || leftAmount < 1 || leftAmount > 31 || leftAmount + rightAmount != 32 ||
+                static_cast<unsigned>(maskValue) != (1u << leftAmount) - 1) {
+                continue;
+            }
+            shiftLeft->getLeft()->accept(*this);
+            std::string reg = getExpressionResult();
+            emit(Opcode::Rori, {Reg(reg), Reg(reg), Imm(rightAmount)});
+            currentExprResult = reg;
+            return true;
+        }
+    }
+    return false;
+}
+
+// a < b ? a : b -> min, a < b ? b : a -> max (and the >, <=, >= forms)
+bool CodeGenVisitor::emitMinMax(const ast::ConditionalExpression& expr) {
+    auto* condExpr = expr.getCondition()->asBinaryExpression();
+    if (!condExpr) {
+        return false;
+    }
+    bool less;
+    switch (condExpr->getOperator()) {
+        case ast::BinaryOp::Type::LT:
+        case ast::BinaryOp::Type::LE:
+            less = true;
+            break;
+        case ast::BinaryOp::Type::GT:
+        case ast::BinaryOp::Type::GE:
+            less = false;
+            break;
+        default:
+            return false;
+    }
+    const Expression* a = condExpr->getLeft();
+    const Expression* b = condExpr->getRight();
+    if (!isSimpleIntOperand(a) || !isSimpleIntOperand(b)) {
+        return false;
+    }
+
+    bool pickFirst;
+    if (sameOperand(expr.getThenExpression(), a) && sameOperand(expr.getElseExpression(), b)) {
+        pickFirst = true;
+    } else if (sameOperand(expr.getThenExpression(), b) && sameOperand(expr.getElseExpression(), a)) {
+        pickFirst = false;
+    } else {
+        return false;
+    }
+
+    a->accept(*this);
+    std::string aReg = getExpressionResult();
+    b->accept(*this);
+    std::string bReg = getExpressionResult();
+    // ties pick equal values, so <= behaves as < here
+    emit((less == pickFirst) ? Opcode::Min : Opcode::Max, {Reg(aReg), Reg(aReg), Reg(bReg)});
+    context.freeRegister(bReg);
+    currentExprResult = aReg;
+    return true;
+}
+
+// expression statements of a loop body, plus the for-increment split at commas
+static bool collectLoopSteps(const Node* node, std::vector<const Expression*>& steps) {
+    if (!node) {
+        return true;
+    }
+    if (auto* commaExpr = dynamic_cast<const ast::CommaExpression*>(node)) {
+        return collectLoopSteps(commaExpr->getLeft(), steps) && collectLoopSteps(commaExpr->getRight(), steps);
+    }
+    if (auto* expr = dynamic_cast<const Expression*>(node)) {
+        steps.push_back(expr);
+        return true;
+    }
+    if (auto* compound = dynamic_cast<const ast::CompoundStatement*>(node)) {
+        const NodeList* declList = compound->getDeclarationList();
+        if (declList && !declList->empty()) {
+            return false;
+        }
+        for (const auto& s : compound->getStatements()) {
+            if (!collectLoopSteps(s, steps)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (auto* exprStmt = dynamic_cast<const ast::ExpressionStatement*>(node)) {
+        return collectLoopSteps(exprStmt->getExpression(), steps);
+    }
+    return false;
+}
+
+// x = x op k or x op= k, returning the identifier updated
+static const ast::IdentifierExpression* selfUpdate(const Expression* step, ast::BinaryOp::Type op, const Expression*& operand) {
+    auto* assignExpr = dynamic_cast<const ast::AssignmentExpression*>(step);
+    if (!assignExpr) {
+        return nullptr;
+    }
+    auto* target = assignExpr->getLHS()->asIdentifierExpression();
+    if (!target) {
+        return nullptr;
+    }
+    ast::AssignOp::Type compoundOp;
+    switch (op) {
+        case ast::BinaryOp::Type::ADD:         compoundOp = ast::AssignOp::Type::ADD_ASSIGN; break;
+        case ast::BinaryOp::Type::AND:         compoundOp = ast::AssignOp::Type::AND_ASSIGN; break;
+        case ast::BinaryOp::Type::LEFT_SHIFT:  compoundOp = ast::AssignOp::Type::LEFT_ASSIGN; break;
+        case ast::BinaryOp::Type::RIGHT_SHIFT: compoundOp = ast::AssignOp::Type::RIGHT_ASSIGN; break;
+        default:                               return nullptr;
+    }
+    if (assignExpr->getOperator() == compoundOp) {
+        operand = assignExpr->getRHS();
+        return target;
+    }
+    auto* binaryExpr = binaryWith(assignExpr->getRHS(), op);
+    if (assignExpr->getOperator() != ast::AssignOp::Type::ASSIGN || !binaryExpr) {
+        return nullptr;
+    }
+    if (sameVariable(binaryExpr->getLeft(), target)) {
+        operand = binaryExpr->getRight();
+        return target;
+    }
+    // all four operators here are commutative except the shifts
+    if (op != ast::BinaryOp::Type::LEFT_SHIFT && op != ast::BinaryOp::Type::RIGHT_SHIFT &&
+        sameVariable(binaryExpr->getRight(), target)) {
+        operand = binaryExpr->getLeft();
+        return target;
+    }
+    return nullptr;
+}
+
+/* Loops that only count the bits of x, all leaving x == 0:
+   while (x) { n++; x &= x - 1; }          n += cpop(x)
+   while (x) { n += x & 1; x >>= 1; }      n += cpop(x)
+   while (x) { n++; x >>= 1; }             n += 32 - clz(x)
+   while (x) { n++; x <<= 1; }             n += 32 - ctz(x)
+   A negative x never reaches zero under >>, so the forms with >> check the
+   sign first and leave a negative x to the loop as written. */
+bool CodeGenVisitor::matchBitCountLoop(const Expression* condition, const Node* body, const Expression* increment, BitCountLoop& loop) {
+    const Expression* tested = condition;
+    if (auto* condExpr = binaryWith(condition, ast::BinaryOp::Type::NE)) {
+        if (isConstant(condExpr->getRight(), 0)) {
+            tested = condExpr->getLeft();
+        } else if (isConstant(condExpr->getLeft(), 0)) {
+            tested = condExpr->getRight();
+        } else {
+            return false;
+        }
+    }
+    if (!isLocalIntVariable(tested)) {
+        return false;
+    }
+    loop.value = tested->asIdentifierExpression()->getSymbol();
+
+    std::vector<const Expression*> steps;
+    if (!collectLoopSteps(body, steps) || !collectLoopSteps(increment, steps) || steps.size() != 2) {
+        return false;
+    }
+
+    enum class ValueStep { None, ClearLowest, ShiftRight, ShiftLeft };
+    ValueStep valueStep = ValueStep::None;
+    int valueIndex = -1;
+    bool countsLowBit = false;
+    int counterIndex = -1;
+    for (int i = 0; i < 2; i++) {
+        const Expression* step = steps[i];
+        const Expression* operand = nullptr;
+        const ast::IdentifierExpression* target = nullptr;
+
+        if ((target = selfUpdate(step, ast::BinaryOp::Type::AND, operand)) && target->getSymbol() == loop.value) {
+            // x & (x - 1)
+            auto* minusOne = binaryWith(operand, ast::BinaryOp::Type::SUB);
+            if (minusOne && sameVariable(minusOne->getLeft(), target) && isConstant(minusOne->getRight(), 1)) {
+                valueStep = ValueStep::ClearLowest;
+                valueIndex = i;
+            }
+            continue;
+        }
+        if ((target = selfUpdate(step, ast::BinaryOp::Type::RIGHT_SHIFT, operand)) && target->getSymbol() == loop.value) {
+            if (isConstant(operand, 1)) {
+                valueStep = ValueStep::ShiftRight;
+                valueIndex = i;
+            }
+            continue;
+        }
+        if ((target = selfUpdate(step, ast::BinaryOp::Type::LEFT_SHIFT, operand)) && target->getSymbol() == loop.value) {
+            if (isConstant(operand, 1)) {
+                valueStep = ValueStep::ShiftLeft;
+                valueIndex = i;
+            }
+            continue;
+        }
+
+        // n++, ++n, n += 1, n = n + 1, or n += x & 1
+        if (auto* unaryExpr = step->asUnaryExpression()) {
+            if (unaryExpr->getOperator() == ast::UnaryOp::Type::POST_INCREMENT ||
+                unaryExpr->getOperator() == ast::UnaryOp::Type::PRE_INCREMENT) {
+                target = unaryExpr->getOperand()->asIdentifierExpression();
+                operand = nullptr;
+            }
+        } else {
+            target = selfUpdate(step, ast::BinaryOp::Type::ADD, operand);
+        }
+        if (!target || target->getSymbol() == loop.value || !isLocalIntVariable(target)) {
+            continue;
+        }
+        if (operand) {
+            auto* lowBit = binaryWith(operand, ast::BinaryOp::Type::AND);
+            if (lowBit && ((sameVariable(lowBit->getLeft(), tested) && isConstant(lowBit->getRight(), 1)) ||
+                           (sameVariable(lowBit->getRight(), tested) && isConstant(lowBit->getLeft(), 1)))) {
+                countsLowBit = true;
+            } else if (!isConstant(operand, 1)) {
+                continue;
+            }
+        }
+        loop.counter = target->getSymbol();
+        counterIndex = i;
+    }
+    if (valueIndex < 0 || counterIndex < 0 || valueIndex == counterIndex) {
+        return false;
+    }
+
+    switch (valueStep) {
+        case ValueStep::ClearLowest:
+            if (countsLowBit) {
+                return false;
+            }
+            loop.opcode = Opcode::Cpop;
+            loop.fromWidth = false;
+            return true;
+        case ValueStep::ShiftRight:
+            // the low bit must be counted before it is shifted out
+            if (countsLowBit && counterIndex > valueIndex) {
+                return false;
+            }
+            loop.opcode = countsLowBit ? Opcode::Cpop : Opcode::Clz;
+            loop.fromWidth = !countsLowBit;
+            loop.shiftsRight = true;
+            return true;
+        case ValueStep::ShiftLeft:
+            if (countsLowBit) {
+                return false;
+            }
+            loop.opcode = Opcode::Ctz;
+            loop.fromWidth = true;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool CodeGenVisitor::emitBitCountLoop(const Node* init, const Expression* condition, const Node* body, const Expression* increment) {
+    BitCountLoop loop;
+    if (!condition || !matchBitCountLoop(condition, body, increment, loop)) {
+        return false;
+    }
+
+    if (init) {
+        init->accept(*this);
+        if (!currentExprResult.empty()) {
+            context.freeRegister(currentExprResult);
+            currentExprResult.clear();
+        }
+    }
+
+    std::string scalarLabel;
+    std::string endLabel;
+    std::string valueReg = context.allocateRegister();
+    context.loadVariable(*code, valueReg, loop.value);
+    if (loop.shiftsRight) {
+        scalarLabel = context.generateUniqueLabel("bitcount_scalar");
+        endLabel = context.generateUniqueLabel("bitcount_end");
+        emit(Opcode::Bltz, {Reg(valueReg), Sym(scalarLabel)});
+    }
+    emit(loop.opcode, {Reg(valueReg), Reg(valueReg)});
+    std::string counterReg = context.allocateRegister();
+    if (loop.fromWidth) {
+        emit(Opcode::Li, {Reg(counterReg), Imm(32)});
+        emit(Opcode::Sub, {Reg(valueReg), Reg(counterReg), Reg(valueReg)});
+    }
+    context.loadVariable(*code, counterReg, loop.counter);
+    emit(Opcode::Add, {Reg(counterReg), Reg(counterReg), Reg(valueReg)});
+    context.storeVariable(*code, counterReg, loop.counter);
+    context.storeVariable(*code, "zero", loop.value);
+    context.freeRegister(counterReg);
+    context.freeRegister(valueReg);
+
+    if (loop.shiftsRight) {
+        // the body is nothing but the two steps, so no break or continue to route
+        emit(Opcode::J, {Sym(endLabel)});
+        code->addLabel(scalarLabel);
+        condition->accept(*this);
+        std::string condReg = getExpressionResult();
+        emit(Opcode::Beqz, {Reg(condReg), Sym(endLabel)});
+        context.freeRegister(condReg);
+        body->accept(*this);
+        if (increment) {
+            increment->accept(*this);
+            if (!currentExprResult.empty()) {
+                context.freeRegister(currentExprResult);
+                currentExprResult.clear();
+            }
+        }
+        emit(Opcode::J, {Sym(scalarLabel)});
+        code->addLabel(endLabel);
+    }
+    return true;
+}
+
+/*******************  PROFILE FEEDBACK **********************/
+
+// -2 for statements outside the numbering, so block + 1 is still never a real block
+int CodeGenVisitor::profileBlock(const Node& stmt) const {
+    auto it = profileBlocks.find(&stmt);
+    return it != profileBlocks.end() ? it->second : -2;
+}
+
+// -fprofile-generate: bump this block's 64-bit counter each time control reaches it
+void CodeGenVisitor::emitProfileCounter(int block) {
+    if (context.getOptions().profile_generate.empty() || block < 0) {
+        return;
+    }
+    int index = context.addProfileCounter(context.getCurrentFunction().str() + " " + std::to_string(block));
+    std::string counter = ".Lprofile_counters+" + std::to_string(8 * index);
+    std::string addressReg = context.allocateRegister();
+    std::string countReg = context.allocateRegister();
+    std::string carryReg = context.allocateRegister();
+    emit(Opcode::Lui, {Reg(addressReg), Hi(counter)});
+    emit(Opcode::Addi, {Reg(addressReg), Reg(addressReg), Lo(counter)});
+    emit(Opcode::Lw, {Reg(countReg), Mem(0, addressReg)});
+    emit(Opcode::Addi, {Reg(countReg), Reg(countReg), Imm(1)});
+    emit(Opcode::Sw, {Reg(countReg), Mem(0, addressReg)});
+    // the low word wrapped to zero: carry into the high word
+    emit(Opcode::Sltiu, {Reg(carryReg), Reg(countReg), Imm(1)});
+    emit(Opcode::Lw, {Reg(countReg), Mem(4, addressReg)});
+    emit(Opcode::Add, {Reg(countReg), Reg(countReg), Reg(carryReg)});
+    emit(Opcode::Sw, {Reg(countReg), Mem(4, addressReg)});
+    context.freeRegister(carryReg);
+    context.freeRegister(countReg);
+    context.freeRegister(addressReg);
+}
+
+// nullopt without -fprofile-use or when the profile never saw this function
+std::optional<uint64_t> CodeGenVisitor::profileCount(int block) const {
+    const ProfileData* profile = context.getProfile();
+    if (profile == nullptr || block < 0) {
+        return std::nullopt;
+    }
+    return profile->count(context.getCurrentFunction().str(), block);
+}
+
+/* With a profile, compare against the case values hottest first and then jump
+   to the default (or out), instead of testing them in source order on the way
+   through the body. Only used when every case label sits directly in the
+   switch body, so the labels the dispatch jumps to are all emitted. */
+bool CodeGenVisitor::emitProfiledSwitch(const ast::SwitchStatement& stmt, const std::string& valueReg, const std::string& endLabel) {
+    auto* body = dynamic_cast<const CompoundStatement*>(stmt.getBody());
+    if (context.getProfile() == nullptr || body == nullptr) {
+        return false;
+    }
+
+    // case 1: case 2: stmt nests one label inside the other
+    std::vector<const CaseStatement*> cases;
+    for (const auto& s : body->getStatements()) {
+        auto* caseStmt = dynamic_cast<const CaseStatement*>(s);
+        while (caseStmt != nullptr) {
+            cases.push_back(caseStmt);
+            caseStmt = dynamic_cast<const CaseStatement*>(caseStmt->getStatement());
+        }
+    }
+    AnalysisVisitor bodyInfo;
+    body->accept(bodyInfo);
+    size_t labels = 0;
+    for (const Node* node : bodyInfo.getBranchStatements()) {
+        if (dynamic_cast<const SwitchStatement*>(node)) {
+            return false;
+        }
+        if (dynamic_cast<const CaseStatement*>(node)) {
+            labels++;
+        }
+    }
+    if (cases.empty() || labels != cases.size()) {
+        return false;
+    }
+
+    std::vector<std::pair<uint64_t, const CaseStatement*>> tests;
+    std::string fallback = endLabel;
+    for (const CaseStatement* caseStmt : cases) {
+        auto count = profileCount(profileBlock(*caseStmt));
+        if (!count) {
+            return false;
+        }
+        std::string label = context.generateUniqueLabel(caseStmt->isDefault() ? "default" : "case");
+        profiledCaseLabels[caseStmt] = label;
+        if (caseStmt->isDefault()) {
+            fallback = label;
+        } else {
+            tests.push_back({*count, caseStmt});
+        }
+    }
+    std::stable_sort(tests.begin(), tests.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    for (const auto& test : tests) {
+        test.second->getCaseValue()->accept(*this);
+        std::string caseValueReg = getExpressionResult();
+        emit(Opcode::Beq, {Reg(valueReg), Reg(caseValueReg), Sym(profiledCaseLabels[test.second])});
+        context.freeRegister(caseValueReg);
+    }
+    emit(Opcode::J, {Sym(fallback)});
+    return true;
+}
+
+/*******************  BLOCK LAYOUT **********************/
+
+// a statement that leaves the function on every path through its end
+static bool endsInReturn(const Node* stmt) {
+    if (dynamic_cast<const ReturnStatement*>(stmt)) {
+        return true;
+    }
+    auto* compound = dynamic_cast<const CompoundStatement*>(stmt);
+    if (compound && !compound->getStatements().empty()) {
+        return endsInReturn(compound->getStatements().back());
+    }
+    return false;
+}
+
+/* Static guess for code without profile counts: an arm that aborts the program,
+   or that returns early from inside a loop (a search hit, an error exit),
+   runs far less often than the code around it. */
+bool CodeGenVisitor::isColdPath(const Node* arm) const {
+    static const std::set<std::string> noReturn = {"abort", "exit", "_Exit", "__assert_fail"};
+
+    AnalysisVisitor armInfo;
+    arm->accept(armInfo);
+    for (const auto& name : armInfo.getCalledFunctions()) {
+        if (noReturn.count(name.str())) {
+            return true;
+        }
+    }
+    bool inLoop = !context.getContinueTarget().empty();
+    return inLoop && endsInReturn(arm);
+}
+
+CodeGenVisitor::BranchLayout CodeGenVisitor::chooseIfLayout(const ast::IfStatement& stmt, int block) const {
+    bool hasElse = stmt.hasElseStatement();
+    auto entered = profileCount(block);
+    auto taken = profileCount(block + 1);
+    if (entered && taken && *entered > 0) {
+        uint64_t skipped = *entered - std::min(*taken, *entered);
+        if (16 * *taken <= *entered) {
+            return BranchLayout::ThenOutOfLine;
+        }
+        if (hasElse && 16 * skipped <= *entered) {
+            return BranchLayout::ElseOutOfLine;
+        }
+        if (hasElse && skipped > 2 * *taken) {
+            return BranchLayout::ElseFirst;
+        }
+        return BranchLayout::Source;
+    }
+
+    if (!context.getOptions().reorder_blocks) {
+        return BranchLayout::Source;
+    }
+    if (isColdPath(stmt.getThenStatement())) {
+        return BranchLayout::ThenOutOfLine;
+    }
+    if (hasElse && isColdPath(stmt.getElseStatement())) {
+        return BranchLayout::ElseOutOfLine;
+    }
+    return BranchLayout::Source;
+}
+
+// generates arm where it stands (so registers and scopes are as usual) but
+// keeps the code aside until the function's epilogue has been written
+void CodeGenVisitor::emitOutOfLine(const Node* arm, const std::string& label, const std::string& resumeLabel, int block) {
+    mir::Function cold;
+    mir::Function* hot = code;
+    code = &cold;
+    coldDepth++;
+
+    code->addLabel(label);
+    emitProfileCounter(block);
+    arm->accept(*this);
+    if (!endsInReturn(arm)) {
+        emit(Opcode::J, {Sym(resumeLabel)});
+    }
+
+    coldDepth--;
+    code = hot;
+    coldBlocks.push_back(std::move(cold));
+}
+
+// while loop tested at the bottom, so each iteration takes a single branch
+void CodeGenVisitor::emitRotatedWhileLoop(const ast::WhileStatement& stmt, int block) {
+    std::string bodyLabel = context.generateUniqueLabel("while_body");
+    std::string condLabel = context.generateUniqueLabel("while_cond");
+    std::string endLabel = context.generateUniqueLabel("while_end");
+    context.pushBreakTarget(endLabel);
+    context.pushContinueTarget(condLabel);
+    auto hoisted = hoistInvariantDivisors(stmt);
+
+    emit(Opcode::J, {Sym(condLabel)});
+    code->addLabel(bodyLabel);
+    emitProfileCounter(block + 1);
+    stmt.getBody()->accept(*this);
+
+    code->addLabel(condLabel);
+    stmt.getCondition()->accept(*this);
+    std::string condReg = getExpressionResult();
+    emit(Opcode::Bnez, {Reg(condReg), Sym(bodyLabel)});
+    context.freeRegister(condReg);
+    code->addLabel(endLabel);
+
+    dropInvariantDivisors(hoisted);
+    context.popBreakTarget();
+    context.popContinueTarget();
+}
+
+/*******************  FUNCTION PLACEMENT **********************/
+
+// section for code that profile counts or heuristics say almost never runs
+const char* const CodeGenVisitor::COLD_TEXT_SECTION = ".section .text.unlikely,\"ax\",@progbits";
+
+// a function the profile saw compiled in but never entered
+bool CodeGenVisitor::isColdFunction(const std::string& name) const {
+    const ProfileData* profile = context.getProfile();
+    if (!context.getOptions().partition_cold || profile == nullptr) {
+        return false;
+    }
+    auto entries = profile->count(name, 0);
+    return entries && *entries == 0;
+}
+
+// static call-site weight: each enclosing loop is guessed to run eight times,
+// and calls from out-of-line code are not worth keeping close
+void CodeGenVisitor::noteCall(const std::string& callee) {
+    if (coldDepth > 0) {
+        return;
+    }
+    uint64_t weight = 1;
+    for (int depth = context.getLoopDepth(); depth > 0 && weight < 4096; depth--) {
+        weight *= 8;
+    }
+    callWeights[context.getCurrentFunction().str()][callee] += weight;
+}
+
+void CodeGenVisitor::finishTranslationUnit() {
+    if (emittedFunctions.empty()) {
+        return;
+    }
+    const ProfileData* profile = context.getProfile();
+
+    std::unordered_map<std::string, uint64_t> incoming;
+    for (const auto& [caller, callees] : callWeights) {
+        for (const auto& [callee, weight] : callees) {
+            incoming[callee] += weight;
+        }
+    }
+
+    std::vector<FunctionNode> nodes;
+    for (const auto& function : emittedFunctions) {
+        FunctionNode node;
+        node.name = function.name;
+        node.size = function.lineCount();
+        auto entries = profile ? profile->count(function.name, 0) : std::nullopt;
+        node.heat = entries ? *entries : incoming[function.name] + (function.name == "main" ? 1 : 0);
+        for (const auto& [callee, weight] : callWeights[function.name]) {
+            // with counts, share the callee's entries among its call sites by their static weight
+            auto calleeEntries = profile ? profile->count(callee, 0) : std::nullopt;
+            node.calls[callee] = calleeEntries ? *calleeEntries * weight / incoming[callee] : weight;
+        }
+        nodes.push_back(node);
+    }
+
+    for (size_t i : OrderFunctions(nodes)) {
+        mir::Print(emittedFunctions[i], output);
+    }
+    emittedFunctions.clear();
+}
+
 } // namespace codegen
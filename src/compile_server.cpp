@@ -0,0 +1,116 @@
+#include "compile_server.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// a client that neither sends nor reads for this long loses its worker
+void setIdleTimeout(int connection)
+{
+    timeval timeout{};
+    timeout.tv_sec = CONNECTION_IDLE_SECONDS;
+    setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+// a socket left by an earlier server may be replaced; anything else at the path is not ours
+void removeStaleSocket(const std::string& socket_path)
+{
+    struct stat status;
+    if (lstat(socket_path.c_str(), &status) != 0) {
+        if (errno == ENOENT) {
+            return;
+        }
+        throw std::runtime_error("Could not check " + socket_path + ": " + std::strerror(errno));
+    }
+    if (!S_ISSOCK(status.st_mode)) {
+        throw std::runtime_error("Not replacing " + socket_path + ": it exists and is not a socket");
+    }
+    unlink(socket_path.c_str());
+}
+
+void serveConnection(int connection, const CompileHandler& handler)
+{
+    setIdleTimeout(connection);
+    for (;;) {
+        CompileRequest request;
+        CompileResponse response;
+        bool received = false;
+        try {
+            received = protocol::ReceiveRequest(connection, request);
+            if (received) {
+                response = handler(request);
+            }
+        } catch (const std::exception& error) {
+            // a request that could not be held leaves the stream out of step: drop the client
+            if (!received) {
+                break;
+            }
+            response.ok = false;
+            response.log = std::string("error: ") + error.what() + "\n";
+        }
+        if (!received || !protocol::SendResponse(connection, response)) {
+            break;
+        }
+    }
+    close(connection);
+}
+
+} // namespace
+
+void RunCompileServer(const std::string& socket_path, unsigned workers, const CompileHandler& handler)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + socket_path);
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+
+    removeStaleSocket(socket_path);
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error(std::string("Could not create socket: ") + std::strerror(errno));
+    }
+    // only the user who started the server may connect: the socket is created 0600
+    mode_t previous_mask = umask(0177);
+    int bound = bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    umask(previous_mask);
+    if (bound != 0 || listen(listener, 128) != 0) {
+        const std::string reason = std::strerror(errno);
+        close(listener);
+        throw std::runtime_error("Could not listen on " + socket_path + ": " + reason);
+    }
+
+    auto worker = [&]() {
+        for (;;) {
+            int connection = accept(listener, nullptr, nullptr);
+            if (connection < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                return;
+            }
+            serveConnection(connection, handler);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < workers; i++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    close(listener);
+}
@@ -1,81 +1,302 @@
+#include <chrono>
+#include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <sstream>
 
 #include "cli.hpp"
+#include "assembly_stream.hpp"
 #include "ast.hpp"
+#include "c_compiler.hpp"
+#include "compile_server.hpp"
+#include "driver.hpp"
+#include "source_buffer.hpp"
+#include "whole_program.hpp"
 
 using ast::NodePtr;
 
-// Wrapper for ParseAST defined in YACC
-NodePtr Parse(const std::string& compile_source_path);
+// Wrapper for ParseAST defined in YACC; the nodes are allocated from arena.
+NodePtr Parse(const std::string& compile_source_path, ast::Arena& arena, std::ostream& log);
 
 // Output the pretty print version of what was parsed to the .printed output file.
-void PrettyPrint(const NodePtr& root, const std::string& compile_output_path);
+void PrettyPrint(const NodePtr& root, const std::string& compile_output_path, std::ostream& log);
 
 // Compile from the root of the AST and output this to the compiledOutputPath file.
-void Compile(const NodePtr& root, const std::string& compile_output_path);
+void Compile(const NodePtr& root, const std::string& compile_output_path, const CompileOptions& options,
+             std::ostream& log);
+
+// One source file through the library: regular files are mapped, "-" and
+// pipes read. A file that cannot be read fails like any other unit.
+CompileResult CompileFile(Compiler& compiler, const std::string& compile_source_path, const CompileOptions& options);
+
+// Writes what the library produced to compile_output_path and its .printed
+// AST beside it, then logs the result. Throws if the unit failed.
+void WriteResult(const CompileResult& result, const std::string& compile_output_path, std::ostream& log);
+
+// Driver mode: parse and compile one translation unit with its own arena and
+// Context, so several can run on different threads. Throws if it fails.
+void CompileUnit(const std::string& compile_source_path, const std::string& compile_output_path,
+                 const CompileOptions& options, std::ostream& log);
+
+// Driver mode: every unit on up to cli_args.jobs threads, one status line each.
+int CompileUnits(const CommandLineArguments& cli_args);
+
+// --server: one client's request, compiled with its flags on top of the server's options.
+CompileResponse ServeCompile(const CompileRequest& request, const CompileOptions& options);
+
+// Each driver or server worker thread keeps its compiler, and so its arena, warm.
+thread_local Compiler worker_compiler;
 
 int main(int argc, char **argv)
 {
     // Parse CLI arguments to fetch the source file to compile and the path to output to.
     // This retrives [source-file.c] and [dest-file.s], when the compiler is invoked as follows:
     // ./bin/c_compiler -S [source-file.c] -o [dest-file.s]
-    const auto [compile_source_path, compile_output_path] = ParseCommandLineArgs(argc, argv);
+    const auto cli_args = ParseCommandLineArgs(argc, argv);
+    const auto& compile_source_paths = cli_args.compile_source_paths;
+    const auto& compile_output_path = cli_args.compile_output_path;
+    const auto& options = cli_args.options;
 
-    // Parse input and generate AST.
-    auto ast_root = Parse(compile_source_path);
+    // Stay resident and compile for c_compiler_client until killed.
+    if (!cli_args.server_socket.empty())
+    {
+        std::cout << "Serving compile requests on " << cli_args.server_socket << " with " << cli_args.jobs
+                  << " workers" << std::endl;
+        try
+        {
+            RunCompileServer(cli_args.server_socket, cli_args.jobs,
+                             [&options](const CompileRequest& request) { return ServeCompile(request, options); });
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Several independent translation units: compile them side by side.
+    if (cli_args.driver)
+    {
+        return CompileUnits(cli_args);
+    }
+
+    // One translation unit: the library does everything but the files.
+    if (!options.whole_program)
+    {
+        Compiler compiler;
+        compiler.setPrintAst(true);
+        const CompileResult result = CompileFile(compiler, compile_source_paths.front(), options);
+        try
+        {
+            WriteResult(result, compile_output_path, std::cout);
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
 
-    // Check something was actually returned by parseAST().
-    if (ast_root == nullptr)
+    // Parse input and generate AST.
+    std::vector<SourceUnit> units;
+    for (const auto& compile_source_path : compile_source_paths)
     {
-        std::cerr << "The root of the AST is a null pointer. ";
-        std::cerr << "Likely the root was never initialised correctly during parsing." << std::endl;
-        return 3;
+        auto arena = std::make_unique<ast::Arena>();
+        NodePtr unit_root = nullptr;
+        try
+        {
+            unit_root = Parse(compile_source_path, *arena, std::cout);
+        }
+        catch (const std::runtime_error& error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+
+        // Check something was actually returned by parseAST().
+        if (unit_root == nullptr)
+        {
+            std::cerr << "The root of the AST is a null pointer. ";
+            std::cerr << "Likely the root was never initialised correctly during parsing." << std::endl;
+            return 3;
+        }
+        units.push_back({compile_source_path, std::move(arena), unit_root});
     }
 
+    // nodes made after parsing, by the linker or -fipa-ra, live with the first unit
+    ast::Arena::Scope arena_scope(*units.front().arena);
+
+    // -fwhole-program: one tree for every unit, without what main never reaches.
+    LinkReport report;
+    auto ast_root = LinkProgram(units, report);
+    std::cout << "Linked " << units.size() << " translation units, removed " << report.removedFunctions
+              << " unreferenced functions and " << report.removedGlobals << " globals" << std::endl;
+
     // Print AST in a human-readable way. It's not assessed, but exists for your convenience.
-    PrettyPrint(ast_root, compile_output_path);
+    PrettyPrint(ast_root, compile_output_path, std::cout);
 
     // Compile to RISC-V assembly, the main goal of this project.
-    Compile(ast_root, compile_output_path);
+    Compile(ast_root, compile_output_path, options, std::cout);
 }
 
-NodePtr Parse(const std::string& compile_source_path)
+NodePtr Parse(const std::string& compile_source_path, ast::Arena& arena, std::ostream& log)
 {
-    std::cout << "Parsing ..." << compile_source_path << std::endl;
+    log << "Parsing ..." << compile_source_path << std::endl;
 
-    NodePtr root = ParseAST(compile_source_path);
+    NodePtr root = ParseAST(compile_source_path, arena);
 
-    std::cout << "AST parsing complete" << std::endl;
+    log << "AST parsing complete" << std::endl;
+    log << "AST has " << arena.objectCount() << " nodes in " << arena.bytesUsed() << " arena bytes ("
+        << arena.bytesReserved() << " reserved)" << std::endl;
 
     return root;
 }
 
-void PrettyPrint(const NodePtr& root, const std::string& compile_output_path)
+void PrettyPrint(const NodePtr& root, const std::string& compile_output_path, std::ostream& log)
 {
     auto output_path = compile_output_path + ".printed";
 
-    std::cout << "Printing parsed AST..." << std::endl;
+    log << "Printing parsed AST..." << std::endl;
 
     std::ofstream output(output_path, std::ios::trunc);
     root->Print(output);
 
-    std::cout << "Printed parsed AST to: " << output_path << std::endl;
+    log << "Printed parsed AST to: " << output_path << std::endl;
+}
+
+void Compile(const NodePtr& root, const std::string& compile_output_path, const CompileOptions& options,
+             std::ostream& log)
+{
+    AssemblyStream output(compile_output_path);
+    GenerateAssembly(root, output, options, log);
+    output.close();
+    log << "Compiled to: " << compile_output_path << std::endl;
+
+    if (options.compressed)
+    {
+        std::ifstream assembly(compile_output_path);
+        ReportCompression(assembly, log);
+    }
+}
+
+CompileResult CompileFile(Compiler& compiler, const std::string& compile_source_path, const CompileOptions& options)
+{
+    if (std::optional<SourceBuffer> source = SourceBuffer::Load(compile_source_path))
+    {
+        return compiler.compile(*source, options, compile_source_path);
+    }
+
+    std::ostringstream text;
+    if (compile_source_path == "-")
+    {
+        text << std::cin.rdbuf();
+    }
+    else
+    {
+        std::ifstream input(compile_source_path);
+        if (!input)
+        {
+            CompileResult result;
+            result.diagnostics = "Couldn't open input file: " + compile_source_path;
+            return result;
+        }
+        text << input.rdbuf();
+    }
+    return compiler.compile(text.str(), options, compile_source_path);
 }
 
-void Compile(const NodePtr& root, const std::string& compile_output_path)
+void WriteResult(const CompileResult& result, const std::string& compile_output_path, std::ostream& log)
 {
-    std::cout << "Compiling parsed AST..." << std::endl;
+    log << result.log;
+    if (!result.ok)
+    {
+        throw std::runtime_error(result.diagnostics);
+    }
 
-    ast::Context ctx;
+    const auto output_directory = std::filesystem::path(compile_output_path).parent_path();
+    if (!output_directory.empty())
+    {
+        std::filesystem::create_directories(output_directory);
+    }
+
+    if (!result.printed_ast.empty())
+    {
+        std::ofstream printed(compile_output_path + ".printed", std::ios::trunc);
+        printed << result.printed_ast;
+        log << "Printed parsed AST to: " << compile_output_path << ".printed" << std::endl;
+    }
 
     std::ofstream output(compile_output_path, std::ios::trunc);
+    output << result.assembly;
+    log << "Compiled to: " << compile_output_path << std::endl;
+}
+
+void CompileUnit(const std::string& compile_source_path, const std::string& compile_output_path,
+                 const CompileOptions& options, std::ostream& log)
+{
+    worker_compiler.setPrintAst(true);
+    WriteResult(CompileFile(worker_compiler, compile_source_path, options), compile_output_path, log);
+}
+
+int CompileUnits(const CommandLineArguments& cli_args)
+{
+    const auto& sources = cli_args.compile_source_paths;
+    const auto& outputs = cli_args.compile_output_paths;
+    const unsigned threads = std::min<size_t>(cli_args.jobs, sources.size());
+
+    // each unit logs into its own buffer, shown only if it fails
+    std::vector<std::ostringstream> logs(sources.size());
 
-    codegen::CodeGenVisitor visitor(ctx, output);
+    const auto start = std::chrono::steady_clock::now();
+    const auto results = RunJobs(
+        sources.size(), threads,
+        [&](size_t i) { CompileUnit(sources[i], outputs[i], cli_args.options, logs[i]); },
+        [&](size_t i, const JobResult& result) {
+            std::cout << (result.ok ? "ok   " : "FAIL ") << std::fixed << std::setprecision(1) << std::setw(8)
+                      << result.milliseconds << " ms  " << sources[i] << " -> " << outputs[i] << std::endl;
+            if (!result.ok)
+            {
+                std::cout << logs[i].str() << "error: " << result.error << std::endl;
+            }
+        });
+    const double milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    size_t compiled = 0;
+    for (const auto& result : results)
+    {
+        compiled += result.ok;
+    }
+    std::cout << "Compiled " << compiled << " of " << sources.size() << " translation units on " << threads
+              << " threads in " << std::fixed << std::setprecision(1) << milliseconds << " ms" << std::endl;
+    return compiled == sources.size() ? 0 : 4;
+}
 
-    root->accept(visitor);
-    std::cout << "Compiled to: " << compile_output_path << std::endl;
-    ctx.printDoubleData(output);
-    ctx.printFloatData(output);
-    ctx.printStringData(output);
+CompileResponse ServeCompile(const CompileRequest& request, const CompileOptions& options)
+{
+    CompileOptions request_options = options;
+    for (const auto& flag : request.flags)
+    {
+        if (!ParseOptionFlag(flag, request_options))
+        {
+            throw std::runtime_error("Unknown option `" + flag + "'");
+        }
+    }
+
+    worker_compiler.setPrintAst(false);
+    CompileResult result = worker_compiler.compile(request.source_text, request_options, request.source_name);
+
+    CompileResponse response;
+    response.ok = result.ok;
+    response.assembly = std::move(result.assembly);
+    response.log = std::move(result.log);
+    if (!result.ok)
+    {
+        response.log += "error: " + result.diagnostics + "\n";
+    }
+    return response;
 }
@@ -0,0 +1,209 @@
+#include "compression_report.hpp"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// x8-x15 and f8-f15, the only registers most RVC formats can name
+const std::set<std::string> COMPRESSED_REGISTERS = {
+    "s0", "fp", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+    "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15"
+};
+const std::set<std::string> COMPRESSED_FLOAT_REGISTERS = {
+    "fs0", "fs1", "fa0", "fa1", "fa2", "fa3", "fa4", "fa5",
+    "f8", "f9", "f10", "f11", "f12", "f13", "f14", "f15"
+};
+
+bool isCompressedRegister(const std::string& reg) {
+    return COMPRESSED_REGISTERS.count(reg) > 0;
+}
+
+bool isCompressedFloatRegister(const std::string& reg) {
+    return COMPRESSED_FLOAT_REGISTERS.count(reg) > 0;
+}
+
+bool isZero(const std::string& reg) {
+    return reg == "zero" || reg == "x0";
+}
+
+bool isStackPointer(const std::string& reg) {
+    return reg == "sp" || reg == "x2";
+}
+
+// numeric immediates only; %lo(sym) and friends are never compressible
+bool parseImmediate(const std::string& text, long& value) {
+    if (text.empty()) {
+        return false;
+    }
+    try {
+        size_t used = 0;
+        value = std::stol(text, &used, 0);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool fitsSigned6(long value) {
+    return value >= -32 && value <= 31;
+}
+
+// splits "12(s0)" into offset and base register
+bool parseMemoryOperand(const std::string& text, long& offset, std::string& base) {
+    size_t open = text.find('(');
+    size_t close = text.find(')');
+    if (open == std::string::npos || close == std::string::npos || close < open) {
+        return false;
+    }
+    base = text.substr(open + 1, close - open - 1);
+    std::string displacement = text.substr(0, open);
+    if (displacement.empty()) {
+        offset = 0;
+        return true;
+    }
+    return parseImmediate(displacement, offset);
+}
+
+// c.lw/c.sw/c.flw/c.fsw (scale 4) and c.fld/c.fsd (scale 8), plus their sp forms
+bool isCompressedMemoryAccess(const std::string& reg, const std::string& address, int scale, bool isFloat, bool isLoad) {
+    long offset;
+    std::string base;
+    if (!parseMemoryOperand(address, offset, base) || offset < 0 || offset % scale != 0) {
+        return false;
+    }
+    if (isStackPointer(base)) {
+        return (isFloat || !isLoad || !isZero(reg)) && offset < 64 * scale;
+    }
+    bool regOk = isFloat ? isCompressedFloatRegister(reg) : isCompressedRegister(reg);
+    return regOk && isCompressedRegister(base) && offset < 32 * scale;
+}
+
+// number of machine instructions a (pseudo-)instruction turns into, and how many compress
+std::pair<int, int> classify(const std::string& mnemonic, const std::vector<std::string>& ops) {
+    auto op = [&](size_t i) -> std::string { return i < ops.size() ? ops[i] : ""; };
+    long imm;
+
+    if (mnemonic == "call" || mnemonic == "tail" || mnemonic == "la" || mnemonic == "lla") {
+        return {2, 0};
+    }
+    if (mnemonic == "nop" || mnemonic == "ret" || mnemonic == "ebreak" ||
+        mnemonic == "j" || mnemonic == "jr" || mnemonic == "jalr") {
+        return {1, 1};
+    }
+    if (mnemonic == "li") {
+        if (!parseImmediate(op(1), imm)) {
+            return {1, 0};
+        }
+        if (imm < -2048 || imm > 2047) {
+            return {2, 0};
+        }
+        return {1, fitsSigned6(imm) && !isZero(op(0)) ? 1 : 0};
+    }
+    if (mnemonic == "mv") {
+        return {1, !isZero(op(0)) ? 1 : 0};
+    }
+    if (mnemonic == "addi") {
+        if (!parseImmediate(op(2), imm)) {
+            return {1, 0};
+        }
+        if (imm == 0) {
+            return {1, !isZero(op(0)) && !isZero(op(1)) ? 1 : 0};
+        }
+        if (op(0) == op(1) && isStackPointer(op(0)) && imm % 16 == 0 && imm >= -512 && imm <= 496) {
+            return {1, 1};
+        }
+        if (isStackPointer(op(1)) && isCompressedRegister(op(0)) && imm % 4 == 0 && imm > 0 && imm <= 1020) {
+            return {1, 1};
+        }
+        return {1, op(0) == op(1) && !isZero(op(0)) && fitsSigned6(imm) ? 1 : 0};
+    }
+    if (mnemonic == "add") {
+        if (isZero(op(1)) || isZero(op(2))) {
+            return {1, !isZero(op(0)) ? 1 : 0};
+        }
+        return {1, !isZero(op(0)) && (op(0) == op(1) || op(0) == op(2)) ? 1 : 0};
+    }
+    if (mnemonic == "and" || mnemonic == "or" || mnemonic == "xor") {
+        bool twoAddress = (op(0) == op(1) && isCompressedRegister(op(2))) ||
+                          (op(0) == op(2) && isCompressedRegister(op(1)));
+        return {1, isCompressedRegister(op(0)) && twoAddress ? 1 : 0};
+    }
+    if (mnemonic == "sub") {
+        return {1, op(0) == op(1) && isCompressedRegister(op(0)) && isCompressedRegister(op(2)) ? 1 : 0};
+    }
+    if (mnemonic == "andi") {
+        return {1, op(0) == op(1) && isCompressedRegister(op(0)) &&
+                   parseImmediate(op(2), imm) && fitsSigned6(imm) ? 1 : 0};
+    }
+    if (mnemonic == "slli" || mnemonic == "srli" || mnemonic == "srai") {
+        bool regOk = mnemonic == "slli" ? !isZero(op(0)) : isCompressedRegister(op(0));
+        return {1, op(0) == op(1) && regOk && parseImmediate(op(2), imm) && imm > 0 && imm < 32 ? 1 : 0};
+    }
+    if (mnemonic == "lui") {
+        bool small = parseImmediate(op(1), imm) && imm != 0 && (imm < 32 || (imm >= 0xfffe0 && imm <= 0xfffff));
+        return {1, small && !isZero(op(0)) && !isStackPointer(op(0)) ? 1 : 0};
+    }
+    if (mnemonic == "beqz" || mnemonic == "bnez") {
+        return {1, isCompressedRegister(op(0)) ? 1 : 0};
+    }
+    if (mnemonic == "beq" || mnemonic == "bne") {
+        return {1, isZero(op(1)) && isCompressedRegister(op(0)) ? 1 : 0};
+    }
+    if (mnemonic == "lw" || mnemonic == "sw" || mnemonic == "flw" || mnemonic == "fsw" ||
+        mnemonic == "fld" || mnemonic == "fsd" || mnemonic == "lb" || mnemonic == "lbu" ||
+        mnemonic == "lh" || mnemonic == "lhu" || mnemonic == "sb" || mnemonic == "sh") {
+        if (op(1).find('(') == std::string::npos) {
+            // lw rd, symbol expands to auipc + lw
+            return {2, 0};
+        }
+        bool isFloat = mnemonic[0] == 'f';
+        bool isLoad = mnemonic[0] == 'l' || mnemonic.rfind("fl", 0) == 0;
+        if (mnemonic == "lw" || mnemonic == "sw" || mnemonic == "flw" || mnemonic == "fsw") {
+            return {1, isCompressedMemoryAccess(op(0), op(1), 4, isFloat, isLoad) ? 1 : 0};
+        }
+        if (mnemonic == "fld" || mnemonic == "fsd") {
+            return {1, isCompressedMemoryAccess(op(0), op(1), 8, isFloat, isLoad) ? 1 : 0};
+        }
+        return {1, 0};
+    }
+    return {1, 0};
+}
+
+} // namespace
+
+CompressionReport MeasureCompression(std::istream& assembly)
+{
+    CompressionReport report;
+    std::string line;
+    while (std::getline(assembly, line)) {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream words(line);
+        std::string mnemonic;
+        if (!(words >> mnemonic) || mnemonic[0] == '.' || mnemonic.back() == ':') {
+            continue;
+        }
+
+        std::vector<std::string> operands;
+        std::string rest;
+        std::getline(words, rest);
+        std::istringstream operandList(rest);
+        std::string operand;
+        while (std::getline(operandList, operand, ',')) {
+            size_t first = operand.find_first_not_of(" \t");
+            size_t last = operand.find_last_not_of(" \t");
+            operands.push_back(first == std::string::npos ? "" : operand.substr(first, last - first + 1));
+        }
+
+        auto [count, compressed] = classify(mnemonic, operands);
+        report.instructions += count;
+        report.compressed += compressed;
+    }
+    return report;
+}
@@ -0,0 +1,48 @@
+#include "driver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+std::vector<JobResult> RunJobs(size_t count, unsigned threads, const std::function<void(size_t)>& job,
+                               const std::function<void(size_t, const JobResult&)>& finished)
+{
+    std::vector<JobResult> results(count);
+    std::atomic<size_t> next{0};
+    std::mutex reporting;
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            JobResult& result = results[i];
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                job(i);
+                result.ok = true;
+            } catch (const std::exception& error) {
+                result.error = error.what();
+            } catch (...) {
+                result.error = "unknown exception";
+            }
+            result.milliseconds =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> lock(reporting);
+            finished(i, result);
+        }
+    };
+
+    // the calling thread is one of the workers
+    const size_t helpers = std::min<size_t>(std::max(threads, 1u), count) - (count > 0 ? 1 : 0);
+    std::vector<std::thread> pool;
+    for (size_t i = 0; i < helpers; i++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return results;
+}
@@ -0,0 +1,128 @@
+#include "function_order.hpp"
+
+#include <algorithm>
+#include <map>
+
+namespace {
+
+struct Edge {
+    size_t a;
+    size_t b;
+    uint64_t weight;
+};
+
+// distance in lines between the ends of a and b when laid out as chain
+size_t distance(const std::vector<size_t>& chain, size_t a, size_t b, const std::vector<FunctionNode>& functions) {
+    size_t position = 0;
+    size_t start = 0;
+    bool inside = false;
+    for (size_t node : chain) {
+        if (node == a || node == b) {
+            if (inside) {
+                return position - start;
+            }
+            inside = true;
+            start = position + functions[node].size;
+        }
+        position += functions[node].size;
+    }
+    return 0;
+}
+
+std::vector<size_t> reversed(std::vector<size_t> chain) {
+    std::reverse(chain.begin(), chain.end());
+    return chain;
+}
+
+std::vector<size_t> joined(const std::vector<size_t>& first, const std::vector<size_t>& second) {
+    std::vector<size_t> chain = first;
+    chain.insert(chain.end(), second.begin(), second.end());
+    return chain;
+}
+
+} // namespace
+
+std::vector<size_t> OrderFunctions(const std::vector<FunctionNode>& functions)
+{
+    std::map<std::string, size_t> index;
+    for (size_t i = 0; i < functions.size(); i++) {
+        index[functions[i].name] = i;
+    }
+
+    // undirected graph: calls both ways between two functions add up
+    std::map<std::pair<size_t, size_t>, uint64_t> weights;
+    for (size_t i = 0; i < functions.size(); i++) {
+        for (const auto& [callee, weight] : functions[i].calls) {
+            auto it = index.find(callee);
+            if (it == index.end() || it->second == i || weight == 0) {
+                continue;
+            }
+            weights[{std::min(i, it->second), std::max(i, it->second)}] += weight;
+        }
+    }
+    std::vector<Edge> edges;
+    for (const auto& [pair, weight] : weights) {
+        edges.push_back({pair.first, pair.second, weight});
+    }
+    std::stable_sort(edges.begin(), edges.end(), [](const Edge& x, const Edge& y) { return x.weight > y.weight; });
+
+    std::vector<std::vector<size_t>> chains(functions.size());
+    std::vector<size_t> chainOf(functions.size());
+    for (size_t i = 0; i < functions.size(); i++) {
+        chains[i] = {i};
+        chainOf[i] = i;
+    }
+
+    for (const Edge& edge : edges) {
+        size_t first = chainOf[edge.a];
+        size_t second = chainOf[edge.b];
+        if (first == second) {
+            continue;
+        }
+        const std::vector<size_t>& x = chains[first];
+        const std::vector<size_t>& y = chains[second];
+        std::vector<std::vector<size_t>> candidates = {
+            joined(x, y), joined(x, reversed(y)), joined(reversed(x), y), joined(reversed(x), reversed(y))
+        };
+        size_t best = 0;
+        for (size_t c = 1; c < candidates.size(); c++) {
+            if (distance(candidates[c], edge.a, edge.b, functions) < distance(candidates[best], edge.a, edge.b, functions)) {
+                best = c;
+            }
+        }
+        chains[first] = candidates[best];
+        chains[second].clear();
+        for (size_t node : chains[first]) {
+            chainOf[node] = first;
+        }
+    }
+
+    // hottest chain first; a chain is as hot as its hottest function
+    std::vector<size_t> order;
+    for (size_t i = 0; i < chains.size(); i++) {
+        if (!chains[i].empty()) {
+            order.push_back(i);
+        }
+    }
+    auto chainHeat = [&](size_t chain) {
+        uint64_t heat = 0;
+        for (size_t node : chains[chain]) {
+            heat = std::max(heat, functions[node].heat);
+        }
+        return heat;
+    };
+    auto chainStart = [&](size_t chain) {
+        return *std::min_element(chains[chain].begin(), chains[chain].end());
+    };
+    std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) {
+        uint64_t heatX = chainHeat(x);
+        uint64_t heatY = chainHeat(y);
+        return heatX != heatY ? heatX > heatY : chainStart(x) < chainStart(y);
+    });
+
+    std::vector<size_t> result;
+    for (size_t chain : order) {
+        result.insert(result.end(), chains[chain].begin(), chains[chain].end());
+    }
+    return result;
+}
@@ -0,0 +1,276 @@
+#include "instruction_scheduler.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+int latencyOf(mir::Unit unit, const MachineModel& model) {
+    switch (unit) {
+        case mir::Unit::Load:
+            return model.loadLatency;
+        case mir::Unit::Multiply:
+            return model.mulLatency;
+        case mir::Unit::Divide:
+            return model.divLatency;
+        case mir::Unit::FloatDivide:
+            return model.fpDivLatency;
+        case mir::Unit::FloatMultiply:
+            return model.fpMulLatency;
+        case mir::Unit::FloatAdd:
+            return model.fpAddLatency;
+        case mir::Unit::FloatMove:
+            return model.fpMoveLatency;
+        default:
+            return 1;
+    }
+}
+
+// control flow, calls, CSR and vector state, fences and atomics are never moved
+bool isSchedulable(const mir::Instruction& insn) {
+    mir::Unit unit = insn.info().unit;
+    if (unit == mir::Unit::Control || unit == mir::Unit::System) {
+        return false;
+    }
+    return insn.opcode == mir::Opcode::Nop || (!insn.operands.empty() && !insn.operands[0].empty());
+}
+
+struct Instruction {
+    std::vector<std::string> defs;
+    std::vector<std::string> uses;
+    bool load = false;
+    bool store = false;
+    std::string base;               // address register, empty if unknown
+    bool knownOffset = false;       // a number rather than %lo(x)
+    long offset = 0;
+    int size = 4;
+    int latency = 1;
+};
+
+Instruction describe(const mir::Instruction& insn, const MachineModel& model) {
+    Instruction node;
+    const mir::OpcodeInfo& info = insn.info();
+    node.defs = insn.defs();
+    node.uses = insn.uses();
+    node.latency = latencyOf(info.unit, model);
+    node.load = info.unit == mir::Unit::Load;
+    node.store = info.unit == mir::Unit::Store;
+    if (node.load || node.store) {
+        node.size = info.accessSize;
+        if (insn.operands.size() > 1 && insn.operands[1].kind == mir::Operand::Kind::Memory &&
+            insn.operands[1].reg != "zero") {
+            const mir::Operand& address = insn.operands[1];
+            node.base = address.reg == "fp" ? "s0" : address.reg;
+            node.knownOffset = address.relocation == mir::Relocation::None && address.symbol.empty();
+            node.offset = address.value;
+        }
+    }
+    return node;
+}
+
+/* Two accesses provably touch different bytes only when they use the same base
+   register with numeric, non-overlapping displacements. If the base is
+   redefined between them, the register dependences already order them. */
+bool mayAlias(const Instruction& a, const Instruction& b) {
+    if (a.base.empty() || a.base != b.base || !a.knownOffset || !b.knownOffset) {
+        return true;
+    }
+    return a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+}
+
+bool contains(const std::vector<std::string>& regs, const std::string& reg) {
+    return std::find(regs.begin(), regs.end(), reg) != regs.end();
+}
+
+struct Edge {
+    int to;
+    int latency;
+};
+
+// minimum distance in cycles from a to a later b, or -1 if they are independent
+int dependence(const Instruction& a, const Instruction& b) {
+    int distance = -1;
+    for (const auto& reg : a.defs) {
+        if (contains(b.uses, reg)) {
+            distance = std::max(distance, a.latency);   // read after write
+        }
+        if (contains(b.defs, reg)) {
+            distance = std::max(distance, 1);           // write after write
+        }
+    }
+    for (const auto& reg : a.uses) {
+        if (contains(b.defs, reg)) {
+            distance = std::max(distance, 0);           // write after read
+        }
+    }
+    if ((a.store && (b.load || b.store)) || (a.load && b.store)) {
+        if (mayAlias(a, b)) {
+            distance = std::max(distance, a.store ? 1 : 0);
+        }
+    }
+    return distance;
+}
+
+// cycle at which the last instruction issues + 1, issuing strictly in the given order
+int countCycles(const std::vector<int>& order, const std::vector<std::vector<Edge>>& successors,
+                const MachineModel& model) {
+    std::vector<int> earliest(order.size(), 0);
+    int cycle = 0;
+    int issued = 0;
+    for (int node : order) {
+        if (earliest[node] > cycle) {
+            cycle = earliest[node];
+            issued = 0;
+        }
+        if (issued == model.issueWidth) {
+            cycle++;
+            issued = 0;
+        }
+        issued++;
+        for (const auto& edge : successors[node]) {
+            earliest[edge.to] = std::max(earliest[edge.to], cycle + edge.latency);
+        }
+    }
+    return order.empty() ? 0 : cycle + 1;
+}
+
+// the order to issue a run of movable instructions in
+std::vector<int> scheduleBlock(const std::vector<Instruction>& block, const MachineModel& model,
+                               ScheduleReport& report) {
+    int count = static_cast<int>(block.size());
+    std::vector<std::vector<Edge>> successors(count);
+    std::vector<int> predecessors(count, 0);
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            int distance = dependence(block[i], block[j]);
+            if (distance >= 0) {
+                successors[i].push_back({j, distance});
+                predecessors[j]++;
+            }
+        }
+    }
+
+    // priority: length of the longest latency chain from here to the end of the block
+    std::vector<int> height(count, 0);
+    for (int i = count - 1; i >= 0; i--) {
+        height[i] = block[i].latency;
+        for (const auto& edge : successors[i]) {
+            height[i] = std::max(height[i], edge.latency + height[edge.to]);
+        }
+    }
+
+    std::vector<int> earliest(count, 0);
+    std::vector<int> order;
+    std::vector<bool> done(count, false);
+    int cycle = 0;
+    int issued = 0;
+    while (static_cast<int>(order.size()) < count) {
+        // highest ready instruction that can issue this cycle, else the first to become ready
+        int best = -1;
+        for (int i = 0; i < count; i++) {
+            if (done[i] || predecessors[i] > 0) {
+                continue;
+            }
+            if (best < 0) {
+                best = i;
+                continue;
+            }
+            bool readyNow = earliest[i] <= cycle;
+            bool bestReadyNow = earliest[best] <= cycle;
+            if (readyNow != bestReadyNow) {
+                if (readyNow) {
+                    best = i;
+                }
+            } else if (readyNow ? height[i] > height[best] : earliest[i] < earliest[best]) {
+                best = i;
+            }
+        }
+
+        if (earliest[best] > cycle) {
+            cycle = earliest[best];
+            issued = 0;
+        }
+        if (issued == model.issueWidth) {
+            cycle++;
+            issued = 0;
+        }
+        issued++;
+        done[best] = true;
+        order.push_back(best);
+        for (const auto& edge : successors[best]) {
+            predecessors[edge.to]--;
+            earliest[edge.to] = std::max(earliest[edge.to], cycle + edge.latency);
+        }
+    }
+
+    std::vector<int> original(count);
+    for (int i = 0; i < count; i++) {
+        original[i] = i;
+    }
+    int before = countCycles(original, successors, model);
+    int after = countCycles(order, successors, model);
+    // a greedy schedule can lose to the source order; never make a block slower
+    if (after > before) {
+        order = original;
+        after = before;
+    }
+
+    report.blocks++;
+    report.instructions += count;
+    report.cyclesBefore += before;
+    report.cyclesAfter += after;
+    return order;
+}
+
+} // namespace
+
+void ScheduleFunction(mir::Function& function, const MachineModel& model, ScheduleReport& report)
+{
+    for (auto& block : function.blocks) {
+        std::vector<mir::Instruction>& code = block.instructions;
+        size_t start = 0;
+        while (start < code.size()) {
+            if (!isSchedulable(code[start])) {
+                start++;
+                continue;
+            }
+            std::vector<Instruction> run;
+            size_t end = start;
+            for (; end < code.size() && isSchedulable(code[end]); end++) {
+                run.push_back(describe(code[end], model));
+            }
+            std::vector<mir::Instruction> scheduled;
+            for (int node : scheduleBlock(run, model, report)) {
+                scheduled.push_back(std::move(code[start + node]));
+            }
+            std::move(scheduled.begin(), scheduled.end(), code.begin() + start);
+            start = end;
+        }
+    }
+}
+
+bool LookupMachineModel(const std::string& name, MachineModel& model)
+{
+    // rough figures for common in-order RV32/RV64 cores
+    if (name == "generic") {
+        model = MachineModel();
+    } else if (name == "rocket") {
+        model = MachineModel();
+        model.loadLatency = 3;
+        model.mulLatency = 4;
+        model.divLatency = 33;
+        model.fpDivLatency = 25;
+    } else if (name == "sifive-7-series") {
+        model = MachineModel();
+        model.issueWidth = 2;
+        model.loadLatency = 3;
+        model.mulLatency = 3;
+        model.divLatency = 34;
+        model.fpAddLatency = 5;
+        model.fpMulLatency = 5;
+        model.fpDivLatency = 27;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,443 @@
+#include "machine_ir.hpp"
+
+#include <charconv>
+#include <iterator>
+
+namespace mir {
+
+namespace {
+
+constexpr OpcodeInfo OPCODES[] = {
+    {Opcode::Lui, "lui", Unit::Integer, 0},
+    {Opcode::Auipc, "auipc", Unit::Integer, 0},
+    {Opcode::Addi, "addi", Unit::Integer, 0},
+    {Opcode::Slti, "slti", Unit::Integer, 0},
+    {Opcode::Sltiu, "sltiu", Unit::Integer, 0},
+    {Opcode::Xori, "xori", Unit::Integer, 0},
+    {Opcode::Ori, "ori", Unit::Integer, 0},
+    {Opcode::Andi, "andi", Unit::Integer, 0},
+    {Opcode::Slli, "slli", Unit::Integer, 0},
+    {Opcode::Srli, "srli", Unit::Integer, 0},
+    {Opcode::Srai, "srai", Unit::Integer, 0},
+    {Opcode::Add, "add", Unit::Integer, 0},
+    {Opcode::Sub, "sub", Unit::Integer, 0},
+    {Opcode::Sll, "sll", Unit::Integer, 0},
+    {Opcode::Slt, "slt", Unit::Integer, 0},
+    {Opcode::Sltu, "sltu", Unit::Integer, 0},
+    {Opcode::Xor, "xor", Unit::Integer, 0},
+    {Opcode::Srl, "srl", Unit::Integer, 0},
+    {Opcode::Sra, "sra", Unit::Integer, 0},
+    {Opcode::Or, "or", Unit::Integer, 0},
+    {Opcode::And, "and", Unit::Integer, 0},
+    {Opcode::Lb, "lb", Unit::Load, 1},
+    {Opcode::Lh, "lh", Unit::Load, 2},
+    {Opcode::Lw, "lw", Unit::Load, 4},
+    {Opcode::Lbu, "lbu", Unit::Load, 1},
+    {Opcode::Lhu, "lhu", Unit::Load, 2},
+    {Opcode::Sb, "sb", Unit::Store, 1},
+    {Opcode::Sh, "sh", Unit::Store, 2},
+    {Opcode::Sw, "sw", Unit::Store, 4},
+    {Opcode::Beq, "beq", Unit::Control, 0},
+    {Opcode::Bne, "bne", Unit::Control, 0},
+    {Opcode::Blt, "blt", Unit::Control, 0},
+    {Opcode::Bge, "bge", Unit::Control, 0},
+    {Opcode::Bltu, "bltu", Unit::Control, 0},
+    {Opcode::Bgeu, "bgeu", Unit::Control, 0},
+    {Opcode::Jal, "jal", Unit::Control, 0},
+    {Opcode::Jalr, "jalr", Unit::Control, 0},
+    {Opcode::Ecall, "ecall", Unit::System, 0},
+    {Opcode::Ebreak, "ebreak", Unit::System, 0},
+    {Opcode::Fence, "fence", Unit::System, 0},
+
+    {Opcode::Mul, "mul", Unit::Multiply, 0},
+    {Opcode::Mulh, "mulh", Unit::Multiply, 0},
+    {Opcode::Mulhsu, "mulhsu", Unit::Multiply, 0},
+    {Opcode::Mulhu, "mulhu", Unit::Multiply, 0},
+    {Opcode::Div, "div", Unit::Divide, 0},
+    {Opcode::Divu, "divu", Unit::Divide, 0},
+    {Opcode::Rem, "rem", Unit::Divide, 0},
+    {Opcode::Remu, "remu", Unit::Divide, 0},
+
+    {Opcode::Flw, "flw", Unit::Load, 4},
+    {Opcode::Fsw, "fsw", Unit::Store, 4},
+    {Opcode::Fld, "fld", Unit::Load, 8},
+    {Opcode::Fsd, "fsd", Unit::Store, 8},
+    {Opcode::FaddS, "fadd.s", Unit::FloatAdd, 0},
+    {Opcode::FsubS, "fsub.s", Unit::FloatAdd, 0},
+    {Opcode::FmulS, "fmul.s", Unit::FloatMultiply, 0},
+    {Opcode::FdivS, "fdiv.s", Unit::FloatDivide, 0},
+    {Opcode::FsqrtS, "fsqrt.s", Unit::FloatDivide, 0},
+    {Opcode::FminS, "fmin.s", Unit::FloatAdd, 0},
+    {Opcode::FmaxS, "fmax.s", Unit::FloatAdd, 0},
+    {Opcode::FmaddS, "fmadd.s", Unit::FloatMultiply, 0},
+    {Opcode::FmsubS, "fmsub.s", Unit::FloatMultiply, 0},
+    {Opcode::FnmaddS, "fnmadd.s", Unit::FloatMultiply, 0},
+    {Opcode::FnmsubS, "fnmsub.s", Unit::FloatMultiply, 0},
+    {Opcode::FaddD, "fadd.d", Unit::FloatAdd, 0},
+    {Opcode::FsubD, "fsub.d", Unit::FloatAdd, 0},
+    {Opcode::FmulD, "fmul.d", Unit::FloatMultiply, 0},
+    {Opcode::FdivD, "fdiv.d", Unit::FloatDivide, 0},
+    {Opcode::FsqrtD, "fsqrt.d", Unit::FloatDivide, 0},
+    {Opcode::FminD, "fmin.d", Unit::FloatAdd, 0},
+    {Opcode::FmaxD, "fmax.d", Unit::FloatAdd, 0},
+    {Opcode::FmaddD, "fmadd.d", Unit::FloatMultiply, 0},
+    {Opcode::FmsubD, "fmsub.d", Unit::FloatMultiply, 0},
+    {Opcode::FnmaddD, "fnmadd.d", Unit::FloatMultiply, 0},
+    {Opcode::FnmsubD, "fnmsub.d", Unit::FloatMultiply, 0},
+    {Opcode::FsgnjS, "fsgnj.s", Unit::FloatMove, 0},
+    {Opcode::FsgnjnS, "fsgnjn.s", Unit::FloatMove, 0},
+    {Opcode::FsgnjxS, "fsgnjx.s", Unit::FloatMove, 0},
+    {Opcode::FsgnjD, "fsgnj.d", Unit::FloatMove, 0},
+    {Opcode::FsgnjnD, "fsgnjn.d", Unit::FloatMove, 0},
+    {Opcode::FsgnjxD, "fsgnjx.d", Unit::FloatMove, 0},
+    {Opcode::FeqS, "feq.s", Unit::FloatMove, 0},
+    {Opcode::FltS, "flt.s", Unit::FloatMove, 0},
+    {Opcode::FleS, "fle.s", Unit::FloatMove, 0},
+    {Opcode::FeqD, "feq.d", Unit::FloatMove, 0},
+    {Opcode::FltD, "flt.d", Unit::FloatMove, 0},
+    {Opcode::FleD, "fle.d", Unit::FloatMove, 0},
+    {Opcode::FcvtWS, "fcvt.w.s", Unit::FloatMove, 0},
+    {Opcode::FcvtWuS, "fcvt.wu.s", Unit::FloatMove, 0},
+    {Opcode::FcvtSW, "fcvt.s.w", Unit::FloatMove, 0},
+    {Opcode::FcvtSWu, "fcvt.s.wu", Unit::FloatMove, 0},
+    {Opcode::FcvtWD, "fcvt.w.d", Unit::FloatMove, 0},
+    {Opcode::FcvtWuD, "fcvt.wu.d", Unit::FloatMove, 0},
+    {Opcode::FcvtDW, "fcvt.d.w", Unit::FloatMove, 0},
+    {Opcode::FcvtDWu, "fcvt.d.wu", Unit::FloatMove, 0},
+    {Opcode::FcvtSD, "fcvt.s.d", Unit::FloatMove, 0},
+    {Opcode::FcvtDS, "fcvt.d.s", Unit::FloatMove, 0},
+    {Opcode::FmvXW, "fmv.x.w", Unit::FloatMove, 0},
+    {Opcode::FmvWX, "fmv.w.x", Unit::FloatMove, 0},
+    {Opcode::FclassS, "fclass.s", Unit::FloatMove, 0},
+    {Opcode::FclassD, "fclass.d", Unit::FloatMove, 0},
+
+    {Opcode::Csrr, "csrr", Unit::System, 0},
+    {Opcode::Csrw, "csrw", Unit::System, 0},
+    {Opcode::Csrrw, "csrrw", Unit::System, 0},
+    {Opcode::Csrrs, "csrrs", Unit::System, 0},
+    {Opcode::Csrrc, "csrrc", Unit::System, 0},
+    {Opcode::Frcsr, "frcsr", Unit::System, 0},
+    {Opcode::Fscsr, "fscsr", Unit::System, 0},
+    {Opcode::Frrm, "frrm", Unit::System, 0},
+    {Opcode::Fsrm, "fsrm", Unit::System, 0},
+    {Opcode::Frflags, "frflags", Unit::System, 0},
+    {Opcode::Fsflags, "fsflags", Unit::System, 0},
+
+    {Opcode::Sh1add, "sh1add", Unit::Integer, 0},
+    {Opcode::Sh2add, "sh2add", Unit::Integer, 0},
+    {Opcode::Sh3add, "sh3add", Unit::Integer, 0},
+    {Opcode::Andn, "andn", Unit::Integer, 0},
+    {Opcode::Orn, "orn", Unit::Integer, 0},
+    {Opcode::Xnor, "xnor", Unit::Integer, 0},
+    {Opcode::Clz, "clz", Unit::Integer, 0},
+    {Opcode::Ctz, "ctz", Unit::Integer, 0},
+    {Opcode::Cpop, "cpop", Unit::Integer, 0},
+    {Opcode::Min, "min", Unit::Integer, 0},
+    {Opcode::Max, "max", Unit::Integer, 0},
+    {Opcode::Minu, "minu", Unit::Integer, 0},
+    {Opcode::Maxu, "maxu", Unit::Integer, 0},
+    {Opcode::SextB, "sext.b", Unit::Integer, 0},
+    {Opcode::SextH, "sext.h", Unit::Integer, 0},
+    {Opcode::ZextH, "zext.h", Unit::Integer, 0},
+    {Opcode::Rol, "rol", Unit::Integer, 0},
+    {Opcode::Ror, "ror", Unit::Integer, 0},
+    {Opcode::Rori, "rori", Unit::Integer, 0},
+    {Opcode::Rev8, "rev8", Unit::Integer, 0},
+    {Opcode::OrcB, "orc.b", Unit::Integer, 0},
+
+    {Opcode::Nop, "nop", Unit::Integer, 0},
+    {Opcode::Li, "li", Unit::Integer, 0},
+    {Opcode::La, "la", Unit::Integer, 0},
+    {Opcode::Lla, "lla", Unit::Integer, 0},
+    {Opcode::Mv, "mv", Unit::Integer, 0},
+    {Opcode::Not, "not", Unit::Integer, 0},
+    {Opcode::Neg, "neg", Unit::Integer, 0},
+    {Opcode::Seqz, "seqz", Unit::Integer, 0},
+    {Opcode::Snez, "snez", Unit::Integer, 0},
+    {Opcode::Sltz, "sltz", Unit::Integer, 0},
+    {Opcode::Sgtz, "sgtz", Unit::Integer, 0},
+    {Opcode::Sgt, "sgt", Unit::Integer, 0},
+    {Opcode::Sgtu, "sgtu", Unit::Integer, 0},
+    {Opcode::Beqz, "beqz", Unit::Control, 0},
+    {Opcode::Bnez, "bnez", Unit::Control, 0},
+    {Opcode::Blez, "blez", Unit::Control, 0},
+    {Opcode::Bgez, "bgez", Unit::Control, 0},
+    {Opcode::Bltz, "bltz", Unit::Control, 0},
+    {Opcode::Bgtz, "bgtz", Unit::Control, 0},
+    {Opcode::Bgt, "bgt", Unit::Control, 0},
+    {Opcode::Ble, "ble", Unit::Control, 0},
+    {Opcode::Bgtu, "bgtu", Unit::Control, 0},
+    {Opcode::Bleu, "bleu", Unit::Control, 0},
+    {Opcode::J, "j", Unit::Control, 0},
+    {Opcode::Jr, "jr", Unit::Control, 0},
+    {Opcode::Ret, "ret", Unit::Control, 0},
+    {Opcode::Call, "call", Unit::Control, 0},
+    {Opcode::Tail, "tail", Unit::Control, 0},
+    {Opcode::FmvS, "fmv.s", Unit::FloatMove, 0},
+    {Opcode::FnegS, "fneg.s", Unit::FloatMove, 0},
+    {Opcode::FabsS, "fabs.s", Unit::FloatMove, 0},
+    {Opcode::FgtS, "fgt.s", Unit::FloatMove, 0},
+    {Opcode::FgeS, "fge.s", Unit::FloatMove, 0},
+    {Opcode::FmvD, "fmv.d", Unit::FloatMove, 0},
+    {Opcode::FnegD, "fneg.d", Unit::FloatMove, 0},
+    {Opcode::FabsD, "fabs.d", Unit::FloatMove, 0},
+    {Opcode::FgtD, "fgt.d", Unit::FloatMove, 0},
+    {Opcode::FgeD, "fge.d", Unit::FloatMove, 0},
+
+    // vector, atomic and anything else unknown: in place, in program order
+    {Opcode::Other, "", Unit::System, 0},
+};
+
+constexpr bool inDeclarationOrder() {
+    for (size_t i = 0; i < std::size(OPCODES); i++) {
+        if (static_cast<size_t>(OPCODES[i].opcode) != i) {
+            return false;
+        }
+    }
+    return std::size(OPCODES) == static_cast<size_t>(Opcode::Other) + 1;
+}
+static_assert(inDeclarationOrder(), "OPCODES must list every opcode in declaration order");
+
+// fp is another name for s0; zero never carries a dependence
+void addRegister(const std::string& name, std::vector<std::string>& regs) {
+    if (name == "zero") {
+        return;
+    }
+    regs.push_back(name == "fp" ? "s0" : name);
+}
+
+} // namespace
+
+const OpcodeInfo& Info(Opcode opcode)
+{
+    return OPCODES[static_cast<size_t>(opcode)];
+}
+
+Operand Reg(std::string name)
+{
+    Operand operand;
+    operand.kind = Operand::Kind::Register;
+    operand.reg = std::move(name);
+    return operand;
+}
+
+Operand Imm(int64_t value)
+{
+    Operand operand;
+    operand.kind = Operand::Kind::Immediate;
+    operand.value = value;
+    return operand;
+}
+
+Operand Sym(std::string name)
+{
+    Operand operand;
+    operand.kind = Operand::Kind::Symbol;
+    operand.symbol = std::move(name);
+    return operand;
+}
+
+Operand Hi(std::string symbol)
+{
+    Operand operand;
+    operand.kind = Operand::Kind::Relocation;
+    operand.relocation = Relocation::Hi;
+    operand.symbol = std::move(symbol);
+    return operand;
+}
+
+Operand Lo(std::string symbol)
+{
+    Operand operand = Hi(std::move(symbol));
+    operand.relocation = Relocation::Lo;
+    return operand;
+}
+
+Operand Mem(int64_t offset, std::string base)
+{
+    Operand operand;
+    operand.kind = Operand::Kind::Memory;
+    operand.value = offset;
+    operand.reg = std::move(base);
+    return operand;
+}
+
+Operand Mem(const Operand& offset, std::string base)
+{
+    Operand operand = Mem(offset.value, std::move(base));
+    operand.relocation = offset.relocation;
+    operand.symbol = offset.symbol;
+    return operand;
+}
+
+Operand Mem(std::string base)
+{
+    Operand operand = Mem(0, std::move(base));
+    operand.hasOffset = false;
+    return operand;
+}
+
+Instruction::Instruction(Opcode opcode, std::initializer_list<Operand> operands)
+    : opcode(opcode), operands(operands)
+{
+}
+
+Instruction::Instruction(std::string name, std::initializer_list<Operand> operands)
+    : name(std::move(name)), operands(operands)
+{
+}
+
+std::vector<std::string> Instruction::defs() const
+{
+    std::vector<std::string> regs;
+    if (info().definesFirst() && !operands.empty() && operands[0].isRegister()) {
+        addRegister(operands[0].reg, regs);
+    }
+    return regs;
+}
+
+std::vector<std::string> Instruction::uses() const
+{
+    std::vector<std::string> regs;
+    for (size_t i = info().definesFirst() ? 1 : 0; i < operands.size(); i++) {
+        if (operands[i].isRegister() || operands[i].kind == Operand::Kind::Memory) {
+            addRegister(operands[i].reg, regs);
+        }
+    }
+    return regs;
+}
+
+size_t Function::lineCount() const
+{
+    size_t lines = 0;
+    for (const auto& block : blocks) {
+        lines += block.header.size() + block.instructions.size();
+    }
+    return lines;
+}
+
+void Function::add(Instruction insn)
+{
+    if (blocks.empty() || (!blocks.back().instructions.empty() &&
+                           blocks.back().instructions.back().info().unit == Unit::Control)) {
+        blocks.emplace_back();
+    }
+    blocks.back().instructions.push_back(std::move(insn));
+}
+
+void Function::addLine(std::string line)
+{
+    if (blocks.empty() || !blocks.back().instructions.empty()) {
+        blocks.emplace_back();
+    }
+    blocks.back().header.push_back(std::move(line));
+}
+
+void Function::addLine(std::string_view directive, int64_t value)
+{
+    std::string line(directive);
+    line += ' ';
+    Append(line, value);
+    addLine(std::move(line));
+}
+
+void Function::addLabel(std::string_view label)
+{
+    std::string line(label);
+    line += ':';
+    addLine(std::move(line));
+}
+
+void Function::append(const Function& code)
+{
+    for (const auto& block : code.blocks) {
+        for (const auto& line : block.header) {
+            addLine(line);
+        }
+        for (const auto& insn : block.instructions) {
+            add(insn);
+        }
+    }
+}
+
+void Append(std::string& text, int64_t value)
+{
+    char digits[24];
+    auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+    text.append(digits, end);
+}
+
+void Append(std::string& text, const Operand& operand)
+{
+    switch (operand.kind) {
+        case Operand::Kind::Register:
+            text += operand.reg;
+            return;
+        case Operand::Kind::Immediate:
+            Append(text, operand.value);
+            return;
+        case Operand::Kind::Symbol:
+            text += operand.symbol;
+            return;
+        case Operand::Kind::Relocation:
+        case Operand::Kind::Memory:
+            break;
+    }
+    if (operand.relocation != Relocation::None) {
+        text += operand.relocation == Relocation::Hi ? "%hi(" : "%lo(";
+        text += operand.symbol;
+        text += ')';
+    } else if (!operand.symbol.empty()) {
+        text += operand.symbol;
+    } else if (operand.hasOffset) {
+        Append(text, operand.value);
+    }
+    if (operand.kind == Operand::Kind::Memory) {
+        text += '(';
+        text += operand.reg;
+        text += ')';
+    }
+}
+
+void Append(std::string& text, const Instruction& insn)
+{
+    text += "    ";
+    text += insn.mnemonic();
+    for (size_t i = 0; i < insn.operands.size(); i++) {
+        text += i == 0 ? " " : ", ";
+        Append(text, insn.operands[i]);
+    }
+}
+
+void Print(const Function& function, std::ostream& output)
+{
+    // one write for the whole function rather than one per token
+    std::string text;
+    for (const auto& block : function.blocks) {
+        for (const auto& line : block.header) {
+            text += line;
+            text += '\n';
+        }
+        for (const auto& insn : block.instructions) {
+            Append(text, insn);
+            text += '\n';
+        }
+    }
+    output.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+std::ostream& operator<<(std::ostream& output, const Instruction& insn)
+{
+    std::string text;
+    Append(text, insn);
+    return output.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+std::ostream& operator<<(std::ostream& output, const Operand& operand)
+{
+    std::string text;
+    Append(text, operand);
+    return output.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+} // namespace mir
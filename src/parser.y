@@ -8,38 +8,54 @@
     #include "ast_type_specifier.hpp"
     #include "EnumDeclaration.hpp"
     #include "Factory.hpp"
+    #include "parse_context.hpp"
+    #include "source_buffer.hpp"
+    #include <stdexcept>
     #include <string>
 
     using namespace ast;
 
-    extern int yylineno;
-    extern char* yytext;
+    #ifndef YY_TYPEDEF_YY_SCANNER_T
+    #define YY_TYPEDEF_YY_SCANNER_T
+    typedef void* yyscan_t;
+    #endif
+}
 
-    extern std::shared_ptr<Node> g_root;
-    extern FILE* yyin;
-    int yylex(void);
-    void yyerror(const char*);
-    int yylex_destroy(void);
-    void updateTypeDefs(std::string id, ast::TypeSpecifier type);
-    ast::TypeSpecifier getTypeDefType(std::string id);
+%code{
+    // the reentrant scanner's interface, from lexer.flex
+    int yylex(YYSTYPE* yylval, yyscan_t scanner);
+    int yylex_init_extra(ParseContext* context, yyscan_t* scanner);
+    int yylex_destroy(yyscan_t scanner);
+    void yyset_in(FILE* in, yyscan_t scanner);
+    char* yyget_text(yyscan_t scanner);
+    int yyget_lineno(yyscan_t scanner);
+    typedef struct yy_buffer_state* YY_BUFFER_STATE;
+    YY_BUFFER_STATE yy_scan_buffer(char* base, size_t size, yyscan_t scanner);
+    void yy_delete_buffer(YY_BUFFER_STATE buffer, yyscan_t scanner);
+
+    void yyerror(yyscan_t scanner, ParseContext& context, const char* s);
 }
 
+%define api.pure full
+%param {yyscan_t scanner}
+%parse-param {ParseContext& context}
+
 %define parse.error detailed
 %define parse.lac full
 
 %union{
-    std::shared_ptr<Node>*              node_ptr;
-    std::shared_ptr<NodeList>*          node_list_ptr;
-    std::shared_ptr<ParameterList>*     parameter_list_ptr;
-    std::shared_ptr<Declarator>*        declarator_ptr;
-    std::shared_ptr<Expression>*        expr_ptr;
-    std::shared_ptr<Statement>*         stmt_ptr;
-    std::shared_ptr<Identifier>*        identifier_ptr;
+    Node*                               node_ptr;
+    NodeList*                           node_list_ptr;
+    ParameterList*                      parameter_list_ptr;
+    Declarator*                         declarator_ptr;
+    Expression*                         expr_ptr;
+    Statement*                          stmt_ptr;
+    Identifier*                         identifier_ptr;
     int                                 number_int;
     float                               number_float;
     double                              number_double;
     char                                number_char;
-    std::string*                        string;
+    Symbol::Id                          symbol;     // interned by the lexer
     TypeSpecifier                       type_specifier;
     BinaryOp::Type                      binary_op;
     UnaryOp::Type                       unary_op;
@@ -54,7 +70,7 @@
 %token STRUCT UNION ENUM ELLIPSIS
 %token CASE DEFAULT IF ELSE SWITCH WHILE DO FOR GOTO CONTINUE BREAK RETURN
 %token UNKNOWN
-%token <string> TYPE_NAME
+%token <symbol> TYPE_NAME
 %token END_OF_CODE
 
 %type <node_ptr> external_declaration function_definition enumerator
@@ -70,7 +86,7 @@
 %type <node_ptr> declaration parameter_declaration enum_specifier
 %type <declarator_ptr> declarator direct_declarator
 %type <identifier_ptr> identifier
-%type <string> IDENTIFIER STRING_LITERAL
+%type <symbol> IDENTIFIER STRING_LITERAL
 %type <number_int> INT_CONSTANT
 %type <number_float> FLOAT_CONSTANT
 %type <number_double> DOUBLE_CONSTANT
@@ -85,22 +101,20 @@
 
 
 ROOT
-    : translation_unit {g_root = *$1; delete $1;}
+    : translation_unit {context.root = $1;}
     ;
 
 translation_unit
     : external_declaration
         {
             auto list = ast::makeNodeList();
-            list->PushBack(*$1);
-            $$ = new std::shared_ptr<NodeList>(list);
-            delete $1;
+            list->PushBack($1);
+            $$ = list;
         }
     | translation_unit external_declaration
         {
-            (*$1)->PushBack(*$2);
+            $1->PushBack($2);
             $$ = $1;
-            delete $2;
         }
     ;
 
@@ -112,84 +126,67 @@ external_declaration
 function_definition
     : declaration_specifiers declarator compound_statement
         {
-            auto fn = std::dynamic_pointer_cast<FunctionDeclarator>(*$2);
+            auto fn = dynamic_cast<FunctionDeclarator*>($2);
             if (fn) {
-                auto compoundStmt = std::dynamic_pointer_cast<CompoundStatement>(*$3);
+                auto compoundStmt = dynamic_cast<CompoundStatement*>($3);
                 if (compoundStmt) {
-                    $$ = new std::shared_ptr<Node>(makeFunctionDeclaration($1, fn, compoundStmt));
+                    $$ = makeFunctionDeclaration($1, fn, compoundStmt);
                 } else {
-                    $$ = new std::shared_ptr<Node>(makeFunctionDeclaration($1, fn, nullptr));
-                }
-
-                if (fn->getParameters()) {
-                    const auto& params = fn->getParameters()->getParameters();
-                    std::cerr << "Function parameters: ";
-                    for (const auto& param : params) {
-                        auto paramDecl = std::dynamic_pointer_cast<ParameterDeclaration>(param);
-                        if (paramDecl) {
-                            std::cerr << paramDecl->getIdentifier() << " ";
-                        }
-                    }
-                    std::cerr << std::endl;
+                    $$ = makeFunctionDeclaration($1, fn, nullptr);
                 }
-
             } else {
-                auto fnDecl = makeFunctionDeclarator(*$2, nullptr);
-                auto compoundStmt = std::dynamic_pointer_cast<CompoundStatement>(*$3);
-                $$ = new std::shared_ptr<Node>(makeFunctionDeclaration($1, fnDecl, compoundStmt));
+                auto fnDecl = makeFunctionDeclarator($2, nullptr);
+                auto compoundStmt = dynamic_cast<CompoundStatement*>($3);
+                $$ = makeFunctionDeclaration($1, fnDecl, compoundStmt);
             }
-            delete $2;
-            delete $3;
         }
     ;
 
 declaration
     : TYPEDEF declaration_specifiers init_declarator_list ';'
         {
-            for (const auto &node : (*$3)->getNodes())
+            for (const auto &node : $3->getNodes())
             {
-                auto initDecl = std::dynamic_pointer_cast<InitDeclarator>(node);
+                auto initDecl = dynamic_cast<InitDeclarator*>(node);
                 if (initDecl) {
                     auto ident = initDecl->getDeclarator();
                     if (ident) {
-                        updateTypeDefs(ident->getIdentifier(), $2);
+                        context.updateTypeDefs(ident->getSymbol(), $2);
                     }
                 }
             }
-            auto initDeclarator = std::dynamic_pointer_cast<InitDeclarator>((*$3)->getNodes()[0]);
-            $$ = new std::shared_ptr<Node>(makeVariableDeclaration($2, initDeclarator->getDeclarator(), initDeclarator->getInitializer()));
-            delete $3;
+            auto initDeclarator = dynamic_cast<InitDeclarator*>($3->getNodes()[0]);
+            $$ = makeTypedefDeclaration($2, initDeclarator->getDeclarator());
         }
     | declaration_specifiers init_declarator_list ';'
         {
             // if there is only one declaration (case most of the time) -> return single variable decl
-            if ((*$2)->getNodes().size() == 1) {
-                auto initDeclarator = std::dynamic_pointer_cast<InitDeclarator>((*$2)->getNodes()[0]);
+            if ($2->getNodes().size() == 1) {
+                auto initDeclarator = dynamic_cast<InitDeclarator*>($2->getNodes()[0]);
                 if (initDeclarator) {
-                    $$ = new std::shared_ptr<Node>(makeVariableDeclaration(
-                        $1, initDeclarator->getDeclarator(), initDeclarator->getInitializer()));
+                    $$ = makeVariableDeclaration(
+                        $1, initDeclarator->getDeclarator(), initDeclarator->getInitializer());
                 }
                 else {
-                    $$ = new std::shared_ptr<Node>(makeNodeList());
+                    $$ = makeNodeList();
                 } /*empty list if smth wrong*/
             }
             else {
                 // for multiple declarations
                 auto decls = makeNodeList();
-                for (auto& initDecl : (*$2)->getNodes()) {
-                    auto initDeclarator = std::dynamic_pointer_cast<InitDeclarator>(initDecl);
+                for (auto& initDecl : $2->getNodes()) {
+                    auto initDeclarator = dynamic_cast<InitDeclarator*>(initDecl);
                     if (initDeclarator) {
                         auto decl = makeVariableDeclaration(
                             $1, initDeclarator->getDeclarator(), initDeclarator->getInitializer());
                         decls->PushBack(decl);
                     }
                 }
-                $$ = new std::shared_ptr<Node>(decls);
+                $$ = decls;
             }
-            delete $2;
         }
     | declaration_specifiers ';'
-        { $$ = new std::shared_ptr<Node>(makeNodeList()); }
+        { $$ = makeNodeList(); }
     | enum_specifier ';'
         { $$ = $1; }
     ;
@@ -198,48 +195,45 @@ enum_specifier
     : ENUM '{' enumerator_list '}'
         {
             auto enumDecl = makeEnumDeclaration(nullptr);
-            for (auto& node : (*$3)->getNodes()) {
-                auto enumValue = std::dynamic_pointer_cast<EnumValue>(node);
+            for (auto& node : $3->getNodes()) {
+                auto enumValue = dynamic_cast<EnumValue*>(node);
                 if (enumValue) {
                     enumDecl->addValue(enumValue);
                 }
             }
-            $$ = new std::shared_ptr<Node>(enumDecl);
-            delete $3;
+            $$ = enumDecl;
         }
     | ENUM identifier '{' enumerator_list '}'
         {
-            auto enumDecl = makeEnumDeclaration(*$2);
-            for (auto& node : (*$4)->getNodes()) {
-                auto enumValue = std::dynamic_pointer_cast<EnumValue>(node);
+            auto enumDecl = makeEnumDeclaration($2);
+            for (auto& node : $4->getNodes()) {
+                auto enumValue = dynamic_cast<EnumValue*>(node);
                 if (enumValue) {
                     enumDecl->addValue(enumValue);
                 }
             }
-            $$ = new std::shared_ptr<Node>(enumDecl);
-            delete $2; delete $4;
+            $$ = enumDecl;
         }
     | ENUM identifier
-        {$$ = new std::shared_ptr<Node>(makeEnumDeclaration(*$2)); delete $2;}
+        {$$ = makeEnumDeclaration($2);}
     ;
 
 enumerator_list
     : enumerator
         {
             auto list = makeNodeList();
-            list->PushBack(*$1);
-            $$ = new std::shared_ptr<NodeList>(list);
-            delete $1;
+            list->PushBack($1);
+            $$ = list;
         }
     | enumerator_list ',' enumerator
-        {(*$1)->PushBack(*$3); $$ = $1; delete $3;}
+        {$1->PushBack($3); $$ = $1;}
     ;
 
 enumerator
     : identifier
-        {$$ = new std::shared_ptr<Node>(makeEnumValue(*$1)); delete $1;}
+        {$$ = makeEnumValue($1);}
     | identifier '=' constant_expression
-        { $$ = new std::shared_ptr<Node>(makeEnumValue(*$1, *$3)); delete $1; delete $3;}
+        { $$ = makeEnumValue($1, $3);}
     ;
 
 declaration_specifiers
@@ -254,7 +248,7 @@ type_specifier
     | INT { $$ = TypeSpecifier::INT; }
     | FLOAT { $$ = TypeSpecifier::FLOAT; }
     | DOUBLE { $$ = TypeSpecifier::DOUBLE; }
-    | TYPE_NAME { $$ = getTypeDefType(*$1); }
+    | TYPE_NAME { $$ = context.getTypeDefType(Symbol::FromId($1)); }
     | SIGNED { $$ = TypeSpecifier::SIGNED; }
     | UNSIGNED { $$ = TypeSpecifier::UNSIGNED; }
     ;
@@ -263,105 +257,92 @@ init_declarator_list
     : declarator
         {
             auto list = makeInitDeclaratorList();
-            auto initDecl = makeInitDeclarator(*$1, nullptr);
+            auto initDecl = makeInitDeclarator($1, nullptr);
             list->PushBack(initDecl);
-            $$ = new std::shared_ptr<NodeList>(list);
-            delete $1;
+            $$ = list;
         }
     | init_declarator_list ',' declarator
         {
-            auto initDecl = makeInitDeclarator(*$3, nullptr);
-            (*$1)->PushBack(initDecl);
+            auto initDecl = makeInitDeclarator($3, nullptr);
+            $1->PushBack(initDecl);
             $$ = $1;
-            delete $3;
         }
     | declarator '=' initializer
         {
                 auto list = makeInitDeclaratorList();
-                auto initDecl = makeInitDeclarator(*$1, *$3);
+                auto initDecl = makeInitDeclarator($1, $3);
                 list->PushBack(initDecl);
-                $$ = new std::shared_ptr<NodeList>(list);
+                $$ = list;
 
-                if ((*$1)->isPointer() && (*$3)->getType() == TypeSpecifier::CHAR) {
-                auto stringExpr = std::dynamic_pointer_cast<ast::StringLiteralExpression>(*($3));
+                if ($1->isPointer() && $3->getType() == TypeSpecifier::CHAR) {
+                auto stringExpr = dynamic_cast<ast::StringLiteralExpression*>($3);
                 if (stringExpr) {
-                    int charCount = stringExpr->getSize();
-                    std::cerr << "String array declaration of length: " << charCount << std::endl;
-                    auto arrayDecl = makeArrayDeclarator(*$1, std::make_shared<ast::LiteralExpression>(4)); //size should be a word no matter what (4 CHARS)
+                    auto arrayDecl = makeArrayDeclarator($1, makeLiteralExpression(4)); //size should be a word no matter what (4 CHARS)
                     list->PushBack(arrayDecl);
                     }
                 }
-                delete $1; delete $3;
 
 
         }
     | init_declarator_list ',' declarator '=' initializer
         {
-            auto initDecl = makeInitDeclarator(*$3, *$5);
-            (*$1)->PushBack(initDecl);
+            auto initDecl = makeInitDeclarator($3, $5);
+            $1->PushBack(initDecl);
             $$ = $1;
-            delete $3; delete $5;
         }
     ;
 
 declarator
     : direct_declarator { $$ = $1; }
     | '*' declarator {
-            // std::string id = (*$2)->getIdentifier();
-            // std::cerr << (*$2)->getIdentifier() << std::endl;
-            $$ = new std::shared_ptr<Declarator>(makePointerDeclarator(*$2));
-            std::cerr << "Pointer found" << std::endl;
-            delete $2;
+            // std::string id = $2->getIdentifier();
+            // std::cerr << $2->getIdentifier() << std::endl;
+            $$ = makePointerDeclarator($2);
         }
     ;
 
 direct_declarator
     : IDENTIFIER
-            {$$ = new std::shared_ptr<Declarator>(makeIdentifierDeclarator(*$1)); delete $1;}
+            {$$ = makeIdentifierDeclarator(Symbol::FromId($1));}
     | '(' declarator ')' { $$ = $2; }
     | direct_declarator '[' ']'
-            {$$ = new std::shared_ptr<Declarator>(makeArrayDeclarator(*$1, nullptr)); delete $1;}
+            {$$ = makeArrayDeclarator($1, nullptr);}
     | direct_declarator '[' constant_expression ']' {
-            $$ = new std::shared_ptr<Declarator>(makeArrayDeclarator(*$1, *$3));
-            delete $1; delete $3;
+            $$ = makeArrayDeclarator($1, $3);
         }
     | direct_declarator '(' parameter_list ')' {
-            $$ = new std::shared_ptr<Declarator>(makeFunctionDeclarator(*$1, *$3));
-            delete $1; delete $3;
+            $$ = makeFunctionDeclarator($1, $3);
         }
     | direct_declarator '(' ')'
-            {$$ = new std::shared_ptr<Declarator>(makeFunctionDeclarator(*$1, nullptr)); delete $1;}
+            {$$ = makeFunctionDeclarator($1, nullptr);}
     ;
 
 parameter_list
     : parameter_declaration
         {
             auto list = makeParameterList();
-            list->addParameter(*$1);
-            $$ = new std::shared_ptr<ParameterList>(list);
-            delete $1;
+            list->addParameter($1);
+            $$ = list;
         }
     | parameter_list ',' parameter_declaration
         {
-            (*$1)->addParameter(*$3);
+            $1->addParameter($3);
             $$ = $1;
-            delete $3;
         }
     ;
 
 parameter_declaration
     : declaration_specifiers declarator
         {
-            $$ = new std::shared_ptr<Node>(makeParameterDeclaration($1, *$2));
-            delete $2;
+            $$ = makeParameterDeclaration($1, $2);
         }
     | declaration_specifiers
-        {$$ = new std::shared_ptr<Node>(makeParameterDeclaration($1, nullptr));}
+        {$$ = makeParameterDeclaration($1, nullptr);}
     ;
 
 identifier
     : IDENTIFIER
-            {$$ = new std::shared_ptr<Identifier>(makeIdentifier(*$1)); delete $1;}
+            {$$ = makeIdentifier(Symbol::FromId($1));}
     ;
 
 initializer
@@ -369,8 +350,7 @@ initializer
     | '{' initializer_list '}' { $$ = $2; }
     | '{' initializer_list ',' '}' { $$ = $2; }
     | STRING_LITERAL {
-            $$ = new std::shared_ptr<Expression>(makeStringLiteralExpression(*$1));
-            delete $1;
+            $$ = makeStringLiteralExpression(Symbol::FromId($1));
         }
     ;
 
@@ -378,16 +358,14 @@ initializer_list
     : initializer
         {
             auto list = makeInitializerList();
-            list->addExpression(*$1);
-            $$ = new std::shared_ptr<Expression>(list);
-            delete $1;
+            list->addExpression($1);
+            $$ = list;
         }
     | initializer_list ',' initializer
         {
-            auto list = std::dynamic_pointer_cast<InitializerList>(*$1);
-            list->addExpression(*$3);
+            auto list = dynamic_cast<InitializerList*>($1);
+            list->addExpression($3);
             $$ = $1;
-            delete $3;
         }
     ;
 
@@ -402,35 +380,31 @@ statement
 
 compound_statement
     : '{' '}' {
-            $$ = new std::shared_ptr<Statement>(makeCompoundStatement());
+            $$ = makeCompoundStatement();
         }
     | '{' statement_list '}' {
-            $$ = new std::shared_ptr<Statement>(makeCompoundStatement(*$2));
-            delete $2;
+            $$ = makeCompoundStatement($2);
         }
     | '{' declaration_list '}'
         {
             auto compStmt = makeCompoundStatement();
-            compStmt->setDeclarationList(*$2);
-            $$ = new std::shared_ptr<Statement>(compStmt);
-            delete $2;
+            compStmt->setDeclarationList($2);
+            $$ = compStmt;
         }
     | '{' declaration_list statement_list '}'
         {
             auto compStmt = makeCompoundStatement();
-            compStmt->setDeclarationList(*$2);
+            compStmt->setDeclarationList($2);
 
             // Add the statements
-            for (auto& node : (*$3)->getNodes()) {
-                auto stmt = std::dynamic_pointer_cast<Statement>(node);
+            for (auto& node : $3->getNodes()) {
+                auto stmt = dynamic_cast<Statement*>(node);
                 if (stmt) {
                     compStmt->addStatement(stmt);
                 }
             }
 
-            $$ = new std::shared_ptr<Statement>(compStmt);
-            delete $2;
-            delete $3;
+            $$ = compStmt;
         }
     ;
 
@@ -438,15 +412,13 @@ statement_list
     : statement
         {
             auto list = makeNodeList();
-            list->PushBack(*$1);
-            $$ = new std::shared_ptr<NodeList>(list);
-            delete $1;
+            list->PushBack($1);
+            $$ = list;
         }
     | statement_list statement
         {
-            (*$1)->PushBack(*$2);
+            $1->PushBack($2);
             $$ = $1;
-            delete $2;
         }
     ;
 
@@ -454,182 +426,157 @@ declaration_list
     : declaration
         {
             auto list = makeNodeList();
-            list->PushBack(*$1);
-            $$ = new std::shared_ptr<NodeList>(list);
-            delete $1;
+            list->PushBack($1);
+            $$ = list;
         }
     | declaration_list declaration
         {
-            (*$1)->PushBack(*$2);
+            $1->PushBack($2);
             $$ = $1;
-            delete $2;
         }
     ;
 
 expression_statement
-    : ';' {$$ = new std::shared_ptr<Statement>(makeExpressionStatement(nullptr));}
-    | expression ';' {$$ = new std::shared_ptr<Statement>(makeExpressionStatement(*$1)); delete $1;}
+    : ';' {$$ = makeExpressionStatement(nullptr);}
+    | expression ';' {$$ = makeExpressionStatement($1);}
     ;
 
 selection_statement
     : IF '(' expression ')' statement
         {
-            $$ = new std::shared_ptr<Statement>(makeIfStatement(*$3, *$5, nullptr));
-            delete $3; delete $5;
+            $$ = makeIfStatement($3, $5, nullptr);
         }
     | IF '(' expression ')' statement ELSE statement
         {
-            $$ = new std::shared_ptr<Statement>(makeIfStatement(*$3, *$5, *$7));
-            delete $3; delete $5; delete $7;
+            $$ = makeIfStatement($3, $5, $7);
         }
     | SWITCH '(' expression ')' statement
         {
-            $$ = new std::shared_ptr<Statement>(makeSwitchStatement(*$3, *$5));
-            delete $3; delete $5;
+            $$ = makeSwitchStatement($3, $5);
         }
     ;
 
 labeled_statement
     : IDENTIFIER ':' statement {
-            auto id = makeIdentifier(*$1);
-            $$ = new std::shared_ptr<Statement>(makeLabeledStatement(id, *$3));
-            delete $1; delete $3;
+            auto id = makeIdentifier(Symbol::FromId($1));
+            $$ = makeLabeledStatement(id, $3);
         }
     | CASE constant_expression ':' statement
         {
-            $$ = new std::shared_ptr<Statement>(makeCaseStatement(*$2, *$4));
-            delete $2; delete $4;
+            $$ = makeCaseStatement($2, $4);
         }
     | DEFAULT ':' statement
-        {$$ = new std::shared_ptr<Statement>(makeDefaultStatement(*$3)); delete $3;}
+        {$$ = makeDefaultStatement($3);}
     ;
 
 iteration_statement
     : WHILE '(' expression ')' statement
         {
-            $$ = new std::shared_ptr<Statement>(makeWhileStatement(*$3, *$5));
-            delete $3; delete $5;
+            $$ = makeWhileStatement($3, $5);
         }
     | DO statement WHILE '(' expression ')' ';'
         {
-            $$ = new std::shared_ptr<Statement>(makeDoWhileStatement(*$2, *$5));
-            delete $2; delete $5;
+            $$ = makeDoWhileStatement($2, $5);
         }
     | FOR '(' expression_statement expression_statement ')' statement
     {
         // Cast to ExpressionStatement
-        auto initStmt = std::dynamic_pointer_cast<ExpressionStatement>(*$3);
-        auto condStmt = std::dynamic_pointer_cast<ExpressionStatement>(*$4);
+        auto initStmt = dynamic_cast<ExpressionStatement*>($3);
+        auto condStmt = dynamic_cast<ExpressionStatement*>($4);
 
-        std::shared_ptr<Expression> init = initStmt ? initStmt->getExpression() : nullptr;
-        std::shared_ptr<Expression> cond = condStmt ? condStmt->getExpression() : nullptr;
+        Expression* init = initStmt ? initStmt->getExpression() : nullptr;
+        Expression* cond = condStmt ? condStmt->getExpression() : nullptr;
 
-        $$ = new std::shared_ptr<Statement>(makeForStatement(init, cond, nullptr, *$6));
-        delete $3; delete $4; delete $6;
+        $$ = makeForStatement(init, cond, nullptr, $6);
     }
     | FOR '(' expression_statement expression_statement expression ')' statement
     {
-        auto initStmt = std::dynamic_pointer_cast<ExpressionStatement>(*$3);
-        auto condStmt = std::dynamic_pointer_cast<ExpressionStatement>(*$4);
+        auto initStmt = dynamic_cast<ExpressionStatement*>($3);
+        auto condStmt = dynamic_cast<ExpressionStatement*>($4);
 
-        std::shared_ptr<Expression> init = initStmt ? initStmt->getExpression() : nullptr;
-        std::shared_ptr<Expression> cond = condStmt ? condStmt->getExpression() : nullptr;
+        Expression* init = initStmt ? initStmt->getExpression() : nullptr;
+        Expression* cond = condStmt ? condStmt->getExpression() : nullptr;
 
-        $$ = new std::shared_ptr<Statement>(makeForStatement(init, cond, *$5, *$7));
-        delete $3; delete $4; delete $5; delete $7;
+        $$ = makeForStatement(init, cond, $5, $7);
     }
     ;
 
 jump_statement
     : GOTO IDENTIFIER ';'
         {
-            auto id = makeIdentifier(*$2);
-            $$ = new std::shared_ptr<Statement>(makeGotoStatement(id));
-            delete $2;
+            auto id = makeIdentifier(Symbol::FromId($2));
+            $$ = makeGotoStatement(id);
         }
     | CONTINUE ';'
-        {$$ = new std::shared_ptr<Statement>(makeContinueStatement());}
+        {$$ = makeContinueStatement();}
     | BREAK ';'
-        {$$ = new std::shared_ptr<Statement>(makeBreakStatement());}
+        {$$ = makeBreakStatement();}
     | RETURN ';'
-        { $$ = new std::shared_ptr<Statement>(makeReturnStatement(nullptr));}
+        { $$ = makeReturnStatement(nullptr);}
     | RETURN expression ';'
-        {$$ = new std::shared_ptr<Statement>(makeReturnStatement(*$2)); delete $2;}
+        {$$ = makeReturnStatement($2);}
     ;
 
 primary_expression
     : identifier {
-            $$ = new std::shared_ptr<Expression>(makeIdentifierExpression(*$1));
-            delete $1;
-        }
-    | INT_CONSTANT {$$ = new std::shared_ptr<Expression>(makeLiteralExpression($1));}
-    | FLOAT_CONSTANT {$$ = new std::shared_ptr<Expression>(makeLiteralExpression($1));}
-    | DOUBLE_CONSTANT {$$ = new std::shared_ptr<Expression>(makeLiteralExpression($1));}
-    | CHAR_CONSTANT {$$ = new std::shared_ptr<Expression>(makeLiteralExpression($1));
-                    std::cerr << "Declaring char: " << static_cast<char>($1) << std::endl;}
-    | STRING_LITERAL {$$ = new std::shared_ptr<Expression>(makeStringLiteralExpression(*$1)); delete $1;
-                    std::cerr << "Declaring string" << std::endl;}
+            $$ = makeIdentifierExpression($1);
+        }
+    | INT_CONSTANT {$$ = makeLiteralExpression($1);}
+    | FLOAT_CONSTANT {$$ = makeLiteralExpression($1);}
+    | DOUBLE_CONSTANT {$$ = makeLiteralExpression($1);}
+    | CHAR_CONSTANT {$$ = makeLiteralExpression($1);}
+    | STRING_LITERAL {$$ = makeStringLiteralExpression(Symbol::FromId($1));}
     | '(' expression ')' { $$ = $2; }
     ;
 
 postfix_expression
     : primary_expression { $$ = $1; }
     | postfix_expression '[' expression ']' {
-            $$ = new std::shared_ptr<Expression>(makeArrayAccessExpression(*$1, *$3));
-            delete $1; delete $3;
+            $$ = makeArrayAccessExpression($1, $3);
         }
-    | postfix_expression '(' ')' {$$ = new std::shared_ptr<Expression>(makeCallExpression(*$1, nullptr)); delete $1;}
+    | postfix_expression '(' ')' {$$ = makeCallExpression($1, nullptr);}
     | postfix_expression '(' argument_list ')' {
-            $$ = new std::shared_ptr<Expression>(makeCallExpression(*$1, *$3));
-            delete $1; delete $3;
+            $$ = makeCallExpression($1, $3);
         }
     | postfix_expression '.' identifier {
-            $$ = new std::shared_ptr<Expression>(makeMemberAccessExpression(*$1, *$3));
-            delete $1; delete $3;
+            $$ = makeMemberAccessExpression($1, $3);
         }
     | postfix_expression PTR_OP identifier {
-            $$ = new std::shared_ptr<Expression>(makePointerMemberAccessExpression(*$1, *$3));
-            delete $1; delete $3;
+            $$ = makePointerMemberAccessExpression($1, $3);
         }
-    | postfix_expression INC_OP {$$ = new std::shared_ptr<Expression>(makeUnaryExpression(*$1, UnaryOp::Type::POST_INCREMENT)); delete $1;}
-    | postfix_expression DEC_OP {$$ = new std::shared_ptr<Expression>(makeUnaryExpression(*$1, UnaryOp::Type::POST_DECREMENT)); delete $1;}
+    | postfix_expression INC_OP {$$ = makeUnaryExpression($1, UnaryOp::Type::POST_INCREMENT);}
+    | postfix_expression DEC_OP {$$ = makeUnaryExpression($1, UnaryOp::Type::POST_DECREMENT);}
     ;
 
 argument_list
     : assignment_expression
         {
             auto list = makeNodeList();
-            list->PushBack(*$1);
-            $$ = new std::shared_ptr<NodeList>(list);
-            delete $1;
+            list->PushBack($1);
+            $$ = list;
         }
     | argument_list ',' assignment_expression
         {
-            (*$1)->PushBack(*$3);
+            $1->PushBack($3);
             $$ = $1;
-            delete $3;
         }
     ;
 
 unary_expression
     : postfix_expression { $$ = $1; }
     | INC_OP unary_expression {
-            $$ = new std::shared_ptr<Expression>(makeUnaryExpression(*$2, UnaryOp::Type::PRE_INCREMENT));
-            delete $2;
+            $$ = makeUnaryExpression($2, UnaryOp::Type::PRE_INCREMENT);
         }
     | DEC_OP unary_expression {
-            $$ = new std::shared_ptr<Expression>(makeUnaryExpression(*$2, UnaryOp::Type::PRE_DECREMENT));
-            delete $2;
+            $$ = makeUnaryExpression($2, UnaryOp::Type::PRE_DECREMENT);
         }
     | unary_operator cast_expression {
-            $$ = new std::shared_ptr<Expression>(makeUnaryExpression(*$2, $1));
-            delete $2;
+            $$ = makeUnaryExpression($2, $1);
         }
     | SIZEOF unary_expression {
-            $$ = new std::shared_ptr<Expression>(makeSizeofExpression(*$2));
-            delete $2;
+            $$ = makeSizeofExpression($2);
         }
-    | SIZEOF '(' type_specifier ')' {$$ = new std::shared_ptr<Expression>(makeSizeofTypeExpression($3));}
+    | SIZEOF '(' type_specifier ')' {$$ = makeSizeofTypeExpression($3);}
     ;
 
 unary_operator
@@ -644,140 +591,118 @@ unary_operator
 cast_expression
     : unary_expression { $$ = $1; }
     | '(' type_specifier ')' cast_expression
-        {$$ = new std::shared_ptr<Expression>(makeCastExpression($2, *$4)); delete $4;}
+        {$$ = makeCastExpression($2, $4);}
     ;
 
 multiplicative_expression
     : cast_expression { $$ = $1; }
     | multiplicative_expression '*' cast_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::MUL));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::MUL);
         }
     | multiplicative_expression '/' cast_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::DIV));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::DIV);
         }
     | multiplicative_expression '%' cast_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::MOD));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::MOD);
         }
     ;
 
 additive_expression
     : multiplicative_expression { $$ = $1; }
     | additive_expression '+' multiplicative_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::ADD));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::ADD);
         }
     | additive_expression '-' multiplicative_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::SUB));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::SUB);
         }
     ;
 
 shift_expression
     : additive_expression { $$ = $1; }
     | shift_expression LEFT_OP additive_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::LEFT_SHIFT));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::LEFT_SHIFT);
         }
     | shift_expression RIGHT_OP additive_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::RIGHT_SHIFT));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::RIGHT_SHIFT);
         }
     ;
 
 relational_expression
     : shift_expression { $$ = $1; }
     | relational_expression '<' shift_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::LT));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::LT);
         }
     | relational_expression '>' shift_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::GT));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::GT);
         }
     | relational_expression LE_OP shift_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::LE));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::LE);
         }
     | relational_expression GE_OP shift_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::GE));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::GE);
         }
     ;
 
 equality_expression
     : relational_expression { $$ = $1; }
     | equality_expression EQ_OP relational_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::EQ));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::EQ);
         }
     | equality_expression NE_OP relational_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::NE));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::NE);
         }
     ;
 
 and_expression
     : equality_expression { $$ = $1; }
     | and_expression '&' equality_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::AND));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::AND);
         }
     ;
 
 exclusive_or_expression
     : and_expression { $$ = $1; }
     | exclusive_or_expression '^' and_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::XOR));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::XOR);
         }
     ;
 
 inclusive_or_expression
     : exclusive_or_expression { $$ = $1; }
     | inclusive_or_expression '|' exclusive_or_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::OR));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::OR);
         }
     ;
 
 logical_and_expression
     : inclusive_or_expression { $$ = $1; }
     | logical_and_expression AND_OP inclusive_or_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::LOGICAL_AND));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::LOGICAL_AND);
         }
     ;
 
 logical_or_expression
     : logical_and_expression { $$ = $1; }
     | logical_or_expression OR_OP logical_and_expression {
-            $$ = new std::shared_ptr<Expression>(makeBinaryExpression(*$1, *$3, BinaryOp::Type::LOGICAL_OR));
-            delete $1; delete $3;
+            $$ = makeBinaryExpression($1, $3, BinaryOp::Type::LOGICAL_OR);
         }
     ;
 
 conditional_expression
     : logical_or_expression { $$ = $1; }
     | logical_or_expression '?' expression ':' conditional_expression {
-            $$ = new std::shared_ptr<Expression>(makeConditionalExpression(*$1, *$3, *$5));
-            delete $1; delete $3; delete $5;
+            $$ = makeConditionalExpression($1, $3, $5);
         }
     ;
 
 assignment_expression
     : conditional_expression { $$ = $1; }
     | unary_expression assignment_operator assignment_expression {
-            $$ = new std::shared_ptr<Expression>(makeAssignmentExpression(*$1, *$3, $2));
-            delete $1; delete $3;
+            $$ = makeAssignmentExpression($1, $3, $2);
         }
     | unary_expression '=' STRING_LITERAL {
-        std::cerr << " x = str " << std::endl;
-            auto stringExpr = std::make_shared<ast::StringLiteralExpression>(*$3);
-            $$ = new std::shared_ptr<Expression>(makeAssignmentExpression(*$1, stringExpr, AssignOp::ASSIGN));
-            delete $1; delete $3;
+            auto stringExpr = makeStringLiteralExpression(Symbol::FromId($3));
+            $$ = makeAssignmentExpression($1, stringExpr, AssignOp::ASSIGN);
         }
     ;
 
@@ -815,8 +740,7 @@ binary_operator
 expression
     : assignment_expression { $$ = $1; }
     | expression ',' assignment_expression {
-            $$ = new std::shared_ptr<Expression>(makeCommaExpression(*$1, *$3));
-            delete $1; delete $3;
+            $$ = makeCommaExpression($1, $3);
         }
     ;
 
@@ -826,25 +750,66 @@ constant_expression
 
 %%
 
-void yyerror (const char *s)
+// Bison gives up after the first error; ParseAST reports it once the scanner is cleaned up.
+// A character the scanner could not lex has already been described by it.
+void yyerror (yyscan_t scanner, ParseContext& context, const char *s)
 {
-    std::cerr << "Error: " << s << " at line " << yylineno;
-    std::cerr << " near '" << yytext << "'" << std::endl;
-    std::exit(1);
+    if (context.error.empty()) {
+        context.error = std::string("Error: ") + s + " at line " + std::to_string(yyget_lineno(scanner)) +
+                        " near '" + yyget_text(scanner) + "'";
+    }
 }
 
-std::shared_ptr<Node> g_root;
+NodePtr ParseAST(std::string file_name, SourceBuffer& source, Arena& arena)
+{
+  ParseContext context;
+  Arena::Scope scope(arena);
+  yyscan_t scanner;
+  yylex_init_extra(&context, &scanner);
+  YY_BUFFER_STATE buffer = yy_scan_buffer(source.scanBuffer(), source.scanBufferSize(), scanner);
+  int failed = yyparse(scanner, context);
+  yy_delete_buffer(buffer, scanner);
+  yylex_destroy(scanner);
+  if(failed){
+    throw std::runtime_error(file_name + ": " + context.error);
+  }
+  return context.root;
+}
 
-NodePtr ParseAST(std::string file_name)
+// Nothing here is shared between calls: the scanner and the typedef table
+// belong to this parse, so files may be parsed on several threads at once.
+NodePtr ParseAST(std::string file_name, Arena& arena)
 {
-  yyin = fopen(file_name.c_str(), "r");
-  if(yyin == NULL){
-    std::cerr << "Couldn't open input file: " << file_name << std::endl;
-    exit(1);
+  // regular files are scanned in place; "-", pipes and terminals are streamed
+  std::optional<SourceBuffer> source = SourceBuffer::Load(file_name);
+  if(source){
+    return ParseAST(file_name, *source, arena);
+  }
+
+  ParseContext context;
+  Arena::Scope scope(arena);
+  yyscan_t scanner;
+  yylex_init_extra(&context, &scanner);
+
+  FILE* input = file_name == "-" ? stdin : fopen(file_name.c_str(), "r");
+  if(input == NULL){
+    yylex_destroy(scanner);
+    throw std::runtime_error("Couldn't open input file: " + file_name);
+  }
+  yyset_in(input, scanner);
+  int failed = yyparse(scanner, context);
+  if(input != stdin){
+    fclose(input);
   }
-  g_root = nullptr;
-  yyparse();
-  fclose(yyin);
-  yylex_destroy();
-  return g_root;
+  yylex_destroy(scanner);
+  if(failed){
+    throw std::runtime_error(file_name + ": " + context.error);
+  }
+  return context.root;
+}
+
+NodePtr ParseAST(std::string file_name, std::string_view text, Arena& arena)
+{
+  SourceBuffer source = SourceBuffer::FromText(text);
+  return ParseAST(file_name, source, arena);
 }
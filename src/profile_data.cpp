@@ -0,0 +1,146 @@
+#include "profile_data.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string quoted(const std::string& text) {
+    std::string result = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + "\"";
+}
+
+} // namespace
+
+ProfileData ProfileData::Load(const std::string& path)
+{
+    std::ifstream input(path);
+    if (!input) {
+        throw std::runtime_error("Cannot read profile: " + path);
+    }
+
+    ProfileData profile;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        std::istringstream fields(line);
+        std::string function;
+        int block;
+        uint64_t count;
+        if (!(fields >> function)) {
+            continue;   // blank line
+        }
+        std::string extra;
+        if (!(fields >> block >> count) || fields >> extra) {
+            throw std::runtime_error("Malformed profile " + path + ":" + std::to_string(lineNumber));
+        }
+        profile.counts[function][block] += count;
+    }
+    return profile;
+}
+
+std::optional<uint64_t> ProfileData::count(const std::string& function, int block) const
+{
+    auto functionIt = counts.find(function);
+    if (functionIt == counts.end()) {
+        return std::nullopt;
+    }
+    auto blockIt = functionIt->second.find(block);
+    if (blockIt == functionIt->second.end()) {
+        // the function ran but never reached this block
+        return 0;
+    }
+    return blockIt->second;
+}
+
+void EmitProfileRuntime(mir::Function& code, const std::vector<std::string>& counters, const std::string& path)
+{
+    if (counters.empty()) {
+        return;
+    }
+
+    // 64-bit counters, low word first
+    code.addLine("    .bss");
+    code.addLine("    .align 3");
+    code.addLabel(".Lprofile_counters");
+    code.addLine("    .zero", 8 * counters.size());
+
+    code.addLine("    .section    .rodata");
+    code.addLine("    .align 2");
+    code.addLabel(".Lprofile_names");
+    for (size_t i = 0; i < counters.size(); i++) {
+        code.addLine("    .word .Lprofile_name_" + std::to_string(i));
+    }
+    for (size_t i = 0; i < counters.size(); i++) {
+        code.addLabel(".Lprofile_name_" + std::to_string(i));
+        code.addLine("    .string " + quoted(counters[i]));
+    }
+    code.addLabel(".Lprofile_path");
+    code.addLine("    .string " + quoted(path));
+    code.addLabel(".Lprofile_mode");
+    code.addLine("    .string \"a\"");
+    code.addLabel(".Lprofile_format");
+    code.addLine("    .string \"%s %llu\\n\"");
+
+    // atexit handler: fopen(path, "a"), one fprintf per counter, fclose;
+    // s1 steps through the counters, the name table is half as wide
+    code.addLine("    .text");
+    code.addLine("    .align 2");
+    code.addLabel(".Lprofile_dump");
+    code.add(mir::Opcode::Addi, {mir::Reg("sp"), mir::Reg("sp"), mir::Imm(-16)});
+    code.add(mir::Opcode::Sw, {mir::Reg("ra"), mir::Mem(12, "sp")});
+    code.add(mir::Opcode::Sw, {mir::Reg("s0"), mir::Mem(8, "sp")});
+    code.add(mir::Opcode::Sw, {mir::Reg("s1"), mir::Mem(4, "sp")});
+    code.add(mir::Opcode::Lui, {mir::Reg("a0"), mir::Hi(".Lprofile_path")});
+    code.add(mir::Opcode::Addi, {mir::Reg("a0"), mir::Reg("a0"), mir::Lo(".Lprofile_path")});
+    code.add(mir::Opcode::Lui, {mir::Reg("a1"), mir::Hi(".Lprofile_mode")});
+    code.add(mir::Opcode::Addi, {mir::Reg("a1"), mir::Reg("a1"), mir::Lo(".Lprofile_mode")});
+    code.add(mir::Opcode::Call, {mir::Sym("fopen")});
+    code.add(mir::Opcode::Beqz, {mir::Reg("a0"), mir::Sym(".Lprofile_dump_end")});
+    code.add(mir::Opcode::Mv, {mir::Reg("s0"), mir::Reg("a0")});
+    code.add(mir::Opcode::Li, {mir::Reg("s1"), mir::Imm(0)});
+    code.addLabel(".Lprofile_dump_loop");
+    code.add(mir::Opcode::Lui, {mir::Reg("t0"), mir::Hi(".Lprofile_names")});
+    code.add(mir::Opcode::Addi, {mir::Reg("t0"), mir::Reg("t0"), mir::Lo(".Lprofile_names")});
+    code.add(mir::Opcode::Srli, {mir::Reg("t1"), mir::Reg("s1"), mir::Imm(1)});
+    code.add(mir::Opcode::Add, {mir::Reg("t0"), mir::Reg("t0"), mir::Reg("t1")});
+    code.add(mir::Opcode::Lw, {mir::Reg("a2"), mir::Mem(0, "t0")});
+    code.add(mir::Opcode::Lui, {mir::Reg("t0"), mir::Hi(".Lprofile_counters")});
+    code.add(mir::Opcode::Addi, {mir::Reg("t0"), mir::Reg("t0"), mir::Lo(".Lprofile_counters")});
+    code.add(mir::Opcode::Add, {mir::Reg("t0"), mir::Reg("t0"), mir::Reg("s1")});
+    // a variadic 64-bit argument takes an even register pair, so a3 is skipped
+    code.add(mir::Opcode::Lw, {mir::Reg("a4"), mir::Mem(0, "t0")});
+    code.add(mir::Opcode::Lw, {mir::Reg("a5"), mir::Mem(4, "t0")});
+    code.add(mir::Opcode::Mv, {mir::Reg("a0"), mir::Reg("s0")});
+    code.add(mir::Opcode::Lui, {mir::Reg("a1"), mir::Hi(".Lprofile_format")});
+    code.add(mir::Opcode::Addi, {mir::Reg("a1"), mir::Reg("a1"), mir::Lo(".Lprofile_format")});
+    code.add(mir::Opcode::Call, {mir::Sym("fprintf")});
+    code.add(mir::Opcode::Addi, {mir::Reg("s1"), mir::Reg("s1"), mir::Imm(8)});
+    code.add(mir::Opcode::Li, {mir::Reg("t0"), mir::Imm(8 * counters.size())});
+    code.add(mir::Opcode::Blt, {mir::Reg("s1"), mir::Reg("t0"), mir::Sym(".Lprofile_dump_loop")});
+    code.add(mir::Opcode::Mv, {mir::Reg("a0"), mir::Reg("s0")});
+    code.add(mir::Opcode::Call, {mir::Sym("fclose")});
+    code.addLabel(".Lprofile_dump_end");
+    code.add(mir::Opcode::Lw, {mir::Reg("s1"), mir::Mem(4, "sp")});
+    code.add(mir::Opcode::Lw, {mir::Reg("s0"), mir::Mem(8, "sp")});
+    code.add(mir::Opcode::Lw, {mir::Reg("ra"), mir::Mem(12, "sp")});
+    code.add(mir::Opcode::Addi, {mir::Reg("sp"), mir::Reg("sp"), mir::Imm(16)});
+    code.add(mir::Opcode::Ret, {});
+
+    // run before main by the C runtime's .init_array walk
+    code.addLabel(".Lprofile_init");
+    code.add(mir::Opcode::Lui, {mir::Reg("a0"), mir::Hi(".Lprofile_dump")});
+    code.add(mir::Opcode::Addi, {mir::Reg("a0"), mir::Reg("a0"), mir::Lo(".Lprofile_dump")});
+    code.add(mir::Opcode::Tail, {mir::Sym("atexit")});
+    code.addLine("    .section    .init_array,\"aw\"");
+    code.addLine("    .align 2");
+    code.addLine("    .word .Lprofile_init");
+}
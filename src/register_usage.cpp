@@ -0,0 +1,67 @@
+#include "register_usage.hpp"
+
+namespace {
+
+bool inRange(const std::string& name, const std::string& prefix, int last) {
+    if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    std::string digits = name.substr(prefix.size());
+    if (digits.size() > 2 || (digits.size() == 2 && digits[0] == '0')) {
+        return false;
+    }
+    for (char c : digits) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+    return std::stoi(digits) <= last;
+}
+
+// t0-t6, a0-a7, ft0-ft11 and fa0-fa7
+bool isCallerSaved(const std::string& name) {
+    return inRange(name, "t", 6) || inRange(name, "a", 7) || inRange(name, "ft", 11) || inRange(name, "fa", 7);
+}
+
+// registers the assembler's expansion writes without the instruction naming
+// them: call is auipc ra + jalr ra, tail is auipc t1 + jr t1
+void addImplicitClobbers(mir::Opcode opcode, std::set<std::string>& clobbered) {
+    if (opcode == mir::Opcode::Call) {
+        clobbered.insert("ra");
+    } else if (opcode == mir::Opcode::Tail) {
+        clobbered.insert("t1");
+    }
+}
+
+} // namespace
+
+std::optional<std::set<std::string>> ClobberedRegisters(const mir::Function& function,
+    const std::unordered_map<std::string, std::set<std::string>>& known)
+{
+    std::set<std::string> clobbered;
+    for (const auto& block : function.blocks) {
+        for (const auto& insn : block.instructions) {
+            if (insn.opcode == mir::Opcode::Call || insn.opcode == mir::Opcode::Tail) {
+                auto it = insn.operands.empty() ? known.end() : known.find(insn.operands[0].symbol);
+                if (it == known.end()) {
+                    return std::nullopt;
+                }
+                clobbered.insert(it->second.begin(), it->second.end());
+                addImplicitClobbers(insn.opcode, clobbered);
+                continue;
+            }
+            if (insn.opcode == mir::Opcode::Jalr || insn.mnemonic() == "c.jalr") {
+                return std::nullopt;
+            }
+
+            // sources are counted too, which only errs towards saving more
+            for (const auto& operand : insn.operands) {
+                bool named = operand.isRegister() || operand.kind == mir::Operand::Kind::Memory;
+                if (named && isCallerSaved(operand.reg)) {
+                    clobbered.insert(operand.reg);
+                }
+            }
+        }
+    }
+    return clobbered;
+}
@@ -0,0 +1,107 @@
+#include "source_buffer.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// closes the descriptor however Load returns
+struct FileDescriptor {
+    int fd;
+    ~FileDescriptor() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+} // namespace
+
+std::optional<SourceBuffer> SourceBuffer::Load(const std::string& path)
+{
+    if (path == "-") {
+        return std::nullopt;
+    }
+    FileDescriptor file{open(path.c_str(), O_RDONLY)};
+    struct stat info;
+    if (file.fd < 0 || fstat(file.fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        return std::nullopt;
+    }
+
+    SourceBuffer source;
+    source.length = static_cast<size_t>(info.st_size);
+
+    // Reserve zeroed pages for the text and its terminators, then map the file
+    // over the front. Mapping only the file would fault on the terminators
+    // whenever its size is a whole number of pages.
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t size = (source.length + 2 + page - 1) / page * page;
+    void* reserved = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved != MAP_FAILED) {
+        if (source.length == 0 ||
+            mmap(reserved, source.length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, file.fd, 0) != MAP_FAILED) {
+            source.bytes = static_cast<char*>(reserved);
+            source.mapping_size = size;
+            madvise(reserved, size, MADV_SEQUENTIAL);
+            return source;
+        }
+        munmap(reserved, size);
+    }
+
+    // no mapping: one read of the whole file, short reads aside
+    source.copy.resize(source.length + 2, '\0');
+    size_t done = 0;
+    while (done < source.length) {
+        ssize_t got = read(file.fd, source.copy.data() + done, source.length - done);
+        if (got <= 0) {
+            break;
+        }
+        done += static_cast<size_t>(got);
+    }
+    source.length = done;
+    source.copy.resize(done + 2);
+    source.bytes = source.copy.data();
+    return source;
+}
+
+SourceBuffer SourceBuffer::FromText(std::string_view text)
+{
+    SourceBuffer source;
+    source.copy.reserve(text.size() + 2);
+    source.copy.assign(text.begin(), text.end());
+    source.copy.resize(text.size() + 2, '\0');
+    source.length = text.size();
+    source.bytes = source.copy.data();
+    return source;
+}
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept
+{
+    if (this != &other) {
+        if (mapping_size > 0) {
+            munmap(bytes, mapping_size);
+        }
+        length = other.length;
+        mapping_size = other.mapping_size;
+        copy = std::move(other.copy);
+        bytes = mapping_size > 0 ? other.bytes : copy.data();
+        other.bytes = nullptr;
+        other.length = 0;
+        other.mapping_size = 0;
+    }
+    return *this;
+}
+
+SourceBuffer::~SourceBuffer()
+{
+    if (mapping_size > 0) {
+        munmap(bytes, mapping_size);
+    }
+}
@@ -0,0 +1,116 @@
+#include "symbol.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace ast {
+
+namespace {
+
+// Names live in fixed-size chunks that are never reallocated, so str() can
+// read them without the lock while other threads keep interning.
+constexpr size_t CHUNK_BITS = 12;
+constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+constexpr size_t MAX_CHUNKS = size_t(1) << 12;
+
+thread_local SymbolTable* current = nullptr;
+
+} // namespace
+
+struct SymbolTable::Names {
+    std::mutex mutex;
+    std::unordered_map<std::string_view, Symbol::Id> ids;   // views into chunks
+    std::atomic<std::string*> chunks[MAX_CHUNKS] = {};
+    std::atomic<size_t> count{0};
+
+    Names() {
+        chunks[0] = new std::string[CHUNK_SIZE];
+        clear();
+    }
+
+    ~Names() {
+        for (auto& chunk : chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    void clear() {
+        ids.clear();
+        ids.emplace(std::string_view(), 0);
+        count = 1;
+    }
+};
+
+SymbolTable::SymbolTable() : names(std::make_unique<Names>()) {}
+
+SymbolTable::~SymbolTable() = default;
+
+void SymbolTable::reset()
+{
+    std::lock_guard<std::mutex> lock(names->mutex);
+    names->clear();
+}
+
+Symbol::Scope::Scope(SymbolTable& table) : previous(current)
+{
+    current = &table;
+}
+
+Symbol::Scope::~Scope()
+{
+    current = previous;
+}
+
+SymbolTable& Symbol::CurrentTable()
+{
+    static SymbolTable* process = new SymbolTable();    // lives as long as the names handed out
+    return current ? *current : *process;
+}
+
+Symbol Symbol::Intern(std::string_view text)
+{
+    SymbolTable::Names& symbols = *CurrentTable().names;
+    std::lock_guard<std::mutex> lock(symbols.mutex);
+    auto it = symbols.ids.find(text);
+    if (it != symbols.ids.end()) {
+        return FromId(it->second);
+    }
+
+    size_t id = symbols.count;
+    size_t chunk = id >> CHUNK_BITS;
+    if (chunk >= MAX_CHUNKS) {
+        throw std::runtime_error("Too many distinct names");
+    }
+    std::string* names = symbols.chunks[chunk].load(std::memory_order_relaxed);
+    if (!names) {
+        names = new std::string[CHUNK_SIZE];
+        symbols.chunks[chunk].store(names, std::memory_order_release);
+    }
+    std::string& name = names[id & (CHUNK_SIZE - 1)];
+    name.assign(text);
+    symbols.ids.emplace(name, static_cast<Id>(id));
+    symbols.count.store(id + 1, std::memory_order_release);
+    return FromId(static_cast<Id>(id));
+}
+
+Symbol Symbol::FromId(Id id)
+{
+    Symbol symbol;
+    symbol.id_ = id;
+    return symbol;
+}
+
+size_t Symbol::Count()
+{
+    return CurrentTable().names->count.load(std::memory_order_acquire);
+}
+
+const std::string& Symbol::str() const
+{
+    const std::string* names = CurrentTable().names->chunks[id_ >> CHUNK_BITS].load(std::memory_order_acquire);
+    return names[id_ & (CHUNK_SIZE - 1)];
+}
+
+} // namespace ast
@@ -0,0 +1,192 @@
+#include "whole_program.hpp"
+
+#include <initializer_list>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "ast.hpp"
+#include "analysis_visitor.hpp"
+
+namespace {
+
+struct TopLevel {
+    ast::NodePtr node;
+    std::string name;       // empty for declarations that define nothing
+    bool isFunction = false;
+    size_t unit = 0;
+};
+
+// multi-declarator lines (int a, b;) arrive as a nested list
+void flatten(const ast::NodePtr& node, size_t unit, std::vector<TopLevel>& items) {
+    if (auto list = dynamic_cast<ast::NodeList*>(node)) {
+        for (const auto& child : list->getNodes()) {
+            flatten(child, unit, items);
+        }
+        return;
+    }
+    TopLevel item;
+    item.node = node;
+    item.unit = unit;
+    if (auto function = dynamic_cast<ast::FunctionDeclaration*>(node)) {
+        if (function->hasBody()) {
+            item.name = function->getIdentifier();
+            item.isFunction = true;
+        }
+    } else if (auto variable = dynamic_cast<ast::VariableDeclaration*>(node)) {
+        // prototypes and typedefs only declare
+        if (!variable->isTypedef() && !(variable->getDeclarator() && variable->getDeclarator()->isFunction())) {
+            item.name = variable->getIdentifier();
+        }
+    }
+    items.push_back(item);
+}
+
+// the text of each group's names, sorted so the callees-first order is stable
+std::set<std::string> names(std::initializer_list<const std::unordered_set<ast::Symbol>*> groups) {
+    std::set<std::string> text;
+    for (const auto* group : groups) {
+        for (const auto& symbol : *group) {
+            text.insert(symbol.str());
+        }
+    }
+    return text;
+}
+
+// every name a definition refers to, including operands of sizeof
+std::set<std::string> references(const ast::Node& node) {
+    codegen::AnalysisVisitor info;
+    node.accept(info);
+    return names({&info.getRead(), &info.getAssigned(), &info.getStoredArrays(), &info.getAddressTaken(),
+                  &info.getCalledFunctions(), &info.getUnevaluated()});
+}
+
+// names a definition uses as values rather than call targets
+std::set<std::string> escapes(const ast::Node& node) {
+    codegen::AnalysisVisitor info;
+    node.accept(info);
+    return names({&info.getRead(), &info.getAssigned(), &info.getStoredArrays(), &info.getAddressTaken()});
+}
+
+std::set<std::string> callees(const ast::Node& node) {
+    codegen::AnalysisVisitor info;
+    node.accept(info);
+    return names({&info.getCalledFunctions()});
+}
+
+void placeCalleesFirst(size_t item, const std::vector<TopLevel>& items, const std::map<std::string, size_t>& functions,
+                       std::set<size_t>& placed, std::vector<size_t>& order) {
+    if (!placed.insert(item).second) {
+        return;
+    }
+    for (const auto& callee : callees(*items[item].node)) {
+        auto it = functions.find(callee);
+        if (it != functions.end()) {
+            placeCalleesFirst(it->second, items, functions, placed, order);
+        }
+    }
+    order.push_back(item);
+}
+
+} // namespace
+
+ast::NodePtr LinkProgram(const std::vector<SourceUnit>& units, LinkReport& report)
+{
+    std::vector<TopLevel> items;
+    for (size_t i = 0; i < units.size(); i++) {
+        if (units[i].root) {
+            flatten(units[i].root, i, items);
+        }
+    }
+
+    std::map<std::string, size_t> definitions;
+    for (size_t i = 0; i < items.size(); i++) {
+        const std::string& name = items[i].name;
+        if (name.empty()) {
+            continue;
+        }
+        auto [it, added] = definitions.insert({name, i});
+        if (!added) {
+            throw std::runtime_error("'" + name + "' is defined in both " + units[items[it->second].unit].path +
+                                     " and " + units[items[i].unit].path);
+        }
+    }
+
+    std::set<std::string> live;
+    if (definitions.count("main")) {
+        std::vector<std::string> worklist = {"main"};
+        live.insert("main");
+        while (!worklist.empty()) {
+            std::string name = worklist.back();
+            worklist.pop_back();
+            for (const auto& used : references(*items[definitions[name]].node)) {
+                if (definitions.count(used) && live.insert(used).second) {
+                    worklist.push_back(used);
+                }
+            }
+        }
+    }
+
+    auto program = ast::makeNodeList();
+    for (const auto& item : items) {
+        if (!live.empty() && !item.name.empty() && !live.count(item.name)) {
+            if (item.isFunction) {
+                report.removedFunctions++;
+            } else {
+                report.removedGlobals++;
+            }
+            continue;
+        }
+        program->PushBack(item.node);
+    }
+    return program;
+}
+
+ast::NodePtr OrderCalleesFirst(const ast::NodePtr& root, std::set<std::string>& registerArguments)
+{
+    std::vector<TopLevel> items;
+    flatten(root, 0, items);
+
+    auto program = ast::makeNodeList();
+    std::map<std::string, size_t> functions;
+    std::set<std::string> escaping = {"main"};
+    for (size_t i = 0; i < items.size(); i++) {
+        if (items[i].isFunction) {
+            functions[items[i].name] = i;
+        } else {
+            program->PushBack(items[i].node);
+        }
+        const auto used = escapes(*items[i].node);
+        escaping.insert(used.begin(), used.end());
+    }
+
+    std::set<size_t> placed;
+    std::vector<size_t> order;
+    for (size_t i = 0; i < items.size(); i++) {
+        if (items[i].isFunction) {
+            placeCalleesFirst(i, items, functions, placed, order);
+        }
+    }
+    for (size_t item : order) {
+        program->PushBack(items[item].node);
+    }
+
+    for (const auto& [name, item] : functions) {
+        if (escaping.count(name)) {
+            continue;
+        }
+        auto function = dynamic_cast<ast::FunctionDeclaration*>(items[item].node);
+        bool integerOnly = true;
+        for (const auto& param : function->getParameters()) {
+            if (!param->isPointer() && (param->getType() == ast::TypeSpecifier::FLOAT ||
+                                        param->getType() == ast::TypeSpecifier::DOUBLE)) {
+                integerOnly = false;
+            }
+        }
+        if (integerOnly) {
+            registerArguments.insert(name);
+        }
+    }
+    return program;
+}
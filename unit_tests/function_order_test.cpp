@@ -0,0 +1,61 @@
+#include "unit_test.hpp"
+
+#include <algorithm>
+
+#include "function_order.hpp"
+
+namespace {
+
+FunctionNode node(const std::string& name, size_t size, uint64_t heat)
+{
+    FunctionNode function;
+    function.name = name;
+    function.size = size;
+    function.heat = heat;
+    return function;
+}
+
+size_t position(const std::vector<size_t>& order, size_t function)
+{
+    return std::find(order.begin(), order.end(), function) - order.begin();
+}
+
+} // namespace
+
+// the hot caller and callee sit apart in the source, with a large cold
+// function between them
+UNIT_TEST(HotCallerAndCalleeAreAdjacent)
+{
+    std::vector<FunctionNode> functions = {
+        node("caller", 40, 1000),
+        node("cold", 400, 0),
+        node("lukewarm", 20, 10),
+        node("callee", 30, 1000),
+    };
+    functions[0].calls["callee"] = 1000;
+    functions[0].calls["lukewarm"] = 10;
+
+    std::vector<size_t> order = OrderFunctions(functions);
+    CHECK(order.size() == functions.size());
+    size_t caller = position(order, 0);
+    size_t callee = position(order, 3);
+    CHECK(caller + 1 == callee || callee + 1 == caller);
+    CHECK(position(order, 1) == order.size() - 1);
+}
+
+UNIT_TEST(EveryFunctionIsPlacedOnce)
+{
+    std::vector<FunctionNode> functions = {
+        node("a", 10, 1),
+        node("b", 10, 5),
+        node("c", 10, 3),
+    };
+    functions[0].calls["b"] = 2;
+    functions[1].calls["a"] = 2;
+    functions[2].calls["missing"] = 7;
+
+    std::vector<size_t> order = OrderFunctions(functions);
+    std::vector<size_t> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    CHECK((sorted == std::vector<size_t>{0, 1, 2}));
+}
@@ -0,0 +1,38 @@
+#include "unit_test.hpp"
+
+#include <sstream>
+
+#include "machine_ir.hpp"
+
+UNIT_TEST(OperandsFormatCompactly)
+{
+    std::string text;
+    mir::Append(text, mir::Instruction(mir::Opcode::Lw, {mir::Reg("a0"), mir::Mem(-8, "s0")}));
+    CHECK(text == "    lw a0, -8(s0)");
+
+    text.clear();
+    mir::Append(text, mir::Instruction(mir::Opcode::Addi, {mir::Reg("t0"), mir::Reg("t0"), mir::Lo("table")}));
+    CHECK(text == "    addi t0, t0, %lo(table)");
+
+    text.clear();
+    mir::Append(text, mir::Instruction(mir::Opcode::Bnez, {mir::Reg("a1"), mir::Sym(".L3")}));
+    CHECK(text == "    bnez a1, .L3");
+}
+
+// labels and directives open a block, a branch closes one
+UNIT_TEST(FunctionPrintsInProgramOrder)
+{
+    mir::Function code;
+    code.addLine("    .data");
+    code.addLabel("count");
+    code.addLine("    .word", -2147483648LL);
+    code.add(mir::Opcode::Beqz, {mir::Reg("a0"), mir::Sym(".L1")});
+    code.add(mir::Opcode::Li, {mir::Reg("a0"), mir::Imm(1)});
+    code.addLabel(".L1");
+    code.add(mir::Opcode::Ret, {});
+    CHECK(code.blocks.size() == 3);
+
+    std::ostringstream output;
+    mir::Print(code, output);
+    CHECK(output.str() == "    .data\ncount:\n    .word -2147483648\n    beqz a0, .L1\n    li a0, 1\n.L1:\n    ret\n");
+}
@@ -0,0 +1,30 @@
+#include "unit_test.hpp"
+
+#include <exception>
+#include <iostream>
+
+std::vector<UnitTest>& UnitTests()
+{
+    static std::vector<UnitTest> tests;
+    return tests;
+}
+
+int main()
+{
+    int failed = 0;
+    for (const auto& test : UnitTests())
+    {
+        try
+        {
+            test.run();
+            std::cout << test.name << "\n\t> Pass" << std::endl;
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << test.name << "\n\t> " << e.what() << std::endl;
+            failed++;
+        }
+    }
+    std::cout << "\nPassing " << UnitTests().size() - failed << "/" << UnitTests().size() << " unit tests" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+#include "unit_test.hpp"
+
+#include "register_usage.hpp"
+
+// a tail call jumps through t1, which the instruction never names
+UNIT_TEST(TailCallClobbersT1)
+{
+    mir::Function function;
+    function.add(mir::Opcode::Li, {mir::Reg("a0"), mir::Imm(1)});
+    function.add(mir::Opcode::Tail, {mir::Sym("leaf")});
+
+    auto clobbered = ClobberedRegisters(function, {{"leaf", {"a0"}}});
+    CHECK(clobbered.has_value());
+    CHECK(clobbered->count("t1") == 1);
+    CHECK(clobbered->count("a0") == 1);
+}
+
+UNIT_TEST(CallAddsTheCalleesSet)
+{
+    mir::Function function;
+    function.add(mir::Opcode::Call, {mir::Sym("leaf")});
+    function.add(mir::Opcode::Ret, {});
+
+    auto clobbered = ClobberedRegisters(function, {{"leaf", {"t3", "a0"}}});
+    CHECK(clobbered.has_value());
+    CHECK(clobbered->count("ra") == 1);
+    CHECK(clobbered->count("t3") == 1);
+    CHECK(!ClobberedRegisters(function, {}).has_value());
+}
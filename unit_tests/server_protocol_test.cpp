@@ -0,0 +1,64 @@
+#include "unit_test.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "server_protocol.hpp"
+
+namespace {
+
+// both ends of a connected local socket, closed when the test is done
+struct SocketPair
+{
+    int fds[2] = {-1, -1};
+
+    SocketPair()
+    {
+        CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    }
+
+    ~SocketPair()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+};
+
+void sendWord(int fd, uint32_t value)
+{
+    CHECK(protocol::SendAll(fd, &value, sizeof(value)));
+}
+
+} // namespace
+
+UNIT_TEST(RequestRoundTrips)
+{
+    SocketPair sockets;
+    CompileRequest sent{"a.c", "int f() { return 1; }\n", {"-O1", "-fipa-ra"}};
+    CHECK(protocol::SendRequest(sockets.fds[0], sent));
+
+    CompileRequest received;
+    CHECK(protocol::ReceiveRequest(sockets.fds[1], received));
+    CHECK(received.source_name == sent.source_name);
+    CHECK(received.source_text == sent.source_text);
+    CHECK(received.flags == sent.flags);
+}
+
+UNIT_TEST(TooManyFieldsIsABrokenMessage)
+{
+    SocketPair sockets;
+    sendWord(sockets.fds[0], protocol::MAX_MESSAGE_FIELDS + 1);
+
+    std::vector<std::string> fields;
+    CHECK(!protocol::ReceiveMessage(sockets.fds[1], fields));
+}
+
+UNIT_TEST(OversizedFieldIsABrokenMessage)
+{
+    SocketPair sockets;
+    sendWord(sockets.fds[0], 1);
+    sendWord(sockets.fds[0], 0xffffffffu);
+
+    std::vector<std::string> fields;
+    CHECK(!protocol::ReceiveMessage(sockets.fds[1], fields));
+}
@@ -0,0 +1,28 @@
+#include "unit_test.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+#include "c_compiler.hpp"
+#include "source_buffer.hpp"
+
+// a loaded file is compiled where it lies, and the scanner leaves it as it was
+UNIT_TEST(LoadedFileCompilesInPlace)
+{
+    const std::string path = "/tmp/c_compiler_unit_source_buffer.c";
+    const std::string text = "int twice(int x)\n{\n    return x + x;\n}\n";
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << text;
+    }
+
+    std::optional<SourceBuffer> source = SourceBuffer::Load(path);
+    std::remove(path.c_str());
+    CHECK(source.has_value());
+
+    Compiler compiler;
+    CompileResult result = compiler.compile(*source, CompileOptions(), path);
+    CHECK(result.ok);
+    CHECK(result.assembly.find("twice:") != std::string::npos);
+    CHECK(source->text() == text);
+}
@@ -0,0 +1,30 @@
+#include "unit_test.hpp"
+
+#include "c_compiler.hpp"
+#include "symbol.hpp"
+
+UNIT_TEST(ScopedTableForgetsItsNamesOnReset)
+{
+    ast::SymbolTable table;
+    ast::Symbol::Scope scope(table);
+    ast::Symbol name = ast::Symbol::Intern("only_in_this_table");
+    CHECK(name.str() == "only_in_this_table");
+    CHECK(ast::Symbol::Count() == 2);
+
+    table.reset();
+    CHECK(ast::Symbol::Count() == 1);
+    CHECK(ast::Symbol::Intern("another").id() == name.id());
+}
+
+// a resident server compiles request after request: none of their names
+// may build up in the process-wide table
+UNIT_TEST(CompilingLeavesNoNamesBehind)
+{
+    Compiler compiler;
+    compiler.compile("int first_unit(int a) { return a; }\n", CompileOptions());
+    size_t before = ast::Symbol::Count();
+    CompileResult result = compiler.compile("int second_unit(int b) { return b + 1; }\n", CompileOptions());
+    CHECK(result.ok);
+    CHECK(result.assembly.find("second_unit:") != std::string::npos);
+    CHECK(ast::Symbol::Count() == before);
+}
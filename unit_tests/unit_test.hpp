@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Checks of single modules, linked against bin/libc_compiler.a and run by
+// bin/unit_tests. A test throws to fail; CHECK says which condition broke.
+struct UnitTest
+{
+    const char* name;
+    void (*run)();
+};
+
+std::vector<UnitTest>& UnitTests();
+
+struct UnitTestRegistration
+{
+    UnitTestRegistration(const char* name, void (*run)()) { UnitTests().push_back({name, run}); }
+};
+
+#define UNIT_TEST(name) \
+    static void name(); \
+    static UnitTestRegistration name##_registration(#name, name); \
+    static void name()
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            throw std::runtime_error(std::string(__FILE__) + ":" + std::to_string(__LINE__) + ": CHECK(" #condition ") failed"); \
+        } \
+    } while (false)
@@ -0,0 +1,73 @@
+#include "unit_test.hpp"
+
+#include <stdexcept>
+
+#include "ast.hpp"
+#include "whole_program.hpp"
+
+namespace {
+
+SourceUnit unit(const std::string& path, std::string_view text)
+{
+    SourceUnit source;
+    source.path = path;
+    source.arena = std::make_unique<ast::Arena>();
+    source.root = ParseAST(path, text, *source.arena);
+    return source;
+}
+
+std::vector<SourceUnit> program(std::string_view first, std::string_view second)
+{
+    std::vector<SourceUnit> units;
+    units.push_back(unit("first.c", first));
+    units.push_back(unit("second.c", second));
+    return units;
+}
+
+// as the compiler does, nodes the linker makes live with the first unit
+ast::NodePtr link(const std::vector<SourceUnit>& units, LinkReport& report)
+{
+    ast::Arena::Scope scope(*units.front().arena);
+    return LinkProgram(units, report);
+}
+
+} // namespace
+
+UNIT_TEST(DuplicateDefinitionIsAnError)
+{
+    auto units = program("int f() { return 1; }\nint main() { return f(); }\n",
+                         "int f() { return 2; }\n");
+    LinkReport report;
+    bool threw = false;
+    try
+    {
+        link(units, report);
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+UNIT_TEST(UnreachableDefinitionsAreRemoved)
+{
+    auto units = program("int used;\nint unused;\nint f();\nint main() { return f() + used; }\n",
+                         "int f() { return 1; }\nint g() { return 2; }\n");
+    LinkReport report;
+    link(units, report);
+    CHECK(report.removedFunctions == 1);
+    CHECK(report.removedGlobals == 1);
+}
+
+// a header typedef seen by both units names a type; it is neither a
+// duplicate definition nor an unused global
+UNIT_TEST(TypedefInEveryUnitIsNotADefinition)
+{
+    auto units = program("typedef int T;\nT f(T x);\nint main() { return f(1); }\n",
+                         "typedef int T;\nT f(T x) { return x + 1; }\n");
+    LinkReport report;
+    link(units, report);
+    CHECK(report.removedFunctions == 0);
+    CHECK(report.removedGlobals == 0);
+}